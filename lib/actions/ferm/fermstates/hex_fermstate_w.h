@@ -15,7 +15,9 @@
 #include "actions/ferm/fermstates/hex_fermstate_params.h"
 #include "util/gauge/stout_utils.h"
 #include "meas/smear/hex_smear.h"
+#include "util/gauge/smeared_link_cache.h"
 
+#include <sstream>
 #include <stdexcept>
 
 namespace Chroma 
@@ -115,7 +117,33 @@ namespace Chroma
 
       thin_links = u_; 
 
-      Hex_Smear(u_, smeared_links, params.n_smear) ;
+      // Without nontrivial BCs the smeared links only depend on the thin
+      // links, so they can be shared through the smeared link cache
+      SmearedLinkCache& cache = TheSmearedLinkCache::Instance();
+      const bool use_cache = cache.enabled() && ! fbc->nontrivialP();
+
+      std::string gauge_id;
+      std::ostringstream key;
+      key << "HEX_FERM_STATE:" << params.n_smear;
+
+      SmearedLinkCache::Levels_t levels;
+
+      if( use_cache ) {
+	gauge_id = cache.gaugeId(thin_links);
+      }
+
+      if( use_cache && cache.lookup(levels, gauge_id, key.str()) ) {
+	smeared_links = levels[0];
+      }
+      else {
+	Hex_Smear(u_, smeared_links, params.n_smear) ;
+
+	if( use_cache ) {
+	  levels.resize(1);
+	  levels[0] = smeared_links;
+	  cache.insert(gauge_id, key.str(), levels);
+	}
+      }
 
       
       if( fbc->nontrivialP() ) {
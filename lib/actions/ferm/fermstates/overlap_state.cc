@@ -7,6 +7,8 @@
 #include "chromabase.h"
 #include "actions/ferm/fermstates/overlap_state.h"
 #include "actions/ferm/fermstates/simple_fermstate.h"
+#include "meas/inline/io/named_objmap.h"
+#include "util/ferm/eigeninfo.h"
 
 
 namespace Chroma 
@@ -201,7 +203,26 @@ namespace Chroma
 	Real lambda_hi;
 	const EigenIO_t& eigen_io = state_info.getEigenIO();
 	  
-	if( eigen_io.eigen_filefmt == EVEC_TYPE_SCIDAC ) { 
+	if( state_info.getEigenId() != "" ) {
+	  // Eigenpairs computed or read earlier in the run
+	  const EigenInfo<LatticeFermion>& eigen_info =
+	    TheNamedObjMap::Instance().getData< EigenInfo<LatticeFermion> >(state_info.getEigenId());
+
+	  if( eigen_info.getEvalues().size() < state_info.getNWilsVec() ) {
+	    QDPIO::cerr << "Named object " << state_info.getEigenId() << " holds only "
+			<< eigen_info.getEvalues().size() << " eigenpairs" << std::endl;
+	    QDP_abort(1);
+	  }
+
+	  lambda_lo.resize(state_info.getNWilsVec());
+	  eigv_lo.resize(state_info.getNWilsVec());
+	  for(int i=0; i < state_info.getNWilsVec(); i++) {
+	    lambda_lo[i] = eigen_info.getEvalues()[i];
+	    eigv_lo[i] = eigen_info.getEvectors()[i];
+	  }
+	  lambda_hi = eigen_info.getLargest();
+	}
+	else if( eigen_io.eigen_filefmt == EVEC_TYPE_SCIDAC ) { 
 	  readEigen(ritz_header, lambda_lo, eigv_lo, lambda_hi, 
 		    eigen_io.eigen_file,
 		    state_info.getNWilsVec(),
@@ -14,6 +14,10 @@
 #include "create_state.h"
 #include "actions/ferm/fermstates/stout_fermstate_params.h"
 #include "util/gauge/stout_utils.h"
+#include "util/gauge/smeared_link_cache.h"
+
+#include <sstream>
+#include <iomanip>
 
 namespace Chroma 
 {
@@ -159,8 +163,27 @@ namespace Chroma
 	fbc->modify( smeared_links[0] );    
       }
       
-      // Iterate up the smearings
-      for(int i=1; i <= params.n_smear; i++) {
+      // Without nontrivial BCs the levels only depend on the thin links,
+      // so they can be shared through the smeared link cache
+      SmearedLinkCache& cache = TheSmearedLinkCache::Instance();
+      const bool use_cache = cache.enabled() && params.n_smear > 0 && ! fbc->nontrivialP();
+
+      std::string gauge_id;
+      int first = 1;
+
+      if( use_cache ) {
+	gauge_id = cache.gaugeId(smeared_links[0]);
+
+	SmearedLinkCache::Levels_t levels;
+	if( cache.lookup(levels, gauge_id, cacheKey()) ) {
+	  for(; first <= params.n_smear && first <= levels.size(); first++) {
+	    smeared_links[first] = levels[first-1];
+	  }
+	}
+      }
+
+      // Iterate up the smearings not found in the cache
+      for(int i=first; i <= params.n_smear; i++) {
 	
 	Stouting::smear_links(smeared_links[i-1], smeared_links[i], params.smear_in_this_dirP, params.rho);
 	if( fbc->nontrivialP() ) {
@@ -169,6 +192,14 @@ namespace Chroma
 	
       }
 
+      if( use_cache && first <= params.n_smear ) {
+	SmearedLinkCache::Levels_t levels(params.n_smear);
+	for(int i=1; i <= params.n_smear; i++) {
+	  levels[i-1] = smeared_links[i];
+	}
+	cache.insert(gauge_id, cacheKey(), levels);
+      }
+
       // ANTIPERIODIC BCs only -- modify only top level smeared thing
       fat_links_with_bc.resize(Nd);
       fat_links_with_bc = smeared_links[params.n_smear];
@@ -177,6 +208,21 @@ namespace Chroma
       
       END_CODE();
     }
+
+
+    //! Cache key of the smearing, independent of the number of levels
+    std::string cacheKey() const
+    {
+      std::ostringstream key;
+      key << "STOUT_FERM_STATE" << std::setprecision(17);
+      for(int mu=0; mu < Nd; mu++) {
+	key << ":" << params.smear_in_this_dirP[mu];
+	for(int nu=0; nu < Nd; nu++) {
+	  key << "," << toDouble(params.rho[mu][nu]);
+	}
+      }
+      return key.str();
+    }
     
 
   private:
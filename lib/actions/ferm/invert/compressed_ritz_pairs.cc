@@ -0,0 +1,614 @@
+/*! \file
+ *  \brief Ritz pairs with the eigenvectors stored in reduced precision
+ */
+
+#include "actions/ferm/invert/compressed_ritz_pairs.h"
+
+#include <cmath>
+
+namespace Chroma
+{
+  namespace LinAlg
+  {
+
+    //! Anonymous namespace
+    namespace
+    {
+      //! Number of reals in a fermion at one site
+      const int site_reals = 2*Ns*Nc;
+
+      //! Largest 16-bit fixed point value
+      const REAL64 half_max = 32767.0;
+
+#ifndef QDP_IS_QDPJIT
+      //! Base pointer of the site data of a fermion
+      template<typename W, typename T>
+      inline
+      W* basePtr(T& x)
+      {
+	return (W*)&(x.elem(0).elem(0).elem(0).real());
+      }
+
+      template<typename W, typename T>
+      inline
+      const W* basePtr(const T& x)
+      {
+	return (const W*)&(x.elem(0).elem(0).elem(0).real());
+      }
+
+
+      //! Arguments for copying one vector in or out
+      template<typename W>
+      struct CopyArgs
+      {
+	CompressedRitzPairs*  obj;
+	W*                    x;
+	const int*            tab;
+	int                   k;
+      };
+
+      template<typename W>
+      inline
+      void setSiteLoop(int lo, int hi, int myId, CopyArgs<W>* a)
+      {
+	REAL64 v[site_reals];
+
+	for(int i=lo; i < hi; ++i)
+	{
+	  int site = a->tab[i];
+	  const W* xs = a->x + site*site_reals;
+	  for(int j=0; j < site_reals; ++j)
+	    v[j] = xs[j];
+
+	  a->obj->encodeSite(a->k, site, v);
+	}
+      }
+
+      template<typename W>
+      inline
+      void getSiteLoop(int lo, int hi, int myId, CopyArgs<W>* a)
+      {
+	REAL64 v[site_reals];
+
+	for(int i=lo; i < hi; ++i)
+	{
+	  int site = a->tab[i];
+	  a->obj->decodeSite(v, a->k, site);
+
+	  W* xs = a->x + site*site_reals;
+	  for(int j=0; j < site_reals; ++j)
+	    xs[j] = v[j];
+	}
+      }
+
+
+      //! Arguments for the block projection
+      template<typename W>
+      struct ProjectArgs
+      {
+	const CompressedRitzPairs*  obj;
+	const W*                    x;
+	const int*                  tab;
+	int                         N;
+	multi1d< multi1d<REAL64> >& partial;   /*!< one accumulator per thread */
+      };
+
+      template<typename W>
+      inline
+      void projectSiteLoop(int lo, int hi, int myId, ProjectArgs<W>* a)
+      {
+	REAL64 v[site_reals];
+	REAL64* acc = a->partial[myId].slice();
+
+	for(int i=lo; i < hi; ++i)
+	{
+	  int site = a->tab[i];
+	  const W* xs = a->x + site*site_reals;
+
+	  for(int k=0; k < a->N; ++k)
+	  {
+	    a->obj->decodeSite(v, k, site);
+
+	    REAL64 re = 0, im = 0;
+	    for(int j=0; j < site_reals; j += 2)
+	    {
+	      re += v[j]*xs[j]   + v[j+1]*xs[j+1];
+	      im += v[j]*xs[j+1] - v[j+1]*xs[j];
+	    }
+	    acc[2*k]   += re;
+	    acc[2*k+1] += im;
+	  }
+	}
+      }
+
+
+      //! Arguments for the block expansion
+      template<typename W>
+      struct ExpandArgs
+      {
+	const CompressedRitzPairs*  obj;
+	W*                          y;
+	const int*                  tab;
+	int                         N;
+	const REAL64*               c;         /*!< re,im pairs */
+      };
+
+      template<typename W>
+      inline
+      void expandSiteLoop(int lo, int hi, int myId, ExpandArgs<W>* a)
+      {
+	REAL64 v[site_reals];
+	REAL64 y[site_reals];
+
+	for(int i=lo; i < hi; ++i)
+	{
+	  int site = a->tab[i];
+	  W* ys = a->y + site*site_reals;
+
+	  for(int j=0; j < site_reals; ++j)
+	    y[j] = ys[j];
+
+	  for(int k=0; k < a->N; ++k)
+	  {
+	    a->obj->decodeSite(v, k, site);
+
+	    REAL64 c_re = a->c[2*k];
+	    REAL64 c_im = a->c[2*k+1];
+	    for(int j=0; j < site_reals; j += 2)
+	    {
+	      y[j]   += c_re*v[j]   - c_im*v[j+1];
+	      y[j+1] += c_re*v[j+1] + c_im*v[j];
+	    }
+	  }
+
+	  for(int j=0; j < site_reals; ++j)
+	    ys[j] = y[j];
+	}
+      }
+
+
+      //! Arguments for the in-place rotation
+      struct RotateArgs
+      {
+	CompressedRitzPairs*  obj;
+	const int*            tab;
+	int                   N;
+	const REAL64*         U;               /*!< U(k,j) at 2*(k*N+j) */
+      };
+
+      inline
+      void rotateSiteLoop(int lo, int hi, int myId, RotateArgs* a)
+      {
+	const int N = a->N;
+	std::vector<REAL64> v(N*site_reals);
+	REAL64 w[site_reals];
+
+	for(int i=lo; i < hi; ++i)
+	{
+	  int site = a->tab[i];
+
+	  for(int j=0; j < N; ++j)
+	    a->obj->decodeSite(&v[j*site_reals], j, site);
+
+	  for(int k=0; k < N; ++k)
+	  {
+	    for(int n=0; n < site_reals; ++n)
+	      w[n] = 0;
+
+	    for(int j=0; j < N; ++j)
+	    {
+	      REAL64 u_re = a->U[2*(k*N+j)];
+	      REAL64 u_im = a->U[2*(k*N+j)+1];
+	      const REAL64* vj = &v[j*site_reals];
+	      for(int n=0; n < site_reals; n += 2)
+	      {
+		w[n]   += u_re*vj[n]   - u_im*vj[n+1];
+		w[n+1] += u_re*vj[n+1] + u_im*vj[n];
+	      }
+	    }
+
+	    a->obj->encodeSite(k, site, w);
+	  }
+	}
+      }
+
+
+      template<typename T, typename W>
+      void setVector_T(CompressedRitzPairs& obj, int k, const T& v, const Subset& s)
+      {
+	CopyArgs<W> args = {&obj, const_cast<W*>(basePtr<W>(v)), s.siteTable().slice(), k};
+	dispatch_to_threads(s.numSiteTable(), args, setSiteLoop<W>);
+      }
+
+      template<typename T, typename W>
+      void getVector_T(const CompressedRitzPairs& obj, T& v, int k, const Subset& s)
+      {
+	CopyArgs<W> args = {const_cast<CompressedRitzPairs*>(&obj), basePtr<W>(v), s.siteTable().slice(), k};
+	dispatch_to_threads(s.numSiteTable(), args, getSiteLoop<W>);
+      }
+
+      template<typename T, typename W>
+      void project_T(const CompressedRitzPairs& obj,
+		     multi1d<DComplex>& c, const T& x, int N, const Subset& s)
+      {
+	c.resize(N);
+	if (N == 0)
+	  return;
+
+	multi1d< multi1d<REAL64> > partial(qdpNumThreads());
+	for(int i=0; i < partial.size(); ++i)
+	{
+	  partial[i].resize(2*N);
+	  partial[i] = 0;
+	}
+
+	ProjectArgs<W> args = {&obj, basePtr<W>(x), s.siteTable().slice(), N, partial};
+	dispatch_to_threads(s.numSiteTable(), args, projectSiteLoop<W>);
+
+	multi1d<REAL64> tot(2*N);
+	tot = 0;
+	for(int i=0; i < partial.size(); ++i)
+	  for(int j=0; j < 2*N; ++j)
+	    tot[j] += partial[i][j];
+
+	QDPInternal::globalSumArray(tot.slice(), 2*N);
+
+	for(int k=0; k < N; ++k)
+	  c[k] = cmplx(Double(tot[2*k]), Double(tot[2*k+1]));
+      }
+
+      template<typename T, typename W>
+      void expand_T(const CompressedRitzPairs& obj,
+		    T& y, const multi1d<DComplex>& c, int N, const Subset& s)
+      {
+	if (N == 0)
+	  return;
+
+	std::vector<REAL64> cc(2*N);
+	for(int k=0; k < N; ++k)
+	{
+	  cc[2*k]   = toDouble(real(c[k]));
+	  cc[2*k+1] = toDouble(imag(c[k]));
+	}
+
+	ExpandArgs<W> args = {&obj, basePtr<W>(y), s.siteTable().slice(), N, &cc[0]};
+	dispatch_to_threads(s.numSiteTable(), args, expandSiteLoop<W>);
+      }
+#else
+      //! No site access under the JIT
+      inline
+      void noJit()
+      {
+	QDPIO::cerr << "CompressedRitzPairs: not supported with QDP-JIT" << std::endl;
+	QDP_abort(1);
+      }
+
+      template<typename T, typename W>
+      void setVector_T(CompressedRitzPairs& obj, int k, const T& v, const Subset& s) {noJit();}
+
+      template<typename T, typename W>
+      void getVector_T(const CompressedRitzPairs& obj, T& v, int k, const Subset& s) {noJit();}
+
+      template<typename T, typename W>
+      void project_T(const CompressedRitzPairs& obj,
+		     multi1d<DComplex>& c, const T& x, int N, const Subset& s) {noJit();}
+
+      template<typename T, typename W>
+      void expand_T(const CompressedRitzPairs& obj,
+		    T& y, const multi1d<DComplex>& c, int N, const Subset& s) {noJit();}
+#endif
+
+
+      //! Write a RitzPairs file of vectors of type T
+      template<typename T, typename Func>
+      void writeRitzPairs_T(int Nmax, int Neig, const multi1d<Double>& eval,
+			    Func getVec,
+			    const std::string& file, QDP_volfmt_t volfmt)
+      {
+	QDPIO::cout << __func__ << ": writing " << Neig << " eigenvectors to " << file << std::endl;
+
+	XMLBufferWriter file_xml;
+	push(file_xml, "RitzPairs");
+	write(file_xml, "id", uniqueId());
+	write(file_xml, "Nmax", Nmax);
+	write(file_xml, "Neig", Neig);
+	pop(file_xml);
+
+	QDPFileWriter to(file_xml, file, volfmt, QDPIO_SERIAL, QDPIO_OPEN);
+
+	// Same record layout as the RitzPairs QIO writer
+	T v;
+	for(int i=0; i < Neig; ++i)
+	{
+	  XMLBufferWriter record_xml;
+	  push(record_xml, "Eigenstd::vector");
+	  write(record_xml, "eigenNum", i);
+	  write(record_xml, "eigenValue", eval[i]);
+	  pop(record_xml);
+
+	  getVec(v, i);
+	  write(to, record_xml, v);
+	}
+
+	close(to);
+      }
+
+      //! Read a RitzPairs file of vectors of type T
+      template<typename T, typename Func>
+      int readRitzPairs_T(int Nmax, multi1d<Double>& eval,
+			  Func setVec,
+			  const std::string& file)
+      {
+	XMLReader file_xml;
+	QDPFileReader to(file_xml, file, QDPIO_SERIAL);
+
+	int Neig;
+	read(file_xml, "/RitzPairs/Neig", Neig);
+
+	if (Neig > Nmax)
+	{
+	  QDPIO::cerr << __func__ << ": file " << file << " has Neig=" << Neig
+		      << " but there is only room for " << Nmax << " vectors" << std::endl;
+	  QDP_abort(1);
+	}
+
+	QDPIO::cout << __func__ << ": reading " << Neig << " eigenvectors from " << file << std::endl;
+
+	T v;
+	for(int i=0; i < Neig; ++i)
+	{
+	  XMLReader record_xml;
+	  read(to, record_xml, v);
+	  read(record_xml, "/Eigenstd::vector/eigenValue", eval[i]);
+
+	  setVec(i, v);
+	}
+
+	close(to);
+
+	return Neig;
+      }
+
+
+      //! Accessors used by the file readers and writers
+      template<typename T>
+      struct FullGet
+      {
+	const RitzPairs<T>& obj;
+	void operator()(T& v, int i) const {v = obj.evec.vec[i];}
+      };
+
+      template<typename T>
+      struct FullSet
+      {
+	RitzPairs<T>& obj;
+	void operator()(int i, const T& v) const {obj.evec.vec[i] = v;}
+      };
+
+      struct CompressedGet
+      {
+	const CompressedRitzPairs& obj;
+	void operator()(LatticeFermionF& v, int i) const {obj.getVector(v, i, all);}
+      };
+
+      struct CompressedSet
+      {
+	CompressedRitzPairs& obj;
+	void operator()(int i, const LatticeFermionF& v) const {obj.setVector(i, v, all);}
+      };
+
+    } // anonymous namespace
+
+
+    // Room for N vectors
+    void CompressedRitzPairs::init(int N, Storage_t storage_)
+    {
+#ifdef QDP_IS_QDPJIT
+      noJit();
+#endif
+      storage = storage_;
+      eval.resize(N);
+      Neig = 0;
+
+      const size_t nsite = Layout::sitesOnNode();
+
+      sdata.clear();
+      hdata.clear();
+      hnorm.clear();
+
+      switch (storage)
+      {
+      case SINGLE:
+	sdata.resize(N);
+	for(int k=0; k < N; ++k)
+	  sdata[k].assign(nsite*site_reals, 0);
+	break;
+
+      case HALF:
+	hdata.resize(N);
+	hnorm.resize(N);
+	for(int k=0; k < N; ++k)
+	{
+	  hdata[k].assign(nsite*site_reals, 0);
+	  hnorm[k].assign(nsite, 0);
+	}
+	break;
+      }
+
+      QDPIO::cout << __func__ << ": eigenvector storage = "
+		  << bytes()/(1024.0*1024.0) << " MB per node" << std::endl;
+    }
+
+
+    // Bytes used by the stored vectors
+    size_t CompressedRitzPairs::bytes() const
+    {
+      size_t b = 0;
+      for(int k=0; k < sdata.size(); ++k)
+	b += sdata[k].size()*sizeof(REAL32);
+      for(int k=0; k < hdata.size(); ++k)
+	b += hdata[k].size()*sizeof(short) + hnorm[k].size()*sizeof(REAL32);
+      return b;
+    }
+
+
+    // Unpack the reals of vector k at a site
+    void CompressedRitzPairs::decodeSite(REAL64* x, int k, int site) const
+    {
+      if (storage == SINGLE)
+      {
+	const REAL32* p = &sdata[k][site*site_reals];
+	for(int j=0; j < site_reals; ++j)
+	  x[j] = p[j];
+      }
+      else
+      {
+	const short* p = &hdata[k][site*site_reals];
+	REAL64 scale = hnorm[k][site] / half_max;
+	for(int j=0; j < site_reals; ++j)
+	  x[j] = scale * p[j];
+      }
+    }
+
+
+    // Pack the reals of vector k at a site
+    void CompressedRitzPairs::encodeSite(int k, int site, const REAL64* x)
+    {
+      if (storage == SINGLE)
+      {
+	REAL32* p = &sdata[k][site*site_reals];
+	for(int j=0; j < site_reals; ++j)
+	  p[j] = x[j];
+      }
+      else
+      {
+	REAL64 xmax = 0;
+	for(int j=0; j < site_reals; ++j)
+	  xmax = std::max(xmax, std::fabs(x[j]));
+
+	// Round the scale first so the stored values never exceed half_max
+	REAL32 scale = xmax;
+	if (scale < xmax)
+	  scale = std::nextafter(scale, REAL32(2*xmax));
+	hnorm[k][site] = scale;
+
+	short* p = &hdata[k][site*site_reals];
+	REAL64 iscale = (scale > 0) ? half_max / scale : 0;
+	for(int j=0; j < site_reals; ++j)
+	  p[j] = short(std::lrint(x[j]*iscale));
+      }
+    }
+
+
+    void CompressedRitzPairs::setVector(int k, const LatticeFermionF& v, const Subset& s)
+    {
+      setVector_T<LatticeFermionF,REAL32>(*this, k, v, s);
+    }
+
+    void CompressedRitzPairs::setVector(int k, const LatticeFermionD& v, const Subset& s)
+    {
+      setVector_T<LatticeFermionD,REAL64>(*this, k, v, s);
+    }
+
+    void CompressedRitzPairs::getVector(LatticeFermionF& v, int k, const Subset& s) const
+    {
+      getVector_T<LatticeFermionF,REAL32>(*this, v, k, s);
+    }
+
+    void CompressedRitzPairs::getVector(LatticeFermionD& v, int k, const Subset& s) const
+    {
+      getVector_T<LatticeFermionD,REAL64>(*this, v, k, s);
+    }
+
+    void CompressedRitzPairs::project(multi1d<DComplex>& c, const LatticeFermionF& x, int N, const Subset& s) const
+    {
+      project_T<LatticeFermionF,REAL32>(*this, c, x, N, s);
+    }
+
+    void CompressedRitzPairs::project(multi1d<DComplex>& c, const LatticeFermionD& x, int N, const Subset& s) const
+    {
+      project_T<LatticeFermionD,REAL64>(*this, c, x, N, s);
+    }
+
+    void CompressedRitzPairs::expand(LatticeFermionF& y, const multi1d<DComplex>& c, int N, const Subset& s) const
+    {
+      expand_T<LatticeFermionF,REAL32>(*this, y, c, N, s);
+    }
+
+    void CompressedRitzPairs::expand(LatticeFermionD& y, const multi1d<DComplex>& c, int N, const Subset& s) const
+    {
+      expand_T<LatticeFermionD,REAL64>(*this, y, c, N, s);
+    }
+
+    // Rotate the space site by site
+    void CompressedRitzPairs::rotate(const multi2d<DComplex>& U, int N, const Subset& s)
+    {
+      std::vector<REAL64> uu(2*N*N);
+      for(int k=0; k < N; ++k)
+	for(int j=0; j < N; ++j)
+	{
+	  uu[2*(k*N+j)]   = toDouble(real(U(k,j)));
+	  uu[2*(k*N+j)+1] = toDouble(imag(U(k,j)));
+	}
+
+#ifndef QDP_IS_QDPJIT
+      RotateArgs args = {this, s.siteTable().slice(), N, &uu[0]};
+      dispatch_to_threads(s.numSiteTable(), args, rotateSiteLoop);
+#else
+      noJit();
+#endif
+    }
+
+
+    //
+    // File IO
+    //
+    void writeRitzPairs(const RitzPairs<LatticeFermionF>& obj,
+			const std::string& file, QDP_volfmt_t volfmt)
+    {
+      FullGet<LatticeFermionF> get = {obj};
+      writeRitzPairs_T<LatticeFermionF>(obj.evec.vec.size(), obj.Neig, obj.eval.vec, get, file, volfmt);
+    }
+
+    void writeRitzPairs(const RitzPairs<LatticeFermionD>& obj,
+			const std::string& file, QDP_volfmt_t volfmt)
+    {
+      FullGet<LatticeFermionD> get = {obj};
+      writeRitzPairs_T<LatticeFermionD>(obj.evec.vec.size(), obj.Neig, obj.eval.vec, get, file, volfmt);
+    }
+
+    void writeRitzPairs(const CompressedRitzPairs& obj,
+			const std::string& file, QDP_volfmt_t volfmt)
+    {
+      CompressedGet get = {obj};
+      writeRitzPairs_T<LatticeFermionF>(obj.size(), obj.Neig, obj.eval, get, file, volfmt);
+    }
+
+    void readRitzPairs(RitzPairs<LatticeFermionF>& obj, int Nmax,
+		       const std::string& file)
+    {
+      obj.init(Nmax);
+      FullSet<LatticeFermionF> set = {obj};
+      int Neig = readRitzPairs_T<LatticeFermionF>(Nmax, obj.eval.vec, set, file);
+      obj.eval.N = obj.evec.N = obj.Neig = Neig;
+    }
+
+    void readRitzPairs(RitzPairs<LatticeFermionD>& obj, int Nmax,
+		       const std::string& file)
+    {
+      obj.init(Nmax);
+      FullSet<LatticeFermionD> set = {obj};
+      int Neig = readRitzPairs_T<LatticeFermionD>(Nmax, obj.eval.vec, set, file);
+      obj.eval.N = obj.evec.N = obj.Neig = Neig;
+    }
+
+    void readRitzPairs(CompressedRitzPairs& obj,
+		       const std::string& file)
+    {
+      CompressedSet set = {obj};
+      obj.Neig = readRitzPairs_T<LatticeFermionF>(obj.size(), obj.eval, set, file);
+    }
+
+  } // namespace LinAlg
+
+} // namespace Chroma
@@ -0,0 +1,113 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Ritz pairs with the eigenvectors stored in reduced precision
+ */
+
+#ifndef __compressed_ritz_pairs_h__
+#define __compressed_ritz_pairs_h__
+
+#include "chromabase.h"
+#include "actions/ferm/invert/containers.h"
+
+#include <vector>
+
+namespace Chroma
+{
+  namespace LinAlg
+  {
+
+    //! Ritz pairs with the eigenvectors stored in reduced precision
+    /*! \ingroup invert
+     *
+     * The vectors of an eigCG deflation space only need to be as accurate
+     * as the deflation itself, so they are kept either in single precision
+     * or as 16-bit fixed point numbers with one single precision scale per
+     * site. They are expanded to the working precision on the fly.
+     *
+     * Projections onto the space and expansions in it are done for all
+     * vectors in one sweep over the lattice with a single global sum.
+     */
+    class CompressedRitzPairs
+    {
+    public:
+      //! Storage precision of the eigenvectors
+      enum Storage_t {SINGLE, HALF};
+
+      multi1d<Double> eval;
+      int Neig;
+
+      CompressedRitzPairs() : Neig(0), storage(SINGLE) {}
+
+      //! Room for N vectors
+      void init(int N, Storage_t storage_);
+
+      //! Maximum number of vectors
+      int size() const {return eval.size();}
+
+      //! Storage precision
+      Storage_t storageType() const {return storage;}
+
+      //! Bytes used by the stored vectors
+      size_t bytes() const;
+
+      //! Store v on subset s as vector k
+      void setVector(int k, const LatticeFermionF& v, const Subset& s);
+      void setVector(int k, const LatticeFermionD& v, const Subset& s);
+
+      //! Expand vector k into v on subset s
+      void getVector(LatticeFermionF& v, int k, const Subset& s) const;
+      void getVector(LatticeFermionD& v, int k, const Subset& s) const;
+
+      //! c[k] = <v_k, x> for all k < N
+      void project(multi1d<DComplex>& c, const LatticeFermionF& x, int N, const Subset& s) const;
+      void project(multi1d<DComplex>& c, const LatticeFermionD& x, int N, const Subset& s) const;
+
+      //! y += sum_{k<N} c[k] v_k
+      void expand(LatticeFermionF& y, const multi1d<DComplex>& c, int N, const Subset& s) const;
+      void expand(LatticeFermionD& y, const multi1d<DComplex>& c, int N, const Subset& s) const;
+
+      //! v_k <- sum_{j<N} U(k,j) v_j for all k < N
+      /*! Done site by site, so no full precision copy of the space is needed */
+      void rotate(const multi2d<DComplex>& U, int N, const Subset& s);
+
+      //! Unpack the 2*Ns*Nc reals of vector k at a site
+      void decodeSite(REAL64* x, int k, int site) const;
+
+      //! Pack the 2*Ns*Nc reals of vector k at a site
+      void encodeSite(int k, int site, const REAL64* x);
+
+    private:
+      Storage_t storage;
+      std::vector< std::vector<REAL32> > sdata;   /*!< SINGLE: 2*Ns*Nc reals per site */
+      std::vector< std::vector<short> >  hdata;   /*!< HALF: 2*Ns*Nc fixed point per site */
+      std::vector< std::vector<REAL32> > hnorm;   /*!< HALF: one scale per site */
+    };
+
+
+    //! Save Ritz pairs in the layout used by the RitzPairs QIO objects
+    /*! \ingroup invert */
+    void writeRitzPairs(const RitzPairs<LatticeFermionF>& obj,
+			const std::string& file, QDP_volfmt_t volfmt);
+    void writeRitzPairs(const RitzPairs<LatticeFermionD>& obj,
+			const std::string& file, QDP_volfmt_t volfmt);
+
+    //! Compressed vectors are written in single precision
+    void writeRitzPairs(const CompressedRitzPairs& obj,
+			const std::string& file, QDP_volfmt_t volfmt);
+
+    //! Read Ritz pairs into a space of at most Nmax vectors
+    /*! \ingroup invert */
+    void readRitzPairs(RitzPairs<LatticeFermionF>& obj, int Nmax,
+		       const std::string& file);
+    void readRitzPairs(RitzPairs<LatticeFermionD>& obj, int Nmax,
+		       const std::string& file);
+
+    //! The space must already be initialised to its size and storage
+    void readRitzPairs(CompressedRitzPairs& obj,
+		       const std::string& file);
+
+  } // namespace LinAlg
+
+} // namespace Chroma
+
+#endif
@@ -0,0 +1,996 @@
+/*! \file
+ *  \brief Fused BLAS-1 kernels of the Krylov solvers
+ */
+
+#include "actions/ferm/invert/fused_blas.h"
+
+#ifndef QDP_IS_QDPJIT
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CHROMA_FUSED_BLAS_X86
+#include <immintrin.h>
+#endif
+
+#ifdef __GNUC__
+#define FUSED_BLAS_INLINE inline __attribute__((always_inline))
+#else
+#define FUSED_BLAS_INLINE inline
+#endif
+
+namespace Chroma
+{
+
+  namespace FusedBLAS
+  {
+
+    // Anonymous namespace
+    namespace
+    {
+      //! Words done together by the generic kernels
+      const int lanes = 8;
+
+      //! (i v)[i+l] on the interleaved real and imaginary parts of v
+      template<typename W>
+      FUSED_BLAS_INLINE
+      W iv(const W* v, int i, int l)
+      {
+	return (l & 1) ? v[i+l-1] : -v[i+l+1];
+      }
+
+      //! Sum of the lanes of an accumulator
+      FUSED_BLAS_INLINE
+      double sumLanes(const double* acc)
+      {
+	double sum = 0;
+	for(int l=0; l < lanes; ++l)
+	  sum += acc[l];
+	return sum;
+      }
+
+
+      //! y += a x, returns |y|^2
+      template<typename W>
+      FUSED_BLAS_INLINE
+      double axpyNormBody(int n, W ar, W ai, const W* x, W* y)
+      {
+	double acc[lanes] = {0};
+
+	for(int i=0; i < n; i += lanes)
+	  for(int l=0; l < lanes; ++l)
+	  {
+	    y[i+l] += ar*x[i+l] + ai*iv(x,i,l);
+	    acc[l] += double(y[i+l])*y[i+l];
+	  }
+
+	return sumLanes(acc);
+      }
+
+      //! y += a x, adds <z,y> to re and im
+      template<typename W>
+      FUSED_BLAS_INLINE
+      void axpyDotBody(int n, W ar, W ai, const W* x, W* y, const W* z, double& re, double& im)
+      {
+	double acc_re[lanes] = {0};
+	double acc_im[lanes] = {0};
+
+	for(int i=0; i < n; i += lanes)
+	{
+	  for(int l=0; l < lanes; ++l)
+	    y[i+l] += ar*x[i+l] + ai*iv(x,i,l);
+
+	  for(int l=0; l < lanes; ++l)
+	  {
+	    acc_re[l] += double(z[i+l])*y[i+l];
+	    acc_im[l] -= double(z[i+l])*iv(y,i,l);
+	  }
+	}
+
+	re += sumLanes(acc_re);
+	im += sumLanes(acc_im);
+      }
+
+      //! y = x + a y
+      template<typename W>
+      FUSED_BLAS_INLINE
+      void xpayBody(int n, W ar, W ai, const W* x, W* y)
+      {
+	W t[lanes];
+
+	for(int i=0; i < n; i += lanes)
+	{
+	  for(int l=0; l < lanes; ++l)
+	    t[l] = x[i+l] + ar*y[i+l] + ai*iv(y,i,l);
+
+	  for(int l=0; l < lanes; ++l)
+	    y[i+l] = t[l];
+	}
+      }
+
+      //! y = a x + b y, returns |y|^2
+      template<typename W>
+      FUSED_BLAS_INLINE
+      double axpbyNormBody(int n, W ar, W ai, const W* x, W br, W bi, W* y)
+      {
+	double acc[lanes] = {0};
+	W t[lanes];
+
+	for(int i=0; i < n; i += lanes)
+	{
+	  for(int l=0; l < lanes; ++l)
+	    t[l] = ar*x[i+l] + ai*iv(x,i,l) + br*y[i+l] + bi*iv(y,i,l);
+
+	  for(int l=0; l < lanes; ++l)
+	  {
+	    y[i+l] = t[l];
+	    acc[l] += double(t[l])*t[l];
+	  }
+	}
+
+	return sumLanes(acc);
+      }
+
+      //! x += a p, r += b q, returns |r|^2
+      template<typename W>
+      FUSED_BLAS_INLINE
+      double axpyAxpyNormBody(int n, W ar, W ai, const W* p, W* x,
+			      W br, W bi, const W* q, W* r)
+      {
+	double acc[lanes] = {0};
+
+	for(int i=0; i < n; i += lanes)
+	{
+	  // x first, p may be r
+	  for(int l=0; l < lanes; ++l)
+	    x[i+l] += ar*p[i+l] + ai*iv(p,i,l);
+
+	  for(int l=0; l < lanes; ++l)
+	  {
+	    r[i+l] += br*q[i+l] + bi*iv(q,i,l);
+	    acc[l] += double(r[i+l])*r[i+l];
+	  }
+	}
+
+	return sumLanes(acc);
+      }
+
+      //! Adds <a,b> to re and im
+      template<typename W>
+      FUSED_BLAS_INLINE
+      void dotBody(int n, const W* a, const W* b, double& re, double& im)
+      {
+	double acc_re[lanes] = {0};
+	double acc_im[lanes] = {0};
+
+	for(int i=0; i < n; i += lanes)
+	  for(int l=0; l < lanes; ++l)
+	  {
+	    acc_re[l] += double(a[i+l])*b[i+l];
+	    acc_im[l] -= double(a[i+l])*iv(b,i,l);
+	  }
+
+	re += sumLanes(acc_re);
+	im += sumLanes(acc_im);
+      }
+
+
+      //! Update of pipelined CG, adds |r|^2 to rr and Re <w,r> to wr
+      template<typename W>
+      FUSED_BLAS_INLINE
+      void pipeCGBody(int n, W alpha, W beta, const W* nv, W* z, W* s, W* p, W* x, W* r, W* w,
+		      double& rr, double& wr)
+      {
+	double acc_rr[lanes] = {0};
+	double acc_wr[lanes] = {0};
+
+	for(int i=0; i < n; i += lanes)
+	  for(int l=0; l < lanes; ++l)
+	  {
+	    z[i+l] = nv[i+l] + beta*z[i+l];
+	    s[i+l] = w[i+l] + beta*s[i+l];
+	    p[i+l] = r[i+l] + beta*p[i+l];
+	    x[i+l] += alpha*p[i+l];
+	    r[i+l] -= alpha*s[i+l];
+	    w[i+l] -= alpha*z[i+l];
+	    acc_rr[l] += double(r[i+l])*r[i+l];
+	    acc_wr[l] += double(w[i+l])*r[i+l];
+	  }
+
+	rr += sumLanes(acc_rr);
+	wr += sumLanes(acc_wr);
+      }
+
+      //! Multi-shift CG update, p and x are at offset off
+      template<typename W>
+      FUSED_BLAS_INLINE
+      void multiShiftBody(int n, int off, const W* r, W* p0, W a, int ns, int nact,
+			  W* const* p, W* const* x, const W* z, const W* c, const W* b)
+      {
+	for(int i=0; i < n; ++i)
+	  p0[i] = r[i] + a*p0[i];
+
+	for(int k=0; k < ns; ++k)
+	{
+	  W* pk = p[k] + off;
+	  W* xk = x[k] + off;
+
+	  for(int i=0; i < n; ++i)
+	    xk[i] -= b[k]*pk[i];
+
+	  if (k < nact)
+	    for(int i=0; i < n; ++i)
+	      pk[i] = z[k]*r[i] + c[k]*pk[i];
+	}
+      }
+
+
+      //! Generic kernels
+      struct Generic
+      {
+	template<typename W>
+	static double axpyNorm(int n, W ar, W ai, const W* x, W* y)
+	{return axpyNormBody(n, ar, ai, x, y);}
+
+	template<typename W>
+	static void axpyDot(int n, W ar, W ai, const W* x, W* y, const W* z,
+			    double& re, double& im)
+	{axpyDotBody(n, ar, ai, x, y, z, re, im);}
+
+	template<typename W>
+	static void xpay(int n, W ar, W ai, const W* x, W* y)
+	{xpayBody(n, ar, ai, x, y);}
+
+	template<typename W>
+	static double axpbyNorm(int n, W ar, W ai, const W* x, W br, W bi, W* y)
+	{return axpbyNormBody(n, ar, ai, x, br, bi, y);}
+
+	template<typename W>
+	static double axpyAxpyNorm(int n, W ar, W ai, const W* p, W* x,
+				   W br, W bi, const W* q, W* r)
+	{return axpyAxpyNormBody(n, ar, ai, p, x, br, bi, q, r);}
+
+	template<typename W>
+	static void dot(int n, const W* a, const W* b, double& re, double& im)
+	{dotBody(n, a, b, re, im);}
+
+	template<typename W>
+	static void pipeCG(int n, W alpha, W beta, const W* nv, W* z, W* s, W* p, W* x, W* r, W* w,
+			   double& rr, double& wr)
+	{pipeCGBody(n, alpha, beta, nv, z, s, p, x, r, w, rr, wr);}
+
+	template<typename W>
+	static void multiShift(int n, int off, const W* r, W* p0, W a, int ns, int nact,
+			       W* const* p, W* const* x, const W* z, const W* c, const W* b)
+	{multiShiftBody(n, off, r, p0, a, ns, nact, p, x, z, c, b);}
+      };
+
+
+#ifdef CHROMA_FUSED_BLAS_X86
+      //! AVX2 kernels
+      namespace AVX2Kernels
+      {
+#define FUSED_BLAS_TARGET __attribute__((target("avx2,fma")))
+
+	template<typename W> struct Vec;
+
+	template<>
+	struct Vec<double>
+	{
+	  typedef __m256d  R;
+	  typedef __m256d  A;
+	  static const int len = 4;
+
+	  FUSED_BLAS_TARGET static R load(const double* p) {return _mm256_loadu_pd(p);}
+	  FUSED_BLAS_TARGET static void store(double* p, R a) {_mm256_storeu_pd(p, a);}
+	  FUSED_BLAS_TARGET static R set1(double a) {return _mm256_set1_pd(a);}
+	  FUSED_BLAS_TARGET static R add(R a, R b) {return _mm256_add_pd(a, b);}
+	  FUSED_BLAS_TARGET static R mul(R a, R b) {return _mm256_mul_pd(a, b);}
+	  FUSED_BLAS_TARGET static R swap(R a) {return _mm256_permute_pd(a, 0x5);}
+	  FUSED_BLAS_TARGET static R fmaddsub(R a, R b, R c) {return _mm256_fmaddsub_pd(a, b, c);}
+	  FUSED_BLAS_TARGET static A accZero() {return _mm256_setzero_pd();}
+	  FUSED_BLAS_TARGET static A acc(A s, R a) {return _mm256_add_pd(s, a);}
+
+	  FUSED_BLAS_TARGET static double sumAll(A s) 
+	  {
+	    double t[4];
+	    _mm256_storeu_pd(t, s);
+	    return t[0] + t[1] + t[2] + t[3];
+	  }
+
+	  FUSED_BLAS_TARGET static double sumEvenMinusOdd(A s) 
+	  {
+	    double t[4];
+	    _mm256_storeu_pd(t, s);
+	    return t[0] - t[1] + t[2] - t[3];
+	  }
+	};
+
+	template<>
+	struct Vec<float>
+	{
+	  typedef __m256   R;
+	  typedef __m256d  A;
+	  static const int len = 8;
+
+	  FUSED_BLAS_TARGET static R load(const float* p) {return _mm256_loadu_ps(p);}
+	  FUSED_BLAS_TARGET static void store(float* p, R a) {_mm256_storeu_ps(p, a);}
+	  FUSED_BLAS_TARGET static R set1(float a) {return _mm256_set1_ps(a);}
+	  FUSED_BLAS_TARGET static R add(R a, R b) {return _mm256_add_ps(a, b);}
+	  FUSED_BLAS_TARGET static R mul(R a, R b) {return _mm256_mul_ps(a, b);}
+	  FUSED_BLAS_TARGET static R swap(R a) {return _mm256_permute_ps(a, 0xB1);}
+	  FUSED_BLAS_TARGET static R fmaddsub(R a, R b, R c) {return _mm256_fmaddsub_ps(a, b, c);}
+	  FUSED_BLAS_TARGET static A accZero() {return _mm256_setzero_pd();}
+
+	  // Both halves go to the same lanes, keeping the real and imaginary parts apart
+	  FUSED_BLAS_TARGET static A acc(A s, R a) 
+	  {
+	    s = _mm256_add_pd(s, _mm256_cvtps_pd(_mm256_castps256_ps128(a)));
+	    return _mm256_add_pd(s, _mm256_cvtps_pd(_mm256_extractf128_ps(a, 1)));
+	  }
+
+	  FUSED_BLAS_TARGET static double sumAll(A s) {return Vec<double>::sumAll(s);}
+	  FUSED_BLAS_TARGET static double sumEvenMinusOdd(A s) {return Vec<double>::sumEvenMinusOdd(s);}
+	};
+
+#include "actions/ferm/invert/fused_blas_simd.h"
+
+#undef FUSED_BLAS_TARGET
+      }
+
+      //! AVX-512 kernels
+      namespace AVX512Kernels
+      {
+#define FUSED_BLAS_TARGET __attribute__((target("avx512f,avx2,fma")))
+
+	template<typename W> struct Vec;
+
+	template<>
+	struct Vec<double>
+	{
+	  typedef __m512d  R;
+	  typedef __m512d  A;
+	  static const int len = 8;
+
+	  FUSED_BLAS_TARGET static R load(const double* p) {return _mm512_loadu_pd(p);}
+	  FUSED_BLAS_TARGET static void store(double* p, R a) {_mm512_storeu_pd(p, a);}
+	  FUSED_BLAS_TARGET static R set1(double a) {return _mm512_set1_pd(a);}
+	  FUSED_BLAS_TARGET static R add(R a, R b) {return _mm512_add_pd(a, b);}
+	  FUSED_BLAS_TARGET static R mul(R a, R b) {return _mm512_mul_pd(a, b);}
+	  FUSED_BLAS_TARGET static R swap(R a) {return _mm512_permute_pd(a, 0x55);}
+	  FUSED_BLAS_TARGET static R fmaddsub(R a, R b, R c) {return _mm512_fmaddsub_pd(a, b, c);}
+	  FUSED_BLAS_TARGET static A accZero() {return _mm512_setzero_pd();}
+	  FUSED_BLAS_TARGET static A acc(A s, R a) {return _mm512_add_pd(s, a);}
+
+	  FUSED_BLAS_TARGET static double sumAll(A s) 
+	  {
+	    double t[8];
+	    _mm512_storeu_pd(t, s);
+	    return t[0] + t[1] + t[2] + t[3] + t[4] + t[5] + t[6] + t[7];
+	  }
+
+	  FUSED_BLAS_TARGET static double sumEvenMinusOdd(A s) 
+	  {
+	    double t[8];
+	    _mm512_storeu_pd(t, s);
+	    return t[0] - t[1] + t[2] - t[3] + t[4] - t[5] + t[6] - t[7];
+	  }
+	};
+
+	template<>
+	struct Vec<float>
+	{
+	  typedef __m512   R;
+	  typedef __m512d  A;
+	  static const int len = 16;
+
+	  FUSED_BLAS_TARGET static R load(const float* p) {return _mm512_loadu_ps(p);}
+	  FUSED_BLAS_TARGET static void store(float* p, R a) {_mm512_storeu_ps(p, a);}
+	  FUSED_BLAS_TARGET static R set1(float a) {return _mm512_set1_ps(a);}
+	  FUSED_BLAS_TARGET static R add(R a, R b) {return _mm512_add_ps(a, b);}
+	  FUSED_BLAS_TARGET static R mul(R a, R b) {return _mm512_mul_ps(a, b);}
+	  FUSED_BLAS_TARGET static R swap(R a) {return _mm512_permute_ps(a, 0xB1);}
+	  FUSED_BLAS_TARGET static R fmaddsub(R a, R b, R c) {return _mm512_fmaddsub_ps(a, b, c);}
+	  FUSED_BLAS_TARGET static A accZero() {return _mm512_setzero_pd();}
+
+	  // Both halves go to the same lanes, keeping the real and imaginary parts apart
+	  FUSED_BLAS_TARGET static A acc(A s, R a) 
+	  {
+	    __m256 hi = _mm256_castpd_ps(_mm512_extractf64x4_pd(_mm512_castps_pd(a), 1));
+	    s = _mm512_add_pd(s, _mm512_cvtps_pd(_mm512_castps512_ps256(a)));
+	    return _mm512_add_pd(s, _mm512_cvtps_pd(hi));
+	  }
+
+	  FUSED_BLAS_TARGET static double sumAll(A s) {return Vec<double>::sumAll(s);}
+	  FUSED_BLAS_TARGET static double sumEvenMinusOdd(A s) {return Vec<double>::sumEvenMinusOdd(s);}
+	};
+
+#include "actions/ferm/invert/fused_blas_simd.h"
+
+#undef FUSED_BLAS_TARGET
+      }
+
+      typedef AVX2Kernels::Kernels    AVX2;
+      typedef AVX512Kernels::Kernels  AVX512;
+#else
+      typedef Generic  AVX2;
+      typedef Generic  AVX512;
+#endif
+
+
+      //! Instruction sets
+      enum Arch {ARCH_GENERIC, ARCH_AVX2, ARCH_AVX512};
+
+      //! Best instruction set of this machine
+      Arch detectArch()
+      {
+	Arch arch = ARCH_GENERIC;
+
+#ifdef CHROMA_FUSED_BLAS_X86
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx512f"))
+	  arch = ARCH_AVX512;
+	else if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+	  arch = ARCH_AVX2;
+#endif
+
+	const char* names[] = {"generic", "AVX2", "AVX-512"};
+	QDPIO::cout << "FusedBLAS: using the " << names[arch] << " kernels" << std::endl;
+
+	return arch;
+      }
+
+      //! Instruction set of the kernels
+      Arch arch()
+      {
+	static const Arch a = detectArch();
+	return a;
+      }
+
+
+      //! Contiguous pieces of the sites of a subset
+      struct Sites
+      {
+	const int*  tab;     /*!< site table, 0 for an ordered subset */
+	int         start;   /*!< first site of an ordered subset */
+	int         nw;      /*!< words per site */
+
+	//! Number of pieces of the sites lo..hi-1 of the subset
+	int pieces(int lo, int hi) const {return (tab) ? hi-lo : 1;}
+
+	//! Offset and length in words of piece k
+	void piece(int lo, int hi, int k, int& off, int& n) const
+	{
+	  if (tab)
+	  {
+	    off = nw*tab[lo+k];
+	    n   = nw;
+	  }
+	  else
+	  {
+	    off = nw*(start+lo);
+	    n   = nw*(hi-lo);
+	  }
+	}
+      };
+
+      //! Sites of a subset for fields of T
+      template<typename T>
+      Sites makeSites(const Subset& s)
+      {
+	typedef typename WordType<T>::Type_t W;
+
+	Sites sites;
+	sites.nw    = sizeof(typename T::Subtype_t) / sizeof(W);
+	sites.tab   = (s.hasOrderedRep()) ? 0 : s.siteTable().slice();
+	sites.start = (s.hasOrderedRep()) ? s.start() : 0;
+
+	if (sites.nw % lanes != 0)
+	{
+	  QDPIO::cerr << "FusedBLAS: words per site not a multiple of " << lanes << std::endl;
+	  QDP_abort(1);
+	}
+
+	return sites;
+      }
+
+      //! Words of a field
+      template<typename T>
+      typename WordType<T>::Type_t* words(T& x)
+      {
+	return reinterpret_cast<typename WordType<T>::Type_t*>(&(x.elem(0)));
+      }
+
+      template<typename T>
+      const typename WordType<T>::Type_t* words(const T& x)
+      {
+	return reinterpret_cast<const typename WordType<T>::Type_t*>(&(x.elem(0)));
+      }
+
+
+      //! Arguments of the threaded kernels
+      template<typename W>
+      struct Args
+      {
+	Sites      sites;
+	W          ar, ai;
+	W          br, bi;
+	const W*   x;
+	W*         y;
+	const W*   z;
+	const W*   q;
+	W*         r;
+	double*    partial;   /*!< [thread][nsum] */
+	int        nsum;
+      };
+
+      template<typename K, typename W>
+      void axpyNormThread(int lo, int hi, int myId, Args<W>* a)
+      {
+	double sum = 0;
+	for(int k=0; k < a->sites.pieces(lo,hi); ++k)
+	{
+	  int off, n;
+	  a->sites.piece(lo, hi, k, off, n);
+	  sum += K::axpyNorm(n, a->ar, a->ai, a->x+off, a->y+off);
+	}
+	a->partial[myId*a->nsum] = sum;
+      }
+
+      template<typename K, typename W>
+      void axpyDotThread(int lo, int hi, int myId, Args<W>* a)
+      {
+	double re = 0, im = 0;
+	for(int k=0; k < a->sites.pieces(lo,hi); ++k)
+	{
+	  int off, n;
+	  a->sites.piece(lo, hi, k, off, n);
+	  K::axpyDot(n, a->ar, a->ai, a->x+off, a->y+off, a->z+off, re, im);
+	}
+	a->partial[myId*a->nsum]   = re;
+	a->partial[myId*a->nsum+1] = im;
+      }
+
+      template<typename K, typename W>
+      void xpayThread(int lo, int hi, int myId, Args<W>* a)
+      {
+	for(int k=0; k < a->sites.pieces(lo,hi); ++k)
+	{
+	  int off, n;
+	  a->sites.piece(lo, hi, k, off, n);
+	  K::xpay(n, a->ar, a->ai, a->x+off, a->y+off);
+	}
+      }
+
+      template<typename K, typename W>
+      void axpbyNormThread(int lo, int hi, int myId, Args<W>* a)
+      {
+	double sum = 0;
+	for(int k=0; k < a->sites.pieces(lo,hi); ++k)
+	{
+	  int off, n;
+	  a->sites.piece(lo, hi, k, off, n);
+	  sum += K::axpbyNorm(n, a->ar, a->ai, a->x+off, a->br, a->bi, a->y+off);
+	}
+	a->partial[myId*a->nsum] = sum;
+      }
+
+      //! x is p and y is x of axpyAxpyNorm
+      template<typename K, typename W>
+      void axpyAxpyNormThread(int lo, int hi, int myId, Args<W>* a)
+      {
+	double sum = 0;
+	for(int k=0; k < a->sites.pieces(lo,hi); ++k)
+	{
+	  int off, n;
+	  a->sites.piece(lo, hi, k, off, n);
+	  sum += K::axpyAxpyNorm(n, a->ar, a->ai, a->x+off, a->y+off,
+				 a->br, a->bi, a->q+off, a->r+off);
+	}
+	a->partial[myId*a->nsum] = sum;
+      }
+
+      //! Arguments of the block inner products
+      template<typename W>
+      struct DotArgs
+      {
+	Sites                         sites;
+	const std::vector<const W*>&  a;
+	const std::vector<const W*>&  b;
+	double*                       partial;   /*!< [thread][2*a.size()] */
+      };
+
+      template<typename K, typename W>
+      void blockDotThread(int lo, int hi, int myId, DotArgs<W>* a)
+      {
+	const int nv = a->a.size();
+	double* sum  = a->partial + myId*2*nv;
+
+	for(int j=0; j < 2*nv; ++j)
+	  sum[j] = 0;
+
+	for(int k=0; k < a->sites.pieces(lo,hi); ++k)
+	{
+	  int off, n;
+	  a->sites.piece(lo, hi, k, off, n);
+
+	  for(int j=0; j < nv; ++j)
+	    K::dot(n, a->a[j]+off, a->b[j]+off, sum[2*j], sum[2*j+1]);
+	}
+      }
+
+
+      //! Arguments of the pipelined CG update
+      template<typename W>
+      struct PipeCGArgs
+      {
+	Sites      sites;
+	W          alpha, beta;
+	const W*   n;
+	W          *z, *s, *p, *x, *r, *w;
+	double*    partial;   /*!< [thread][2] */
+      };
+
+      template<typename K, typename W>
+      void pipeCGThread(int lo, int hi, int myId, PipeCGArgs<W>* a)
+      {
+	double rr = 0, wr = 0;
+	for(int k=0; k < a->sites.pieces(lo,hi); ++k)
+	{
+	  int off, n;
+	  a->sites.piece(lo, hi, k, off, n);
+	  K::pipeCG(n, a->alpha, a->beta, a->n+off, a->z+off, a->s+off, a->p+off,
+		    a->x+off, a->r+off, a->w+off, rr, wr);
+	}
+	a->partial[2*myId]   = rr;
+	a->partial[2*myId+1] = wr;
+      }
+
+      //! Arguments of the multi-shift CG update
+      template<typename W>
+      struct MultiShiftArgs
+      {
+	Sites      sites;
+	const W*   r;
+	W*         p0;
+	W          a;
+	int        ns;
+	int        nact;
+	W* const*  p;
+	W* const*  x;
+	const W*   z;
+	const W*   c;
+	const W*   b;
+      };
+
+      template<typename K, typename W>
+      void multiShiftThread(int lo, int hi, int myId, MultiShiftArgs<W>* a)
+      {
+	for(int k=0; k < a->sites.pieces(lo,hi); ++k)
+	{
+	  int off, n;
+	  a->sites.piece(lo, hi, k, off, n);
+	  K::multiShift(n, off, a->r+off, a->p0+off, a->a, a->ns, a->nact,
+			a->p, a->x, a->z, a->c, a->b);
+	}
+      }
+
+
+      //! Run the threaded kernel of the instruction set
+      template<typename A>
+      void run(int nsites, A& args,
+	       void (*generic)(int,int,int,A*),
+	       void (*avx2)(int,int,int,A*),
+	       void (*avx512)(int,int,int,A*))
+      {
+	switch (arch())
+	{
+	case ARCH_AVX512:
+	  dispatch_to_threads(nsites, args, avx512);
+	  break;
+
+	case ARCH_AVX2:
+	  dispatch_to_threads(nsites, args, avx2);
+	  break;
+
+	default:
+	  dispatch_to_threads(nsites, args, generic);
+	}
+      }
+
+      //! Sum the partial sums of the threads and nodes into the first nsum
+      void reduce(std::vector<double>& partial, int nsum)
+      {
+	for(int t=1; t < qdpNumThreads(); ++t)
+	  for(int j=0; j < nsum; ++j)
+	    partial[j] += partial[t*nsum + j];
+
+	QDPInternal::globalSumArray(&partial[0], nsum);
+      }
+
+
+      template<typename T>
+      Double axpyNorm_a(T& y, const DComplex& a, const T& x, const Subset& s)
+      {
+	typedef typename WordType<T>::Type_t W;
+
+	std::vector<double> partial(qdpNumThreads(), 0.0);
+	Args<W> args = {makeSites<T>(s), W(toDouble(real(a))), W(toDouble(imag(a))), 0, 0,
+			words(x), words(y), 0, 0, 0, &partial[0], 1};
+
+	run(s.numSiteTable(), args,
+	    axpyNormThread<Generic,W>, axpyNormThread<AVX2,W>, axpyNormThread<AVX512,W>);
+	reduce(partial, 1);
+
+	return Double(partial[0]);
+      }
+
+      template<typename T>
+      DComplex axpyDot_a(T& y, const DComplex& a, const T& x, const T& z, const Subset& s)
+      {
+	typedef typename WordType<T>::Type_t W;
+
+	std::vector<double> partial(2*qdpNumThreads(), 0.0);
+	Args<W> args = {makeSites<T>(s), W(toDouble(real(a))), W(toDouble(imag(a))), 0, 0,
+			words(x), words(y), words(z), 0, 0, &partial[0], 2};
+
+	run(s.numSiteTable(), args,
+	    axpyDotThread<Generic,W>, axpyDotThread<AVX2,W>, axpyDotThread<AVX512,W>);
+	reduce(partial, 2);
+
+	return cmplx(Double(partial[0]), Double(partial[1]));
+      }
+
+      template<typename T>
+      void xpay_a(T& y, const T& x, const DComplex& a, const Subset& s)
+      {
+	typedef typename WordType<T>::Type_t W;
+
+	Args<W> args = {makeSites<T>(s), W(toDouble(real(a))), W(toDouble(imag(a))), 0, 0,
+			words(x), words(y), 0, 0, 0, 0, 0};
+
+	run(s.numSiteTable(), args,
+	    xpayThread<Generic,W>, xpayThread<AVX2,W>, xpayThread<AVX512,W>);
+      }
+
+      template<typename T>
+      Double axpbyNorm_a(T& y, const DComplex& a, const T& x, const DComplex& b, const Subset& s)
+      {
+	typedef typename WordType<T>::Type_t W;
+
+	std::vector<double> partial(qdpNumThreads(), 0.0);
+	Args<W> args = {makeSites<T>(s), W(toDouble(real(a))), W(toDouble(imag(a))),
+			W(toDouble(real(b))), W(toDouble(imag(b))),
+			words(x), words(y), 0, 0, 0, &partial[0], 1};
+
+	run(s.numSiteTable(), args,
+	    axpbyNormThread<Generic,W>, axpbyNormThread<AVX2,W>, axpbyNormThread<AVX512,W>);
+	reduce(partial, 1);
+
+	return Double(partial[0]);
+      }
+
+      template<typename T>
+      Double axpyAxpyNorm_a(T& x, const DComplex& a, const T& p,
+			    T& r, const DComplex& b, const T& q, const Subset& s)
+      {
+	typedef typename WordType<T>::Type_t W;
+
+	std::vector<double> partial(qdpNumThreads(), 0.0);
+	Args<W> args = {makeSites<T>(s), W(toDouble(real(a))), W(toDouble(imag(a))),
+			W(toDouble(real(b))), W(toDouble(imag(b))),
+			words(p), words(x), 0, words(q), words(r), &partial[0], 1};
+
+	run(s.numSiteTable(), args,
+	    axpyAxpyNormThread<Generic,W>, axpyAxpyNormThread<AVX2,W>, axpyAxpyNormThread<AVX512,W>);
+	reduce(partial, 1);
+
+	return Double(partial[0]);
+      }
+
+      template<typename T>
+      void blockDot_a(std::vector<DComplex>& out,
+		      const std::vector<const T*>& a, const std::vector<const T*>& b,
+		      const Subset& s)
+      {
+	typedef typename WordType<T>::Type_t W;
+
+	const int nv = a.size();
+	out.resize(nv);
+	if (nv == 0)
+	  return;
+
+	std::vector<const W*> a_w(nv), b_w(nv);
+	for(int j=0; j < nv; ++j)
+	{
+	  a_w[j] = words(*a[j]);
+	  b_w[j] = words(*b[j]);
+	}
+
+	std::vector<double> partial(2*nv*qdpNumThreads(), 0.0);
+	DotArgs<W> args = {makeSites<T>(s), a_w, b_w, &partial[0]};
+
+	run(s.numSiteTable(), args,
+	    blockDotThread<Generic,W>, blockDotThread<AVX2,W>, blockDotThread<AVX512,W>);
+	reduce(partial, 2*nv);
+
+	for(int j=0; j < nv; ++j)
+	  out[j] = cmplx(Double(partial[2*j]), Double(partial[2*j+1]));
+      }
+
+
+      template<typename T>
+      void pipeCGUpdate_a(Double& rr, Double& wr, const Double& alpha, const Double& beta,
+			  const T& n, T& z, T& s, T& p, T& x, T& r, T& w, const Subset& sub)
+      {
+	typedef typename WordType<T>::Type_t W;
+
+	std::vector<double> partial(2*qdpNumThreads(), 0.0);
+	PipeCGArgs<W> args = {makeSites<T>(sub), W(toDouble(alpha)), W(toDouble(beta)),
+			      words(n), words(z), words(s), words(p), words(x), words(r), words(w),
+			      &partial[0]};
+
+	run(sub.numSiteTable(), args,
+	    pipeCGThread<Generic,W>, pipeCGThread<AVX2,W>, pipeCGThread<AVX512,W>);
+	reduce(partial, 2);
+
+	rr = partial[0];
+	wr = partial[1];
+      }
+
+      template<typename T>
+      void multiShiftUpdate_a(const T& r, T& p_0, const Double& a,
+			      const std::vector<T*>& p, const std::vector<T*>& x, int nact,
+			      const std::vector<double>& z, const std::vector<double>& c,
+			      const std::vector<double>& b, const Subset& sub)
+      {
+	typedef typename WordType<T>::Type_t W;
+
+	const int ns = p.size();
+	std::vector<W*> p_w(ns), x_w(ns);
+	std::vector<W>  z_w(ns), c_w(ns), b_w(ns);
+	for(int k=0; k < ns; ++k)
+	{
+	  p_w[k] = words(*p[k]);
+	  x_w[k] = words(*x[k]);
+	  z_w[k] = W(z[k]);
+	  c_w[k] = W(c[k]);
+	  b_w[k] = W(b[k]);
+	}
+
+	MultiShiftArgs<W> args = {makeSites<T>(sub), words(r), words(p_0), W(toDouble(a)),
+				  ns, nact, (ns > 0) ? &p_w[0] : 0, (ns > 0) ? &x_w[0] : 0,
+				  (ns > 0) ? &z_w[0] : 0, (ns > 0) ? &c_w[0] : 0, (ns > 0) ? &b_w[0] : 0};
+
+	run(sub.numSiteTable(), args,
+	    multiShiftThread<Generic,W>, multiShiftThread<AVX2,W>, multiShiftThread<AVX512,W>);
+      }
+
+    }
+
+
+    template<>
+    Double axpyNorm(LatticeFermionF& y, const DComplex& a, const LatticeFermionF& x, const Subset& s)
+    {
+      return axpyNorm_a(y, a, x, s);
+    }
+
+    template<>
+    Double axpyNorm(LatticeFermionD& y, const DComplex& a, const LatticeFermionD& x, const Subset& s)
+    {
+      return axpyNorm_a(y, a, x, s);
+    }
+
+    template<>
+    DComplex axpyDot(LatticeFermionF& y, const DComplex& a, const LatticeFermionF& x,
+		     const LatticeFermionF& z, const Subset& s)
+    {
+      return axpyDot_a(y, a, x, z, s);
+    }
+
+    template<>
+    DComplex axpyDot(LatticeFermionD& y, const DComplex& a, const LatticeFermionD& x,
+		     const LatticeFermionD& z, const Subset& s)
+    {
+      return axpyDot_a(y, a, x, z, s);
+    }
+
+    template<>
+    void xpay(LatticeFermionF& y, const LatticeFermionF& x, const DComplex& a, const Subset& s)
+    {
+      xpay_a(y, x, a, s);
+    }
+
+    template<>
+    void xpay(LatticeFermionD& y, const LatticeFermionD& x, const DComplex& a, const Subset& s)
+    {
+      xpay_a(y, x, a, s);
+    }
+
+    template<>
+    Double axpbyNorm(LatticeFermionF& y, const DComplex& a, const LatticeFermionF& x,
+		     const DComplex& b, const Subset& s)
+    {
+      return axpbyNorm_a(y, a, x, b, s);
+    }
+
+    template<>
+    Double axpbyNorm(LatticeFermionD& y, const DComplex& a, const LatticeFermionD& x,
+		     const DComplex& b, const Subset& s)
+    {
+      return axpbyNorm_a(y, a, x, b, s);
+    }
+
+    template<>
+    Double axpyAxpyNorm(LatticeFermionF& x, const DComplex& a, const LatticeFermionF& p,
+			LatticeFermionF& r, const DComplex& b, const LatticeFermionF& q,
+			const Subset& s)
+    {
+      return axpyAxpyNorm_a(x, a, p, r, b, q, s);
+    }
+
+    template<>
+    Double axpyAxpyNorm(LatticeFermionD& x, const DComplex& a, const LatticeFermionD& p,
+			LatticeFermionD& r, const DComplex& b, const LatticeFermionD& q,
+			const Subset& s)
+    {
+      return axpyAxpyNorm_a(x, a, p, r, b, q, s);
+    }
+
+    template<>
+    void blockDot(std::vector<DComplex>& out,
+		  const std::vector<const LatticeFermionF*>& a,
+		  const std::vector<const LatticeFermionF*>& b,
+		  const Subset& s)
+    {
+      blockDot_a(out, a, b, s);
+    }
+
+    template<>
+    void blockDot(std::vector<DComplex>& out,
+		  const std::vector<const LatticeFermionD*>& a,
+		  const std::vector<const LatticeFermionD*>& b,
+		  const Subset& s)
+    {
+      blockDot_a(out, a, b, s);
+    }
+
+    template<>
+    void pipeCGUpdate(Double& rr, Double& wr, const Double& alpha, const Double& beta,
+		      const LatticeFermionF& n, LatticeFermionF& z, LatticeFermionF& s,
+		      LatticeFermionF& p, LatticeFermionF& x, LatticeFermionF& r,
+		      LatticeFermionF& w, const Subset& sub)
+    {
+      pipeCGUpdate_a(rr, wr, alpha, beta, n, z, s, p, x, r, w, sub);
+    }
+
+    template<>
+    void pipeCGUpdate(Double& rr, Double& wr, const Double& alpha, const Double& beta,
+		      const LatticeFermionD& n, LatticeFermionD& z, LatticeFermionD& s,
+		      LatticeFermionD& p, LatticeFermionD& x, LatticeFermionD& r,
+		      LatticeFermionD& w, const Subset& sub)
+    {
+      pipeCGUpdate_a(rr, wr, alpha, beta, n, z, s, p, x, r, w, sub);
+    }
+
+    template<>
+    void multiShiftUpdate(const LatticeFermionF& r, LatticeFermionF& p_0, const Double& a,
+			  const std::vector<LatticeFermionF*>& p, const std::vector<LatticeFermionF*>& x,
+			  int nact, const std::vector<double>& z, const std::vector<double>& c,
+			  const std::vector<double>& b, const Subset& sub)
+    {
+      multiShiftUpdate_a(r, p_0, a, p, x, nact, z, c, b, sub);
+    }
+
+    template<>
+    void multiShiftUpdate(const LatticeFermionD& r, LatticeFermionD& p_0, const Double& a,
+			  const std::vector<LatticeFermionD*>& p, const std::vector<LatticeFermionD*>& x,
+			  int nact, const std::vector<double>& z, const std::vector<double>& c,
+			  const std::vector<double>& b, const Subset& sub)
+    {
+      multiShiftUpdate_a(r, p_0, a, p, x, nact, z, c, b, sub);
+    }
+
+  }
+
+} // End namespace
+
+#endif
@@ -0,0 +1,240 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Fused BLAS-1 kernels of the Krylov solvers
+ */
+
+#ifndef __fused_blas_h__
+#define __fused_blas_h__
+
+#include "chromabase.h"
+
+#include <vector>
+
+namespace Chroma
+{
+
+  //! Fused BLAS-1 kernels of the Krylov solvers
+  /*! \ingroup invert
+   *
+   * Each kernel does its updates and reductions in a single threaded pass
+   * over the vectors and takes at most one global sum. For LatticeFermionF and
+   * LatticeFermionD the pass is done by kernels chosen at run time for
+   * AVX-512, AVX2 or generic code, all other types use QDP expressions.
+   */
+  namespace FusedBLAS
+  {
+    //! Scalars with the precision of T
+    template<typename T>
+    struct Scalar
+    {
+      typedef OScalar< PScalar< PScalar< RComplex<typename WordType<T>::Type_t> > > >  Complex_t;
+      typedef OScalar< PScalar< PScalar< RScalar<typename WordType<T>::Type_t> > > >   Real_t;
+    };
+
+
+    //! y += a x, returns |y|^2
+    template<typename T>
+    inline
+    Double axpyNorm(T& y, const DComplex& a, const T& x, const Subset& s)
+    {
+      typename Scalar<T>::Complex_t a_c = a;
+      y[s] += a_c*x;
+      return norm2(y, s);
+    }
+
+    //! y += a x, returns <z,y>
+    template<typename T>
+    inline
+    DComplex axpyDot(T& y, const DComplex& a, const T& x, const T& z, const Subset& s)
+    {
+      typename Scalar<T>::Complex_t a_c = a;
+      y[s] += a_c*x;
+      return innerProduct(z, y, s);
+    }
+
+    //! y = x + a y
+    template<typename T>
+    inline
+    void xpay(T& y, const T& x, const DComplex& a, const Subset& s)
+    {
+      typename Scalar<T>::Complex_t a_c = a;
+      y[s] = x + a_c*y;
+    }
+
+    //! y = a x + b y, returns |y|^2
+    template<typename T>
+    inline
+    Double axpbyNorm(T& y, const DComplex& a, const T& x, const DComplex& b, const Subset& s)
+    {
+      typename Scalar<T>::Complex_t a_c = a;
+      typename Scalar<T>::Complex_t b_c = b;
+      y[s] = a_c*x + b_c*y;
+      return norm2(y, s);
+    }
+
+    //! x += a p, r += b q, returns |r|^2
+    /*! p may be r, x is then updated with the old r */
+    template<typename T>
+    inline
+    Double axpyAxpyNorm(T& x, const DComplex& a, const T& p,
+			T& r, const DComplex& b, const T& q, const Subset& s)
+    {
+      typename Scalar<T>::Complex_t a_c = a;
+      typename Scalar<T>::Complex_t b_c = b;
+      x[s] += a_c*p;
+      r[s] += b_c*q;
+      return norm2(r, s);
+    }
+
+    //! out[k] = <a[k],b[k]> for all k
+    template<typename T>
+    inline
+    void blockDot(std::vector<DComplex>& out,
+		  const std::vector<const T*>& a, const std::vector<const T*>& b,
+		  const Subset& s)
+    {
+      out.resize(a.size());
+      for(int k=0; k < a.size(); ++k)
+	out[k] = innerProduct(*a[k], *b[k], s);
+    }
+
+    //! Update of pipelined CG, returns |r|^2 and Re <w,r> of the new vectors
+    /*!
+     * z = n + beta z, s = w + beta s, p = r + beta p, x += alpha p,
+     * r -= alpha s, w -= alpha z
+     */
+    template<typename T>
+    inline
+    void pipeCGUpdate(Double& rr, Double& wr, const Double& alpha, const Double& beta,
+		      const T& n, T& z, T& s, T& p, T& x, T& r, T& w, const Subset& sub)
+    {
+      typedef typename WordType<T>::Type_t W;
+      typename Scalar<T>::Real_t a_r = W(toDouble(alpha));
+      typename Scalar<T>::Real_t b_r = W(toDouble(beta));
+
+      z[sub] = n + b_r*z;
+      s[sub] = w + b_r*s;
+      p[sub] = r + b_r*p;
+      x[sub] += a_r*p;
+      r[sub] -= a_r*s;
+      w[sub] -= a_r*z;
+
+      rr = norm2(r, sub);
+      wr = real(innerProduct(w, r, sub));
+    }
+
+    //! Search directions and solutions of multi-shift CG
+    /*!
+     * p_0 = r + a p_0 and for every shift k x[k] -= b[k] p[k], followed by
+     * p[k] = z[k] r + c[k] p[k] for the first nact shifts, reading r once
+     */
+    template<typename T>
+    inline
+    void multiShiftUpdate(const T& r, T& p_0, const Double& a,
+			  const std::vector<T*>& p, const std::vector<T*>& x, int nact,
+			  const std::vector<double>& z, const std::vector<double>& c,
+			  const std::vector<double>& b, const Subset& sub)
+    {
+      typedef typename WordType<T>::Type_t W;
+      typedef typename Scalar<T>::Real_t R;
+
+      for(int k=0; k < p.size(); ++k)
+      {
+	R b_r = W(b[k]);
+	(*x[k])[sub] -= b_r*(*p[k]);
+
+	if (k < nact)
+	{
+	  R z_r = W(z[k]);
+	  R c_r = W(c[k]);
+	  (*p[k])[sub] = z_r*r + c_r*(*p[k]);
+	}
+      }
+
+      R a_r = W(toDouble(a));
+      p_0[sub] = r + a_r*p_0;
+    }
+
+
+#ifndef QDP_IS_QDPJIT
+    // Kernels for the fermions
+    template<>
+    Double axpyNorm(LatticeFermionF& y, const DComplex& a, const LatticeFermionF& x, const Subset& s);
+
+    template<>
+    Double axpyNorm(LatticeFermionD& y, const DComplex& a, const LatticeFermionD& x, const Subset& s);
+
+    template<>
+    DComplex axpyDot(LatticeFermionF& y, const DComplex& a, const LatticeFermionF& x,
+		     const LatticeFermionF& z, const Subset& s);
+
+    template<>
+    DComplex axpyDot(LatticeFermionD& y, const DComplex& a, const LatticeFermionD& x,
+		     const LatticeFermionD& z, const Subset& s);
+
+    template<>
+    void xpay(LatticeFermionF& y, const LatticeFermionF& x, const DComplex& a, const Subset& s);
+
+    template<>
+    void xpay(LatticeFermionD& y, const LatticeFermionD& x, const DComplex& a, const Subset& s);
+
+    template<>
+    Double axpbyNorm(LatticeFermionF& y, const DComplex& a, const LatticeFermionF& x,
+		     const DComplex& b, const Subset& s);
+
+    template<>
+    Double axpbyNorm(LatticeFermionD& y, const DComplex& a, const LatticeFermionD& x,
+		     const DComplex& b, const Subset& s);
+
+    template<>
+    Double axpyAxpyNorm(LatticeFermionF& x, const DComplex& a, const LatticeFermionF& p,
+			LatticeFermionF& r, const DComplex& b, const LatticeFermionF& q,
+			const Subset& s);
+
+    template<>
+    Double axpyAxpyNorm(LatticeFermionD& x, const DComplex& a, const LatticeFermionD& p,
+			LatticeFermionD& r, const DComplex& b, const LatticeFermionD& q,
+			const Subset& s);
+
+    template<>
+    void blockDot(std::vector<DComplex>& out,
+		  const std::vector<const LatticeFermionF*>& a,
+		  const std::vector<const LatticeFermionF*>& b,
+		  const Subset& s);
+
+    template<>
+    void blockDot(std::vector<DComplex>& out,
+		  const std::vector<const LatticeFermionD*>& a,
+		  const std::vector<const LatticeFermionD*>& b,
+		  const Subset& s);
+
+    template<>
+    void pipeCGUpdate(Double& rr, Double& wr, const Double& alpha, const Double& beta,
+		      const LatticeFermionF& n, LatticeFermionF& z, LatticeFermionF& s,
+		      LatticeFermionF& p, LatticeFermionF& x, LatticeFermionF& r,
+		      LatticeFermionF& w, const Subset& sub);
+
+    template<>
+    void pipeCGUpdate(Double& rr, Double& wr, const Double& alpha, const Double& beta,
+		      const LatticeFermionD& n, LatticeFermionD& z, LatticeFermionD& s,
+		      LatticeFermionD& p, LatticeFermionD& x, LatticeFermionD& r,
+		      LatticeFermionD& w, const Subset& sub);
+
+    template<>
+    void multiShiftUpdate(const LatticeFermionF& r, LatticeFermionF& p_0, const Double& a,
+			  const std::vector<LatticeFermionF*>& p, const std::vector<LatticeFermionF*>& x,
+			  int nact, const std::vector<double>& z, const std::vector<double>& c,
+			  const std::vector<double>& b, const Subset& sub);
+
+    template<>
+    void multiShiftUpdate(const LatticeFermionD& r, LatticeFermionD& p_0, const Double& a,
+			  const std::vector<LatticeFermionD*>& p, const std::vector<LatticeFermionD*>& x,
+			  int nact, const std::vector<double>& z, const std::vector<double>& c,
+			  const std::vector<double>& b, const Subset& sub);
+#endif
+
+  }
+
+} // End namespace
+
+#endif
@@ -0,0 +1,230 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Vector kernels of the fused BLAS-1 library
+ *
+ * Included by fused_blas.cc once for every instruction set, inside a
+ * namespace defining FUSED_BLAS_TARGET and the vector types Vec<float> and
+ * Vec<double>, so there is no include guard. The words are the interleaved
+ * real and imaginary parts of the fields, and the words beyond the last
+ * full vector are done by the generic code.
+ */
+
+//! Kernels for one instruction set
+struct Kernels
+{
+  //! y += a x, returns |y|^2
+  template<typename W>
+  FUSED_BLAS_TARGET
+  static double axpyNorm(int n, W ar, W ai, const W* x, W* y)
+  {
+    typedef Vec<W> V;
+    const typename V::R var = V::set1(ar);
+    const typename V::R vai = V::set1(ai);
+    typename V::A acc = V::accZero();
+
+    int i = 0;
+    for(; i + V::len <= n; i += V::len)
+    {
+      typename V::R vx = V::load(x+i);
+      typename V::R vy = V::add(V::load(y+i), V::fmaddsub(var, vx, V::mul(vai, V::swap(vx))));
+      V::store(y+i, vy);
+      acc = V::acc(acc, V::mul(vy, vy));
+    }
+
+    return V::sumAll(acc) + axpyNormBody(n-i, ar, ai, x+i, y+i);
+  }
+
+  //! y += a x, adds <z,y> to re and im
+  template<typename W>
+  FUSED_BLAS_TARGET
+  static void axpyDot(int n, W ar, W ai, const W* x, W* y, const W* z, double& re, double& im)
+  {
+    typedef Vec<W> V;
+    const typename V::R var = V::set1(ar);
+    const typename V::R vai = V::set1(ai);
+    typename V::A acc_re = V::accZero();
+    typename V::A acc_im = V::accZero();
+
+    int i = 0;
+    for(; i + V::len <= n; i += V::len)
+    {
+      typename V::R vx = V::load(x+i);
+      typename V::R vz = V::load(z+i);
+      typename V::R vy = V::add(V::load(y+i), V::fmaddsub(var, vx, V::mul(vai, V::swap(vx))));
+      V::store(y+i, vy);
+      acc_re = V::acc(acc_re, V::mul(vz, vy));
+      acc_im = V::acc(acc_im, V::mul(vz, V::swap(vy)));
+    }
+
+    re += V::sumAll(acc_re);
+    im += V::sumEvenMinusOdd(acc_im);
+    axpyDotBody(n-i, ar, ai, x+i, y+i, z+i, re, im);
+  }
+
+  //! y = x + a y
+  template<typename W>
+  FUSED_BLAS_TARGET
+  static void xpay(int n, W ar, W ai, const W* x, W* y)
+  {
+    typedef Vec<W> V;
+    const typename V::R var = V::set1(ar);
+    const typename V::R vai = V::set1(ai);
+
+    int i = 0;
+    for(; i + V::len <= n; i += V::len)
+    {
+      typename V::R vy = V::load(y+i);
+      V::store(y+i, V::add(V::load(x+i), V::fmaddsub(var, vy, V::mul(vai, V::swap(vy)))));
+    }
+
+    xpayBody(n-i, ar, ai, x+i, y+i);
+  }
+
+  //! y = a x + b y, returns |y|^2
+  template<typename W>
+  FUSED_BLAS_TARGET
+  static double axpbyNorm(int n, W ar, W ai, const W* x, W br, W bi, W* y)
+  {
+    typedef Vec<W> V;
+    const typename V::R var = V::set1(ar);
+    const typename V::R vai = V::set1(ai);
+    const typename V::R vbr = V::set1(br);
+    const typename V::R vbi = V::set1(bi);
+    typename V::A acc = V::accZero();
+
+    int i = 0;
+    for(; i + V::len <= n; i += V::len)
+    {
+      typename V::R vx = V::load(x+i);
+      typename V::R vy = V::load(y+i);
+      vy = V::add(V::fmaddsub(var, vx, V::mul(vai, V::swap(vx))),
+		  V::fmaddsub(vbr, vy, V::mul(vbi, V::swap(vy))));
+      V::store(y+i, vy);
+      acc = V::acc(acc, V::mul(vy, vy));
+    }
+
+    return V::sumAll(acc) + axpbyNormBody(n-i, ar, ai, x+i, br, bi, y+i);
+  }
+
+  //! x += a p, r += b q, returns |r|^2
+  template<typename W>
+  FUSED_BLAS_TARGET
+  static double axpyAxpyNorm(int n, W ar, W ai, const W* p, W* x,
+			     W br, W bi, const W* q, W* r)
+  {
+    typedef Vec<W> V;
+    const typename V::R var = V::set1(ar);
+    const typename V::R vai = V::set1(ai);
+    const typename V::R vbr = V::set1(br);
+    const typename V::R vbi = V::set1(bi);
+    typename V::A acc = V::accZero();
+
+    int i = 0;
+    for(; i + V::len <= n; i += V::len)
+    {
+      // p is loaded before r is stored, p may be r
+      typename V::R vp = V::load(p+i);
+      typename V::R vq = V::load(q+i);
+      V::store(x+i, V::add(V::load(x+i), V::fmaddsub(var, vp, V::mul(vai, V::swap(vp)))));
+
+      typename V::R vr = V::add(V::load(r+i), V::fmaddsub(vbr, vq, V::mul(vbi, V::swap(vq))));
+      V::store(r+i, vr);
+      acc = V::acc(acc, V::mul(vr, vr));
+    }
+
+    return V::sumAll(acc) + axpyAxpyNormBody(n-i, ar, ai, p+i, x+i, br, bi, q+i, r+i);
+  }
+
+  //! Adds <a,b> to re and im
+  template<typename W>
+  FUSED_BLAS_TARGET
+  static void dot(int n, const W* a, const W* b, double& re, double& im)
+  {
+    typedef Vec<W> V;
+    typename V::A acc_re = V::accZero();
+    typename V::A acc_im = V::accZero();
+
+    int i = 0;
+    for(; i + V::len <= n; i += V::len)
+    {
+      typename V::R va = V::load(a+i);
+      typename V::R vb = V::load(b+i);
+      acc_re = V::acc(acc_re, V::mul(va, vb));
+      acc_im = V::acc(acc_im, V::mul(va, V::swap(vb)));
+    }
+
+    re += V::sumAll(acc_re);
+    im += V::sumEvenMinusOdd(acc_im);
+    dotBody(n-i, a+i, b+i, re, im);
+  }
+
+  //! Update of pipelined CG, adds |r|^2 to rr and Re <w,r> to wr
+  template<typename W>
+  FUSED_BLAS_TARGET
+  static void pipeCG(int n, W alpha, W beta, const W* nv, W* z, W* s, W* p, W* x, W* r, W* w,
+		     double& rr, double& wr)
+  {
+    typedef Vec<W> V;
+    const typename V::R va  = V::set1(alpha);
+    const typename V::R vma = V::set1(-alpha);
+    const typename V::R vb  = V::set1(beta);
+    typename V::A acc_rr = V::accZero();
+    typename V::A acc_wr = V::accZero();
+
+    int i = 0;
+    for(; i + V::len <= n; i += V::len)
+    {
+      typename V::R vr = V::load(r+i);
+      typename V::R vw = V::load(w+i);
+      typename V::R vz = V::add(V::load(nv+i), V::mul(vb, V::load(z+i)));
+      typename V::R vs = V::add(vw, V::mul(vb, V::load(s+i)));
+      typename V::R vp = V::add(vr, V::mul(vb, V::load(p+i)));
+      V::store(z+i, vz);
+      V::store(s+i, vs);
+      V::store(p+i, vp);
+      V::store(x+i, V::add(V::load(x+i), V::mul(va, vp)));
+
+      vr = V::add(vr, V::mul(vma, vs));
+      vw = V::add(vw, V::mul(vma, vz));
+      V::store(r+i, vr);
+      V::store(w+i, vw);
+      acc_rr = V::acc(acc_rr, V::mul(vr, vr));
+      acc_wr = V::acc(acc_wr, V::mul(vw, vr));
+    }
+
+    rr += V::sumAll(acc_rr);
+    wr += V::sumAll(acc_wr);
+    pipeCGBody(n-i, alpha, beta, nv+i, z+i, s+i, p+i, x+i, r+i, w+i, rr, wr);
+  }
+
+  //! Multi-shift CG update, p and x are at offset off
+  template<typename W>
+  FUSED_BLAS_TARGET
+  static void multiShift(int n, int off, const W* r, W* p0, W a, int ns, int nact,
+			 W* const* p, W* const* x, const W* z, const W* c, const W* b)
+  {
+    typedef Vec<W> V;
+    const typename V::R va = V::set1(a);
+
+    int i = 0;
+    for(; i + V::len <= n; i += V::len)
+    {
+      typename V::R vr = V::load(r+i);
+      V::store(p0+i, V::add(vr, V::mul(va, V::load(p0+i))));
+
+      for(int k=0; k < ns; ++k)
+      {
+	W* pk = p[k] + off + i;
+	W* xk = x[k] + off + i;
+
+	typename V::R vp = V::load(pk);
+	V::store(xk, V::add(V::load(xk), V::mul(V::set1(-b[k]), vp)));
+
+	if (k < nact)
+	  V::store(pk, V::add(V::mul(V::set1(z[k]), vr), V::mul(V::set1(c[k]), vp)));
+      }
+    }
+
+    multiShiftBody(n-i, off+i, r+i, p0+i, a, ns, nact, p, x, z, c, b);
+  }
+};
@@ -104,4 +104,87 @@ namespace Chroma {
 
 
 
+
+  //! Iterative refinement of a 5D system
+  /*! As above with the residual and the correction on all the slices */
+  void InvMultiPrecRichardson( const SystemSolverArray< LatticeFermionF >& Dinv,
+			       const LinearOperatorArray< LatticeFermionD >& D,
+			       const multi1d<LatticeFermionD>& b, 
+			       multi1d<LatticeFermionD>& x,
+			       int MaxIter,
+			       Real RsdTarget,
+			       SystemSolverResults_t& res)
+  {
+    START_CODE();
+
+    const int N = D.size();
+    const Subset& s = D.subset();
+
+    multi1d<LatticeFermionD> r(N), tmp(N);
+
+    // Target Residue
+    Double rsd_t = Double(RsdTarget)*Double(RsdTarget)*norm2(b,s);
+
+    // Compute Initial residue: r = b-Ax
+    D(tmp, x, PLUS);
+    for(int n=0; n < N; ++n)
+      r[n][s] = b[n] - tmp[n];
+
+    Double rnorm = norm2(r, s);
+    QDPIO::cout << "Initial Norm: " << rnorm << std::endl;
+
+    if( toBool( rnorm <= rsd_t ) ) { 
+      res.n_count = 0;
+      res.resid = Real(sqrt(rnorm));
+
+      END_CODE();
+      return;
+    }
+
+    multi1d<LatticeFermionF> r_single(N), dx_single(N);
+    multi1d<LatticeFermionD> delta_x(N);
+
+    for(int i=1; i <= MaxIter ; i++) { 
+
+      // Compute Delta_x = D^{-1} r in single
+      for(int n=0; n < N; ++n) {
+	r_single[n][s] = r[n];
+	dx_single[n][s] = zero;
+      }
+
+      Dinv(dx_single, r_single);
+
+      for(int n=0; n < N; ++n)
+	delta_x[n][s] = dx_single[n];
+
+      D(tmp, delta_x, PLUS);
+
+      for(int n=0; n < N; ++n) {
+	x[n][s] += delta_x[n];
+	r[n][s] -= tmp[n];
+      }
+
+      rnorm = norm2(r, s); 
+
+      // Convergence check on the true residual
+      if( toBool( rnorm <= rsd_t ) ) { 
+	D(tmp, x, PLUS);
+	for(int n=0; n < N; ++n)
+	  r[n][s] = b[n] - tmp[n];
+
+	res.n_count = i;
+	res.resid = Real(sqrt(norm2(r,s)/norm2(b,s)));
+
+	END_CODE();
+	return;
+      }
+    }
+
+    QDPIO::cout << "Richardson Multi Prec Solver: NONCONVERGENCE" << std::endl;
+    res.n_count = MaxIter;
+    res.resid = Real(sqrt(rnorm));
+
+    END_CODE();
+  }
+
 }
@@ -16,6 +16,15 @@ namespace Chroma {
 			       Real RsdTarget,
 			       SystemSolverResults_t& res);
 
+  //! Iterative refinement of a 5D system
+  void InvMultiPrecRichardson( const SystemSolverArray< LatticeFermionF >& Dinv,
+			       const LinearOperatorArray< LatticeFermionD >& D,
+			       const multi1d<LatticeFermionD>& b, 
+			       multi1d<LatticeFermionD>& x,
+			       int MaxIter,
+			       Real RsdTarget,
+			       SystemSolverResults_t& res);
+
 
 }
 
@@ -1,6 +1,7 @@
 #include "chromabase.h"
 #include "actions/ferm/invert/inv_rel_cg1.h"
 #include "actions/ferm/invert/inv_rel_gmresr_cg.h"
+#include "actions/ferm/invert/fused_blas.h"
 
 namespace Chroma {
 
@@ -60,15 +61,26 @@ void InvRelGMRESR_CG_a(const LinearOperator<T>& PrecMM,
 
 
     // Now there is some orthogonalisation to do
-    for(int i =0; i < C_size; i++) { 
-      Complex beta = innerProduct( *(C[i]), *(c), s );
-      (*c)[s] -= beta*(*(C[i]));
-      (*u)[s] -= beta*(*(U[i]));
+    // Each projection is fused with the next inner product,
+    // the last one with the norm of c
+    Double norm_c;
+    if( C_size == 0 ) { 
+      norm_c = sqrt(norm2( *c, s));
+    }
+    else {
+      Complex beta = innerProduct( *(C[0]), *(c), s );
+      for(int i =0; i < C_size; i++) { 
+	(*u)[s] -= beta*(*(U[i]));
+	if( i+1 < C_size ) {
+	  beta = FusedBLAS::axpyDot( *c, Complex(-beta), *(C[i]), *(C[i+1]), s);
+	}
+	else {
+	  norm_c = sqrt(FusedBLAS::axpyNorm( *c, Complex(-beta), *(C[i]), s));
+	}
+      }
     }
 
     // Normalise c
-    Double norm_c = sqrt(norm2( *c, s));
-
     (*c)[s] /= norm_c;
     (*u)[s] /= norm_c;
 
@@ -79,11 +91,8 @@ void InvRelGMRESR_CG_a(const LinearOperator<T>& PrecMM,
 
     Complex alpha = innerProduct( *c, r, s);
     
-    x[s] += alpha*(*u);
-    r[s] -= alpha*(*c);
-
     iter++;
-    norm_r = sqrt(norm2(r,s));
+    norm_r = sqrt(FusedBLAS::axpyAxpyNorm(x, alpha, *u, r, Complex(-alpha), *c, s));
     QDPIO::cout << "Inv Rel GMRESR: iter "<< iter <<" || r || = " << norm_r << std::endl;
   }
 
@@ -4,6 +4,7 @@
 
 #include "chromabase.h"
 #include "actions/ferm/invert/invbicgstab.h"
+#include "actions/ferm/invert/fused_blas.h"
 
 namespace Chroma {
 
@@ -59,7 +60,6 @@ InvBiCGStab_a(const LinearOperator<T>& A,
   p[s] = zero;
   v[s] = zero;
 
-  T tmp;
   T t;
 
   ComplexD rho, rho_prev, alpha, omega;
@@ -89,12 +89,10 @@ InvBiCGStab_a(const LinearOperator<T>& A,
     // p = r + beta(p - omega v)
 
     // first work out p - omega v 
-    // into tmp
-    // then do p = r + beta tmp
+    // then do p = r + beta p in one pass
     CR omega_r = omega;
-    CR beta_r = beta;
-    tmp[s] = p - omega_r*v;
-    p[s] = r + beta_r*tmp;
+    p[s] -= omega_r*v;
+    FusedBLAS::xpay(p, r, beta, s);
 
 
     // v = Ap
@@ -126,8 +124,12 @@ InvBiCGStab_a(const LinearOperator<T>& A,
     A(t,r,isign);
     // omega = < t | s > / < t | t > = < t | r > / norm2(t);
 
-    // This does the full 5D norm
-    Double t_norm = norm2(t,s);
+    // < t | t > and < t | r > in one pass
+    std::vector<const T*> t_l(2, &t), tr_l(2, &t);
+    tr_l[1] = &r;
+    std::vector<DComplex> tt_tr;
+    FusedBLAS::blockDot(tt_tr, t_l, tr_l, s);
+    Double t_norm = real(tt_tr[0]);
 
 
     if( toBool(t_norm == 0) ) { 
@@ -135,29 +137,19 @@ InvBiCGStab_a(const LinearOperator<T>& A,
       QDP_abort(1);
     }
 
-    // accumulate <t | s > = <t | r> into omega
-    omega = innerProduct(t,r,s);
+    // <t | s > = <t | r> into omega
+    omega = tt_tr[1];
     omega /= t_norm;
 
     // psi = psi + omega s + alpha p 
     //     = psi + omega r + alpha p
     //
-    // use tmp to compute psi + omega r
-    // then add in the alpha p
-    omega_r = omega;
-    alpha_r = alpha;
-    tmp[s] = psi + omega_r*r;   
-    psi[s] = tmp + alpha_r*p;
-
-
-
-    // r = s - omega t = r - omega t1G
+    // psi += omega r and r = s - omega t = r - omega t with |r|^2
+    // in one pass, then add in the alpha p
+    Double r_norm = FusedBLAS::axpyAxpyNorm(psi, omega, r, r, DComplex(-omega), t, s);
 
-    
-    r[s] -= omega_r*t;
-
-
-    Double r_norm = norm2(r,s);
+    alpha_r = alpha;
+    psi[s] += alpha_r*p;
 
 
     //    QDPIO::cout << "Iteration " << k << " : r = " << r_norm << std::endl;
@@ -4,6 +4,7 @@
 
 #include "chromabase.h"
 #include "actions/ferm/invert/invcg1.h"
+#include "actions/ferm/invert/fused_blas.h"
 
 using namespace QDP::Hints;
 
@@ -157,21 +158,15 @@ InvCG1_a(const LinearOperator<T>& A,
 
 
     //  Psi[k] += a[k] p[k]
-    psi[s] += a * p;	/* 2 Nc Ns  flops */
-
     //  r[k] -= a[k] A . p[k] ;
     //      	      
     //  r  =  r  - a A p  
-
-    r[s] -= a * ap;
-
-
+    //  cp  =  | r[k] |**2
+    //  in one pass
+    cp = FusedBLAS::axpyAxpyNorm(psi, DComplex(a), p, r, DComplex(-a), ap, s);	/* 6 Nc Ns  flops */
 
     //  IF |r[k]| <= RsdCG |Chi| THEN RETURN;
 
-    //  cp  =  | r[k] |**2
-    cp = norm2(r, s);	                /* 2 Nc Ns  flops */
-
 #if 0
     QDPIO::cout << "InvCG1: k = " << k << "  cp = " << cp << std::endl;
 #endif
@@ -199,7 +194,7 @@ InvCG1_a(const LinearOperator<T>& A,
     b = Real(cp) / Real(c);
 
     //  p[k+1] := r[k] + b[k+1] p[k]
-    p[s] = r + b*p;	/* Nc Ns  flops */
+    FusedBLAS::xpay(p, r, Double(b), s);	/* Nc Ns  flops */
   }
   res.n_count = MaxCG;
   res.resid   = sqrt(cp);
@@ -4,6 +4,7 @@
 
 #include "chromabase.h"
 #include "actions/ferm/invert/invcg2.h"
+#include "actions/ferm/invert/fused_blas.h"
 
 using namespace QDP::Hints;
 #undef PAT
@@ -173,16 +174,11 @@ namespace Chroma
  
       a = c/d;
 
-      RT ar = a;
-
-      r[s] -= ar * mmp;
-      flopcount.addSiteFlops(4*Nc*Ns, s);
-
-      //  cp  =  | r[k] |**2
-      cp = norm2(r, s);    flopcount.addSiteFlops(4*Nc*Ns,s);
-
       //  Psi[k] += a[k] p[k]
-      psi[s] += ar * p;    flopcount.addSiteFlops(4*Nc*Ns,s);
+      //  r[k] -= a[k] A . p[k]
+      //  cp  =  | r[k] |**2
+      cp = FusedBLAS::axpyAxpyNorm(psi, a, p, r, Double(-a), mmp, s);
+      flopcount.addSiteFlops(12*Nc*Ns,s);
 
 
 
@@ -214,10 +210,9 @@ namespace Chroma
 
       //  b[k+1] := |r[k]|**2 / |r[k-1]|**2
       b = cp / c;
-      RT br = b;
 
       //  p[k+1] := r[k] + b[k+1] p[k]
-      p[s] = r + br*p;    flopcount.addSiteFlops(4*Nc*Ns,s);
+      FusedBLAS::xpay(p, r, b, s);    flopcount.addSiteFlops(4*Nc*Ns,s);
     }
     res.n_count = MaxCG;
     res.resid   = sqrt(cp);
@@ -4,6 +4,7 @@
 
 #include "chromabase.h"
 #include "actions/ferm/invert/invmr.h"
+#include "actions/ferm/invert/fused_blas.h"
 
 using namespace QDP::Hints;
 
@@ -134,11 +135,17 @@ namespace Chroma
       /*  Mr = M * r  */
       M(Mr, r, isign);  flopcount.addFlops(M.nFlops());
 
-      /*  c = < M.r, r > */
-      c = innerProduct(Mr, r, s);  flopcount.addSiteFlops(4*Nc*Ns,s);
-    
-      /*  d = | M.r | ** 2  */
-      d = norm2(Mr, s);  flopcount.addSiteFlops(4*Nc*Ns,s);
+      /*  c = < M.r, r >,  d = | M.r | ** 2 */
+      {
+	std::vector<const T*> va(2, &Mr), vb(2, &Mr);
+	vb[0] = &r;
+
+	std::vector<DComplex> dots;
+	FusedBLAS::blockDot(dots, va, vb, s);
+	c = dots[0];
+	d = real(dots[1]);
+	flopcount.addSiteFlops(8*Nc*Ns,s);
+      }
 
       /*  a = c / d */
       a = c / d;
@@ -147,13 +154,10 @@ namespace Chroma
       a = a * MRovpar;
 
       /*  Psi[k] += a[k-1] r[k-1] ; */
-      psi[s] += r * a;    flopcount.addSiteFlops(4*Nc*Ns,s);
-
       /*  r[k] -= a[k-1] M . r[k-1] ; */
-      r[s] -= Mr * a;    flopcount.addSiteFlops(4*Nc*Ns,s);
-
       /*  cp  =  | r[k] |**2 */
-      cp = norm2(r, s);    flopcount.addSiteFlops(4*Nc*Ns,s);
+      cp = FusedBLAS::axpyAxpyNorm(psi, a, r, r, Complex(-a), Mr, s);
+      flopcount.addSiteFlops(12*Nc*Ns,s);
 
 //    QDPIO::cout << "InvMR: k = " << k << "  cp = " << cp << std::endl;
     }
@@ -0,0 +1,280 @@
+/*! \file
+ *  \brief Pipelined BiCGStab algorithm for a generic Linear Operator
+ */
+
+#include "chromabase.h"
+#include "actions/ferm/invert/invpipebicgstab.h"
+#include "actions/ferm/invert/fused_blas.h"
+
+namespace Chroma 
+{
+
+  // Anonymous namespace
+  namespace
+  {
+    //! Restart the recursions from the true residual
+    /*!
+     * r := chi - A psi, w := A r, t := A w and p, s, z, v := 0.
+     * Returns <r0,r>, <r0,w> and |r|^2.
+     */
+    template<typename T>
+    void restart(DComplex& rho, DComplex& r0w, Double& r_norm,
+		 const LinearOperator<T>& A, const T& chi, const T& psi, const T& r0,
+		 T& r, T& w, T& t, T& p, T& s, T& z, T& v,
+		 enum PlusMinus isign)
+    {
+      const Subset& sub = A.subset();
+
+      A(t, psi, isign);
+      r[sub] = chi - t;
+      A(w, r, isign);
+      A(t, w, isign);
+
+      p[sub] = zero;
+      s[sub] = zero;
+      z[sub] = zero;
+      v[sub] = zero;
+
+      std::vector<const T*> a(3, &r0), b(3, &r);
+      b[1] = &w;
+      a[2] = &r;
+
+      std::vector<DComplex> dots;
+      FusedBLAS::blockDot(dots, a, b, sub);
+      rho    = dots[0];
+      r0w    = dots[1];
+      r_norm = real(dots[2]);
+    }
+  }
+
+
+  //! Pipelined BiCGStab
+  /*!
+   * Algorithm:
+   *
+   *  r := chi - A psi;  r0 := r;  w := A r;  t := A w
+   *  alpha := <r0,r> / <r0,w>;  beta := 0
+   *  FOR k FROM 1 TO MaxBiCGStab DO
+   *      p := r + beta (p - omega s)
+   *      s := w + beta (s - omega z)
+   *      z := t + beta (z - omega v)
+   *      q := r - alpha s;  y := w - alpha z
+   *      <y,q>, <y,y>                                     one global sum
+   *      v := A z
+   *      omega := <y,q> / <y,y>
+   *      psi += alpha p + omega q
+   *      r := q - omega y;  w := y - omega (t - alpha v);  t := A w
+   *      <r0,r>, <r0,w>, <r0,s>, <r0,z>, |r|^2            one global sum
+   *      beta  := (alpha / omega) <r0,r> / <r0,r>_prev
+   *      alpha := <r0,r> / (<r0,w> + beta <r0,s> - beta omega <r0,z>)
+   */
+  template<typename T, typename CR>
+  SystemSolverResults_t
+  InvPipeBiCGStab_a(const LinearOperator<T>& A,
+		    const T& chi,
+		    T& psi,
+		    const Real& RsdBiCGStab,
+		    int MaxBiCGStab, 
+		    int ReplaceInterval,
+		    enum PlusMinus isign)
+  {
+    START_CODE();
+
+    const Subset& sub = A.subset();
+    SystemSolverResults_t ret;
+
+    FlopCounter flopcount;
+    flopcount.reset();
+    StopWatch swatch;
+    swatch.reset();
+    swatch.start();
+
+    Double chi_sq = norm2(chi, sub);
+    flopcount.addSiteFlops(4*Nc*Ns,sub);
+
+    Double rsd_sq = Double(RsdBiCGStab)*Double(RsdBiCGStab)*chi_sq;
+
+    T r, r0, w, t, p, s, z, v, q, y;
+
+    DComplex rho, r0w;
+    Double   r_norm;
+
+    // The shadow residual is the first residual
+    A(t, psi, isign);
+    r0[sub] = chi - t;
+    flopcount.addFlops(A.nFlops());
+
+    restart(rho, r0w, r_norm, A, chi, psi, r0, r, w, t, p, s, z, v, isign);
+    flopcount.addFlops(3*A.nFlops());
+
+    if ( toBool( real(r0w) == 0 ) && toBool( imag(r0w) == 0 ) ) {
+      QDPIO::cerr << "InvPipeBiCGStab breakdown: <r_0|A r> = 0" << std::endl;
+      QDP_abort(1);
+    }
+
+    ComplexD alpha = rho / r0w;
+    ComplexD beta  = Double(0);
+    ComplexD omega = Double(1);
+
+    int k = 0;
+    int since_restart = 0;
+
+    while (k < MaxBiCGStab)
+    {
+      bool do_restart = (ReplaceInterval > 0 && since_restart >= ReplaceInterval);
+
+      // Converged, check the true residual
+      if ( toBool(r_norm <= rsd_sq) )
+      {
+	A(y, psi, isign);
+	q[sub] = chi - y;
+	Double t_sq = norm2(q, sub);
+	flopcount.addFlops(A.nFlops());
+
+	if ( toBool(t_sq <= rsd_sq) )
+	  break;
+
+	QDPIO::cout << "InvPipeBiCGStab: k = " << k << " true residual = " << sqrt(t_sq/chi_sq) 
+		    << ", restarting" << std::endl;
+	do_restart = true;
+      }
+
+      if (do_restart)
+      {
+	restart(rho, r0w, r_norm, A, chi, psi, r0, r, w, t, p, s, z, v, isign);
+	flopcount.addFlops(3*A.nFlops());
+
+	if ( toBool( real(r0w) == 0 ) && toBool( imag(r0w) == 0 ) ) {
+	  QDPIO::cerr << "InvPipeBiCGStab breakdown: <r_0|A r> = 0" << std::endl;
+	  QDP_abort(1);
+	}
+
+	alpha = rho / r0w;
+	beta  = Double(0);
+	since_restart = 0;
+      }
+
+      CR alpha_r = alpha;
+      CR beta_r  = beta;
+      CR bo_r    = beta*omega;
+
+      p[sub] = r + beta_r*p - bo_r*s;
+      s[sub] = w + beta_r*s - bo_r*z;
+      z[sub] = t + beta_r*z - bo_r*v;
+      q[sub] = r - alpha_r*s;
+      y[sub] = w - alpha_r*z;
+
+      std::vector<const T*> a1(2, &y), b1(2, &y);
+      b1[0] = &q;
+
+      std::vector<DComplex> dots1;
+      FusedBLAS::blockDot(dots1, a1, b1, sub);
+
+      A(v, z, isign);
+
+      Double y_norm = real(dots1[1]);
+      if ( toBool(y_norm == 0) ) {
+	QDPIO::cerr << "InvPipeBiCGStab breakdown: || A q || = 0" << std::endl;
+	QDP_abort(1);
+      }
+
+      omega = dots1[0] / y_norm;
+      CR omega_r = omega;
+
+      psi[sub] += alpha_r*p + omega_r*q;
+      r[sub] = q - omega_r*y;
+      w[sub] = y - omega_r*(t - alpha_r*v);
+
+      A(t, w, isign);
+
+      std::vector<const T*> a2(5, &r0), b2(5, &r);
+      b2[1] = &w;
+      b2[2] = &s;
+      b2[3] = &z;
+      a2[4] = &r;
+
+      std::vector<DComplex> dots2;
+      FusedBLAS::blockDot(dots2, a2, b2, sub);
+      r_norm = real(dots2[4]);
+
+      if ( toBool( real(rho) == 0 ) && toBool( imag(rho) == 0 ) ) {
+	QDPIO::cerr << "InvPipeBiCGStab breakdown: rho = 0" << std::endl;
+	QDP_abort(1);
+      }
+
+      beta = (alpha / omega) * (dots2[0] / rho);
+      rho  = dots2[0];
+
+      DComplex denom = dots2[1] + beta*dots2[2] - beta*omega*dots2[3];
+      if ( toBool( real(denom) == 0 ) && toBool( imag(denom) == 0 ) ) {
+	QDPIO::cerr << "InvPipeBiCGStab breakdown: <r_0|A p> = 0" << std::endl;
+	QDP_abort(1);
+      }
+
+      alpha = rho / denom;
+
+      //-------Pipelined BiCGStab Flopcounting -----------------------------
+      // flopcount.addSiteFlops(48*Nc*Ns,sub);   // p, s, z
+      // flopcount.addSiteFlops(16*Nc*Ns,sub);   // q, y
+      // flopcount.addSiteFlops(12*Nc*Ns,sub);   // <y,q>, <y,y>
+      // flopcount.addSiteFlops(16*Nc*Ns,sub);   // psi
+      // flopcount.addSiteFlops(24*Nc*Ns,sub);   // r, w
+      // flopcount.addSiteFlops(36*Nc*Ns,sub);   // <r0,r>, <r0,w>, <r0,s>, <r0,z>, |r|^2
+      // flopcount.addFlops(2*A.nFlops());
+      //----------------------------------------------------------------------
+      flopcount.addSiteFlops(152*Nc*Ns,sub);
+      flopcount.addFlops(2*A.nFlops());
+
+      ++k;
+      ++since_restart;
+    }
+
+    // True residual
+    A(y, psi, isign);
+    q[sub] = chi - y;
+    ret.resid = sqrt(norm2(q, sub));
+    ret.n_count = k;
+
+    swatch.stop();
+
+    QDPIO::cout << "InvPipeBiCGStab: k = " << ret.n_count << " resid = " << ret.resid << std::endl;
+    flopcount.report("invpipebicgstab", swatch.getTimeInSeconds());
+
+    if ( ret.n_count == MaxBiCGStab ) { 
+      QDPIO::cerr << "Nonconvergence of pipelined BiCGStab. MaxIters reached " << std::endl;
+    }
+
+    END_CODE();
+    return ret;
+  }
+
+
+  // Single precision
+  SystemSolverResults_t
+  InvPipeBiCGStab(const LinearOperator<LatticeFermionF>& A,
+		  const LatticeFermionF& chi,
+		  LatticeFermionF& psi,
+		  const Real& RsdBiCGStab,
+		  int MaxBiCGStab,
+		  int ReplaceInterval,
+		  enum PlusMinus isign)
+  {
+    return InvPipeBiCGStab_a<LatticeFermionF, ComplexF>(A, chi, psi, RsdBiCGStab, MaxBiCGStab, 
+							ReplaceInterval, isign);
+  }
+
+  // Double precision
+  SystemSolverResults_t
+  InvPipeBiCGStab(const LinearOperator<LatticeFermionD>& A,
+		  const LatticeFermionD& chi,
+		  LatticeFermionD& psi,
+		  const Real& RsdBiCGStab,
+		  int MaxBiCGStab,
+		  int ReplaceInterval,
+		  enum PlusMinus isign)
+  {
+    return InvPipeBiCGStab_a<LatticeFermionD, ComplexD>(A, chi, psi, RsdBiCGStab, MaxBiCGStab, 
+							ReplaceInterval, isign);
+  }
+
+}  // end namespace Chroma
@@ -0,0 +1,63 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Pipelined BiCGStab algorithm for a generic Linear Operator
+ */
+
+#ifndef __invpipebicgstab__
+#define __invpipebicgstab__
+
+#include "linearop.h"
+#include "syssolver.h"
+
+namespace Chroma 
+{
+
+  //! Pipelined Bi-CG stabilized
+  /*! \ingroup invert
+   *
+   * Solves A psi = chi like InvBiCGStab with the recurrences of Cools and
+   * Vanroose, Parallel Computing 65 (2017) 1. The four inner products of
+   * an iteration are gathered into two groups, each taken with a single
+   * global sum.
+   *
+   * The recursions are restarted from the true residual every
+   * ReplaceInterval iterations, and whenever the recursive residual has
+   * converged but the true one has not. The solver stops only when the
+   * true residual has converged.
+   *
+   * \param A               Linear Operator             (Read)
+   * \param chi             Source                      (Read)
+   * \param psi             Solution                    (Modify)
+   * \param RsdBiCGStab     Residual accuracy           (Read)
+   * \param MaxBiCGStab     Maximum iterations          (Read)
+   * \param ReplaceInterval Iterations between restarts, 0 for none (Read)
+   * \param isign           Apply A or A^dag            (Read)
+   *
+   * @{
+   */
+
+  // Single precision
+  SystemSolverResults_t
+  InvPipeBiCGStab(const LinearOperator<LatticeFermionF>& A,
+		  const LatticeFermionF& chi,
+		  LatticeFermionF& psi,
+		  const Real& RsdBiCGStab,
+		  int MaxBiCGStab,
+		  int ReplaceInterval,
+		  enum PlusMinus isign);
+
+  // Double precision
+  SystemSolverResults_t
+  InvPipeBiCGStab(const LinearOperator<LatticeFermionD>& A,
+		  const LatticeFermionD& chi,
+		  LatticeFermionD& psi,
+		  const Real& RsdBiCGStab,
+		  int MaxBiCGStab,
+		  int ReplaceInterval,
+		  enum PlusMinus isign);
+
+  /*! @} */  // end of group invert
+
+}  // end namespace Chroma
+
+#endif
@@ -0,0 +1,195 @@
+/*! \file
+ *  \brief Pipelined Conjugate-Gradient algorithm for a generic Linear Operator
+ */
+
+#include "chromabase.h"
+#include "actions/ferm/invert/invpipecg.h"
+#include "actions/ferm/invert/fused_blas.h"
+
+namespace Chroma 
+{
+
+  // Anonymous namespace
+  namespace
+  {
+    //! out = M^dag M in
+    template<typename T>
+    inline
+    void mdagm(const LinearOperator<T>& M, T& out, const T& in, T& tmp)
+    {
+      M(tmp, in, PLUS);
+      M(out, tmp, MINUS);
+    }
+
+    //! Recompute the recursive vectors from psi and p, returns |r|^2 and Re <w,r>
+    template<typename T>
+    void replaceVecs(Double& g, Double& d, 
+		     const LinearOperator<T>& M, const T& chi, const T& psi, const T& p,
+		     T& r, T& w, T& s, T& z, T& tmp)
+    {
+      const Subset& sub = M.subset();
+
+      mdagm(M, r, psi, tmp);
+      r[sub] = chi - r;
+      mdagm(M, w, r, tmp);
+      mdagm(M, s, p, tmp);
+      mdagm(M, z, s, tmp);
+
+      std::vector<const T*> a(2, &r), b(2, &r);
+      a[1] = &w;
+
+      std::vector<DComplex> dots;
+      FusedBLAS::blockDot(dots, a, b, sub);
+      g = real(dots[0]);
+      d = real(dots[1]);
+    }
+  }
+
+
+  //! Pipelined CGNE
+  /*!
+   * Algorithm, with A = M^dag M:
+   *
+   *  r := chi - A psi;  w := A r;  g := |r|^2;  d := <w,r>
+   *  FOR k FROM 0 TO MaxCG DO
+   *      n := A w
+   *      b := g / g_prev;  a := g / (d - b g / a_prev)    (b := 0, a := g/d at k = 0)
+   *      z := n + b z;  s := w + b s;  p := r + b p
+   *      psi += a p;  r -= a s;  w -= a z
+   *      g := |r|^2;  d := <w,r>                          one global sum
+   *
+   * with the replacement r := chi - A psi, w := A r, s := A p, z := A s.
+   */
+  template<typename T>
+  SystemSolverResults_t 
+  InvPipeCG_a(const LinearOperator<T>& M,
+	      const T& chi,
+	      T& psi,
+	      const Real& RsdCG, 
+	      int MaxCG,
+	      int ReplaceInterval)
+  {
+    START_CODE();
+
+    const Subset& sub = M.subset();
+    SystemSolverResults_t res;
+
+    FlopCounter flopcount;
+    flopcount.reset();
+    StopWatch swatch;
+    swatch.reset();
+    swatch.start();
+
+    T tmp;                moveToFastMemoryHint(tmp);
+    T r, w, n, z, s, p;   
+
+    Double chi_sq = norm2(chi, sub);                 flopcount.addSiteFlops(4*Nc*Ns,sub);
+    Double rsd_sq = Double(RsdCG)*Double(RsdCG)*chi_sq;
+
+    //  g = |r|^2,  d = <w,r>
+    Double g, d, g_prev, a_prev;
+
+    p[sub] = zero;
+    replaceVecs(g, d, M, chi, psi, p, r, w, s, z, tmp);
+    flopcount.addFlops(8*M.nFlops());
+
+    int k = 0;
+    int since_replace = 0;
+
+    while (k < MaxCG)
+    {
+      bool do_replace = (ReplaceInterval > 0 && since_replace >= ReplaceInterval);
+
+      // Converged, check the true residual
+      if (toBool(g <= rsd_sq))
+      {
+	mdagm(M, tmp, psi, r);
+	tmp[sub] = chi - tmp;
+	Double t_sq = norm2(tmp, sub);
+	flopcount.addFlops(2*M.nFlops());
+
+	if (toBool(t_sq <= rsd_sq))
+	  break;
+
+	QDPIO::cout << "InvPipeCG: k = " << k << " true residual = " << sqrt(t_sq/chi_sq) 
+		    << ", replacing" << std::endl;
+	do_replace = true;
+      }
+
+      if (do_replace)
+      {
+	replaceVecs(g, d, M, chi, psi, p, r, w, s, z, tmp);
+	flopcount.addFlops(8*M.nFlops());
+	since_replace = 0;
+      }
+
+      mdagm(M, n, w, tmp);
+      flopcount.addFlops(2*M.nFlops());
+
+      Double alpha, beta;
+      if (k == 0)
+      {
+	beta  = zero;
+	alpha = g / d;
+      }
+      else
+      {
+	beta  = g / g_prev;
+	alpha = g / (d - beta*g/a_prev);
+      }
+
+      g_prev = g;
+      a_prev = alpha;
+
+      FusedBLAS::pipeCGUpdate(g, d, alpha, beta, n, z, s, p, psi, r, w, sub);
+      flopcount.addSiteFlops(24*Nc*Ns,sub);
+
+      ++k;
+      ++since_replace;
+    }
+
+    // True residual
+    mdagm(M, tmp, psi, r);
+    tmp[sub] = chi - tmp;
+    res.resid = sqrt(norm2(tmp, sub));
+    res.n_count = k;
+
+    swatch.stop();
+    QDPIO::cout << "InvPipeCG: k = " << k << std::endl;
+    flopcount.report("invpipecg", swatch.getTimeInSeconds());
+
+    if (k == MaxCG)
+    {
+      QDPIO::cerr << "Nonconvergence Warning: InvPipeCG, n_count = " << k << std::endl;
+    }
+
+    END_CODE();
+    return res;
+  }
+
+
+  // Single precision
+  SystemSolverResults_t 
+  InvPipeCG(const LinearOperator<LatticeFermionF>& M,
+	    const LatticeFermionF& chi,
+	    LatticeFermionF& psi,
+	    const Real& RsdCG, 
+	    int MaxCG,
+	    int ReplaceInterval)
+  {
+    return InvPipeCG_a(M, chi, psi, RsdCG, MaxCG, ReplaceInterval);
+  }
+
+  // Double precision
+  SystemSolverResults_t 
+  InvPipeCG(const LinearOperator<LatticeFermionD>& M,
+	    const LatticeFermionD& chi,
+	    LatticeFermionD& psi,
+	    const Real& RsdCG, 
+	    int MaxCG,
+	    int ReplaceInterval)
+  {
+    return InvPipeCG_a(M, chi, psi, RsdCG, MaxCG, ReplaceInterval);
+  }
+
+}  // end namespace Chroma
@@ -0,0 +1,61 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Pipelined Conjugate-Gradient algorithm for a generic Linear Operator
+ */
+
+#ifndef __invpipecg__
+#define __invpipecg__
+
+#include "linearop.h"
+#include "syssolver.h"
+
+namespace Chroma 
+{
+
+  //! Pipelined Conjugate-Gradient (CGNE) algorithm for a generic Linear Operator
+  /*! \ingroup invert
+   *
+   * Solves M^dag M psi = chi like InvCG2 with the recurrences of
+   * Ghysels and Vanroose, Parallel Computing 40 (2014) 224. Both inner
+   * products of an iteration come from the vectors just updated, so they
+   * are computed in the pass doing the updates and need a single global sum
+   * per iteration instead of two.
+   *
+   * The recursive residual drifts from the true one, so every
+   * ReplaceInterval iterations, and whenever the recursive residual has
+   * converged, r, w, s and z are recomputed from psi and p. The solver
+   * stops only when the true residual has converged.
+   *
+   * \param M               Linear Operator             (Read)
+   * \param chi             Source                      (Read)
+   * \param psi             Solution                    (Modify)
+   * \param RsdCG           CG residual accuracy        (Read)
+   * \param MaxCG           Maximum CG iterations       (Read)
+   * \param ReplaceInterval Iterations between replacements, 0 for none (Read)
+   *
+   * @{
+   */
+
+  // Single precision
+  SystemSolverResults_t 
+  InvPipeCG(const LinearOperator<LatticeFermionF>& M,
+	    const LatticeFermionF& chi,
+	    LatticeFermionF& psi,
+	    const Real& RsdCG, 
+	    int MaxCG,
+	    int ReplaceInterval);
+
+  // Double precision
+  SystemSolverResults_t 
+  InvPipeCG(const LinearOperator<LatticeFermionD>& M,
+	    const LatticeFermionD& chi,
+	    LatticeFermionD& psi,
+	    const Real& RsdCG, 
+	    int MaxCG,
+	    int ReplaceInterval);
+
+  /*! @} */  // end of group invert
+
+}  // end namespace Chroma
+
+#endif
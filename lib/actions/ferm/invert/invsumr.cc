@@ -1,5 +1,6 @@
 #include "chromabase.h"
 #include "actions/ferm/invert/invsumr.h"
+#include "actions/ferm/invert/fused_blas.h"
 
 namespace Chroma {
 
@@ -202,11 +203,11 @@ void InvSUMR_a(const LinearOperator<T>& U,
       // vtilde_{m+1} := sigma_m vtilde_m + conj(gamma_m)*v_{m+1} 
       Complex gconj = conj(gamma);
       Complex csigma=cmplx(sigma,0);
-      vtilde = csigma*vtilde + gconj*v;
+      Double vtilde_sq = FusedBLAS::axpbyNorm(vtilde, gconj, v, csigma, all);
 
       // Normalise vtilde -- I found this in the Wuppertal MATLAB code
       // It is not prescribed by the Reichel/Jagels paper
-      Real ftmp3 = Real(1)/sqrt(norm2(vtilde));
+      Real ftmp3 = Real(1)/sqrt(vtilde_sq);
       vtilde *= ftmp3;
 
       // Check whether we have converged or not:
@@ -0,0 +1,726 @@
+/*! \file
+ *  \brief Setup of the native aggregation based multigrid solver
+ */
+
+#include "actions/ferm/invert/mg_native_setup.h"
+#include "util/ferm/block_subset.h"
+
+#include <cmath>
+
+namespace Chroma
+{
+  typedef MGNativeSetup::Cmplx      Cmplx;
+  typedef MGNativeSetup::CoarseVec  CoarseVec;
+
+  // Anonymous namespace
+  namespace
+  {
+#ifndef QDP_IS_QDPJIT
+    //! <a,b> on one site
+    inline
+    Cmplx siteInner(const LatticeFermion& a, const LatticeFermion& b, int site)
+    {
+      double re = 0, im = 0;
+
+      for(int s=0; s < Ns; ++s)
+	for(int c=0; c < Nc; ++c)
+	{
+	  const RComplex<REAL>& u = a.elem(site).elem(s).elem(c);
+	  const RComplex<REAL>& v = b.elem(site).elem(s).elem(c);
+
+	  re += u.real()*v.real() + u.imag()*v.imag();
+	  im += u.real()*v.imag() - u.imag()*v.real();
+	}
+
+      return Cmplx(re, im);
+    }
+
+
+    //! Arguments for the restriction
+    struct RestrictArgs
+    {
+      const Set&                      blocks;
+      const multi1d<LatticeFermion>&  vecs;
+      const LatticeFermion&           x;
+      Cmplx*                          xc;
+    };
+
+    //! Restrict a range of blocks
+    inline
+    void restrictBlockLoop(int lo, int hi, int myId, RestrictArgs* a)
+    {
+      const int n = a->vecs.size();
+
+      for(int b=lo; b < hi; ++b)
+      {
+	const multi1d<int>& tab = a->blocks[b].siteTable();
+
+	for(int k=0; k < n; ++k)
+	{
+	  Cmplx sum = 0;
+	  for(int j=0; j < tab.size(); ++j)
+	    sum += siteInner(a->vecs[k], a->x, tab[j]);
+
+	  a->xc[b*n + k] = sum;
+	}
+      }
+    }
+
+
+    //! Arguments for the prolongation
+    struct ProlongArgs
+    {
+      const Set&                      blocks;
+      const multi1d<LatticeFermion>&  vecs;
+      LatticeFermion&                 x;
+      const Cmplx*                    xc;
+    };
+
+    //! Prolongate a range of blocks
+    inline
+    void prolongBlockLoop(int lo, int hi, int myId, ProlongArgs* a)
+    {
+      const int n = a->vecs.size();
+
+      for(int b=lo; b < hi; ++b)
+      {
+	const multi1d<int>& tab = a->blocks[b].siteTable();
+	const Cmplx* c = a->xc + b*n;
+
+	for(int j=0; j < tab.size(); ++j)
+	{
+	  const int site = tab[j];
+
+	  for(int s=0; s < Ns; ++s)
+	    for(int col=0; col < Nc; ++col)
+	    {
+	      double re = 0, im = 0;
+	      for(int k=0; k < n; ++k)
+	      {
+		const RComplex<REAL>& v = a->vecs[k].elem(site).elem(s).elem(col);
+		re += c[k].real()*v.real() - c[k].imag()*v.imag();
+		im += c[k].real()*v.imag() + c[k].imag()*v.real();
+	      }
+
+	      a->x.elem(site).elem(s).elem(col).real() = re;
+	      a->x.elem(site).elem(s).elem(col).imag() = im;
+	    }
+	}
+      }
+    }
+
+
+    //! Arguments for spreading per block values
+    struct SpreadArgs
+    {
+      const multi1d<int>&       coloring;
+      const multi1d<DComplex>&  per_block;
+      LatticeComplex&           c;
+    };
+
+    //! Spread over a range of sites
+    inline
+    void spreadSiteLoop(int lo, int hi, int myId, SpreadArgs* a)
+    {
+      for(int site=lo; site < hi; ++site)
+      {
+	const DComplex& v = a->per_block[a->coloring[site]];
+	a->c.elem(site).elem().elem().real() = toDouble(real(v));
+	a->c.elem(site).elem().elem().imag() = toDouble(imag(v));
+      }
+    }
+
+
+    //! Arguments for probing the coarse operator
+    struct ProbeArgs
+    {
+      const Set&                          blocks;
+      const multi1d<LatticeFermion>&      vecs;
+      const LatticeFermion&               r;        /*!< A on the probe */
+      const std::vector<int>&             color;
+      const std::vector<unsigned char>&   face;
+      int                                 probe_color;
+      int                                 col;      /*!< coarse component probed */
+      int                                 num_slots;
+      Cmplx*                              op;
+    };
+
+    //! Sort the result of a probe into the stencil, for a range of blocks
+    inline
+    void probeBlockLoop(int lo, int hi, int myId, ProbeArgs* a)
+    {
+      const int n = a->vecs.size();
+
+      for(int b=lo; b < hi; ++b)
+      {
+	// The probed blocks seen by this one differ in at most one direction
+	const int diff = a->color[b] ^ a->probe_color;
+	int mu = -1;
+	if (diff != 0)
+	{
+	  for(int d=0; d < Nd; ++d)
+	    if (diff == (1 << d))
+	      mu = d;
+
+	  if (mu < 0)
+	    continue;
+	}
+
+	const multi1d<int>& tab = a->blocks[b].siteTable();
+	for(int j=0; j < tab.size(); ++j)
+	{
+	  const int site = tab[j];
+
+	  // The forward neighbour reaches the upper face, the backward one the lower face
+	  int slot = 0;
+	  if (mu >= 0)
+	  {
+	    const unsigned char f = a->face[site*Nd + mu];
+	    if (f == 0)
+	      continue;
+
+	    slot = (f == 1) ? 1 + 2*mu : 2 + 2*mu;
+	  }
+
+	  Cmplx* out = a->op + (b*a->num_slots + slot)*n*n + a->col;
+	  for(int row=0; row < n; ++row)
+	    out[row*n] += siteInner(a->vecs[row], a->r, site);
+	}
+      }
+    }
+#endif
+
+
+    //! Arguments for the coarse operator
+    struct CoarseArgs
+    {
+      const std::vector<Cmplx>&  op;
+      const std::vector<int>&    neighbour;
+      const std::vector<bool>&   active;     /*!< slots that couple anything */
+      int                        num_slots;
+      int                        n;
+      const Cmplx*               x;
+      Cmplx*                     y;
+    };
+
+    //! Coarse operator on a range of blocks
+    inline
+    void coarseBlockLoop(int lo, int hi, int myId, CoarseArgs* a)
+    {
+      const int n = a->n;
+
+      for(int b=lo; b < hi; ++b)
+      {
+	Cmplx* y = a->y + b*n;
+	for(int row=0; row < n; ++row)
+	  y[row] = 0;
+
+	for(int slot=0; slot < a->num_slots; ++slot)
+	{
+	  if (! a->active[slot])
+	    continue;
+
+	  const Cmplx* m = &(a->op[(b*a->num_slots + slot)*n*n]);
+	  const Cmplx* x = a->x + a->neighbour[b*a->num_slots + slot]*n;
+
+	  for(int row=0; row < n; ++row)
+	  {
+	    Cmplx sum = 0;
+	    for(int col=0; col < n; ++col)
+	      sum += m[row*n + col] * x[col];
+
+	    y[row] += sum;
+	  }
+	}
+      }
+    }
+
+
+    //! <a,b> of coarse vectors
+    Cmplx coarseInner(const CoarseVec& a, const CoarseVec& b)
+    {
+      Cmplx sum = 0;
+      for(int i=0; i < a.size(); ++i)
+	sum += std::conj(a[i]) * b[i];
+      return sum;
+    }
+
+    //! |a| of a coarse vector
+    double coarseNorm(const CoarseVec& a)
+    {
+      double sum = 0;
+      for(int i=0; i < a.size(); ++i)
+	sum += std::norm(a[i]);
+      return std::sqrt(sum);
+    }
+  }
+
+
+  // Build the setup
+  MGNativeSetup::MGNativeSetup(const LinearOperator<LatticeFermion>& A,
+			       const SysSolverMGNativeParams& params_,
+			       const std::string& gauge_id_) :
+    params(params_), gauge_id(gauge_id_)
+  {
+    START_CODE();
+
+#ifdef QDP_IS_QDPJIT
+    QDPIO::cerr << "MG_NATIVE: needs site access, not available with QDP-JIT" << std::endl;
+    QDP_abort(1);
+#endif
+
+    if (A.subset().numSiteTable() != Layout::sitesOnNode())
+    {
+      QDPIO::cerr << "MG_NATIVE: the operator must act on the whole lattice, use an unpreconditioned action" << std::endl;
+      QDP_abort(1);
+    }
+
+    if (params.NumNullVecs <= 0)
+    {
+      QDPIO::cerr << "MG_NATIVE: NumNullVecs must be positive" << std::endl;
+      QDP_abort(1);
+    }
+
+    StopWatch swatch;
+    swatch.reset();
+    swatch.start();
+
+    makeBlocks();
+    makeNullVecs(A);
+    makeCoarseOp(A);
+
+    swatch.stop();
+    QDPIO::cout << "MG_NATIVE: setup with " << num_blocks << " blocks of " << block_dim
+		<< " components, time= " << swatch.getTimeInSeconds() << " secs" << std::endl;
+
+    END_CODE();
+  }
+
+
+  // Aggregates and their neighbours
+  void MGNativeSetup::makeBlocks()
+  {
+    if (params.Blocking.size() != Nd)
+    {
+      QDPIO::cerr << "MG_NATIVE: Blocking must have " << Nd << " entries" << std::endl;
+      QDP_abort(1);
+    }
+
+    block_size = params.Blocking;
+    block_num.resize(Nd);
+
+    for(int mu=0; mu < Nd; ++mu)
+    {
+      if (block_size[mu] <= 0 || Layout::lattSize()[mu] % block_size[mu] != 0)
+      {
+	QDPIO::cerr << "MG_NATIVE: block size " << block_size[mu] << " does not divide the lattice in direction " << mu << std::endl;
+	QDP_abort(1);
+      }
+
+      block_num[mu] = Layout::lattSize()[mu] / block_size[mu];
+
+      if (block_num[mu] > 1 && (block_num[mu] % 2 != 0 || block_size[mu] < 2))
+      {
+	QDPIO::cerr << "MG_NATIVE: need an even number of blocks at least 2 sites wide in direction " << mu << std::endl;
+	QDP_abort(1);
+      }
+    }
+
+    blocks.make(BlockFunc(block_size));
+    num_blocks = blocks.numSubsets();
+    block_dim  = 2*params.NumNullVecs;
+    num_slots  = 1 + 2*Nd;
+
+    // Neighbours, in the order of BlockFunc with the first direction fastest
+    neighbour.resize(num_blocks*num_slots);
+    color.resize(num_blocks);
+
+    for(int b=0; b < num_blocks; ++b)
+    {
+      multi1d<int> bc(Nd);
+      int rem = b;
+      for(int mu=0; mu < Nd; ++mu)
+      {
+	bc[mu] = rem % block_num[mu];
+	rem /= block_num[mu];
+      }
+
+      color[b] = 0;
+      for(int mu=0; mu < Nd; ++mu)
+	if (block_num[mu] > 1)
+	  color[b] |= (bc[mu] % 2) << mu;
+
+      neighbour[b*num_slots] = b;
+      for(int mu=0; mu < Nd; ++mu)
+      {
+	for(int dir=0; dir < 2; ++dir)
+	{
+	  multi1d<int> nc = bc;
+	  nc[mu] = (bc[mu] + ((dir == 0) ? 1 : block_num[mu] - 1)) % block_num[mu];
+
+	  int nb = 0;
+	  for(int nu=Nd-1; nu >= 0; --nu)
+	    nb = nb*block_num[nu] + nc[nu];
+
+	  neighbour[b*num_slots + 1 + 2*mu + dir] = nb;
+	}
+      }
+    }
+
+    // Faces of the blocks
+    face.resize(Layout::sitesOnNode()*Nd);
+    for(int site=0; site < Layout::sitesOnNode(); ++site)
+    {
+      multi1d<int> coord = Layout::siteCoords(Layout::nodeNumber(), site);
+
+      for(int mu=0; mu < Nd; ++mu)
+      {
+	const int x = coord[mu] % block_size[mu];
+	face[site*Nd + mu] = (x == block_size[mu]-1) ? 1 : ((x == 0) ? 2 : 0);
+      }
+    }
+  }
+
+
+  // A per block value on every site
+  void MGNativeSetup::spread(LatticeComplex& c, const multi1d<DComplex>& per_block) const
+  {
+#ifndef QDP_IS_QDPJIT
+    SpreadArgs args = {blocks.latticeColoring(), per_block, c};
+    dispatch_to_threads(Layout::sitesOnNode(), args, spreadSiteLoop);
+#endif
+  }
+
+
+  // Null vectors split by chirality and orthonormal per block
+  void MGNativeSetup::makeNullVecs(const LinearOperator<LatticeFermion>& A)
+  {
+    START_CODE();
+
+    const int nvec = params.NumNullVecs;
+    multi1d<LatticeFermion> null(nvec);
+    LatticeFermion zero_rhs = zero;
+
+    // Save current seed
+    Seed ran_seed;
+    QDP::RNG::savern(ran_seed);
+
+    for(int i=0; i < nvec; ++i)
+    {
+      gaussian(null[i]);
+
+      // Damp the high modes
+      smooth(A, null[i], zero_rhs, params.NullSetupIters);
+
+      for(int j=0; j < i; ++j)
+	null[i] -= innerProduct(null[j], null[i]) * null[j];
+
+      Real nrm = sqrt(norm2(null[i]));
+      null[i] *= Real(1) / nrm;
+    }
+
+    // Reset the seed
+    QDP::RNG::setrn(ran_seed);
+
+    // Split by chirality
+    vecs.resize(block_dim);
+    for(int i=0; i < nvec; ++i)
+    {
+      LatticeFermion g5 = Gamma(Ns*Ns-1) * null[i];
+      vecs[i]        = Real(0.5) * (null[i] + g5);
+      vecs[nvec + i] = Real(0.5) * (null[i] - g5);
+    }
+
+    // Orthonormalize on every block, the two chiralities are orthogonal already
+    LatticeComplex c;
+    for(int k=0; k < block_dim; ++k)
+    {
+      for(int j=(k/nvec)*nvec; j < k; ++j)
+      {
+	spread(c, sumMulti(localInnerProduct(vecs[j], vecs[k]), blocks));
+	vecs[k] -= c * vecs[j];
+      }
+
+      multi1d<Double> nrm = sumMulti(localNorm2(vecs[k]), blocks);
+      multi1d<DComplex> inv(num_blocks);
+      for(int b=0; b < num_blocks; ++b)
+      {
+	if (toDouble(nrm[b]) <= 0)
+	{
+	  QDPIO::cerr << "MG_NATIVE: null vector " << k << " vanishes on block " << b << std::endl;
+	  QDP_abort(1);
+	}
+	inv[b] = cmplx(Double(1) / sqrt(nrm[b]), Double(0));
+      }
+
+      spread(c, inv);
+      vecs[k] = c * vecs[k];
+    }
+
+    END_CODE();
+  }
+
+
+  // Probe the coarse operator
+  void MGNativeSetup::makeCoarseOp(const LinearOperator<LatticeFermion>& A)
+  {
+    START_CODE();
+
+    const int n = block_dim;
+    coarse_op.assign(num_blocks*num_slots*n*n, Cmplx(0));
+
+#ifndef QDP_IS_QDPJIT
+    LatticeComplex mask;
+    LatticeFermion y, r;
+
+    for(int probe_color=0; probe_color < (1 << Nd); ++probe_color)
+    {
+      multi1d<DComplex> on(num_blocks);
+      bool any = false;
+      for(int b=0; b < num_blocks; ++b)
+      {
+	on[b] = (color[b] == probe_color) ? cmplx(Double(1),Double(0)) : cmplx(Double(0),Double(0));
+	any |= (color[b] == probe_color);
+      }
+
+      if (! any)
+	continue;
+
+      spread(mask, on);
+
+      for(int col=0; col < n; ++col)
+      {
+	y = mask * vecs[col];
+	A(r, y, PLUS);
+
+	ProbeArgs args = {blocks, vecs, r, color, face, probe_color, col, num_slots, &coarse_op[0]};
+	dispatch_to_threads(num_blocks, args, probeBlockLoop);
+      }
+    }
+
+    // Blocks are spread over the nodes
+    QDPInternal::globalSumArray(reinterpret_cast<double*>(&coarse_op[0]), 2*coarse_op.size());
+#endif
+
+    END_CODE();
+  }
+
+
+  // Restrict a fine vector
+  void MGNativeSetup::restrictVec(CoarseVec& xc, const LatticeFermion& x) const
+  {
+    xc.assign(coarseSize(), Cmplx(0));
+
+#ifndef QDP_IS_QDPJIT
+    RestrictArgs args = {blocks, vecs, x, &xc[0]};
+    dispatch_to_threads(num_blocks, args, restrictBlockLoop);
+
+    QDPInternal::globalSumArray(reinterpret_cast<double*>(&xc[0]), 2*xc.size());
+#endif
+  }
+
+
+  // Prolongate a coarse vector
+  void MGNativeSetup::prolongVec(LatticeFermion& x, const CoarseVec& xc) const
+  {
+#ifndef QDP_IS_QDPJIT
+    ProlongArgs args = {blocks, vecs, x, &xc[0]};
+    dispatch_to_threads(num_blocks, args, prolongBlockLoop);
+#endif
+  }
+
+
+  // Apply the coarse operator
+  void MGNativeSetup::applyCoarse(CoarseVec& y, const CoarseVec& x) const
+  {
+    y.resize(coarseSize());
+
+    // Directions with a single block couple through the self term only
+    std::vector<bool> active(num_slots, true);
+    for(int mu=0; mu < Nd; ++mu)
+      if (block_num[mu] == 1)
+	active[1 + 2*mu] = active[2 + 2*mu] = false;
+
+    CoarseArgs args = {coarse_op, neighbour, active, num_slots, block_dim, &x[0], &y[0]};
+    dispatch_to_threads(num_blocks, args, coarseBlockLoop);
+  }
+
+
+  // Solve the coarse system by restarted GMRES from zero
+  int MGNativeSetup::solveCoarse(CoarseVec& x, const CoarseVec& b) const
+  {
+    const int N = coarseSize();
+    const int m = params.CoarseNKrylov;
+
+    x.assign(N, Cmplx(0));
+
+    const double target = toDouble(params.CoarseRsdTarget) * coarseNorm(b);
+    if (target == 0)
+      return 0;
+
+    std::vector<CoarseVec> V(m+1, CoarseVec(N));
+    std::vector<Cmplx> H((m+1)*m), g(m+1), sn(m), y(m);
+    std::vector<double> cs(m);
+    CoarseVec w;
+
+    int iters = 0;
+    while (iters < params.CoarseMaxIter)
+    {
+      // r = b - A x
+      applyCoarse(w, x);
+      for(int i=0; i < N; ++i)
+	V[0][i] = b[i] - w[i];
+
+      double beta = coarseNorm(V[0]);
+      if (beta <= target)
+	break;
+
+      for(int i=0; i < N; ++i)
+	V[0][i] /= beta;
+
+      std::fill(g.begin(), g.end(), Cmplx(0));
+      g[0] = beta;
+
+      int j = 0;
+      double resid = beta;
+      while (j < m && iters < params.CoarseMaxIter && resid > target)
+      {
+	applyCoarse(w, V[j]);
+
+	// Arnoldi, column j of H
+	for(int i=0; i <= j; ++i)
+	{
+	  Cmplx h = coarseInner(V[i], w);
+	  H[i*m + j] = h;
+	  for(int l=0; l < N; ++l)
+	    w[l] -= h * V[i][l];
+	}
+
+	double wnorm = coarseNorm(w);
+	H[(j+1)*m + j] = wnorm;
+	if (wnorm > 0)
+	  for(int l=0; l < N; ++l)
+	    V[j+1][l] = w[l] / wnorm;
+
+	// Previous rotations
+	for(int i=0; i < j; ++i)
+	{
+	  Cmplx a = H[i*m + j];
+	  Cmplx c = H[(i+1)*m + j];
+	  H[i*m + j]     = cs[i]*a + sn[i]*c;
+	  H[(i+1)*m + j] = -std::conj(sn[i])*a + cs[i]*c;
+	}
+
+	// New rotation zeroing H(j+1,j)
+	Cmplx a = H[j*m + j];
+	double t = std::sqrt(std::norm(a) + wnorm*wnorm);
+	if (std::abs(a) == 0)
+	{
+	  cs[j] = 0;
+	  sn[j] = 1;
+	}
+	else
+	{
+	  cs[j] = std::abs(a) / t;
+	  sn[j] = (a / std::abs(a)) * wnorm / t;
+	}
+
+	H[j*m + j]     = cs[j]*a + sn[j]*wnorm;
+	H[(j+1)*m + j] = 0;
+
+	g[j+1] = -std::conj(sn[j]) * g[j];
+	g[j]   = cs[j] * g[j];
+
+	resid = std::abs(g[j+1]);
+	++j;
+	++iters;
+
+	if (wnorm == 0)
+	  break;
+      }
+
+      // Back substitution and update
+      for(int i=j-1; i >= 0; --i)
+      {
+	Cmplx sum = g[i];
+	for(int l=i+1; l < j; ++l)
+	  sum -= H[i*m + l] * y[l];
+	y[i] = sum / H[i*m + i];
+      }
+
+      for(int i=0; i < j; ++i)
+	for(int l=0; l < N; ++l)
+	  x[l] += y[i] * V[i][l];
+
+      if (resid <= target)
+	break;
+    }
+
+    return iters;
+  }
+
+
+  // MR smoothing of A x = b
+  void MGNativeSetup::smooth(const LinearOperator<LatticeFermion>& A,
+			     LatticeFermion& x, const LatticeFermion& b, int iters) const
+  {
+    if (iters <= 0)
+      return;
+
+    LatticeFermion r, Ar;
+
+    A(Ar, x, PLUS);
+    r = b - Ar;
+
+    for(int k=0; k < iters; ++k)
+    {
+      A(Ar, r, PLUS);
+
+      DComplex c = innerProduct(Ar, r);
+      Double   d = norm2(Ar);
+      if (toBool(d == Double(0)))
+	break;
+
+      Complex a = c / d;
+      a = a * params.SmootherMROver;
+
+      x += a * r;
+      r -= a * Ar;
+    }
+  }
+
+
+  // One V-cycle
+  void MGNativeSetup::vcycle(const LinearOperator<LatticeFermion>& A,
+			     LatticeFermion& x, const LatticeFermion& r) const
+  {
+    START_CODE();
+
+    LatticeFermion res, tmp;
+
+    x = zero;
+    smooth(A, x, r, params.SmootherPreIters);
+
+    // Coarse grid correction
+    if (params.SmootherPreIters > 0)
+    {
+      A(tmp, x, PLUS);
+      res = r - tmp;
+    }
+    else
+    {
+      res = r;
+    }
+
+    CoarseVec rc, ec;
+    restrictVec(rc, res);
+    solveCoarse(ec, rc);
+    prolongVec(tmp, ec);
+    x += tmp;
+
+    smooth(A, x, r, params.SmootherPostIters);
+
+    END_CODE();
+  }
+
+} // End namespace
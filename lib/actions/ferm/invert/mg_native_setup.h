@@ -0,0 +1,126 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Setup of the native aggregation based multigrid solver
+ */
+
+#ifndef __mg_native_setup_h__
+#define __mg_native_setup_h__
+
+#include "chromabase.h"
+#include "handle.h"
+#include "linearop.h"
+#include "actions/ferm/invert/syssolver_mg_native_params.h"
+
+#include <vector>
+#include <complex>
+
+namespace Chroma
+{
+
+  //! Two level aggregation based multigrid for Wilson like operators
+  /*! \ingroup invert
+   *
+   * The lattice is cut into blocks. Null vectors of the operator are found
+   * by MR iterations on A x = 0 from random vectors, split by chirality and
+   * orthonormalized on every block, so each block carries 2*NumNullVecs
+   * coarse components. The coarse operator P^dag A P is a nearest neighbour
+   * stencil between the blocks, probed with A through the LinearOperator
+   * interface.
+   *
+   * The probing assumes A couples nearest neighbours only and acts on the
+   * whole lattice, as the unpreconditioned Wilson and clover operators do.
+   * The number of blocks in a direction must be 1 or even, and a block must
+   * be at least 2 sites wide in a direction that has more than one block.
+   *
+   * Coarse vectors hold all the blocks on every node. The coarse operator
+   * and the coarse solve are replicated, so the setup is only suited to
+   * coarse lattices that fit on one node.
+   */
+  class MGNativeSetup
+  {
+  public:
+    //! Coarse complex number
+    typedef std::complex<double>   Cmplx;
+
+    //! Coarse vector, block major
+    typedef std::vector<Cmplx>     CoarseVec;
+
+    //! Build the setup
+    /*!
+     * \param A         fine operator ( Read )
+     * \param params    solver parameters ( Read )
+     * \param gauge_id  fingerprint of the gauge field of A ( Read )
+     */
+    MGNativeSetup(const LinearOperator<LatticeFermion>& A,
+		  const SysSolverMGNativeParams& params,
+		  const std::string& gauge_id);
+
+    //! Fingerprint of the gauge field the setup was built on
+    const std::string& gaugeId() const {return gauge_id;}
+
+    //! Number of blocks
+    int numBlocks() const {return num_blocks;}
+
+    //! Coarse components per block
+    int blockDim() const {return block_dim;}
+
+    //! Size of a coarse vector
+    int coarseSize() const {return num_blocks*block_dim;}
+
+    //! Restrict a fine vector: xc = P^dag x
+    void restrictVec(CoarseVec& xc, const LatticeFermion& x) const;
+
+    //! Prolongate a coarse vector: x = P xc
+    void prolongVec(LatticeFermion& x, const CoarseVec& xc) const;
+
+    //! Apply the coarse operator
+    void applyCoarse(CoarseVec& y, const CoarseVec& x) const;
+
+    //! Solve the coarse system by restarted GMRES from zero
+    /*! \return the number of iterations */
+    int solveCoarse(CoarseVec& x, const CoarseVec& b) const;
+
+    //! MR smoothing of A x = b, starting from x
+    void smooth(const LinearOperator<LatticeFermion>& A,
+		LatticeFermion& x, const LatticeFermion& b, int iters) const;
+
+    //! One V-cycle as a preconditioner, x approximates A^-1 r
+    void vcycle(const LinearOperator<LatticeFermion>& A,
+		LatticeFermion& x, const LatticeFermion& r) const;
+
+  private:
+    //! Aggregates and their neighbours
+    void makeBlocks();
+
+    //! Null vectors split by chirality and orthonormal per block
+    void makeNullVecs(const LinearOperator<LatticeFermion>& A);
+
+    //! Probe the coarse operator
+    void makeCoarseOp(const LinearOperator<LatticeFermion>& A);
+
+    //! A per block value on every site
+    void spread(LatticeComplex& c, const multi1d<DComplex>& per_block) const;
+
+  private:
+    SysSolverMGNativeParams  params;
+    std::string              gauge_id;
+
+    multi1d<int>             block_size;   /*!< extent of a block per direction */
+    multi1d<int>             block_num;    /*!< blocks per direction */
+    int                      num_blocks;
+    int                      block_dim;    /*!< 2*NumNullVecs */
+    Set                      blocks;
+
+    //! Stencil slots: self, then forward and backward neighbour per direction
+    int                      num_slots;
+    std::vector<int>         neighbour;    /*!< [block][slot], the block coupled through a slot */
+    std::vector<int>         color;        /*!< [block], parity of the block coordinates */
+    std::vector<unsigned char> face;       /*!< [site][mu], 1 upper face, 2 lower face of its block */
+
+    multi1d<LatticeFermion>  vecs;         /*!< prolongator columns, chirality major */
+    std::vector<Cmplx>       coarse_op;    /*!< [block][slot][row][col] */
+  };
+
+} // End namespace
+
+#endif
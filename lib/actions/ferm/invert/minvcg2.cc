@@ -5,6 +5,9 @@
 
 #include "linearop.h"
 #include "actions/ferm/invert/minvcg2.h"
+#include "actions/ferm/invert/fused_blas.h"
+
+#include <vector>
 #undef PAT
 #ifdef PAT
 #include <pat_api.h>
@@ -218,18 +221,24 @@ namespace Chroma
 
 
     //  Psi[1] -= b[0] p[0] = - b[0] chi;
+    //  The update of psi is done with the next update of p, psi = 0 here
+    std::vector<double> bs_d(n_shift);
     for(s = 0; s < n_shift; ++s) {
-      R bs_r = bs[s];
-      psi[s][sub] = - bs_r*chi_internal;  flopcount.addSiteFlops(2*Nc*Ns,sub);
+      bs_d[s] = toDouble(bs[s]);
     }
+
+    // Arguments of the fused update, the active shifts come first
+    std::vector<T*> p_u, psi_u;
+    std::vector<double> zs_u, as_u, bs_u;
   
     //  c = |r[1]|^2   
     Double c = norm2(r,sub);   	       	         flopcount.addSiteFlops(4*Nc*Ns,sub);
 
-    // Check convergence of first solution
-    multi1d<bool> convsP(n_shift);
+    // Shifts still iterating, and those converged at the last step
+    // with their update of psi pending
+    std::vector<int> active(n_shift), retired;
     for(s = 0; s < n_shift; ++s) {
-      convsP[s] = false;
+      active[s] = s;
     }
 
     bool convP = toBool( c < rsd_sq[isz] );
@@ -253,24 +262,38 @@ namespace Chroma
       //  a[k+1] := |r[k]|**2 / |r[k-1]|**2 ; 
       a = c/cp;
 
-      // Update p
-      R a_r = a;
-      p_0[sub] = r + a_r*p_0;                        flopcount.addSiteFlops(4*Nc*Ns,sub);
       //  p[k+1] := r[k+1] + a[k+1] p[k]; 
       //  Compute the shifted as */
       //  ps[k+1] := zs[k+1] r[k+1] + a[k+1] ps[k];
-      for(s = 0; s < n_shift; ++s) {
-
-	  // Don't update other p-s if converged.
-	if( ! convsP[s] ) {
+      //  Psi[k] -= bs[k] ps[k] is done in the same pass
+      p_u.clear(); psi_u.clear();
+      zs_u.clear(); as_u.clear(); bs_u.clear();
+      for(int n = 0; n < active.size(); ++n) {
+	s = active[n];
+	as = a * z[iz][s]*bs[s] / (z[1-iz][s]*b);
+	p_u.push_back(&p[s]);
+	psi_u.push_back(&psi[s]);
+	zs_u.push_back(toDouble(z[iz][s]));
+	as_u.push_back(toDouble(as));
+	bs_u.push_back(bs_d[s]);
+      }
 
-	  as = a * z[iz][s]*bs[s] / (z[1-iz][s]*b);
-	  R zizs= z[iz][s];
-	  R as_r = as;
-	  p[s][sub] = zizs*r + as_r*p[s];  flopcount.addSiteFlops(6*Nc*Ns,sub);
-	}
+      // The retired shifts only update psi
+      for(int n = 0; n < retired.size(); ++n) {
+	s = retired[n];
+	p_u.push_back(&p[s]);
+	psi_u.push_back(&psi[s]);
+	zs_u.push_back(0);
+	as_u.push_back(0);
+	bs_u.push_back(bs_d[s]);
       }
 
+      FusedBLAS::multiShiftUpdate(r, p_0, a, p_u, psi_u, active.size(), zs_u, as_u, bs_u, sub);
+      flopcount.addSiteFlops(4*Nc*Ns,sub);
+      flopcount.addSiteFlops((6+2)*Nc*Ns*active.size(),sub);
+      flopcount.addSiteFlops(2*Nc*Ns*retired.size(),sub);
+      retired.clear();
+
       //  cp  =  | r[k] |**2 
       cp = c;
 
@@ -287,59 +310,55 @@ namespace Chroma
       bp = b;
       b = -cp/d;
       //  r[k+1] += b[k] A . p[k] ; 
-      b_r = b;
-      r[sub] += b_r*MMp;                                flopcount.addSiteFlops(4*Nc*Ns,sub);
       //  c  =  | r[k] |**2 
-      c = norm2(r,sub);	                                   flopcount.addSiteFlops(4*Nc*Ns,sub);
+      c = FusedBLAS::axpyNorm(r, b, MMp, sub);           flopcount.addSiteFlops(8*Nc*Ns,sub);
 
       // Compute the shifted bs and z 
       iz = 1 - iz;
-      for(s = 0; s < n_shift; s++) {
-      	if ( !convsP[s] ) {
-	  z0 = z[1-iz][s];
-	  z1 = z[iz][s];
-	  z[iz][s] = z0*z1*bp;
-	  z[iz][s] /= b*a*(z1-z0) + z1*bp*(Double(1) - shifts[s]*b);
-	  bs[s] = b*z[iz][s]/z0;
-	}
-      }
-
-
-
-      //  Psi[k+1] -= b[k] p[k] ; 
-      for(s = 0; s < n_shift; ++s) 
-      {
-	if (! convsP[s] ) 
-	{
-	  R bs_r = bs[s];
-
-	  psi[s][sub] -= bs_r*p[s];                 flopcount.addSiteFlops(2*Nc*Ns,sub);
-	}
+      for(int n = 0; n < active.size(); ++n) {
+	s = active[n];
+	z0 = z[1-iz][s];
+	z1 = z[iz][s];
+	z[iz][s] = z0*z1*bp;
+	z[iz][s] /= b*a*(z1-z0) + z1*bp*(Double(1) - shifts[s]*b);
+	bs[s] = b*z[iz][s]/z0;
+	bs_d[s] = toDouble(bs[s]);
       }
 
-
       //    IF |psi[k+1] - psi[k]| <= RsdCG |psi[k+1]| THEN RETURN;
       // or IF |r[k+1]| <= RsdCG |chi| THEN RETURN;
-      convP = true;
-      for(s = 0; s < n_shift; s++) 
+      // Converged shifts are compacted out of the active list
+      int m = 0;
+      for(int n = 0; n < active.size(); ++n) 
       {
-	if (! convsP[s] ) 
-	{
-	  // Convergence methods 
-	  // Check norm of shifted residuals 
-	  Double css = c * z[iz][s]* z[iz][s];
+	s = active[n];
 
+	// Convergence methods 
+	// Check norm of shifted residuals 
+	Double css = c * z[iz][s]* z[iz][s];
 
+	if ( toBool( css < rsd_sq[s] ) )
+	  retired.push_back(s);
+	else
+	  active[m++] = s;
+      }
+      active.resize(m);
+      convP = active.empty();
 
-	  convsP[s] = toBool( css < rsd_sq[s] );
-
+      n_count = k;
+    }
 
+    //  Psi[k+1] -= b[k] p[k] ; 
+    for(int n = 0; n < active.size(); ++n) {
+      retired.push_back(active[n]);
+    }
 
-	}
-	convP &= convsP[s];
-      }
+    for(int n = 0; n < retired.size(); ++n) 
+    {
+      s = retired[n];
+      R bs_r = bs[s];
 
-      n_count = k;
+      psi[s][sub] -= bs_r*p[s];                 flopcount.addSiteFlops(2*Nc*Ns,sub);
     }
 
     swatch.stop();
@@ -450,4 +469,91 @@ namespace Chroma
 #endif
   }
 
+
+  /*! \ingroup invert */
+  void MInvCG2Refine(const LinearOperator<LatticeFermion>& M,
+		     const LinearOperator<LatticeFermionF>& MF,
+		     const LatticeFermion& chi, 
+		     multi1d<LatticeFermion>& psi,
+		     const multi1d<Real>& shifts, 
+		     const multi1d<Real>& RsdCG,
+		     const Real& RsdInner,
+		     int MaxCG,
+		     int &n_count)
+  {
+    START_CODE();
+
+    const Subset& sub = M.subset();
+    const int n_shift = shifts.size();
+    const int MaxRefine = 10;
+
+    if (RsdCG.size() != n_shift) 
+    {
+      QDPIO::cerr << "MInvCG2Refine: number of shifts and residuals must match" << std::endl;
+      QDP_abort(1);
+    }
+
+    // All shifts in single precision
+    multi1d<RealF> shifts_f(n_shift), rsd_f(n_shift);
+    for(int s = 0; s < n_shift; ++s) {
+      shifts_f[s] = shifts[s];
+      rsd_f[s] = toBool(RsdCG[s] > RsdInner) ? RsdCG[s] : RsdInner;
+    }
+
+    LatticeFermionF chi_f;
+    chi_f[sub] = chi;
+
+    multi1d<LatticeFermionF> psi_f(n_shift);
+    MInvCG2(MF, chi_f, psi_f, shifts_f, rsd_f, MaxCG, n_count);
+
+    if (psi.size() < n_shift) {
+      psi.resize(n_shift);
+    }
+
+    // Refine every shift
+    Double chi_norm = sqrt(norm2(chi, sub));
+    LatticeFermion r, e, Mp, MMp;
+    LatticeFermionF r_f;
+    multi1d<LatticeFermionF> e_f(1);
+    multi1d<RealF> shift_f(1), rsdi_f(1);
+    rsdi_f[0] = RsdInner;
+
+    for(int s = 0; s < n_shift; ++s) 
+    {
+      psi[s][sub] = psi_f[s];
+      shift_f[0] = shifts_f[s];
+
+      for(int refine = 0; ; ++refine)
+      {
+	M(Mp, psi[s], PLUS);
+	M(MMp, Mp, MINUS);
+	MMp[sub] += shifts[s]*psi[s];
+	r[sub] = chi - MMp;
+
+	Double rnorm = sqrt(norm2(r, sub));
+	if (toBool(rnorm <= RsdCG[s]*chi_norm))
+	  break;
+
+	if (refine == MaxRefine) 
+	{
+	  QDPIO::cerr << "MInvCG2Refine: shift " << s << " not refined after " << MaxRefine 
+		      << " steps, || r || / || chi || = " << rnorm/chi_norm << std::endl;
+	  break;
+	}
+
+	int n;
+	r_f[sub] = r;
+	MInvCG2(MF, r_f, e_f, shift_f, rsdi_f, MaxCG, n);
+	n_count += n;
+
+	e[sub] = e_f[0];
+	psi[s][sub] += e;
+      }
+    }
+
+    QDPIO::cout << "MInvCG2Refine: " << n_count << " single precision iterations" << std::endl;
+
+    END_CODE();
+  }
+
 }  // end namespace Chroma
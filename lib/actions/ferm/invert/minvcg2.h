@@ -66,6 +66,23 @@ namespace Chroma
 	      int MaxCG,
 	      int &n_count);
 
+  /*! \ingroup invert
+   *
+   * Multishift CG on a single precision copy MF of M to the residuals
+   * max(RsdCG, RsdInner), then every shift is refined in the precision of
+   * M by single shift CG on MF until its true residual reaches RsdCG.
+   * n_count counts the single precision iterations.
+   */
+  void MInvCG2Refine(const LinearOperator<LatticeFermion>& M,
+		     const LinearOperator<LatticeFermionF>& MF,
+		     const LatticeFermion& chi, 
+		     multi1d<LatticeFermion>& psi,
+		     const multi1d<Real>& shifts, 
+		     const multi1d<Real>& RsdCG,
+		     const Real& RsdInner,
+		     int MaxCG,
+		     int &n_count);
+
 }  // end namespace Chroma
 
 
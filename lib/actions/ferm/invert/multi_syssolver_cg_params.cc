@@ -14,6 +14,10 @@ namespace Chroma
 
     read(paramtop, "RsdCG", param.RsdCG);
     read(paramtop, "MaxCG", param.MaxCG);
+
+    param.RsdCGInner = zero;
+    if (paramtop.count("RsdCGInner") != 0)
+      read(paramtop, "RsdCGInner", param.RsdCGInner);
   }
 
   // Writer parameters
@@ -26,6 +30,8 @@ namespace Chroma
     write(xml, "invType", "CG_INVERTER");
     write(xml, "RsdCG", param.RsdCG);
     write(xml, "MaxCG", param.MaxCG);
+    if (toBool(param.RsdCGInner > Real(0)))
+      write(xml, "RsdCGInner", param.RsdCGInner);
 
     pop(xml);
   }
@@ -35,6 +41,7 @@ namespace Chroma
   {
     RsdCG = zero;
     MaxCG = 0;
+    RsdCGInner = zero;
   }
 
   //! Read parameters
@@ -21,6 +21,7 @@ namespace Chroma
     
     multi1d<Real> RsdCG;           /*!< CG residuals */
     int           MaxCG;           /*!< Maximum CG iterations */
+    Real          RsdCGInner;      /*!< If positive, single precision CG to this residual, then refinement */
   };
 
 
@@ -16,10 +16,15 @@ namespace Chroma
     //! Callback function
     MdagMMultiSystemSolver<LatticeFermion>* createFerm(XMLReader& xml_in,
 						       const std::string& path,
-						       Handle< FermState< LatticeFermion, multi1d<LatticeColorMatrix>, multi1d<LatticeColorMatrix> > >,
+						       Handle< FermState< LatticeFermion, multi1d<LatticeColorMatrix>, multi1d<LatticeColorMatrix> > > state,
 						       Handle< LinearOperator<LatticeFermion> > A)
     {
-      return new MdagMMultiSysSolverCG<LatticeFermion>(A, MultiSysSolverCGParams(xml_in, path));
+      MultiSysSolverCGParams params(xml_in, path);
+
+      if (toBool(params.RsdCGInner > Real(0)))
+	return new MdagMMultiSysSolverCGMixed(A, state, params);
+
+      return new MdagMMultiSysSolverCG<LatticeFermion>(A, params);
     }
 
     //! Name to be used
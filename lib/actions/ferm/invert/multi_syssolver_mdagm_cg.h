@@ -7,12 +7,14 @@
 #define __multi_syssolver_mdagm_cg_h__
 
 #include "handle.h"
+#include "state.h"
 #include "syssolver.h"
 #include "linearop.h"
 #include "actions/ferm/invert/multi_syssolver_mdagm.h"
 #include "actions/ferm/invert/multi_syssolver_cg_params.h"
 #include "actions/ferm/invert/minvcg.h"
 #include "actions/ferm/invert/minvcg2.h"
+#include "actions/ferm/linop/single_prec_wilsonlike_linop_w.h"
 #include "init/chroma_init.h"
 
 namespace Chroma
@@ -112,6 +114,80 @@ namespace Chroma
   };
 
 
+
+  //! Solve a CG2 system in single precision with refinement of every shift
+  /*! \ingroup invert
+   *
+   * Used by CG_INVERTER when RsdCGInner is given. The operator is copied
+   * to single precision by SinglePrecWilsonLikeLinOp.
+   */
+  class MdagMMultiSysSolverCGMixed : public MdagMMultiSystemSolver<LatticeFermion>
+  {
+  public:
+    typedef LatticeFermion T;
+    typedef multi1d<LatticeColorMatrix> Q;
+
+    //! Constructor
+    /*!
+     * \param A_        Linear operator ( Read )
+     * \param state_    Fermion state ( Read )
+     * \param invParam  inverter parameters ( Read )
+     */
+    MdagMMultiSysSolverCGMixed(Handle< LinearOperator<T> > A_,
+			       Handle< FermState<T,Q,Q> > state_,
+			       const MultiSysSolverCGParams& invParam_) : 
+      A(A_), invParam(invParam_),
+      M_single(new SinglePrecWilsonLikeLinOp(*A_, state_->getLinks()))
+      {}
+
+    //! Destructor is automatic
+    ~MdagMMultiSysSolverCGMixed() {}
+
+    //! Return the subset on which the operator acts
+    const Subset& subset() const {return A->subset();}
+
+    //! Solver the linear system
+    /*!
+     * \param psi      solution ( Modify )
+     * \param chi      source ( Read )
+     * \return syssolver results
+     */
+    SystemSolverResults_t operator() (multi1d<T>& psi, const multi1d<Real>& shifts, const T& chi) const
+      {
+	START_CODE();
+
+	multi1d<Real> RsdCG(shifts.size());
+	if (invParam.RsdCG.size() == 1)
+	{
+	  RsdCG = invParam.RsdCG[0];
+	}
+	else if (invParam.RsdCG.size() == RsdCG.size())
+	{
+	  RsdCG = invParam.RsdCG;
+	}
+	else
+	{
+	  QDPIO::cerr << "MdagMMultiSysSolverCGMixed: shifts incompatible" << std::endl;
+	  QDP_abort(1);
+	}
+
+	SystemSolverResults_t res;
+	MInvCG2Refine(*A, *M_single, chi, psi, shifts, RsdCG, invParam.RsdCGInner, invParam.MaxCG, res.n_count);
+
+	END_CODE();
+
+	return res;
+      }
+
+  private:
+    // Hide default constructor
+    MdagMMultiSysSolverCGMixed() {}
+
+    Handle< LinearOperator<T> > A;
+    MultiSysSolverCGParams invParam;
+    Handle< LinearOperator<LatticeFermionF> > M_single;
+  };
+
 } // End namespace
 
 #endif 
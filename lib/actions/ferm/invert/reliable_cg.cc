@@ -4,10 +4,11 @@
 
 #include "chromabase.h"
 #include "actions/ferm/invert/reliable_cg.h"
+#include "actions/ferm/invert/fused_blas.h"
 
 namespace Chroma {
 
-  template<typename T, typename TF, typename RF>
+  template<typename T, typename TF>
 SystemSolverResults_t
 RelInvCG_a(const LinearOperator<T>& A,
 	   const LinearOperator<TF>& AF,
@@ -83,8 +84,7 @@ RelInvCG_a(const LinearOperator<T>& A,
       }
       else { 
 	Double beta = r_sq / c;
-	RF br = beta;
-	p[s] = r + br*p;  flopcount.addSiteFlops(4*Nc*Ns,s);
+	FusedBLAS::xpay(p, r, beta, s);  flopcount.addSiteFlops(4*Nc*Ns,s);
       }
 
       c = r_sq;
@@ -95,11 +95,9 @@ RelInvCG_a(const LinearOperator<T>& A,
       AF(mmp,mp,MINUS); 
 
       a = c/d;
-      RF ar = a;
-      x[s] += ar*p;  
-      r[s] -= ar*mmp; 
 
-      r_sq = norm2(r,s); 
+      // x += a p, r -= a mmp and |r|^2 in one pass
+      r_sq = FusedBLAS::axpyAxpyNorm(x, a, p, r, Double(-a), mmp, s);
       
       //      flopcount.addSiteFlops(4*Nc*Ns,s); <mp, mp>
       //      flopcount.addSiteFlops(4*Nc*Ns,s); x += a * p
@@ -198,7 +196,7 @@ InvCGReliable(const LinearOperator<LatticeFermionF>& A,
 	      int MaxCG)
   
 {
-  return RelInvCG_a<LatticeFermionF,LatticeFermionF, RealF>(A,A, chi, psi, RsdCG, Delta, MaxCG);
+  return RelInvCG_a<LatticeFermionF,LatticeFermionF>(A,A, chi, psi, RsdCG, Delta, MaxCG);
 }
 
   // Pure double
@@ -210,7 +208,7 @@ InvCGReliable(const LinearOperator<LatticeFermionD>& A,
 		    const Real& Delta,
 	      int MaxCG)
 {
-  return RelInvCG_a<LatticeFermionD, LatticeFermionD, RealD>(A,A, chi, psi, RsdCG, Delta, MaxCG);
+  return RelInvCG_a<LatticeFermionD, LatticeFermionD>(A,A, chi, psi, RsdCG, Delta, MaxCG);
 }
 
   // single double
@@ -223,7 +221,7 @@ InvCGReliable(const LinearOperator<LatticeFermionD>& A,
 		    const Real& Delta,
 	      int MaxCG)
 {
-  return RelInvCG_a<LatticeFermionD, LatticeFermionF, RealF>(A,AF, chi, psi, RsdCG, Delta, MaxCG);
+  return RelInvCG_a<LatticeFermionD, LatticeFermionF>(A,AF, chi, psi, RsdCG, Delta, MaxCG);
 }
 
 
@@ -0,0 +1,462 @@
+/*! \file
+ *  \brief Schwarz alternating procedure for Wilson like operators
+ */
+
+#include "actions/ferm/invert/sap_preconditioner.h"
+
+#include <map>
+#include <cmath>
+
+namespace Chroma
+{
+  typedef SAPPreconditioner::Cmplx  Cmplx;
+
+  // Anonymous namespace
+  namespace
+  {
+    //! Add -1/2 (1 + sign gamma) t to out on one site
+    inline
+    void hopTerm(Cmplx* out, const Cmplx* t, const Cmplx* g, double sign)
+    {
+      for(int s=0; s < Ns; ++s)
+	for(int a=0; a < Nc; ++a)
+	{
+	  Cmplx gt = 0;
+	  for(int sp=0; sp < Ns; ++sp)
+	    gt += g[s*Ns + sp] * t[sp*Nc + a];
+
+	  out[s*Nc + a] -= 0.5 * (t[s*Nc + a] + sign*gt);
+	}
+    }
+
+
+    //! Arguments for the block solves
+    struct SAPBlockArgs
+    {
+      const SAPPreconditioner&  sap;
+      const std::vector<int>&   list;
+      LatticeFermion&           psi;
+      const LatticeFermion&     r;
+    };
+
+    //! Solve a range of blocks of one color
+    inline
+    void sapBlockLoop(int lo, int hi, int myId, SAPBlockArgs* a)
+    {
+      for(int i=lo; i < hi; ++i)
+	a->sap.solveBlock(a->list[i], a->psi, a->r);
+    }
+  }
+
+
+  // Build the block operators
+  SAPPreconditioner::SAPPreconditioner(const LinearOperator<LatticeFermion>& A,
+				       const multi1d<LatticeColorMatrix>& u,
+				       const SysSolverSAPParams& params_) :
+    params(params_)
+  {
+    START_CODE();
+
+#ifdef QDP_IS_QDPJIT
+    QDPIO::cerr << "SAP: needs site access, not available with QDP-JIT" << std::endl;
+    QDP_abort(1);
+#endif
+
+    if (A.subset().numSiteTable() != Layout::sitesOnNode())
+    {
+      QDPIO::cerr << "SAP: the operator must act on the whole lattice, use an unpreconditioned action" << std::endl;
+      QDP_abort(1);
+    }
+
+    StopWatch swatch;
+    swatch.reset();
+    swatch.start();
+
+    makeBlocks();
+    copyLinks(u);
+    probeDiag(A);
+    check(A, u);
+
+    swatch.stop();
+    QDPIO::cout << "SAP: " << blocks.size() << " blocks on a node, setup time= "
+		<< swatch.getTimeInSeconds() << " secs" << std::endl;
+
+    END_CODE();
+  }
+
+
+  // Blocks and neighbours within the blocks
+  void SAPPreconditioner::makeBlocks()
+  {
+    const multi1d<int>& Blocking = params.Blocking;
+
+    if (Blocking.size() != Nd)
+    {
+      QDPIO::cerr << "SAP: Blocking must have " << Nd << " entries" << std::endl;
+      QDP_abort(1);
+    }
+
+    for(int mu=0; mu < Nd; ++mu)
+    {
+      if (Blocking[mu] <= 0 || Layout::subgridLattSize()[mu] % Blocking[mu] != 0)
+      {
+	QDPIO::cerr << "SAP: block size " << Blocking[mu] << " does not divide the sites on a node in direction " << mu << std::endl;
+	QDP_abort(1);
+      }
+
+      const int num = Layout::lattSize()[mu] / Blocking[mu];
+      if (num > 1 && num % 2 != 0)
+      {
+	QDPIO::cerr << "SAP: need an even number of blocks in direction " << mu << std::endl;
+	QDP_abort(1);
+      }
+    }
+
+#ifndef QDP_IS_QDPJIT
+    const int nsites = Layout::sitesOnNode();
+
+    // Local blocks in the order they are first met
+    std::map<int,int> local;
+    std::vector<int> pos(nsites);
+
+    for(int site=0; site < nsites; ++site)
+    {
+      multi1d<int> coord = Layout::siteCoords(Layout::nodeNumber(), site);
+
+      int gb = 0, parity = 0;
+      for(int mu=Nd-1; mu >= 0; --mu)
+      {
+	const int bc = coord[mu] / Blocking[mu];
+	gb = gb*(Layout::lattSize()[mu] / Blocking[mu]) + bc;
+	parity += bc;
+      }
+
+      std::map<int,int>::const_iterator it = local.find(gb);
+      int b;
+      if (it == local.end())
+      {
+	b = blocks.size();
+	local[gb] = b;
+	blocks.push_back(Block());
+	color_blocks[parity % 2].push_back(b);
+      }
+      else
+	b = it->second;
+
+      pos[site] = blocks[b].sites.size();
+      blocks[b].sites.push_back(site);
+    }
+
+    // Neighbours that stay within the block, the block faces are Dirichlet
+    for(int b=0; b < blocks.size(); ++b)
+    {
+      Block& blk = blocks[b];
+      blk.nbr.assign(blk.sites.size()*2*Nd, -1);
+
+      for(int i=0; i < blk.sites.size(); ++i)
+      {
+	multi1d<int> coord = Layout::siteCoords(Layout::nodeNumber(), blk.sites[i]);
+
+	for(int mu=0; mu < Nd; ++mu)
+	{
+	  const int x = coord[mu] % Blocking[mu];
+
+	  for(int dir=0; dir < 2; ++dir)
+	  {
+	    if ((dir == 0 && x == Blocking[mu]-1) || (dir == 1 && x == 0))
+	      continue;
+
+	    multi1d<int> nc = coord;
+	    nc[mu] += (dir == 0) ? 1 : -1;
+
+	    blk.nbr[i*2*Nd + 2*mu + dir] = pos[Layout::linearSiteIndex(nc)];
+	  }
+	}
+      }
+    }
+#endif
+  }
+
+
+  // Links and gamma matrices
+  void SAPPreconditioner::copyLinks(const multi1d<LatticeColorMatrix>& u)
+  {
+#ifndef QDP_IS_QDPJIT
+    const int nsites = Layout::sitesOnNode();
+
+    links.resize(nsites*Nd*Nc*Nc);
+    for(int site=0; site < nsites; ++site)
+      for(int mu=0; mu < Nd; ++mu)
+	for(int a=0; a < Nc; ++a)
+	  for(int b=0; b < Nc; ++b)
+	  {
+	    const RComplex<REAL>& v = u[mu].elem(site).elem().elem(a,b);
+	    links[((site*Nd + mu)*Nc + a)*Nc + b] = Cmplx(v.real(), v.imag());
+	  }
+
+    // Columns of the gamma matrices from unit spinors on the first site
+    gamma.resize(Nd*Ns*Ns);
+    for(int mu=0; mu < Nd; ++mu)
+      for(int sp=0; sp < Ns; ++sp)
+      {
+	LatticeFermion e = zero;
+	e.elem(0).elem(sp).elem(0).real() = 1;
+
+	LatticeFermion g = Gamma(1 << mu) * e;
+	for(int s=0; s < Ns; ++s)
+	{
+	  const RComplex<REAL>& v = g.elem(0).elem(s).elem(0);
+	  gamma[(mu*Ns + s)*Ns + sp] = Cmplx(v.real(), v.imag());
+	}
+      }
+#endif
+  }
+
+
+  // Site diagonal part of A
+  void SAPPreconditioner::probeDiag(const LinearOperator<LatticeFermion>& A)
+  {
+    START_CODE();
+
+#ifndef QDP_IS_QDPJIT
+    const int n = Ns*Nc;
+    diag.resize(Layout::sitesOnNode()*n*n);
+
+    // Unit vectors on one checkerboard see only the diagonal there
+    LatticeFermion y, r;
+    for(int cb=0; cb < 2; ++cb)
+    {
+      const multi1d<int>& tab = rb[cb].siteTable();
+
+      for(int k=0; k < n; ++k)
+      {
+	y = zero;
+	for(int j=0; j < tab.size(); ++j)
+	  y.elem(tab[j]).elem(k / Nc).elem(k % Nc).real() = 1;
+
+	A(r, y, PLUS);
+
+	for(int j=0; j < tab.size(); ++j)
+	{
+	  const int site = tab[j];
+	  for(int row=0; row < n; ++row)
+	  {
+	    const RComplex<REAL>& v = r.elem(site).elem(row / Nc).elem(row % Nc);
+	    diag[(site*n + row)*n + k] = Cmplx(v.real(), v.imag());
+	  }
+	}
+      }
+    }
+#endif
+
+    END_CODE();
+  }
+
+
+  // Compare A with the diagonal and hopping terms
+  void SAPPreconditioner::check(const LinearOperator<LatticeFermion>& A,
+				const multi1d<LatticeColorMatrix>& u) const
+  {
+    START_CODE();
+
+#ifndef QDP_IS_QDPJIT
+    const int n = Ns*Nc;
+
+    // Save current seed
+    Seed ran_seed;
+    QDP::RNG::savern(ran_seed);
+
+    LatticeFermion x;
+    gaussian(x);
+
+    // Reset the seed
+    QDP::RNG::setrn(ran_seed);
+
+    LatticeFermion Ax, model;
+    A(Ax, x, PLUS);
+
+    for(int site=0; site < Layout::sitesOnNode(); ++site)
+      for(int row=0; row < n; ++row)
+      {
+	Cmplx sum = 0;
+	for(int col=0; col < n; ++col)
+	{
+	  const RComplex<REAL>& v = x.elem(site).elem(col / Nc).elem(col % Nc);
+	  sum += diag[(site*n + row)*n + col] * Cmplx(v.real(), v.imag());
+	}
+
+	model.elem(site).elem(row / Nc).elem(row % Nc).real() = sum.real();
+	model.elem(site).elem(row / Nc).elem(row % Nc).imag() = sum.imag();
+      }
+
+    for(int mu=0; mu < Nd; ++mu)
+    {
+      LatticeFermion fw = u[mu] * shift(x, FORWARD, mu);
+      LatticeFermion bw = shift(adj(u[mu]) * x, BACKWARD, mu);
+      LatticeFermion hop = fw + bw + Gamma(1 << mu) * (bw - fw);
+
+      model -= Real(0.5) * hop;
+    }
+
+    const double diff = toDouble(norm2(Ax - model));
+    const double ref  = toDouble(norm2(Ax));
+
+    if (diff > 1.0e-6 * ref)
+    {
+      QDPIO::cerr << "SAP: the hopping term does not match the operator, relative difference= "
+		  << std::sqrt(diff / ref) << std::endl;
+      QDPIO::cerr << "SAP: only isotropic Wilson type operators on the whole lattice are supported" << std::endl;
+      QDP_abort(1);
+    }
+#endif
+
+    END_CODE();
+  }
+
+
+  // Block operator on the sites of a block
+  void SAPPreconditioner::applyBlock(int b, const Cmplx* in, Cmplx* out) const
+  {
+    const int n = Ns*Nc;
+    const Block& blk = blocks[b];
+    Cmplx t[Ns*Nc];
+
+    for(int i=0; i < blk.sites.size(); ++i)
+    {
+      const int site = blk.sites[i];
+      Cmplx* o = out + i*n;
+
+      const Cmplx* d = &diag[site*n*n];
+      for(int row=0; row < n; ++row)
+      {
+	Cmplx sum = 0;
+	for(int col=0; col < n; ++col)
+	  sum += d[row*n + col] * in[i*n + col];
+	o[row] = sum;
+      }
+
+      for(int mu=0; mu < Nd; ++mu)
+      {
+	const Cmplx* g = &gamma[mu*Ns*Ns];
+
+	// Forward: (1 - gamma_mu) U_mu(x) psi(x+mu)
+	int j = blk.nbr[i*2*Nd + 2*mu];
+	if (j >= 0)
+	{
+	  const Cmplx* U = &links[(site*Nd + mu)*Nc*Nc];
+	  for(int s=0; s < Ns; ++s)
+	    for(int a=0; a < Nc; ++a)
+	    {
+	      Cmplx sum = 0;
+	      for(int c=0; c < Nc; ++c)
+		sum += U[a*Nc + c] * in[j*n + s*Nc + c];
+	      t[s*Nc + a] = sum;
+	    }
+
+	  hopTerm(o, t, g, -1.0);
+	}
+
+	// Backward: (1 + gamma_mu) U^dag_mu(x-mu) psi(x-mu)
+	j = blk.nbr[i*2*Nd + 2*mu + 1];
+	if (j >= 0)
+	{
+	  const Cmplx* U = &links[(blk.sites[j]*Nd + mu)*Nc*Nc];
+	  for(int s=0; s < Ns; ++s)
+	    for(int a=0; a < Nc; ++a)
+	    {
+	      Cmplx sum = 0;
+	      for(int c=0; c < Nc; ++c)
+		sum += std::conj(U[c*Nc + a]) * in[j*n + s*Nc + c];
+	      t[s*Nc + a] = sum;
+	    }
+
+	  hopTerm(o, t, g, 1.0);
+	}
+      }
+    }
+  }
+
+
+  // MR on one block
+  void SAPPreconditioner::solveBlock(int b, LatticeFermion& psi, const LatticeFermion& r) const
+  {
+#ifndef QDP_IS_QDPJIT
+    const int n = Ns*Nc;
+    const Block& blk = blocks[b];
+    const int N = blk.sites.size()*n;
+
+    std::vector<Cmplx> res(N), ares(N), e(N, Cmplx(0));
+
+    for(int i=0; i < blk.sites.size(); ++i)
+      for(int k=0; k < n; ++k)
+      {
+	const RComplex<REAL>& v = r.elem(blk.sites[i]).elem(k / Nc).elem(k % Nc);
+	res[i*n + k] = Cmplx(v.real(), v.imag());
+      }
+
+    const double over = toDouble(params.MROver);
+
+    for(int k=0; k < params.BlockMRIters; ++k)
+    {
+      applyBlock(b, &res[0], &ares[0]);
+
+      Cmplx c = 0;
+      double d = 0;
+      for(int l=0; l < N; ++l)
+      {
+	c += std::conj(ares[l]) * res[l];
+	d += std::norm(ares[l]);
+      }
+
+      if (d == 0)
+	break;
+
+      const Cmplx a = over * c / d;
+      for(int l=0; l < N; ++l)
+      {
+	e[l]   += a * res[l];
+	res[l] -= a * ares[l];
+      }
+    }
+
+    for(int i=0; i < blk.sites.size(); ++i)
+      for(int k=0; k < n; ++k)
+      {
+	RComplex<REAL>& v = psi.elem(blk.sites[i]).elem(k / Nc).elem(k % Nc);
+	v.real() += e[i*n + k].real();
+	v.imag() += e[i*n + k].imag();
+      }
+#endif
+  }
+
+
+  // Approximate psi = A^-1 chi
+  void SAPPreconditioner::operator()(const LinearOperator<LatticeFermion>& A,
+				     LatticeFermion& psi, const LatticeFermion& chi) const
+  {
+    START_CODE();
+
+    LatticeFermion r, Ar;
+    psi = zero;
+
+    for(int cycle=0; cycle < params.NCycles; ++cycle)
+    {
+      for(int color=0; color < 2; ++color)
+      {
+	if (cycle == 0 && color == 0)
+	  r = chi;
+	else
+	{
+	  A(Ar, psi, PLUS);
+	  r = chi - Ar;
+	}
+
+	SAPBlockArgs args = {*this, color_blocks[color], psi, r};
+	dispatch_to_threads(color_blocks[color].size(), args, sapBlockLoop);
+      }
+    }
+
+    END_CODE();
+  }
+
+}
@@ -0,0 +1,98 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Schwarz alternating procedure for Wilson like operators
+ */
+
+#ifndef __sap_preconditioner_h__
+#define __sap_preconditioner_h__
+
+#include "chromabase.h"
+#include "linearop.h"
+#include "actions/ferm/invert/syssolver_sap_params.h"
+
+#include <vector>
+#include <complex>
+
+namespace Chroma
+{
+
+  //! Schwarz alternating procedure
+  /*! \ingroup invert
+   *
+   * The lattice is cut into blocks colored red and black by the parity of
+   * the block coordinates. A cycle solves the system on all red blocks and
+   * then on all black blocks, each approximately by MR with Dirichlet
+   * boundaries, updating the residual with the full operator in between.
+   *
+   * The blocks must lie within a node. The block operator works on copies
+   * of the site data, so the block solves need no communication and run
+   * in a threaded loop over the blocks.
+   *
+   * The site diagonal part of the operator is probed through the
+   * LinearOperator interface, so clover and twisted mass terms are
+   * included. The hopping term is built from the links with the Wilson
+   * projectors and checked against the operator when the object is made.
+   */
+  class SAPPreconditioner
+  {
+  public:
+    //! Complex number of the block data
+    typedef std::complex<double>   Cmplx;
+
+    //! Build the block operators
+    /*!
+     * \param A       operator on the whole lattice ( Read )
+     * \param u       links with the boundary conditions applied ( Read )
+     * \param params  parameters ( Read )
+     */
+    SAPPreconditioner(const LinearOperator<LatticeFermion>& A,
+		      const multi1d<LatticeColorMatrix>& u,
+		      const SysSolverSAPParams& params);
+
+    //! Approximate psi = A^-1 chi, starting from zero
+    void operator()(const LinearOperator<LatticeFermion>& A,
+		    LatticeFermion& psi, const LatticeFermion& chi) const;
+
+    //! Block operator on the sites of a block
+    void applyBlock(int b, const Cmplx* in, Cmplx* out) const;
+
+    //! MR on one block, psi += A_b^-1 r on the block
+    void solveBlock(int b, LatticeFermion& psi, const LatticeFermion& r) const;
+
+    //! Blocks of one color on this node
+    const std::vector<int>& colorBlocks(int color) const {return color_blocks[color];}
+
+  private:
+    //! Blocks and neighbours within the blocks
+    void makeBlocks();
+
+    //! Site diagonal part of A
+    void probeDiag(const LinearOperator<LatticeFermion>& A);
+
+    //! Links and gamma matrices
+    void copyLinks(const multi1d<LatticeColorMatrix>& u);
+
+    //! Compare A with the diagonal and hopping terms
+    void check(const LinearOperator<LatticeFermion>& A,
+	       const multi1d<LatticeColorMatrix>& u) const;
+
+  private:
+    //! A block within the node
+    struct Block
+    {
+      std::vector<int>  sites;    /*!< local sites */
+      std::vector<int>  nbr;      /*!< [site][2*mu+dir], index in sites or -1 */
+    };
+
+    SysSolverSAPParams         params;
+    std::vector<Block>         blocks;
+    std::vector<int>           color_blocks[2];
+
+    std::vector<Cmplx>         diag;       /*!< [site][Ns*Nc][Ns*Nc] */
+    std::vector<Cmplx>         links;      /*!< [site][mu][Nc][Nc] */
+    std::vector<Cmplx>         gamma;      /*!< [mu][Ns][Ns] */
+  };
+
+} // End namespace
+
+#endif
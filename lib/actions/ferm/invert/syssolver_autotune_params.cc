@@ -0,0 +1,81 @@
+/*! \file
+ *  \brief Params of the autotuning solver
+ */
+
+#include "actions/ferm/invert/syssolver_autotune_params.h"
+
+namespace Chroma
+{
+
+  // Read parameters
+  void read(XMLReader& xml, const std::string& path, SysSolverAutotuneParams& p)
+  {
+    XMLReader paramtop(xml, path);
+
+    read(paramtop, "Ensemble", p.Ensemble);
+    read(paramtop, "Action", p.Action);
+    read(paramtop, "Mass", p.Mass);
+    read(paramtop, "CacheFile", p.CacheFile);
+    read(paramtop, "RsdTarget", p.RsdTarget);
+
+    if (paramtop.count("TrialSolves") != 0)
+      read(paramtop, "TrialSolves", p.TrialSolves);
+
+    if (paramtop.count("MaxTrialTime") != 0)
+      read(paramtop, "MaxTrialTime", p.MaxTrialTime);
+
+    if (paramtop.count("Retune") != 0)
+      read(paramtop, "Retune", p.Retune);
+
+    p.SearchSpace = readXMLArrayGroup(paramtop, "SearchSpace", "invType");
+
+    if (p.SearchSpace.size() == 0 || p.TrialSolves < 1)
+    {
+      QDPIO::cerr << "AUTOTUNE_INVERTER: need a SearchSpace and TrialSolves >= 1" << std::endl;
+      QDP_abort(1);
+    }
+  }
+
+  // Writer parameters
+  void write(XMLWriter& xml, const std::string& path, const SysSolverAutotuneParams& p)
+  {
+    push(xml, path);
+
+    write(xml, "invType", "AUTOTUNE_INVERTER");
+    write(xml, "Ensemble", p.Ensemble);
+    write(xml, "Action", p.Action);
+    write(xml, "Mass", p.Mass);
+    write(xml, "CacheFile", p.CacheFile);
+    write(xml, "RsdTarget", p.RsdTarget);
+    write(xml, "TrialSolves", p.TrialSolves);
+    if (toBool(p.MaxTrialTime > 0))
+      write(xml, "MaxTrialTime", p.MaxTrialTime);
+    if (p.Retune)
+      write(xml, "Retune", p.Retune);
+
+    push(xml, "SearchSpace");
+    for(int i=0; i < p.SearchSpace.size(); ++i)
+      xml << p.SearchSpace[i].xml;
+    pop(xml);
+
+    pop(xml);
+  }
+
+  //! Default parameters
+  SysSolverAutotuneParams::SysSolverAutotuneParams()
+  {
+    Mass         = zero;
+    RsdTarget    = zero;
+    TrialSolves  = 1;
+    MaxTrialTime = zero;
+    Retune       = false;
+  }
+
+  //! Read parameters
+  SysSolverAutotuneParams::SysSolverAutotuneParams(XMLReader& xml, const std::string& path)
+  {
+    *this = SysSolverAutotuneParams();
+    read(xml, path, *this);
+  }
+
+}
@@ -0,0 +1,43 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Params of the autotuning solver
+ */
+
+#ifndef __syssolver_autotune_params_h__
+#define __syssolver_autotune_params_h__
+
+#include "chromabase.h"
+#include "io/xml_group_reader.h"
+
+namespace Chroma
+{
+
+  //! Params for the autotuning solver
+  /*! \ingroup invert */
+  struct SysSolverAutotuneParams
+  {
+    SysSolverAutotuneParams();
+    SysSolverAutotuneParams(XMLReader& in, const std::string& path);
+
+    std::string          Ensemble;        /*!< Cache key: ensemble */
+    std::string          Action;          /*!< Cache key: fermion action */
+    Real                 Mass;            /*!< Cache key: quark mass */
+    std::string          CacheFile;       /*!< File holding the tuned choices */
+    Real                 RsdTarget;       /*!< Relative residual a trial solve must reach */
+    int                  TrialSolves;     /*!< Trial solves per candidate */
+    Real                 MaxTrialTime;    /*!< Stop trying candidates after this many seconds, 0 is no limit */
+    bool                 Retune;          /*!< Ignore a cached choice */
+    multi1d<GroupXML_t>  SearchSpace;     /*!< The candidate solvers */
+  };
+
+
+  // Reader/writers
+  /*! \ingroup invert */
+  void read(XMLReader& xml, const std::string& path, SysSolverAutotuneParams& param);
+
+  /*! \ingroup invert */
+  void write(XMLWriter& xml, const std::string& path, const SysSolverAutotuneParams& param);
+
+} // End namespace
+
+#endif
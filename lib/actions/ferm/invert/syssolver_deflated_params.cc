@@ -0,0 +1,64 @@
+/*! \file
+ *  \brief Params of the low mode deflated solver
+ */
+
+#include "actions/ferm/invert/syssolver_deflated_params.h"
+
+namespace Chroma
+{
+
+  // Read parameters
+  void read(XMLReader& xml, const std::string& path, SysSolverDeflatedParams& p)
+  {
+    XMLReader paramtop(xml, path);
+
+    read(paramtop, "eigen_id", p.eigen_id);
+
+    if (paramtop.count("KrylovSchurParams") != 0)
+    {
+      read(paramtop, "KrylovSchurParams", p.EigParams);
+      p.computeEvecs = true;
+    }
+
+    if (paramtop.count("CoarseCorrection") != 0)
+      read(paramtop, "CoarseCorrection", p.CoarseCorrection);
+
+    if (paramtop.count("RsdModes") != 0)
+      read(paramtop, "RsdModes", p.RsdModes);
+
+    p.InnerSolverParams = readXMLGroup(paramtop, "InnerSolverParams", "invType");
+  }
+
+  // Writer parameters
+  void write(XMLWriter& xml, const std::string& path, const SysSolverDeflatedParams& p)
+  {
+    push(xml, path);
+
+    write(xml, "invType", "DEFLATED_INVERTER");
+    write(xml, "eigen_id", p.eigen_id);
+    if (p.computeEvecs)
+      write(xml, "KrylovSchurParams", p.EigParams);
+    if (p.CoarseCorrection)
+      write(xml, "CoarseCorrection", p.CoarseCorrection);
+    write(xml, "RsdModes", p.RsdModes);
+    xml << p.InnerSolverParams.xml;
+
+    pop(xml);
+  }
+
+  //! Default parameters
+  SysSolverDeflatedParams::SysSolverDeflatedParams()
+  {
+    computeEvecs     = false;
+    CoarseCorrection = false;
+    RsdModes         = 1.0e-3;
+  }
+
+  //! Read parameters
+  SysSolverDeflatedParams::SysSolverDeflatedParams(XMLReader& xml, const std::string& path)
+  {
+    *this = SysSolverDeflatedParams();
+    read(xml, path, *this);
+  }
+
+}
@@ -0,0 +1,41 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Params of the low mode deflated solver
+ */
+
+#ifndef __syssolver_deflated_params_h__
+#define __syssolver_deflated_params_h__
+
+#include "chromabase.h"
+#include "io/xml_group_reader.h"
+#include "meas/eig/eig_krylov_schur.h"
+
+namespace Chroma
+{
+
+  //! Params for the low mode deflated solver
+  /*! \ingroup invert */
+  struct SysSolverDeflatedParams
+  {
+    SysSolverDeflatedParams();
+    SysSolverDeflatedParams(XMLReader& in, const std::string& path);
+
+    std::string          eigen_id;            /*!< Named EigenInfo with the low modes of M^dag M */
+    bool                 computeEvecs;        /*!< Compute the low modes if eigen_id is missing or stale */
+    KrylovSchurParams_t  EigParams;           /*!< Eigensolver of computeEvecs */
+    bool                 CoarseCorrection;    /*!< Correct the low modes again after the inner solve */
+    Real                 RsdModes;            /*!< Largest relative residual of modes made elsewhere */
+    GroupXML_t           InnerSolverParams;   /*!< The solver of the deflated system */
+  };
+
+
+  // Reader/writers
+  /*! \ingroup invert */
+  void read(XMLReader& xml, const std::string& path, SysSolverDeflatedParams& param);
+
+  /*! \ingroup invert */
+  void write(XMLWriter& xml, const std::string& path, const SysSolverDeflatedParams& param);
+
+} // End namespace
+
+#endif
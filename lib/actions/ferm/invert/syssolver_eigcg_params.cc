@@ -78,6 +78,10 @@ namespace Chroma
     read(paramtop, "cleanUpEvecs", param.cleanUpEvecs);
     read(paramtop, "eigen_id", param.eigen_id);
 
+    if(paramtop.count("evec_storage")!=0){
+      read(paramtop, "evec_storage", param.evec_storage);
+    }
+
     if(paramtop.count("FileIO")!=0){
       read(paramtop, "FileIO", param.file);
     }
@@ -105,6 +109,8 @@ namespace Chroma
     write(xml, "vPrecCGvecs", param.vPrecCGvecStart);
     write(xml, "cleanUpEvecs", param.cleanUpEvecs);
     write(xml, "eigen_id", param.eigen_id);
+    if(param.evec_storage != "FULL")
+      write(xml, "evec_storage", param.evec_storage);
 
     write(xml, "FileIO",param.file);
 
@@ -18,6 +18,12 @@
 #include "actions/ferm/invert/syssolver_linop_rel_ibicgstab_clover.h"
 #include "actions/ferm/invert/syssolver_linop_rel_cg_clover.h"
 #include "actions/ferm/invert/syssolver_linop_fgmres_dr.h"
+#include "actions/ferm/invert/syssolver_linop_mg_native.h"
+#include "actions/ferm/invert/syssolver_linop_sap.h"
+#include "actions/ferm/invert/syssolver_linop_mixed_prec.h"
+#include "actions/ferm/invert/syssolver_linop_deflated.h"
+#include "actions/ferm/invert/syssolver_linop_autotune.h"
+#include "actions/ferm/invert/syssolver_linop_pipe_bicgstab.h"
 
 
 #include "chroma_config.h"
@@ -31,6 +37,7 @@
 
 #include "actions/ferm/invert/syssolver_linop_cg_array.h"
 #include "actions/ferm/invert/syssolver_linop_eigcg_array.h"
+#include "actions/ferm/invert/syssolver_linop_mixed_prec_array.h"
 
 #ifdef BUILD_QOP_MG
 #include "actions/ferm/invert/qop_mg/syssolver_linop_qop_mg_w.h"
@@ -82,6 +89,12 @@ namespace Chroma
 	success &= LinOpSysSolverReliableIBiCGStabCloverEnv::registerAll();
 	success &= LinOpSysSolverReliableCGCloverEnv::registerAll();
 	success &= LinOpSysSolverFGMRESDREnv::registerAll();
+	success &= LinOpSysSolverMGNativeEnv::registerAll();
+	success &= LinOpSysSolverSAPEnv::registerAll();
+	success &= LinOpSysSolverMixedPrecEnv::registerAll();
+	success &= LinOpSysSolverPipeBiCGStabEnv::registerAll();
+	success &= LinOpSysSolverDeflatedEnv::registerAll();
+	success &= LinOpSysSolverAutotuneEnv::registerAll();
 
 #ifdef BUILD_QUDA
 	success &= LinOpSysSolverQUDACloverEnv::registerAll();
@@ -132,6 +145,7 @@ namespace Chroma
 	success &= LinOpSysSolverMDWFArrayEnv::registerAll();
 #endif
 	success &= LinOpSysSolverEigCGArrayEnv::registerAll();
+	success &= LinOpSysSolverMixedPrecArrayEnv::registerAll();
 	registered = true;
       }
       return success;
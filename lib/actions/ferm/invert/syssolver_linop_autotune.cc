@@ -0,0 +1,325 @@
+/*! \file
+ *  \brief Solve a M*psi=chi linear system with an autotuned solver
+ */
+
+#include "chromabase.h"
+#include "actions/ferm/invert/syssolver_linop_factory.h"
+#include "actions/ferm/invert/syssolver_linop_autotune.h"
+
+#include <fstream>
+
+namespace Chroma
+{
+
+  //! Autotuning system solver namespace
+  namespace LinOpSysSolverAutotuneEnv
+  {
+    //! Anonymous namespace
+    namespace
+    {
+      //! Name to be used
+      const std::string name("AUTOTUNE_INVERTER");
+
+      //! Local registration flag
+      bool registered = false;
+    }
+
+    //! Callback function
+    LinOpSystemSolver<LatticeFermion>* createFerm(XMLReader& xml_in,
+						  const std::string& path,
+						  Handle< FermState< LatticeFermion, multi1d<LatticeColorMatrix>, multi1d<LatticeColorMatrix> > > state,
+						  Handle< LinearOperator<LatticeFermion> > A)
+    {
+      return new LinOpSysSolverAutotune(A, state, SysSolverAutotuneParams(xml_in, path));
+    }
+
+    //! Register all the factories
+    bool registerAll()
+    {
+      bool success = true;
+      if (! registered)
+      {
+	success &= Chroma::TheLinOpFermSystemSolverFactory::Instance().registerObject(name, createFerm);
+	registered = true;
+      }
+      return success;
+    }
+  }
+
+
+  // Anonymous namespace
+  namespace
+  {
+    //! A tuned solver in the cache file
+    struct CacheEntry_t
+    {
+      std::string  ensemble;
+      std::string  action;
+      Real         mass;
+      Double       time;      /*!< Mean trial solve time */
+      GroupXML_t   solver;
+    };
+
+
+    //! Read one entry
+    void readEntry(XMLReader& xml, const std::string& path, CacheEntry_t& e)
+    {
+      XMLReader entrytop(xml, path);
+
+      read(entrytop, "Ensemble", e.ensemble);
+      read(entrytop, "Action", e.action);
+      read(entrytop, "Mass", e.mass);
+      read(entrytop, "Time", e.time);
+
+      XMLReader solvertop(entrytop, "Solver");
+      e.solver = readXMLGroup(solvertop, "elem", "invType");
+    }
+
+
+    //! Write one entry
+    void writeEntry(XMLWriter& xml, const std::string& path, const CacheEntry_t& e)
+    {
+      push(xml, path);
+
+      write(xml, "Ensemble", e.ensemble);
+      write(xml, "Action", e.action);
+      write(xml, "Mass", e.mass);
+      write(xml, "Time", e.time);
+
+      push(xml, "Solver");
+      xml << e.solver.xml;
+      pop(xml);
+
+      pop(xml);
+    }
+
+
+    //! Does the file exist, checked on the primary node
+    bool fileExists(const std::string& file)
+    {
+      int found = 0;
+
+      if (Layout::primaryNode())
+      {
+	std::ifstream in(file.c_str());
+	if (in.good())
+	  found = 1;
+      }
+
+      QDPInternal::broadcast(found);
+
+      return found != 0;
+    }
+
+
+    //! All the entries of the cache file, none if there is no file
+    multi1d<CacheEntry_t> readCache(const std::string& file)
+    {
+      multi1d<CacheEntry_t> entries;
+
+      if (! fileExists(file))
+	return entries;
+
+      XMLReader cache_xml(file);
+      XMLReader entriestop(cache_xml, "/AutotuneCache/Entries");
+
+      entries.resize(entriestop.count("elem"));
+      for(int i=0; i < entries.size(); ++i)
+      {
+	std::ostringstream element_xpath;
+	element_xpath << "elem[" << (i+1) << "]";
+	readEntry(entriestop, element_xpath.str(), entries[i]);
+      }
+
+      return entries;
+    }
+
+
+    //! Rewrite the cache file
+    void writeCache(const std::string& file, const multi1d<CacheEntry_t>& entries)
+    {
+      XMLFileWriter cache_xml(file);
+
+      push(cache_xml, "AutotuneCache");
+      push(cache_xml, "Entries");
+      for(int i=0; i < entries.size(); ++i)
+	writeEntry(cache_xml, "elem", entries[i]);
+      pop(cache_xml);
+      pop(cache_xml);
+
+      cache_xml.close();
+    }
+
+
+    //! Is the entry for this ensemble, action and mass
+    bool sameKey(const CacheEntry_t& e, const SysSolverAutotuneParams& p)
+    {
+      return e.ensemble == p.Ensemble && e.action == p.Action
+	&& toBool(fabs(e.mass - p.Mass) < Real(1.0e-6));
+    }
+  }
+
+
+  // Constructor
+  LinOpSysSolverAutotune::LinOpSysSolverAutotune(Handle< LinearOperator<T> > A_,
+						 Handle< FermState<T,Q,Q> > state_,
+						 const SysSolverAutotuneParams& invParam_) :
+    A(A_), invParam(invParam_)
+  {
+    START_CODE();
+
+    multi1d<CacheEntry_t> entries = readCache(invParam.CacheFile);
+
+    int found = -1;
+    for(int i=0; i < entries.size(); ++i)
+      if (sameKey(entries[i], invParam))
+	found = i;
+
+    QDPIO::cout << "AUTOTUNE_INVERTER: Ensemble= " << invParam.Ensemble
+		<< " Action= " << invParam.Action
+		<< " Mass= " << invParam.Mass << std::endl;
+
+    if (found >= 0 && ! invParam.Retune)
+    {
+      const GroupXML_t& solver = entries[found].solver;
+
+      QDPIO::cout << "AUTOTUNE_INVERTER: using the cached " << solver.id
+		  << " from " << invParam.CacheFile << std::endl;
+
+      std::istringstream is(solver.xml);
+      XMLReader paramtop(is);
+
+      DInv = TheLinOpFermSystemSolverFactory::Instance().createObject(solver.id, paramtop,
+								      solver.path,
+								      state_,
+								      A);
+    }
+    else
+    {
+      CacheEntry_t e;
+      e.ensemble = invParam.Ensemble;
+      e.action   = invParam.Action;
+      e.mass     = invParam.Mass;
+      e.solver   = tune(state_, e.time);
+
+      if (found >= 0)
+	entries[found] = e;
+      else
+      {
+	multi1d<CacheEntry_t> old = entries;
+	entries.resize(old.size()+1);
+	for(int i=0; i < old.size(); ++i)
+	  entries[i] = old[i];
+	entries[old.size()] = e;
+      }
+
+      writeCache(invParam.CacheFile, entries);
+    }
+
+    END_CODE();
+  }
+
+
+  // Time the candidates and return the fastest
+  GroupXML_t
+  LinOpSysSolverAutotune::tune(Handle< FermState<T,Q,Q> > state, Double& best_time)
+  {
+    const Subset& s = A->subset();
+
+    // The trial source does not change the random numbers of the measurement
+    Seed ran_seed;
+    RNG::savern(ran_seed);
+
+    T chi;
+    gaussian(chi);
+
+    RNG::setrn(ran_seed);
+
+    int best = -1;
+    double elapsed = 0;
+
+    for(int i=0; i < invParam.SearchSpace.size(); ++i)
+    {
+      if (best >= 0 && toBool(invParam.MaxTrialTime > 0) && toBool(elapsed > invParam.MaxTrialTime))
+      {
+	QDPIO::cout << "AUTOTUNE_INVERTER: trial time used up, skipping the last "
+		    << invParam.SearchSpace.size() - i << " candidates" << std::endl;
+	break;
+      }
+
+      const GroupXML_t& cand = invParam.SearchSpace[i];
+
+      StopWatch swatch;
+      swatch.start();
+
+      std::istringstream is(cand.xml);
+      XMLReader paramtop(is);
+
+      Handle< LinOpSystemSolver<T> > inv(TheLinOpFermSystemSolverFactory::Instance().createObject(cand.id, paramtop,
+												     cand.path,
+												     state,
+												     A));
+      swatch.stop();
+
+      // Every node must rank the candidates and stop the trials alike, so
+      // the times are those of the slowest node
+      double setup_time = swatch.getTimeInSeconds();
+      QDPInternal::globalMax(setup_time);
+
+      double solve_time = 0;
+      int n_count = 0;
+      bool converged = true;
+
+      for(int n=0; n < invParam.TrialSolves; ++n)
+      {
+	T psi = zero;
+
+	swatch.reset();
+	swatch.start();
+	SystemSolverResults_t res = (*inv)(psi, chi);
+	swatch.stop();
+
+	double t = swatch.getTimeInSeconds();
+	QDPInternal::globalMax(t);
+
+	solve_time += t;
+	n_count += res.n_count;
+
+	T r;
+	T tmp;
+	(*A)(tmp, psi, PLUS);
+	r[s] = chi - tmp;
+
+	if (toBool(sqrt(norm2(r, s)/norm2(chi, s)) > invParam.RsdTarget))
+	  converged = false;
+      }
+
+      elapsed += setup_time + solve_time;
+      solve_time /= invParam.TrialSolves;
+
+      QDPIO::cout << "AUTOTUNE_INVERTER: candidate " << i << " " << cand.id
+		  << " setup = " << setup_time << " sec, solve = " << solve_time << " sec, "
+		  << n_count / invParam.TrialSolves << " iterations"
+		  << (converged ? "" : ", missed RsdTarget") << std::endl;
+
+      if (converged && (best < 0 || solve_time < toDouble(best_time)))
+      {
+	best = i;
+	best_time = solve_time;
+	DInv = inv;
+      }
+    }
+
+    if (best < 0)
+    {
+      QDPIO::cerr << "AUTOTUNE_INVERTER: no candidate reached RsdTarget= " << invParam.RsdTarget << std::endl;
+      QDP_abort(1);
+    }
+
+    QDPIO::cout << "AUTOTUNE_INVERTER: chose candidate " << best << " " << invParam.SearchSpace[best].id
+		<< ", stored in " << invParam.CacheFile << std::endl;
+
+    return invParam.SearchSpace[best];
+  }
+
+}
@@ -0,0 +1,86 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Solve a M*psi=chi linear system with an autotuned solver
+ */
+
+#ifndef __syssolver_linop_autotune_h__
+#define __syssolver_linop_autotune_h__
+
+#include "chroma_config.h"
+#include "handle.h"
+#include "state.h"
+#include "syssolver.h"
+#include "linearop.h"
+
+#include "actions/ferm/invert/syssolver_linop.h"
+#include "actions/ferm/invert/syssolver_autotune_params.h"
+
+namespace Chroma
+{
+
+  //! Autotuning system solver namespace
+  namespace LinOpSysSolverAutotuneEnv
+  {
+    //! Register the syssolver
+    bool registerAll();
+  }
+
+
+  //! Solve a M*psi=chi linear system with an autotuned solver
+  /*! \ingroup invert
+   *
+   * The solver for (Ensemble, Action, Mass) is looked up in CacheFile.
+   * If there is none, or with Retune, every solver of the SearchSpace
+   * does TrialSolves solves of a gaussian source and the fastest one
+   * reaching RsdTarget is used and stored in CacheFile for later jobs.
+   * The time of a candidate is its mean solve time, its setup is only
+   * reported.
+   */
+  class LinOpSysSolverAutotune : public LinOpSystemSolver<LatticeFermion>
+  {
+  public:
+    using T = LatticeFermion;
+    using U = LatticeColorMatrix;
+    using Q = multi1d<U>;
+
+    //! Constructor
+    /*!
+     * \param A_        Linear operator ( Read )
+     * \param state_    Fermion state ( Read )
+     * \param invParam_ inverter parameters ( Read )
+     */
+    LinOpSysSolverAutotune(Handle< LinearOperator<T> > A_,
+			   Handle< FermState<T,Q,Q> > state_,
+			   const SysSolverAutotuneParams& invParam_);
+
+    //! Destructor is automatic
+    ~LinOpSysSolverAutotune() {}
+
+    //! Return the subset on which the operator acts
+    const Subset& subset() const {return A->subset();}
+
+    //! Solver the linear system
+    /*!
+     * \param psi      solution ( Modify )
+     * \param chi      source ( Read )
+     * \return syssolver results
+     */
+    SystemSolverResults_t operator() (T& psi, const T& chi) const {return (*DInv)(psi, chi);}
+
+  private:
+    // Hide default constructor
+    LinOpSysSolverAutotune() {}
+
+    //! Time the candidates and return the fastest
+    GroupXML_t tune(Handle< FermState<T,Q,Q> > state, Double& best_time);
+
+    Handle< LinearOperator<T> > A;
+    SysSolverAutotuneParams invParam;
+
+    // Created and initialized here.
+    Handle< LinOpSystemSolver<T> > DInv;
+  };
+
+} // End namespace
+
+#endif
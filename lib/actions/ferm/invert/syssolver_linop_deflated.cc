@@ -0,0 +1,448 @@
+/*! \file
+ *  \brief Solve a M*psi=chi linear system with low mode deflation
+ */
+
+#include "chromabase.h"
+#include "lmdagm.h"
+#include "actions/ferm/invert/syssolver_linop_factory.h"
+#include "actions/ferm/invert/syssolver_linop_deflated.h"
+#include "actions/ferm/invert/fused_blas.h"
+#include "meas/inline/io/named_objmap.h"
+#include "util/ferm/eigeninfo.h"
+
+#include <vector>
+#include <complex>
+#include <algorithm>
+
+namespace Chroma
+{
+
+  //! Low mode deflated system solver namespace
+  namespace LinOpSysSolverDeflatedEnv
+  {
+    //! Anonymous namespace
+    namespace
+    {
+      //! Name to be used
+      const std::string name("DEFLATED_INVERTER");
+
+      //! Local registration flag
+      bool registered = false;
+    }
+
+    //! Callback function
+    LinOpSystemSolver<LatticeFermion>* createFerm(XMLReader& xml_in,
+						  const std::string& path,
+						  Handle< FermState< LatticeFermion, multi1d<LatticeColorMatrix>, multi1d<LatticeColorMatrix> > > state,
+						  Handle< LinearOperator<LatticeFermion> > A)
+    {
+      return new LinOpSysSolverDeflated(A, state, SysSolverDeflatedParams(xml_in, path));
+    }
+
+    //! Register all the factories
+    bool registerAll()
+    {
+      bool success = true;
+      if (! registered)
+      {
+	success &= Chroma::TheLinOpFermSystemSolverFactory::Instance().registerObject(name, createFerm);
+	registered = true;
+      }
+      return success;
+    }
+  }
+
+
+  // Anonymous namespace
+  namespace
+  {
+    //! Values of the operator on fixed random vectors, which tell operators apart
+    /*!
+     * |M p|^2 and <q, M p> for gaussian p and q from a fixed seed. They
+     * change with the links, the action and its parameters.
+     */
+    multi1d<Double> operatorProbe(const LinearOperator<LatticeFermion>& A)
+    {
+      const Subset& s = A.subset();
+
+      // The probe does not change the random numbers of the measurement
+      Seed ran_seed;
+      RNG::savern(ran_seed);
+
+      Seed probe_seed;
+      probe_seed = 11;
+      RNG::setrn(probe_seed);
+
+      LatticeFermion p, q, t;
+      gaussian(p, s);
+      gaussian(q, s);
+
+      RNG::setrn(ran_seed);
+
+      A(t, p, PLUS);
+      DComplex qt = innerProduct(q, t, s);
+
+      multi1d<Double> f(3);
+      f[0] = norm2(t, s);
+      f[1] = real(qt);
+      f[2] = imag(qt);
+
+      return f;
+    }
+
+
+    //! Does the named space carry the probe of another operator
+    /*! \param has_probe  the space carries a probe at all ( Write ) */
+    bool otherOperator(const std::string& eigen_id, const multi1d<Double>& probe, bool& has_probe)
+    {
+      XMLReader record_xml;
+      TheNamedObjMap::Instance().get(eigen_id).getRecordXML(record_xml);
+
+      has_probe = (record_xml.count("//operator_probe") != 0);
+      if (! has_probe)
+	return false;
+
+      multi1d<Double> f;
+      read(record_xml, "//operator_probe", f);
+
+      if (f.size() != probe.size())
+	return true;
+
+      for(int k=0; k < f.size(); ++k)
+	if (toBool(fabs(f[k] - probe[k]) > Double(1.0e-10)*fabs(probe[0])))
+	  return true;
+
+      return false;
+    }
+  }
+
+
+  // Constructor
+  LinOpSysSolverDeflated::LinOpSysSolverDeflated(Handle< LinearOperator<T> > A_,
+						 Handle< FermState<T,Q,Q> > state_,
+						 const SysSolverDeflatedParams& invParam_) :
+    A(A_), invParam(invParam_)
+  {
+    START_CODE();
+
+    const multi1d<Double> probe = operatorProbe(*A);
+
+    bool make_space = ! TheNamedObjMap::Instance().check(invParam.eigen_id);
+    bool has_probe  = false;
+
+    if (! make_space && otherOperator(invParam.eigen_id, probe, has_probe))
+    {
+      if (! invParam.computeEvecs)
+      {
+	QDPIO::cerr << "DEFLATED_INVERTER: low modes in " << invParam.eigen_id
+		    << " are from another operator" << std::endl;
+	QDP_abort(1);
+      }
+
+      QDPIO::cout << "DEFLATED_INVERTER: low modes in " << invParam.eigen_id
+		  << " are from another operator, recomputing" << std::endl;
+      TheNamedObjMap::Instance().erase(invParam.eigen_id);
+      make_space = true;
+    }
+
+    if (make_space)
+      makeSpace(probe);
+
+    // A space made elsewhere is checked mode by mode
+    if (! make_space && ! has_probe)
+    {
+      QDPIO::cout << "DEFLATED_INVERTER: checking the low modes in " << invParam.eigen_id << std::endl;
+
+      if (toBool(factorGram(true) > invParam.RsdModes))
+      {
+	if (! invParam.computeEvecs)
+	{
+	  QDPIO::cerr << "DEFLATED_INVERTER: low modes in " << invParam.eigen_id
+		      << " are not eigenvectors of this M^dag M" << std::endl;
+	  QDP_abort(1);
+	}
+
+	QDPIO::cout << "DEFLATED_INVERTER: low modes in " << invParam.eigen_id
+		    << " are not eigenvectors of this M^dag M, recomputing" << std::endl;
+	TheNamedObjMap::Instance().erase(invParam.eigen_id);
+	makeSpace(probe);
+	factorGram(false);
+      }
+    }
+    else
+    {
+      factorGram(false);
+    }
+
+    std::istringstream is(invParam.InnerSolverParams.xml);
+    XMLReader paramtop(is);
+
+    DInv = TheLinOpFermSystemSolverFactory::Instance().createObject(invParam.InnerSolverParams.id, paramtop,
+								    invParam.InnerSolverParams.path,
+								    state_,
+								    A);
+
+    END_CODE();
+  }
+
+
+  // Compute the low modes into the named object
+  void
+  LinOpSysSolverDeflated::makeSpace(const multi1d<Double>& probe)
+  {
+    if (! invParam.computeEvecs)
+    {
+      QDPIO::cerr << "DEFLATED_INVERTER: no named object " << invParam.eigen_id
+		  << " and no KrylovSchurParams to compute it" << std::endl;
+      QDP_abort(1);
+    }
+
+    StopWatch swatch;
+    swatch.start();
+
+    MdagMLinOp<T> MdagM(A);
+
+    multi1d<Real> evals;
+    multi1d<T> evecs;
+    Real lambda_hi;
+    int n_matvec;
+    XMLBufferWriter eig_xml;
+
+    EigSpecKrylovSchur(MdagM, evals, evecs, invParam.EigParams, lambda_hi, n_matvec, eig_xml);
+
+    TheNamedObjMap::Instance().create< EigenInfo<T> >(invParam.eigen_id);
+    EigenInfo<T>& space = TheNamedObjMap::Instance().getData< EigenInfo<T> >(invParam.eigen_id);
+    space.getEvalues() = evals;
+    space.getEvectors() = evecs;
+    space.getLargest() = lambda_hi;
+
+    XMLBufferWriter file_xml;
+    push(file_xml, "DeflationSpace");
+    pop(file_xml);
+
+    XMLBufferWriter record_xml;
+    push(record_xml, "DeflationSpace");
+    write(record_xml, "operator_probe", probe);
+    write(record_xml, "KrylovSchurParams", invParam.EigParams);
+    pop(record_xml);
+
+    TheNamedObjMap::Instance().get(invParam.eigen_id).setFileXML(file_xml);
+    TheNamedObjMap::Instance().get(invParam.eigen_id).setRecordXML(record_xml);
+
+    swatch.stop();
+    QDPIO::cout << "DEFLATED_INVERTER: " << evals.size() << " low modes in "
+		<< n_matvec << " matvecs, time = " << swatch.getTimeInSeconds() << " sec" << std::endl;
+  }
+
+
+  // Factor the Gram matrix of M on the low modes
+  Double
+  LinOpSysSolverDeflated::factorGram(bool check)
+  {
+    const Subset& s = A->subset();
+    const multi1d<T>& V =
+      TheNamedObjMap::Instance().getData< EigenInfo<T> >(invParam.eigen_id).getEvectors();
+
+    MdagMLinOp<T> MdagM(A);
+
+    nmodes = V.size();
+    gram.assign(nmodes*nmodes, std::complex<double>(0));
+    dropped.assign(nmodes, false);
+
+    // G_ij = <M v_i, M v_j> = <v_i, M^dag M v_j>, a column per mode
+    T w;
+    std::vector<const T*> a(nmodes), b(nmodes, &w);
+    for(int i=0; i < nmodes; ++i)
+      a[i] = &V[i];
+
+    Double max_rsd = zero;
+
+    for(int j=0; j < nmodes; ++j)
+    {
+      MdagM(w, V[j], PLUS);
+
+      std::vector<DComplex> col;
+      FusedBLAS::blockDot(col, a, b, s);
+
+      for(int i=0; i < nmodes; ++i)
+	gram[i*nmodes + j] = std::complex<double>(toDouble(real(col[i])), toDouble(imag(col[i])));
+
+      // Relative residual of v_j as an eigenvector of M^dag M
+      Double ww = norm2(w, s);
+      if (check && toBool(ww > zero))
+      {
+	Complex rq = col[j] / norm2(V[j], s);
+	T r;
+	r[s] = w - rq*V[j];
+
+	Double rsd = sqrt(norm2(r, s) / ww);
+	if (toBool(rsd > max_rsd))
+	  max_rsd = rsd;
+      }
+    }
+
+    if (check)
+      QDPIO::cout << "DEFLATED_INVERTER: largest relative residual of the low modes = " << max_rsd << std::endl;
+
+    // Cholesky G = L L^dag in place, modes that are zero or linearly
+    // dependent on earlier ones are dropped
+    double max_diag = 0;
+    for(int i=0; i < nmodes; ++i)
+      max_diag = std::max(max_diag, gram[i*nmodes + i].real());
+
+    int num_dropped = 0;
+    for(int k=0; k < nmodes; ++k)
+    {
+      double d = gram[k*nmodes + k].real();
+      for(int j=0; j < k; ++j)
+	d -= std::norm(gram[k*nmodes + j]);
+
+      if (d <= 1.0e-12*max_diag)
+      {
+	dropped[k] = true;
+	++num_dropped;
+	gram[k*nmodes + k] = 1;
+	for(int i=k+1; i < nmodes; ++i)
+	  gram[i*nmodes + k] = 0;
+	continue;
+      }
+
+      const double l_kk = std::sqrt(d);
+      gram[k*nmodes + k] = l_kk;
+
+      for(int i=k+1; i < nmodes; ++i)
+      {
+	std::complex<double> g = gram[i*nmodes + k];
+	for(int j=0; j < k; ++j)
+	  g -= gram[i*nmodes + j] * std::conj(gram[k*nmodes + j]);
+
+	gram[i*nmodes + k] = g / l_kk;
+      }
+    }
+
+    if (num_dropped > 0)
+      QDPIO::cout << "DEFLATED_INVERTER: dropped " << num_dropped
+		  << " low modes that are zero or linearly dependent" << std::endl;
+
+    return max_rsd;
+  }
+
+
+  // psi += V c with c minimizing |chi - M (psi + V c)|, returns |chi - M psi|^2 before
+  Double
+  LinOpSysSolverDeflated::lowModeCorrection(T& psi, const T& chi) const
+  {
+    typedef FusedBLAS::Scalar<T>::Complex_t C;
+
+    const Subset& s = A->subset();
+    const multi1d<T>& V =
+      TheNamedObjMap::Instance().getData< EigenInfo<T> >(invParam.eigen_id).getEvectors();
+
+    T r, t;
+    (*A)(t, psi, PLUS);
+    r[s] = chi - t;
+    Double r_norm = norm2(r, s);
+    (*A)(t, r, MINUS);
+
+    // h = V^dag M^dag r
+    std::vector<const T*> a(nmodes), b(nmodes, &t);
+    for(int i=0; i < nmodes; ++i)
+      a[i] = &V[i];
+
+    std::vector<DComplex> h;
+    FusedBLAS::blockDot(h, a, b, s);
+
+    // G c = h with G = L L^dag, c = 0 for the dropped modes
+    std::vector< std::complex<double> > c(nmodes);
+    for(int k=0; k < nmodes; ++k)
+    {
+      if (dropped[k])
+	continue;
+
+      std::complex<double> y(toDouble(real(h[k])), toDouble(imag(h[k])));
+      for(int j=0; j < k; ++j)
+	y -= gram[k*nmodes + j] * c[j];
+
+      c[k] = y / gram[k*nmodes + k];
+    }
+
+    for(int k=nmodes-1; k >= 0; --k)
+    {
+      if (dropped[k])
+	continue;
+
+      std::complex<double> y = c[k];
+      for(int i=k+1; i < nmodes; ++i)
+	y -= std::conj(gram[i*nmodes + k]) * c[i];
+
+      c[k] = y / gram[k*nmodes + k];
+    }
+
+    for(int k=0; k < nmodes; ++k)
+    {
+      if (dropped[k])
+	continue;
+
+      C c_k = cmplx(Real(c[k].real()), Real(c[k].imag()));
+      psi[s] += c_k*V[k];
+    }
+
+    return r_norm;
+  }
+
+
+  // Solve with the deflated initial guess
+  SystemSolverResults_t
+  LinOpSysSolverDeflated::operator()(T& psi, const T& chi) const
+  {
+    SystemSolverResults_t res;
+
+    START_CODE();
+    StopWatch swatch;
+    swatch.start();
+
+    const Subset& s = A->subset();
+
+    lowModeCorrection(psi, chi);
+
+    res = (*DInv)(psi, chi);
+
+    // The correction is kept only if it lowers the residual, which it
+    // may not do in floating point once the inner solve has converged
+    T psi_solve;
+    Double r_solve;
+    if (invParam.CoarseCorrection)
+    {
+      psi_solve[s] = psi;
+      r_solve = lowModeCorrection(psi, chi);
+    }
+
+    {
+      T r;
+      r[s] = chi;
+      T tmp;
+      (*A)(tmp, psi, PLUS);
+      r[s] -= tmp;
+      Double r_norm = norm2(r, s);
+
+      if (invParam.CoarseCorrection && toBool(r_norm > r_solve))
+      {
+	psi[s] = psi_solve;
+	r_norm = r_solve;
+      }
+
+      res.resid = sqrt(r_norm);
+    }
+
+    swatch.stop();
+    double time = swatch.getTimeInSeconds();
+
+    QDPIO::cout << "DEFLATED_INVERTER: " << nmodes << " low modes, " << res.n_count << " iterations. Rsd = " << res.resid
+		<< " Relative Rsd = " << res.resid/sqrt(norm2(chi,s)) << std::endl;
+    QDPIO::cout << "DEFLATED_INVERTER_TIME: " << time << " sec" << std::endl;
+
+    END_CODE();
+    return res;
+  }
+
+}
@@ -0,0 +1,105 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Solve a M*psi=chi linear system with low mode deflation
+ */
+
+#ifndef __syssolver_linop_deflated_h__
+#define __syssolver_linop_deflated_h__
+
+#include "chroma_config.h"
+#include "handle.h"
+#include "state.h"
+#include "syssolver.h"
+#include "linearop.h"
+
+#include "actions/ferm/invert/syssolver_linop.h"
+#include "actions/ferm/invert/syssolver_deflated_params.h"
+
+#include <vector>
+#include <complex>
+
+namespace Chroma
+{
+
+  //! Low mode deflated system solver namespace
+  namespace LinOpSysSolverDeflatedEnv
+  {
+    //! Register the syssolver
+    bool registerAll();
+  }
+
+
+  //! Solve a M*psi=chi linear system with low mode deflation
+  /*! \ingroup invert
+   *
+   * The low modes v_i of M^dag M on the subset of M are held in the named
+   * EigenInfo eigen_id, which is shared by all the solvers of a
+   * configuration. A space made here records a probe of M, and with
+   * KrylovSchurParams it is recomputed when it was made for another
+   * operator. A space made elsewhere must have modes whose relative
+   * residual as eigenvectors of M^dag M is below RsdModes.
+   *
+   * Every solve starts from psi + V c, with c minimizing the residual
+   * |chi - M (psi + V c)|, and finishes with the inner solver.
+   * CoarseCorrection repeats the correction after it, if that lowers the
+   * residual.
+   */
+  class LinOpSysSolverDeflated : public LinOpSystemSolver<LatticeFermion>
+  {
+  public:
+    using T = LatticeFermion;
+    using U = LatticeColorMatrix;
+    using Q = multi1d<U>;
+
+    //! Constructor
+    /*!
+     * \param A_        Linear operator ( Read )
+     * \param state_    Fermion state ( Read )
+     * \param invParam_ inverter parameters ( Read )
+     */
+    LinOpSysSolverDeflated(Handle< LinearOperator<T> > A_,
+			   Handle< FermState<T,Q,Q> > state_,
+			   const SysSolverDeflatedParams& invParam_);
+
+    //! Destructor is automatic
+    ~LinOpSysSolverDeflated() {}
+
+    //! Return the subset on which the operator acts
+    const Subset& subset() const {return A->subset();}
+
+    //! Solver the linear system
+    /*!
+     * \param psi      solution ( Modify )
+     * \param chi      source ( Read )
+     * \return syssolver results
+     */
+    SystemSolverResults_t operator() (T& psi, const T& chi) const;
+
+  private:
+    // Hide default constructor
+    LinOpSysSolverDeflated() {}
+
+    //! Compute the low modes into the named object
+    void makeSpace(const multi1d<Double>& probe);
+
+    //! Factor the Gram matrix of M on the low modes
+    /*! \return largest relative residual of the modes if check, else zero */
+    Double factorGram(bool check);
+
+    //! psi += the low mode part of the solution for the residual of psi
+    /*! \return |chi - M psi|^2 before the correction */
+    Double lowModeCorrection(T& psi, const T& chi) const;
+
+    Handle< LinearOperator<T> > A;
+    SysSolverDeflatedParams invParam;
+
+    // Created and initialized here.
+    int                                  nmodes;
+    std::vector< std::complex<double> >  gram;      /*!< L of <M v_i, M v_j> = L L^dag, row major */
+    std::vector<bool>                    dropped;   /*!< zero or dependent modes */
+    Handle< LinOpSystemSolver<T> >       DInv;
+  };
+
+} // End namespace
+
+#endif
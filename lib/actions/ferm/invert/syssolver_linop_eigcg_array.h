@@ -42,8 +42,16 @@ namespace Chroma
      */
     LinOpSysSolverEigCGArray(Handle< LinearOperatorArray<T> > A_,
 			     const SysSolverEigCGParams& invParam_) : 
-      MdagM(new MdagMLinOpArray<T>(A_)), A(A_), invParam(invParam_) 
+      MdagM(new MdagMLinOpArray<T>(A_)), A(A_), invParam(invParam_)
       {
+	// The compressed deflation space exists only for the 4D solver
+	if (invParam.evec_storage != "FULL")
+	{
+	  QDPIO::cerr << "EIG_CG_INVERTER: 5D operators need evec_storage = FULL, found "
+		      << invParam.evec_storage << std::endl;
+	  QDP_abort(1);
+	}
+
 	// NEED to grab the eignvectors from the named buffer here
 	if (! TheNamedObjMap::Instance().check(invParam.eigen_id))
 	{
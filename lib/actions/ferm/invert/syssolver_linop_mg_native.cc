@@ -0,0 +1,196 @@
+/*! \file
+ *  \brief Solve a M*psi=chi linear system by FGMRES with a native multigrid preconditioner
+ */
+
+#include "chromabase.h"
+#include "actions/ferm/invert/syssolver_linop_factory.h"
+#include "actions/ferm/invert/syssolver_linop_mg_native.h"
+#include "actions/ferm/invert/syssolver_linop_fgmres_dr.h"
+#include "meas/inline/io/named_objmap.h"
+#include "util/gauge/smeared_link_cache.h"
+
+namespace Chroma
+{
+
+  //! Native multigrid system solver namespace
+  namespace LinOpSysSolverMGNativeEnv
+  {
+    //! Anonymous namespace
+    namespace
+    {
+      //! Name to be used
+      const std::string name("MG_NATIVE_INVERTER");
+
+      //! Local registration flag
+      bool registered = false;
+    }
+
+    //! Callback function
+    LinOpSystemSolver<LatticeFermion>* createFerm(XMLReader& xml_in,
+						  const std::string& path,
+						  Handle< FermState< LatticeFermion, multi1d<LatticeColorMatrix>, multi1d<LatticeColorMatrix> > > state,
+						  Handle< LinearOperator<LatticeFermion> > A)
+    {
+      return new LinOpSysSolverMGNative(A, state, SysSolverMGNativeParams(xml_in, path));
+    }
+
+    //! Register all the factories
+    bool registerAll()
+    {
+      bool success = true;
+      if (! registered)
+      {
+	success &= Chroma::TheLinOpFermSystemSolverFactory::Instance().registerObject(name, createFerm);
+	registered = true;
+      }
+      return success;
+    }
+  }
+
+
+  // The setup of this gauge field, built if needed
+  Handle<MGNativeSetup> LinOpSysSolverMGNative::getSetup() const
+  {
+    const std::string gauge_id = TheSmearedLinkCache::Instance().gaugeId(state->getLinks());
+    const std::string& id = invParam.SubspaceId;
+
+    if (TheNamedObjMap::Instance().check(id))
+    {
+      Handle<MGNativeSetup> setup = TheNamedObjMap::Instance().getData< Handle<MGNativeSetup> >(id);
+      if (setup->gaugeId() == gauge_id)
+	return setup;
+
+      QDPIO::cout << "MG_NATIVE: gauge field changed, redoing the setup " << id << std::endl;
+      TheNamedObjMap::Instance().erase(id);
+    }
+
+    QDPIO::cout << "MG_NATIVE: setup " << id << " not found, creating it" << std::endl;
+
+    Handle<MGNativeSetup> setup(new MGNativeSetup(*A, invParam, gauge_id));
+
+    XMLBufferWriter file_xml, record_xml;
+    push(file_xml, "FileXML");
+    pop(file_xml);
+    write(record_xml, "MGNativeParams", invParam);
+
+    TheNamedObjMap::Instance().create< Handle<MGNativeSetup> >(id);
+    TheNamedObjMap::Instance().get(id).setFileXML(file_xml);
+    TheNamedObjMap::Instance().get(id).setRecordXML(record_xml);
+    TheNamedObjMap::Instance().getData< Handle<MGNativeSetup> >(id) = setup;
+
+    return setup;
+  }
+
+
+  // Solve by FGMRES with the V-cycle as the preconditioner
+  SystemSolverResults_t
+  LinOpSysSolverMGNative::operator()(T& psi, const T& chi) const
+  {
+    START_CODE();
+
+    StopWatch swatch;
+    swatch.reset();
+    swatch.start();
+
+    Handle<MGNativeSetup> setup = getSetup();
+
+    const int m = invParam.NKrylov;
+    const Double target = invParam.RsdTarget * sqrt(norm2(chi));
+
+    multi1d<T> V(m+1), Z(m);
+    multi2d<DComplex> H(m, m+1);
+    multi1d< Handle<Givens> > givens_rots(m);
+    multi1d<DComplex> g(m+1), eta(m);
+
+    SystemSolverResults_t res;
+    T r, w;
+
+    (*A)(w, psi, PLUS);
+    r = chi - w;
+    Double beta = sqrt(norm2(r));
+
+    int iters = 0;
+    while (toBool(beta > target) && iters < invParam.MaxIter)
+    {
+      Double invbeta = Double(1) / beta;
+      V[0] = invbeta * r;
+      for(int i=0; i <= m; ++i)
+	g[i] = zero;
+      g[0] = beta;
+
+      int j = 0;
+      Double resid = beta;
+      while (j < m && iters < invParam.MaxIter && toBool(resid > target))
+      {
+	// Flexible Arnoldi step
+	setup->vcycle(*A, Z[j], V[j]);
+	(*A)(w, Z[j], PLUS);
+
+	for(int i=0; i <= j; ++i)
+	{
+	  H(j,i) = innerProduct(V[i], w);
+	  w -= H(j,i) * V[i];
+	}
+
+	Double wnorm = sqrt(norm2(w));
+	H(j,j+1) = DComplex(wnorm);
+	if (toBool(wnorm > Double(0)))
+	{
+	  Double invwnorm = Double(1) / wnorm;
+	  V[j+1] = invwnorm * w;
+	}
+
+	for(int i=0; i < j; ++i)
+	  (*givens_rots[i])(j,H);
+
+	givens_rots[j] = new Givens(j,H);
+	(*givens_rots[j])(j,H);
+	(*givens_rots[j])(g);
+
+	resid = sqrt(norm2(g[j+1]));
+	++j;
+	++iters;
+
+	if (invParam.Verbose)
+	  QDPIO::cout << "MG_NATIVE: iter " << iters << " || r || = " << resid << " target= " << target << std::endl;
+
+	if (toBool(wnorm == Double(0)))
+	  break;
+      }
+
+      // Least squares by back substitution
+      for(int i=j-1; i >= 0; --i)
+      {
+	eta[i] = g[i];
+	for(int l=i+1; l < j; ++l)
+	  eta[i] -= H(l,i) * eta[l];
+	eta[i] /= H(i,i);
+      }
+
+      for(int i=0; i < j; ++i)
+	psi += eta[i] * Z[i];
+
+      // True residual for the restart
+      (*A)(w, psi, PLUS);
+      r = chi - w;
+      beta = sqrt(norm2(r));
+    }
+
+    swatch.stop();
+
+    res.n_count = iters;
+    res.resid   = beta;
+
+    Double rel_resid = beta / sqrt(norm2(chi));
+    QDPIO::cout << "MG_NATIVE_INVERTER: iters = " << iters << " rel resid = " << rel_resid
+		<< " time= " << swatch.getTimeInSeconds() << " secs" << std::endl;
+
+    if (iters >= invParam.MaxIter && toBool(beta > target))
+      QDPIO::cerr << "MG_NATIVE_INVERTER: not converged after " << iters << " iterations" << std::endl;
+
+    END_CODE();
+
+    return res;
+  }
+
+}
@@ -0,0 +1,84 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Solve a M*psi=chi linear system by FGMRES with a native multigrid preconditioner
+ */
+
+#ifndef __syssolver_linop_mg_native_h__
+#define __syssolver_linop_mg_native_h__
+
+#include "chroma_config.h"
+#include "handle.h"
+#include "state.h"
+#include "syssolver.h"
+#include "linearop.h"
+
+#include "actions/ferm/invert/syssolver_linop.h"
+#include "actions/ferm/invert/syssolver_mg_native_params.h"
+#include "actions/ferm/invert/mg_native_setup.h"
+
+namespace Chroma
+{
+
+  //! Native multigrid system solver namespace
+  namespace LinOpSysSolverMGNativeEnv
+  {
+    //! Register the syssolver
+    bool registerAll();
+  }
+
+
+  //! Solve a M*psi=chi linear system by FGMRES with a native multigrid preconditioner
+  /*! \ingroup invert
+   *
+   * Needs no external library. The setup is kept in the named object
+   * SubspaceId and used again by every solver with that id, as long as the
+   * gauge field is the one it was built on.
+   */
+  class LinOpSysSolverMGNative : public LinOpSystemSolver<LatticeFermion>
+  {
+  public:
+    using T = LatticeFermion;
+    using U = LatticeColorMatrix;
+    using Q = multi1d<U>;
+
+    //! Constructor
+    /*!
+     * \param A_        Linear operator ( Read )
+     * \param state_    Fermion state ( Read )
+     * \param invParam_ inverter parameters ( Read )
+     */
+    LinOpSysSolverMGNative(Handle< LinearOperator<T> > A_,
+			   Handle< FermState<T,Q,Q> > state_,
+			   const SysSolverMGNativeParams& invParam_) :
+      A(A_), state(state_), invParam(invParam_)
+      {}
+
+    //! Destructor is automatic
+    ~LinOpSysSolverMGNative() {}
+
+    //! Return the subset on which the operator acts
+    const Subset& subset() const {return A->subset();}
+
+    //! Solver the linear system
+    /*!
+     * \param psi      solution ( Modify )
+     * \param chi      source ( Read )
+     * \return syssolver results
+     */
+    SystemSolverResults_t operator() (T& psi, const T& chi) const;
+
+  private:
+    //! The setup of this gauge field, built if needed
+    Handle<MGNativeSetup> getSetup() const;
+
+    // Hide default constructor
+    LinOpSysSolverMGNative() {}
+
+    Handle< LinearOperator<T> > A;
+    Handle< FermState<T,Q,Q> > state;
+    SysSolverMGNativeParams invParam;
+  };
+
+} // End namespace
+
+#endif
@@ -0,0 +1,162 @@
+/*! \file
+ *  \brief Solve a M*psi=chi linear system by mixed precision defect correction
+ */
+
+#include "chromabase.h"
+#include "actions/ferm/invert/syssolver_linop_factory.h"
+#include "actions/ferm/invert/syssolver_linop_mixed_prec.h"
+#include "actions/ferm/invert/inv_multiprec_richardson.h"
+#include "actions/ferm/invert/reliable_bicgstab.h"
+#include "actions/ferm/fermstates/periodic_fermstate.h"
+#include "actions/ferm/linop/single_prec_wilsonlike_linop_w.h"
+
+namespace Chroma
+{
+
+  //! Mixed precision system solver namespace
+  namespace LinOpSysSolverMixedPrecEnv
+  {
+    //! Anonymous namespace
+    namespace
+    {
+      //! Name to be used
+      const std::string name("MIXED_PRECISION_INVERTER");
+
+      //! Local registration flag
+      bool registered = false;
+    }
+
+    //! Callback function
+    LinOpSystemSolver<LatticeFermion>* createFerm(XMLReader& xml_in,
+						  const std::string& path,
+						  Handle< FermState< LatticeFermion, multi1d<LatticeColorMatrix>, multi1d<LatticeColorMatrix> > > state,
+						  Handle< LinearOperator<LatticeFermion> > A)
+    {
+      return new LinOpSysSolverMixedPrec(A, state, SysSolverMixedPrecParams(xml_in, path));
+    }
+
+    //! Register all the factories
+    bool registerAll()
+    {
+      bool success = true;
+      if (! registered)
+      {
+	success &= Chroma::TheLinOpFermSystemSolverFactory::Instance().registerObject(name, createFerm);
+	registered = true;
+      }
+      return success;
+    }
+  }
+
+
+  // Anonymous namespace
+  namespace
+  {
+    //! The operator in double precision
+    /*! A no-op conversion unless the build precision is single */
+    class DoublePrecLinOp : public LinearOperator<LatticeFermionD>
+    {
+    public:
+      DoublePrecLinOp(Handle< LinearOperator<LatticeFermion> > A_) : A(A_) {}
+
+      const Subset& subset() const {return A->subset();}
+
+      void operator() (LatticeFermionD& chi, const LatticeFermionD& psi,
+		       enum PlusMinus isign) const
+      {
+	LatticeFermion tmp1, tmp2;
+	tmp1[subset()] = psi;
+	(*A)(tmp2, tmp1, isign);
+	chi[subset()] = tmp2;
+      }
+
+    private:
+      Handle< LinearOperator<LatticeFermion> > A;
+    };
+  }
+
+
+  // Constructor
+  LinOpSysSolverMixedPrec::LinOpSysSolverMixedPrec(Handle< LinearOperator<T> > A_,
+						   Handle< FermState<T,Q,Q> > state_,
+						   const SysSolverMixedPrecParams& invParam_) :
+    A(A_), invParam(invParam_)
+  {
+    const Q& links = state_->getLinks();
+
+    QF links_single(Nd);
+    for(int mu=0; mu < Nd; mu++)
+      links_single[mu] = links[mu];
+
+    // Links hold the possibly stouted links with the BCs applied
+    fstate_single = new PeriodicFermState<TF,QF,QF>(links_single);
+
+    M_single = new SinglePrecWilsonLikeLinOp(*A, links);
+    M_double = new DoublePrecLinOp(A);
+
+    if (invParam.Correction == "RICHARDSON")
+    {
+      std::istringstream is(invParam.InnerSolverParams.xml);
+      XMLReader paramtop(is);
+
+      DInv = TheLinOpFFermSystemSolverFactory::Instance().createObject(invParam.InnerSolverParams.id, paramtop,
+								       invParam.InnerSolverParams.path,
+								       fstate_single,
+								       M_single);
+    }
+  }
+
+
+  // Solve by defect correction
+  SystemSolverResults_t
+  LinOpSysSolverMixedPrec::operator()(T& psi, const T& chi) const
+  {
+    SystemSolverResults_t res;
+
+    START_CODE();
+    StopWatch swatch;
+    swatch.start();
+
+    TD psi_d = psi;
+    TD chi_d = chi;
+
+    if (invParam.Correction == "RICHARDSON")
+      InvMultiPrecRichardson(*DInv,
+			     *M_double,
+			     chi_d,
+			     psi_d,
+			     invParam.MaxIter,
+			     invParam.RsdTarget,
+			     res);
+    else
+      res = InvBiCGStabReliable(*M_double,
+				*M_single,
+				chi_d,
+				psi_d,
+				invParam.RsdTarget,
+				invParam.Delta,
+				invParam.MaxIter,
+				PLUS);
+
+    psi = psi_d;
+
+    swatch.stop();
+    double time = swatch.getTimeInSeconds();
+
+    {
+      T r;
+      r[A->subset()] = chi;
+      T tmp;
+      (*A)(tmp, psi, PLUS);
+      r[A->subset()] -= tmp;
+      res.resid = sqrt(norm2(r, A->subset()));
+    }
+    QDPIO::cout << "MIXED_PRECISION_INVERTER: " << invParam.Correction << " " << res.n_count << " iterations. Rsd = " << res.resid
+		<< " Relative Rsd = " << res.resid/sqrt(norm2(chi,A->subset())) << std::endl;
+    QDPIO::cout << "MIXED_PRECISION_INVERTER_TIME: " << time << " sec" << std::endl;
+
+    END_CODE();
+    return res;
+  }
+
+}
@@ -0,0 +1,89 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Solve a M*psi=chi linear system by mixed precision defect correction
+ */
+
+#ifndef __syssolver_linop_mixed_prec_h__
+#define __syssolver_linop_mixed_prec_h__
+
+#include "chroma_config.h"
+#include "handle.h"
+#include "state.h"
+#include "syssolver.h"
+#include "linearop.h"
+
+#include "actions/ferm/invert/syssolver_linop.h"
+#include "actions/ferm/invert/syssolver_mixed_prec_params.h"
+
+namespace Chroma
+{
+
+  //! Mixed precision system solver namespace
+  namespace LinOpSysSolverMixedPrecEnv
+  {
+    //! Register the syssolver
+    bool registerAll();
+  }
+
+
+  //! Solve a M*psi=chi linear system by mixed precision defect correction
+  /*! \ingroup invert
+   *
+   * The operator of any Wilson like action is copied to single precision
+   * by SinglePrecWilsonLikeLinOp. With Correction RICHARDSON the inner
+   * solver from the single precision solver factory runs on the copy and
+   * the residual is corrected in double; with RELIABLE_BICGSTAB the copy
+   * is used by BiCGStab with reliable updates.
+   */
+  class LinOpSysSolverMixedPrec : public LinOpSystemSolver<LatticeFermion>
+  {
+  public:
+    using T = LatticeFermion;
+    using U = LatticeColorMatrix;
+    using Q = multi1d<U>;
+
+    using TF = LatticeFermionF;
+    using QF = multi1d<LatticeColorMatrixF>;
+    using TD = LatticeFermionD;
+
+    //! Constructor
+    /*!
+     * \param A_        Linear operator ( Read )
+     * \param state_    Fermion state ( Read )
+     * \param invParam_ inverter parameters ( Read )
+     */
+    LinOpSysSolverMixedPrec(Handle< LinearOperator<T> > A_,
+			    Handle< FermState<T,Q,Q> > state_,
+			    const SysSolverMixedPrecParams& invParam_);
+
+    //! Destructor is automatic
+    ~LinOpSysSolverMixedPrec() {}
+
+    //! Return the subset on which the operator acts
+    const Subset& subset() const {return A->subset();}
+
+    //! Solver the linear system
+    /*!
+     * \param psi      solution ( Modify )
+     * \param chi      source ( Read )
+     * \return syssolver results
+     */
+    SystemSolverResults_t operator() (T& psi, const T& chi) const;
+
+  private:
+    // Hide default constructor
+    LinOpSysSolverMixedPrec() {}
+
+    Handle< LinearOperator<T> > A;
+    SysSolverMixedPrecParams invParam;
+
+    // Created and initialized here.
+    Handle< FermState<TF,QF,QF> > fstate_single;
+    Handle< LinearOperator<TF> > M_single;
+    Handle< LinearOperator<TD> > M_double;
+    Handle< LinOpSystemSolver<TF> > DInv;
+  };
+
+} // End namespace
+
+#endif
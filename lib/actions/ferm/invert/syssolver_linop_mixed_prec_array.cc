@@ -0,0 +1,164 @@
+/*! \file
+ *  \brief Solve a M*psi=chi 5D linear system by mixed precision defect correction
+ */
+
+#include "chromabase.h"
+#include "actions/ferm/invert/syssolver_linop_factory.h"
+#include "actions/ferm/invert/syssolver_linop_mixed_prec_array.h"
+#include "actions/ferm/invert/syssolver_linop_cg_array.h"
+#include "actions/ferm/invert/inv_multiprec_richardson.h"
+#include "actions/ferm/linop/single_prec_wilsonlike_linop_w.h"
+
+namespace Chroma
+{
+
+  //! Mixed precision 5D system solver namespace
+  namespace LinOpSysSolverMixedPrecArrayEnv
+  {
+    //! Anonymous namespace
+    namespace
+    {
+      //! Name to be used
+      const std::string name("MIXED_PRECISION_INVERTER");
+
+      //! Local registration flag
+      bool registered = false;
+    }
+
+    //! Callback function
+    LinOpSystemSolverArray<LatticeFermion>* createFerm(XMLReader& xml_in,
+						       const std::string& path,
+						       Handle< FermState< LatticeFermion, multi1d<LatticeColorMatrix>, multi1d<LatticeColorMatrix> > > state,
+						       Handle< LinearOperatorArray<LatticeFermion> > A)
+    {
+      return new LinOpSysSolverMixedPrecArray(A, state, SysSolverMixedPrecParams(xml_in, path));
+    }
+
+    //! Register all the factories
+    bool registerAll()
+    {
+      bool success = true;
+      if (! registered)
+      {
+	success &= Chroma::TheLinOpFermSystemSolverArrayFactory::Instance().registerObject(name, createFerm);
+	registered = true;
+      }
+      return success;
+    }
+  }
+
+
+  // Anonymous namespace
+  namespace
+  {
+    //! The 5D operator in double precision
+    /*! A no-op conversion unless the build precision is single */
+    class DoublePrecLinOpArray : public LinearOperatorArray<LatticeFermionD>
+    {
+    public:
+      DoublePrecLinOpArray(Handle< LinearOperatorArray<LatticeFermion> > A_) : A(A_) {}
+
+      int size() const {return A->size();}
+
+      const Subset& subset() const {return A->subset();}
+
+      void operator() (multi1d<LatticeFermionD>& chi, const multi1d<LatticeFermionD>& psi,
+		       enum PlusMinus isign) const
+      {
+	multi1d<LatticeFermion> tmp1(size()), tmp2(size());
+	for(int n=0; n < size(); ++n)
+	  tmp1[n][subset()] = psi[n];
+
+	(*A)(tmp2, tmp1, isign);
+
+	chi.resize(size());
+	for(int n=0; n < size(); ++n)
+	  chi[n][subset()] = tmp2[n];
+      }
+
+    private:
+      Handle< LinearOperatorArray<LatticeFermion> > A;
+    };
+  }
+
+
+  // Constructor
+  LinOpSysSolverMixedPrecArray::LinOpSysSolverMixedPrecArray(Handle< LinearOperatorArray<T> > A_,
+							     Handle< FermState<T,Q,Q> > state_,
+							     const SysSolverMixedPrecParams& invParam_) :
+    A(A_), invParam(invParam_)
+  {
+    if (invParam.Correction != "RICHARDSON")
+    {
+      QDPIO::cerr << "MIXED_PRECISION_INVERTER: only Correction RICHARDSON is available for 5D operators" << std::endl;
+      QDP_abort(1);
+    }
+
+    std::istringstream is(invParam.InnerSolverParams.xml);
+    XMLReader paramtop(is);
+
+    // Single precision 5D solvers are not in a factory, CG is the one there is
+    if (invParam.InnerSolverParams.id != "CG_INVERTER")
+    {
+      QDPIO::cerr << "MIXED_PRECISION_INVERTER: only the CG_INVERTER inner solver is available for 5D operators, not "
+		  << invParam.InnerSolverParams.id << std::endl;
+      QDP_abort(1);
+    }
+
+    // Links hold the possibly stouted links with the BCs applied
+    M_single = new SinglePrecWilsonLikeLinOpArray(*A, state_->getLinks());
+    M_double = new DoublePrecLinOpArray(A);
+
+    DInv = new LinOpSysSolverCGArray<TF>(M_single,
+					  SysSolverCGParams(paramtop, invParam.InnerSolverParams.path));
+  }
+
+
+  // Solve by defect correction
+  SystemSolverResults_t
+  LinOpSysSolverMixedPrecArray::operator()(multi1d<T>& psi, const multi1d<T>& chi) const
+  {
+    SystemSolverResults_t res;
+
+    START_CODE();
+    StopWatch swatch;
+    swatch.start();
+
+    const int N5 = size();
+    multi1d<TD> psi_d(N5), chi_d(N5);
+    for(int n=0; n < N5; ++n)
+    {
+      psi_d[n] = psi[n];
+      chi_d[n] = chi[n];
+    }
+
+    InvMultiPrecRichardson(*DInv,
+			   *M_double,
+			   chi_d,
+			   psi_d,
+			   invParam.MaxIter,
+			   invParam.RsdTarget,
+			   res);
+
+    for(int n=0; n < N5; ++n)
+      psi[n] = psi_d[n];
+
+    swatch.stop();
+    double time = swatch.getTimeInSeconds();
+
+    {
+      multi1d<T> r(N5), tmp(N5);
+      (*A)(tmp, psi, PLUS);
+      for(int n=0; n < N5; ++n)
+	r[n][A->subset()] = chi[n] - tmp[n];
+      res.resid = sqrt(norm2(r, A->subset()));
+    }
+    QDPIO::cout << "MIXED_PRECISION_INVERTER: " << invParam.Correction << " " << res.n_count << " iterations. Rsd = " << res.resid
+		<< " Relative Rsd = " << res.resid/sqrt(norm2(chi,A->subset())) << std::endl;
+    QDPIO::cout << "MIXED_PRECISION_INVERTER_TIME: " << time << " sec" << std::endl;
+
+    END_CODE();
+    return res;
+  }
+
+}
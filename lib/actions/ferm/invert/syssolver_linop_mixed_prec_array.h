@@ -0,0 +1,88 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Solve a M*psi=chi 5D linear system by mixed precision defect correction
+ */
+
+#ifndef __syssolver_linop_mixed_prec_array_h__
+#define __syssolver_linop_mixed_prec_array_h__
+
+#include "chroma_config.h"
+#include "handle.h"
+#include "state.h"
+#include "syssolver.h"
+#include "linearop.h"
+
+#include "actions/ferm/invert/syssolver_linop.h"
+#include "actions/ferm/invert/syssolver_mixed_prec_params.h"
+
+namespace Chroma
+{
+
+  //! Mixed precision 5D system solver namespace
+  namespace LinOpSysSolverMixedPrecArrayEnv
+  {
+    //! Register the syssolver
+    bool registerAll();
+  }
+
+
+  //! Solve a M*psi=chi 5D linear system by mixed precision defect correction
+  /*! \ingroup invert
+   *
+   * The operator of a domain wall like action is copied to single
+   * precision by SinglePrecWilsonLikeLinOpArray. Only Correction RICHARDSON
+   * is available, with CG_INVERTER on the copy as the inner solver.
+   */
+  class LinOpSysSolverMixedPrecArray : public LinOpSystemSolverArray<LatticeFermion>
+  {
+  public:
+    using T = LatticeFermion;
+    using U = LatticeColorMatrix;
+    using Q = multi1d<U>;
+
+    using TF = LatticeFermionF;
+    using TD = LatticeFermionD;
+
+    //! Constructor
+    /*!
+     * \param A_        Linear operator ( Read )
+     * \param state_    Fermion state ( Read )
+     * \param invParam_ inverter parameters ( Read )
+     */
+    LinOpSysSolverMixedPrecArray(Handle< LinearOperatorArray<T> > A_,
+				 Handle< FermState<T,Q,Q> > state_,
+				 const SysSolverMixedPrecParams& invParam_);
+
+    //! Destructor is automatic
+    ~LinOpSysSolverMixedPrecArray() {}
+
+    //! Expected length of array index
+    int size() const {return A->size();}
+
+    //! Return the subset on which the operator acts
+    const Subset& subset() const {return A->subset();}
+
+    //! Solver the linear system
+    /*!
+     * \param psi      solution ( Modify )
+     * \param chi      source ( Read )
+     * \return syssolver results
+     */
+    SystemSolverResults_t operator() (multi1d<T>& psi, const multi1d<T>& chi) const;
+
+  private:
+    // Hide default constructor
+    LinOpSysSolverMixedPrecArray() {}
+
+    Handle< LinearOperatorArray<T> > A;
+    SysSolverMixedPrecParams invParam;
+
+    // Created and initialized here.
+    Handle< LinearOperatorArray<TF> > M_single;
+    Handle< LinearOperatorArray<TD> > M_double;
+    Handle< LinOpSystemSolverArray<TF> > DInv;
+  };
+
+} // End namespace
+
+#endif
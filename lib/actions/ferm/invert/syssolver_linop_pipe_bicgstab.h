@@ -0,0 +1,91 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Solve a M*psi=chi linear system by pipelined BiCGStab
+ */
+
+#ifndef __syssolver_linop_pipe_bicgstab_h__
+#define __syssolver_linop_pipe_bicgstab_h__
+
+#include "chroma_config.h"
+#include "handle.h"
+#include "syssolver.h"
+#include "linearop.h"
+#include "actions/ferm/invert/syssolver_linop.h"
+#include "actions/ferm/invert/syssolver_pipelined_params.h"
+#include "actions/ferm/invert/invpipebicgstab.h"
+
+namespace Chroma
+{
+
+  //! Pipelined BiCGStab system solver namespace
+  namespace LinOpSysSolverPipeBiCGStabEnv
+  {
+    //! Register the syssolver
+    bool registerAll();
+  }
+
+
+  //! Solve a M*psi=chi linear system by pipelined BiCGStab
+  /*! \ingroup invert
+   */
+  template<typename T>
+  class LinOpSysSolverPipeBiCGStab : public LinOpSystemSolver<T>
+  {
+  public:
+    //! Constructor
+    /*!
+     * \param A_        Linear operator ( Read )
+     * \param invParam  inverter parameters ( Read )
+     */
+    LinOpSysSolverPipeBiCGStab(Handle< LinearOperator<T> > A_,
+			       const SysSolverPipelinedParams& invParam_) : 
+      A(A_), invParam(invParam_) 
+      {}
+
+    //! Destructor is automatic
+    ~LinOpSysSolverPipeBiCGStab() {}
+
+    //! Return the subset on which the operator acts
+    const Subset& subset() const {return A->subset();}
+
+    //! Solver the linear system
+    /*!
+     * \param psi      solution ( Modify )
+     * \param chi      source ( Read )
+     * \return syssolver results
+     */
+    SystemSolverResults_t operator() (T& psi, const T& chi) const
+    {
+      START_CODE();
+      StopWatch swatch;
+      swatch.reset(); swatch.start();
+
+      SystemSolverResults_t res = InvPipeBiCGStab(*A, chi, psi, 
+						  invParam.RsdTarget, 
+						  invParam.MaxIter, 
+						  invParam.ReplaceInterval,
+						  PLUS);
+      
+      swatch.stop();
+      double time = swatch.getTimeInSeconds();
+      QDPIO::cout << "PIPE_BICGSTAB_SOLVER: " << res.n_count << " iterations. Rsd = " << res.resid << " Relative Rsd = " << res.resid/sqrt(norm2(chi,A->subset())) << std::endl;
+      QDPIO::cout << "PIPE_BICGSTAB_SOLVER_TIME: "<<time<< " sec" << std::endl;
+
+      END_CODE();
+      
+      return res;
+    }
+
+
+  private:
+    // Hide default constructor
+    LinOpSysSolverPipeBiCGStab() {}
+
+    Handle< LinearOperator<T> > A;
+    SysSolverPipelinedParams invParam;
+  };
+
+} // End namespace
+
+#endif 
+
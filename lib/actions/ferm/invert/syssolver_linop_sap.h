@@ -0,0 +1,89 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Approximate M*psi=chi by the Schwarz alternating procedure
+ */
+
+#ifndef __syssolver_linop_sap_h__
+#define __syssolver_linop_sap_h__
+
+#include "chroma_config.h"
+#include "handle.h"
+#include "state.h"
+#include "syssolver.h"
+#include "linearop.h"
+
+#include "actions/ferm/invert/syssolver_linop.h"
+#include "actions/ferm/invert/syssolver_sap_params.h"
+#include "actions/ferm/invert/sap_preconditioner.h"
+
+namespace Chroma
+{
+
+  //! SAP system solver namespace
+  namespace LinOpSysSolverSAPEnv
+  {
+    //! Register the syssolver
+    bool registerAll();
+  }
+
+
+  //! Approximate M*psi=chi by the Schwarz alternating procedure
+  /*! \ingroup invert
+   *
+   * A fixed number of cycles, meant as the preconditioner of a flexible
+   * solver such as FGMRESDR_INVERTER. The block operators are built when
+   * the solver is made.
+   */
+  class LinOpSysSolverSAP : public LinOpSystemSolver<LatticeFermion>
+  {
+  public:
+    using T = LatticeFermion;
+    using U = LatticeColorMatrix;
+    using Q = multi1d<U>;
+
+    //! Constructor
+    /*!
+     * \param A_        Linear operator ( Read )
+     * \param state_    Fermion state ( Read )
+     * \param invParam_ inverter parameters ( Read )
+     */
+    LinOpSysSolverSAP(Handle< LinearOperator<T> > A_,
+		      Handle< FermState<T,Q,Q> > state_,
+		      const SysSolverSAPParams& invParam_) :
+      A(A_), invParam(invParam_), sap(*A_, state_->getLinks(), invParam_)
+      {}
+
+    //! Destructor is automatic
+    ~LinOpSysSolverSAP() {}
+
+    //! Return the subset on which the operator acts
+    const Subset& subset() const {return A->subset();}
+
+    //! Apply the cycles
+    /*!
+     * \param psi      solution ( Write )
+     * \param chi      source ( Read )
+     * \return syssolver results, the residual is not computed
+     */
+    SystemSolverResults_t operator() (T& psi, const T& chi) const
+    {
+      START_CODE();
+
+      SystemSolverResults_t res;
+      sap(*A, psi, chi);
+      res.n_count = invParam.NCycles;
+
+      END_CODE();
+
+      return res;
+    }
+
+  private:
+    Handle< LinearOperator<T> > A;
+    SysSolverSAPParams invParam;
+    SAPPreconditioner sap;
+  };
+
+} // End namespace
+
+#endif
@@ -8,6 +8,7 @@
 #include "actions/ferm/invert/syssolver_mdagm_aggregate.h"
 
 #include "actions/ferm/invert/syssolver_mdagm_eigcg_qdp.h"
+#include "actions/ferm/invert/compressed_ritz_pairs.h"
 #include "actions/ferm/invert/inv_eigcg2.h"
 #include "actions/ferm/invert/norm_gram_schm.h"
 #include "actions/ferm/invert/invcg2.h"
@@ -229,6 +230,252 @@ namespace Chroma
       return res;
     }
 
+
+    //! Solver the linear system with a reduced precision deflation space
+    /*!
+     * Same algorithm as sysSolver, but the eigenvectors live in a
+     * CompressedRitzPairs. Deflation, Gram-Schmidt and the subspace matrix
+     * use block projections onto the whole space, and the refinement
+     * rotation is done site by site in the compressed storage.
+     *
+     * \param psi      solution ( Modify )
+     * \param chi      source ( Read )
+     * \return syssolver results
+     */
+    template<typename T>
+    SystemSolverResults_t sysSolverCompressed(T& psi, const T& chi, 
+					      const LinearOperator<T>& A,
+					      const LinearOperator<T>& MdagM, 
+					      const SysSolverEigCGParams& invParam)
+    {
+      START_CODE();
+
+      LinAlg::CompressedRitzPairs& GoodEvecs = 
+	TheNamedObjMap::Instance().getData< LinAlg::CompressedRitzPairs >(invParam.eigen_id);
+      const Subset& sub = MdagM.subset();
+
+      multi1d<Double> lambda ; //the eigenvalues
+      multi1d<T> evec(0); // The new eigenvectors  
+      SystemSolverResults_t res;  // initialized by a constructor
+      int n_CG(0);
+      int flag(-1);//first time through
+      int restart(0);
+      Real restartTol = invParam.restartTol ;
+      StopWatch snoop;
+      while((flag==-1)||flag==3){
+	flag=0 ;
+	if(invParam.PrintLevel>0)
+	  QDPIO::cout<<"GoodEvecs.Neig= "<<GoodEvecs.Neig<<std::endl;
+	if(GoodEvecs.Neig>0){//deflate if there avectors to deflate
+	  snoop.reset();
+	  snoop.start();
+
+	  // x += V Lambda^{-1} V^dag (b - A x) with one block projection
+	  T Ap, r;
+	  MdagM(Ap,psi,PLUS) ;
+	  r[sub] = chi - Ap ;
+
+	  multi1d<DComplex> d;
+	  GoodEvecs.project(d, r, GoodEvecs.Neig, sub);
+	  for(int k(0);k<GoodEvecs.Neig;k++)
+	    d[k] /= GoodEvecs.eval[k];
+	  GoodEvecs.expand(psi, d, GoodEvecs.Neig, sub);
+	  n_CG = 1;
+
+	  snoop.stop();
+	  if(invParam.PrintLevel>0)
+	    QDPIO::cout << "InitGuess:  time = "
+			<< snoop.getTimeInSeconds() 
+			<< " secs" << std::endl;
+	}
+	//if there is space for new
+	if(GoodEvecs.Neig<GoodEvecs.size())
+	  {
+	    evec.resize(0);//get in there with no evecs so that it computes new
+	    res = InvEigCG2Env::InvEigCG2(MdagM, psi, chi, lambda, evec, 
+					  invParam.Neig, invParam.Nmax, 
+					  invParam.RsdCG, invParam.MaxCG,
+					  invParam.PrintLevel);
+	    res.n_count += n_CG ;
+
+	    snoop.reset();
+	    snoop.start();
+
+	    // Orthonormalize the new vectors against the stored ones (twice)
+	    // and add them, as far as they fit
+	    int Nold = GoodEvecs.Neig;
+	    int Nadd = std::min(int(evec.size()), GoodEvecs.size()-Nold);
+	    for(int i(0);i<Nadd;i++){
+	      for(int pass(0);pass<2;pass++){
+		multi1d<DComplex> c;
+		GoodEvecs.project(c, evec[i], Nold+i, sub);
+		for(int k(0);k<c.size();k++)
+		  c[k] = -c[k];
+		GoodEvecs.expand(evec[i], c, Nold+i, sub);
+	      }
+	      evec[i][sub] *= Real(1.0/sqrt(norm2(evec[i],sub)));
+
+	      GoodEvecs.setVector(Nold+i, evec[i], sub);
+	      GoodEvecs.eval[Nold+i] = lambda[i];
+	    }
+	    GoodEvecs.Neig = Nold+Nadd;
+
+	    // Subspace matrix, only the new columns need the operator
+	    LinAlg::Matrix<DComplex> Htmp(GoodEvecs.Neig) ;
+	    Htmp.N = GoodEvecs.Neig;
+	    Htmp.mat = 0.0;
+	    for(int i(0);i<Nold;i++)
+	      Htmp(i,i) = GoodEvecs.eval[i];
+
+	    T v, Av;
+	    for(int i(Nold);i<GoodEvecs.Neig;i++){
+	      GoodEvecs.getVector(v, i, sub);
+	      MdagM(Av,v,PLUS) ;
+
+	      multi1d<DComplex> col;
+	      GoodEvecs.project(col, Av, GoodEvecs.Neig, sub);
+	      for(int j(0);j<GoodEvecs.Neig;j++){
+		Htmp(j,i) = col[j];
+		//enforce hermiticity
+		Htmp(i,j) = conj(Htmp(j,i));
+		if(i==j) Htmp(i,j) = real(Htmp(i,j));
+	      }
+	    }
+
+	    char V = 'V' ; char U = 'U' ;
+	    QDPLapack::zheev(V,U,Htmp.mat,lambda);
+
+	    multi2d<DComplex> Urot(GoodEvecs.Neig,GoodEvecs.Neig);
+	    for(int k(0);k<GoodEvecs.Neig;k++){
+	      GoodEvecs.eval[k] = lambda[k];
+	      for(int j(0);j<GoodEvecs.Neig;j++)
+		Urot(k,j) = conj(Htmp(k,j));
+	    }
+	    GoodEvecs.rotate(Urot, GoodEvecs.Neig, sub);
+
+	    snoop.stop();
+	    if(invParam.PrintLevel>0){
+	      QDPIO::cout << "Evec_Refinement: time = "
+			  << snoop.getTimeInSeconds()
+			  << " secs" << std::endl;
+	    }
+	  
+	    //Check the quality of eigenvectors
+	    if(invParam.PrintLevel>4){
+	      for(int k(0);k<GoodEvecs.Neig;k++){
+		GoodEvecs.getVector(v, k, sub);
+		MdagM(Av,v,PLUS) ;
+		DComplex rq = innerProduct(v,Av,sub);
+		Av[sub] -= GoodEvecs.eval[k]*v ;
+		Double tt = sqrt(norm2(Av,sub));
+		QDPIO::cout<<"REFINE: error evec["<<k<<"] = "<<tt<<" " ;
+		QDPIO::cout<<"--- eval ="<<GoodEvecs.eval[k]<<" ";
+		tt =  sqrt(norm2(v,sub));
+		QDPIO::cout<<"--- rq ="<<real(rq)<<" ";
+		QDPIO::cout<<"--- norm = "<<tt<<std::endl  ;
+	      } 
+	    }
+	  }// if there is space
+	else // call CG but ask it not to compute vectors
+	  {
+	    evec.resize(0);
+	    n_CG = res.n_count ;
+	    if(invParam.PrintLevel<2)// Call the CHROMA CG 
+	      res = InvCG2(A, chi, psi, restartTol, invParam.MaxCG);
+	    else
+	      res = InvEigCG2Env::InvEigCG2(MdagM, 
+					    psi,
+					    chi,
+					    lambda, 
+					    evec, 
+					    0, //Eigenvectors to keep
+					    invParam.Nmax,  // Max vectors to work with
+					    restartTol, // CG residual...
+					    invParam.MaxCG, // Max CG itterations
+					    invParam.PrintLevel
+					    );
+	    res.n_count += n_CG ;
+	    if(toBool(restartTol!=invParam.RsdCG)){
+	      restart++;//count the number of restarts
+	      if(invParam.PrintLevel>0)
+		QDPIO::cout<<"Restart: "<<restart<<std::endl ;
+	      flag=3 ; //restart
+	    }
+	    else{
+	      flag=0; //stop restarting
+	    }
+	    restartTol *=restartTol ;
+	    if(toBool(restartTol < invParam.RsdCG)){
+	      restartTol = invParam.RsdCG;
+	    }
+	  }
+      }//while
+
+      END_CODE();
+
+      return res;
+    }
+
+
+    //! Create the named buffer of eigenvectors
+    template<typename T>
+    void createEvecs(const SysSolverEigCGParams& invParam)
+    {
+      int Nmax = (invParam.Neig_max>0) ? invParam.Neig_max : invParam.Neig;
+
+      if (invParam.evec_storage == "FULL")
+      {
+	TheNamedObjMap::Instance().create< LinAlg::RitzPairs<T> >(invParam.eigen_id);
+	LinAlg::RitzPairs<T>& GoodEvecs = 
+	  TheNamedObjMap::Instance().getData< LinAlg::RitzPairs<T> >(invParam.eigen_id);
+
+	if (invParam.file.read)
+	  LinAlg::readRitzPairs(GoodEvecs, Nmax, invParam.file.file_name);
+	else
+	  GoodEvecs.init(Nmax);
+	return;
+      }
+
+      LinAlg::CompressedRitzPairs::Storage_t storage;
+      if (invParam.evec_storage == "SINGLE")
+	storage = LinAlg::CompressedRitzPairs::SINGLE;
+      else if (invParam.evec_storage == "HALF")
+	storage = LinAlg::CompressedRitzPairs::HALF;
+      else
+      {
+	QDPIO::cerr << __func__ << ": unknown evec_storage = " << invParam.evec_storage
+		    << ", expected FULL, SINGLE or HALF" << std::endl;
+	QDP_abort(1);
+      }
+
+      if (invParam.vPrecCGvecs > 0)
+      {
+	QDPIO::cerr << __func__ << ": vPrecCG needs evec_storage = FULL" << std::endl;
+	QDP_abort(1);
+      }
+
+      TheNamedObjMap::Instance().create< LinAlg::CompressedRitzPairs >(invParam.eigen_id);
+      LinAlg::CompressedRitzPairs& GoodEvecs = 
+	TheNamedObjMap::Instance().getData< LinAlg::CompressedRitzPairs >(invParam.eigen_id);
+
+      GoodEvecs.init(Nmax, storage);
+      if (invParam.file.read)
+	LinAlg::readRitzPairs(GoodEvecs, invParam.file.file_name);
+    }
+
+
+    //! Write the named buffer of eigenvectors
+    template<typename T>
+    void writeEvecs(const SysSolverEigCGParams& invParam)
+    {
+      if (invParam.evec_storage == "FULL")
+	LinAlg::writeRitzPairs(TheNamedObjMap::Instance().getData< LinAlg::RitzPairs<T> >(invParam.eigen_id),
+			       invParam.file.file_name, invParam.file.file_volfmt);
+      else
+	LinAlg::writeRitzPairs(TheNamedObjMap::Instance().getData< LinAlg::CompressedRitzPairs >(invParam.eigen_id),
+			       invParam.file.file_name, invParam.file.file_volfmt);
+    }
+
   } // anonymous namespace
 
 
@@ -241,7 +488,24 @@ namespace Chroma
   SystemSolverResults_t
   MdagMSysSolverQDPEigCG<LatticeFermionF>::operator()(LatticeFermionF& psi, const LatticeFermionF& chi) const
   {
-    return sysSolver(psi, chi, *A, *MdagM, invParam);
+    if (invParam.evec_storage == "FULL")
+      return sysSolver(psi, chi, *A, *MdagM, invParam);
+    else
+      return sysSolverCompressed(psi, chi, *A, *MdagM, invParam);
+  }
+
+  template<>
+  void
+  MdagMSysSolverQDPEigCG<LatticeFermionF>::createEvecs() const
+  {
+    Chroma::createEvecs<LatticeFermionF>(invParam);
+  }
+
+  template<>
+  void
+  MdagMSysSolverQDPEigCG<LatticeFermionF>::writeEvecs() const
+  {
+    Chroma::writeEvecs<LatticeFermionF>(invParam);
   }
 
   // LatticeFermionD
@@ -249,7 +513,24 @@ namespace Chroma
   SystemSolverResults_t
   MdagMSysSolverQDPEigCG<LatticeFermionD>::operator()(LatticeFermionD& psi, const LatticeFermionD& chi) const
   {
-    return sysSolver(psi, chi, *A, *MdagM, invParam);
+    if (invParam.evec_storage == "FULL")
+      return sysSolver(psi, chi, *A, *MdagM, invParam);
+    else
+      return sysSolverCompressed(psi, chi, *A, *MdagM, invParam);
+  }
+
+  template<>
+  void
+  MdagMSysSolverQDPEigCG<LatticeFermionD>::createEvecs() const
+  {
+    Chroma::createEvecs<LatticeFermionD>(invParam);
+  }
+
+  template<>
+  void
+  MdagMSysSolverQDPEigCG<LatticeFermionD>::writeEvecs() const
+  {
+    Chroma::writeEvecs<LatticeFermionD>(invParam);
   }
 
 #if 0
@@ -47,22 +47,18 @@ namespace Chroma
 	// NEED to grab the eignvectors from the named buffer here
 	if (! TheNamedObjMap::Instance().check(invParam.eigen_id))
 	{
-	  TheNamedObjMap::Instance().create< LinAlg::RitzPairs<T> >(invParam.eigen_id);
-	  LinAlg::RitzPairs<T>& GoodEvecs = 
-	    TheNamedObjMap::Instance().getData< LinAlg::RitzPairs<T> >(invParam.eigen_id);
-
-	  if(invParam.Neig_max>0 ){
-	    GoodEvecs.init(invParam.Neig_max);
-	  }
-	  else{
-	    GoodEvecs.init(invParam.Neig);
-	  }
+	  createEvecs();
 	}
       }
 
-    //! Destructor is automatic
+    //! Destructor saves the eigenvectors if requested
     ~MdagMSysSolverQDPEigCG()
       {
+	if (invParam.file.write)
+	{
+	  writeEvecs();
+	}
+
 	if (invParam.cleanUpEvecs)
 	{
 	  TheNamedObjMap::Instance().erase(invParam.eigen_id);
@@ -116,6 +112,12 @@ namespace Chroma
     // Hide default constructor
     MdagMSysSolverQDPEigCG() {}
 
+    //! Create the named buffer of eigenvectors, reading it from file if requested
+    void createEvecs() const;
+
+    //! Write the named buffer of eigenvectors
+    void writeEvecs() const;
+
     Handle< LinearOperator<T> > MdagM;
     Handle< LinearOperator<T> > A;
     SysSolverEigCGParams invParam;
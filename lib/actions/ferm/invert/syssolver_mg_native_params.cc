@@ -0,0 +1,97 @@
+/*! \file
+ *  \brief Params of the native aggregation based multigrid solver
+ */
+
+#include "actions/ferm/invert/syssolver_mg_native_params.h"
+
+namespace Chroma
+{
+
+  // Read parameters
+  void read(XMLReader& xml, const std::string& path, SysSolverMGNativeParams& p)
+  {
+    XMLReader paramtop(xml, path);
+
+    read(paramtop, "SubspaceId", p.SubspaceId);
+    read(paramtop, "RsdTarget", p.RsdTarget);
+    read(paramtop, "MaxIter", p.MaxIter);
+    read(paramtop, "Blocking", p.Blocking);
+    read(paramtop, "NumNullVecs", p.NumNullVecs);
+
+    if (paramtop.count("NKrylov") != 0)
+      read(paramtop, "NKrylov", p.NKrylov);
+
+    if (paramtop.count("NullSetupIters") != 0)
+      read(paramtop, "NullSetupIters", p.NullSetupIters);
+
+    if (paramtop.count("SmootherPreIters") != 0)
+      read(paramtop, "SmootherPreIters", p.SmootherPreIters);
+
+    if (paramtop.count("SmootherPostIters") != 0)
+      read(paramtop, "SmootherPostIters", p.SmootherPostIters);
+
+    if (paramtop.count("SmootherMROver") != 0)
+      read(paramtop, "SmootherMROver", p.SmootherMROver);
+
+    if (paramtop.count("CoarseRsdTarget") != 0)
+      read(paramtop, "CoarseRsdTarget", p.CoarseRsdTarget);
+
+    if (paramtop.count("CoarseNKrylov") != 0)
+      read(paramtop, "CoarseNKrylov", p.CoarseNKrylov);
+
+    if (paramtop.count("CoarseMaxIter") != 0)
+      read(paramtop, "CoarseMaxIter", p.CoarseMaxIter);
+
+    if (paramtop.count("Verbose") != 0)
+      read(paramtop, "Verbose", p.Verbose);
+  }
+
+  // Writer parameters
+  void write(XMLWriter& xml, const std::string& path, const SysSolverMGNativeParams& p)
+  {
+    push(xml, path);
+
+    write(xml, "invType", "MG_NATIVE_INVERTER");
+    write(xml, "SubspaceId", p.SubspaceId);
+    write(xml, "RsdTarget", p.RsdTarget);
+    write(xml, "NKrylov", p.NKrylov);
+    write(xml, "MaxIter", p.MaxIter);
+    write(xml, "Blocking", p.Blocking);
+    write(xml, "NumNullVecs", p.NumNullVecs);
+    write(xml, "NullSetupIters", p.NullSetupIters);
+    write(xml, "SmootherPreIters", p.SmootherPreIters);
+    write(xml, "SmootherPostIters", p.SmootherPostIters);
+    write(xml, "SmootherMROver", p.SmootherMROver);
+    write(xml, "CoarseRsdTarget", p.CoarseRsdTarget);
+    write(xml, "CoarseNKrylov", p.CoarseNKrylov);
+    write(xml, "CoarseMaxIter", p.CoarseMaxIter);
+    write(xml, "Verbose", p.Verbose);
+
+    pop(xml);
+  }
+
+  //! Default parameters
+  SysSolverMGNativeParams::SysSolverMGNativeParams()
+  {
+    RsdTarget         = zero;
+    NKrylov           = 10;
+    MaxIter           = 0;
+    NumNullVecs       = 12;
+    NullSetupIters    = 50;
+    SmootherPreIters  = 0;
+    SmootherPostIters = 4;
+    SmootherMROver    = 1.0;
+    CoarseRsdTarget   = 0.1;
+    CoarseNKrylov     = 16;
+    CoarseMaxIter     = 200;
+    Verbose           = false;
+  }
+
+  //! Read parameters
+  SysSolverMGNativeParams::SysSolverMGNativeParams(XMLReader& xml, const std::string& path)
+  {
+    *this = SysSolverMGNativeParams();
+    read(xml, path, *this);
+  }
+
+}
@@ -0,0 +1,56 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Params of the native aggregation based multigrid solver
+ */
+
+#ifndef __syssolver_mg_native_params_h__
+#define __syssolver_mg_native_params_h__
+
+#include "chromabase.h"
+
+namespace Chroma
+{
+
+  //! Params for the native multigrid inverter
+  /*! \ingroup invert */
+  struct SysSolverMGNativeParams
+  {
+    SysSolverMGNativeParams();
+    SysSolverMGNativeParams(XMLReader& in, const std::string& path);
+
+    std::string   SubspaceId;          /*!< Named object holding the setup */
+
+    // Outer FGMRES
+    Real          RsdTarget;           /*!< Target relative residuum */
+    int           NKrylov;             /*!< Number of vectors before restart */
+    int           MaxIter;             /*!< Total number of iterations */
+
+    // Setup
+    multi1d<int>  Blocking;            /*!< Size of the aggregates */
+    int           NumNullVecs;         /*!< Null vectors, each gives two coarse components */
+    int           NullSetupIters;      /*!< MR iterations on A x = 0 per null vector */
+
+    // Smoother
+    int           SmootherPreIters;    /*!< MR iterations before the coarse correction */
+    int           SmootherPostIters;   /*!< MR iterations after the coarse correction */
+    Real          SmootherMROver;      /*!< MR over relaxation */
+
+    // Coarse solve
+    Real          CoarseRsdTarget;     /*!< Relative residuum of the coarse GMRES */
+    int           CoarseNKrylov;       /*!< Coarse vectors before restart */
+    int           CoarseMaxIter;       /*!< Total coarse iterations */
+
+    bool          Verbose;             /*!< Print every outer iteration */
+  };
+
+
+  // Reader/writers
+  /*! \ingroup invert */
+  void read(XMLReader& xml, const std::string& path, SysSolverMGNativeParams& param);
+
+  /*! \ingroup invert */
+  void write(XMLWriter& xml, const std::string& path, const SysSolverMGNativeParams& param);
+
+} // End namespace
+
+#endif
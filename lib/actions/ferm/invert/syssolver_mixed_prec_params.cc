@@ -0,0 +1,66 @@
+/*! \file
+ *  \brief Params of the mixed precision defect correction solver
+ */
+
+#include "actions/ferm/invert/syssolver_mixed_prec_params.h"
+
+namespace Chroma
+{
+
+  // Read parameters
+  void read(XMLReader& xml, const std::string& path, SysSolverMixedPrecParams& p)
+  {
+    XMLReader paramtop(xml, path);
+
+    read(paramtop, "MaxIter", p.MaxIter);
+    read(paramtop, "RsdTarget", p.RsdTarget);
+
+    if (paramtop.count("Correction") != 0)
+      read(paramtop, "Correction", p.Correction);
+
+    if (paramtop.count("Delta") != 0)
+      read(paramtop, "Delta", p.Delta);
+
+    if (p.Correction == "RICHARDSON")
+      p.InnerSolverParams = readXMLGroup(paramtop, "InnerSolverParams", "invType");
+    else if (p.Correction != "RELIABLE_BICGSTAB")
+    {
+      QDPIO::cerr << "MIXED_PRECISION_INVERTER: unknown Correction= " << p.Correction << std::endl;
+      QDP_abort(1);
+    }
+  }
+
+  // Writer parameters
+  void write(XMLWriter& xml, const std::string& path, const SysSolverMixedPrecParams& p)
+  {
+    push(xml, path);
+
+    write(xml, "invType", "MIXED_PRECISION_INVERTER");
+    write(xml, "MaxIter", p.MaxIter);
+    write(xml, "RsdTarget", p.RsdTarget);
+    write(xml, "Correction", p.Correction);
+    if (p.Correction == "RICHARDSON")
+      xml << p.InnerSolverParams.xml;
+    else
+      write(xml, "Delta", p.Delta);
+
+    pop(xml);
+  }
+
+  //! Default parameters
+  SysSolverMixedPrecParams::SysSolverMixedPrecParams()
+  {
+    MaxIter    = 0;
+    RsdTarget  = zero;
+    Correction = "RICHARDSON";
+    Delta      = 0.1;
+  }
+
+  //! Read parameters
+  SysSolverMixedPrecParams::SysSolverMixedPrecParams(XMLReader& xml, const std::string& path)
+  {
+    *this = SysSolverMixedPrecParams();
+    read(xml, path, *this);
+  }
+
+}
@@ -0,0 +1,39 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Params of the mixed precision defect correction solver
+ */
+
+#ifndef __syssolver_mixed_prec_params_h__
+#define __syssolver_mixed_prec_params_h__
+
+#include "chromabase.h"
+#include "io/xml_group_reader.h"
+
+namespace Chroma
+{
+
+  //! Params for the mixed precision defect correction solver
+  /*! \ingroup invert */
+  struct SysSolverMixedPrecParams
+  {
+    SysSolverMixedPrecParams();
+    SysSolverMixedPrecParams(XMLReader& in, const std::string& path);
+
+    int           MaxIter;             /*!< Outer iterations for RICHARDSON, all iterations otherwise */
+    Real          RsdTarget;           /*!< Target of the true residual */
+    std::string   Correction;          /*!< RICHARDSON or RELIABLE_BICGSTAB */
+    Real          Delta;               /*!< Reliable update parameter */
+    GroupXML_t    InnerSolverParams;   /*!< Single precision solver of RICHARDSON */
+  };
+
+
+  // Reader/writers
+  /*! \ingroup invert */
+  void read(XMLReader& xml, const std::string& path, SysSolverMixedPrecParams& param);
+
+  /*! \ingroup invert */
+  void write(XMLWriter& xml, const std::string& path, const SysSolverMixedPrecParams& param);
+
+} // End namespace
+
+#endif
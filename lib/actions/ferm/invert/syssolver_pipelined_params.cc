@@ -0,0 +1,62 @@
+/*! \file
+ *  \brief Params of the pipelined CG and BiCGStab inverters
+ */
+
+#include "actions/ferm/invert/syssolver_pipelined_params.h"
+
+namespace Chroma
+{
+
+  // Read parameters
+  void read(XMLReader& xml, const std::string& path, SysSolverPipelinedParams& param)
+  {
+    XMLReader paramtop(xml, path);
+
+    // One struct serves both solvers, the name tells them apart
+    read(paramtop, "invType", param.invType);
+    read(paramtop, "RsdTarget", param.RsdTarget);
+    read(paramtop, "MaxIter", param.MaxIter);
+
+    if (paramtop.count("ReplaceInterval") != 0)
+      read(paramtop, "ReplaceInterval", param.ReplaceInterval);
+    else
+      param.ReplaceInterval = 100;
+
+    if (param.ReplaceInterval < 0)
+    {
+      QDPIO::cerr << __func__ << ": ReplaceInterval must not be negative" << std::endl;
+      QDP_abort(1);
+    }
+  }
+
+  // Writer parameters
+  void write(XMLWriter& xml, const std::string& path, const SysSolverPipelinedParams& param)
+  {
+    push(xml, path);
+
+    write(xml, "invType", param.invType);
+    write(xml, "RsdTarget", param.RsdTarget);
+    write(xml, "MaxIter", param.MaxIter);
+
+    if (param.ReplaceInterval != 100)
+      write(xml, "ReplaceInterval", param.ReplaceInterval);
+
+    pop(xml);
+  }
+
+  //! Default constructor
+  SysSolverPipelinedParams::SysSolverPipelinedParams()
+  {
+    invType = "PIPELINED_CG_INVERTER";
+    RsdTarget = zero;
+    MaxIter = 0;
+    ReplaceInterval = 100;
+  }
+
+  //! Read parameters
+  SysSolverPipelinedParams::SysSolverPipelinedParams(XMLReader& xml, const std::string& path)
+  {
+    read(xml, path, *this);
+  }
+
+}
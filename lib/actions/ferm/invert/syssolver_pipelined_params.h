@@ -0,0 +1,38 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Params of the pipelined CG and BiCGStab inverters
+ */
+
+#ifndef __syssolver_pipelined_params_h__
+#define __syssolver_pipelined_params_h__
+
+#include "chromabase.h"
+
+
+namespace Chroma
+{
+
+  //! Params of the pipelined CG and BiCGStab inverters
+  /*! \ingroup invert */
+  struct SysSolverPipelinedParams
+  {
+    SysSolverPipelinedParams();
+    SysSolverPipelinedParams(XMLReader& in, const std::string& path);
+    std::string   invType;               /*!< PIPELINED_CG_INVERTER or PIPELINED_BICGSTAB_INVERTER */
+    Real          RsdTarget;             /*!< Target residual */
+    int           MaxIter;               /*!< Maximum iterations */
+    int           ReplaceInterval;       /*!< Iterations between residual replacements, 0 for none */
+  };
+
+
+  // Reader/writers
+  /*! \ingroup invert */
+  void read(XMLReader& xml, const std::string& path, SysSolverPipelinedParams& param);
+
+  /*! \ingroup invert */
+  void write(XMLWriter& xml, const std::string& path, const SysSolverPipelinedParams& param);
+
+} // End namespace
+
+#endif 
+
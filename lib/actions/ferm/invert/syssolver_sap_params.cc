@@ -0,0 +1,56 @@
+/*! \file
+ *  \brief Params of the Schwarz alternating procedure preconditioner
+ */
+
+#include "actions/ferm/invert/syssolver_sap_params.h"
+
+namespace Chroma
+{
+
+  // Read parameters
+  void read(XMLReader& xml, const std::string& path, SysSolverSAPParams& p)
+  {
+    XMLReader paramtop(xml, path);
+
+    read(paramtop, "Blocking", p.Blocking);
+
+    if (paramtop.count("NCycles") != 0)
+      read(paramtop, "NCycles", p.NCycles);
+
+    if (paramtop.count("BlockMRIters") != 0)
+      read(paramtop, "BlockMRIters", p.BlockMRIters);
+
+    if (paramtop.count("MROver") != 0)
+      read(paramtop, "MROver", p.MROver);
+  }
+
+  // Writer parameters
+  void write(XMLWriter& xml, const std::string& path, const SysSolverSAPParams& p)
+  {
+    push(xml, path);
+
+    write(xml, "invType", "SAP_PRECONDITIONER");
+    write(xml, "Blocking", p.Blocking);
+    write(xml, "NCycles", p.NCycles);
+    write(xml, "BlockMRIters", p.BlockMRIters);
+    write(xml, "MROver", p.MROver);
+
+    pop(xml);
+  }
+
+  //! Default parameters
+  SysSolverSAPParams::SysSolverSAPParams()
+  {
+    NCycles      = 4;
+    BlockMRIters = 4;
+    MROver       = 1.0;
+  }
+
+  //! Read parameters
+  SysSolverSAPParams::SysSolverSAPParams(XMLReader& xml, const std::string& path)
+  {
+    *this = SysSolverSAPParams();
+    read(xml, path, *this);
+  }
+
+}
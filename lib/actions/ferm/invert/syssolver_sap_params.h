@@ -0,0 +1,37 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Params of the Schwarz alternating procedure preconditioner
+ */
+
+#ifndef __syssolver_sap_params_h__
+#define __syssolver_sap_params_h__
+
+#include "chromabase.h"
+
+namespace Chroma
+{
+
+  //! Params for the SAP preconditioner
+  /*! \ingroup invert */
+  struct SysSolverSAPParams
+  {
+    SysSolverSAPParams();
+    SysSolverSAPParams(XMLReader& in, const std::string& path);
+
+    multi1d<int>  Blocking;            /*!< Size of the blocks, must divide the sites on a node */
+    int           NCycles;             /*!< Sweeps over both colors of blocks */
+    int           BlockMRIters;        /*!< MR iterations on every block */
+    Real          MROver;              /*!< MR over relaxation */
+  };
+
+
+  // Reader/writers
+  /*! \ingroup invert */
+  void read(XMLReader& xml, const std::string& path, SysSolverSAPParams& param);
+
+  /*! \ingroup invert */
+  void write(XMLWriter& xml, const std::string& path, const SysSolverSAPParams& param);
+
+} // End namespace
+
+#endif
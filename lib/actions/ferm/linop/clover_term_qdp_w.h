@@ -153,6 +153,9 @@ namespace Chroma
     multi1d<bool> choles_done;   // Keep note of whether the decomposition has been done
                                  // on a particular checkerboard. 
 
+    // In the precision of T, there is no single-precision copy for
+    // QDPCloverTermD. apply, triacntr and the QUDA and QPhiX packers
+    // read this layout
     PrimitiveClovTriang<REALT>*  tri;
     
   };
@@ -390,6 +393,7 @@ namespace Chroma
       const U& f3;
       const U& f4;
       const U& f5;
+      RScalar<REALT> coeff[6];   // Clover coefficients of f0..f5
       PrimitiveClovTriang < REALT >* tri;
     };
     
@@ -410,6 +414,12 @@ namespace Chroma
       const U& f3=a->f3;
       const U& f4=a->f4;
       const U& f5=a->f5;
+      const RScalar<REALT>& c0=a->coeff[0];
+      const RScalar<REALT>& c1=a->coeff[1];
+      const RScalar<REALT>& c2=a->coeff[2];
+      const RScalar<REALT>& c3=a->coeff[3];
+      const RScalar<REALT>& c4=a->coeff[4];
+      const RScalar<REALT>& c5=a->coeff[5];
       PrimitiveClovTriang < REALT >* tri=a->tri;
 
       // SITE LOOP STARTS HERE
@@ -437,8 +447,8 @@ namespace Chroma
 	  
 	  /*# diag_L(i,0) = 1 - i*diag(E_z - B_z) */
 	  /*#             = 1 - i*diag(F(3,2) - F(1,0)) */
-	  ctmp_0 = f5.elem(site).elem().elem(i,i);
-	  ctmp_0 -= f0.elem(site).elem().elem(i,i);
+	  ctmp_0 = c5*f5.elem(site).elem().elem(i,i);
+	  ctmp_0 -= c0*f0.elem(site).elem().elem(i,i);
 	  rtmp_0 = imag(ctmp_0);
 	  tri[site].diag[0][i] += rtmp_0;
 	  
@@ -448,8 +458,8 @@ namespace Chroma
 	  
 	  /*# diag_L(i,1) = 1 + i*diag(E_z + B_z) */
 	  /*#             = 1 + i*diag(F(3,2) + F(1,0)) */
-	  ctmp_1 = f5.elem(site).elem().elem(i,i);
-	  ctmp_1 += f0.elem(site).elem().elem(i,i);
+	  ctmp_1 = c5*f5.elem(site).elem().elem(i,i);
+	  ctmp_1 += c0*f0.elem(site).elem().elem(i,i);
 	  rtmp_1 = imag(ctmp_1);
 	  tri[site].diag[1][i] -= rtmp_1;
 	  
@@ -469,8 +479,8 @@ namespace Chroma
 	    
 	    /*# L(i,j,0) = -i*(E_z - B_z)[i,j] */
 	    /*#          = -i*(F(3,2) - F(1,0)) */
-	    ctmp_0 = f0.elem(site).elem().elem(i,j);
-	    ctmp_0 -= f5.elem(site).elem().elem(i,j);
+	    ctmp_0 = c0*f0.elem(site).elem().elem(i,j);
+	    ctmp_0 -= c5*f5.elem(site).elem().elem(i,j);
 	    tri[site].offd[0][elem_ij] = timesI(ctmp_0);
 	    
 	    /*# L(i+Nc,j+Nc,0) = +i*(E_z - B_z)[i,j] */
@@ -479,8 +489,8 @@ namespace Chroma
 	    
 	    /*# L(i,j,1) = i*(E_z + B_z)[i,j] */
 	    /*#          = i*(F(3,2) + F(1,0)) */
-	    ctmp_1 = f5.elem(site).elem().elem(i,j);
-	    ctmp_1 += f0.elem(site).elem().elem(i,j);
+	    ctmp_1 = c5*f5.elem(site).elem().elem(i,j);
+	    ctmp_1 += c0*f0.elem(site).elem().elem(i,j);
 	    tri[site].offd[1][elem_ij] = timesI(ctmp_1);
 	    
 	    /*# L(i+Nc,j+Nc,1) = -i*(E_z + B_z)[i,j] */
@@ -501,13 +511,13 @@ namespace Chroma
 	    
 	    /*# i*E_- = (i*E_x + E_y) */
 	    /*#       = (i*F(3,0) + F(3,1)) */
-	    E_minus = timesI(f2.elem(site).elem().elem(i,j));
-	    E_minus += f4.elem(site).elem().elem(i,j);
+	    E_minus = timesI(c2*f2.elem(site).elem().elem(i,j));
+	    E_minus += c4*f4.elem(site).elem().elem(i,j);
 	    
 	    /*# i*B_- = (i*B_x + B_y) */
 	    /*#       = (i*F(2,1) - F(2,0)) */
-	    B_minus = timesI(f3.elem(site).elem().elem(i,j));
-	    B_minus -= f1.elem(site).elem().elem(i,j);
+	    B_minus = timesI(c3*f3.elem(site).elem().elem(i,j));
+	    B_minus -= c1*f1.elem(site).elem().elem(i,j);
 	    
 	    /*# L(i+Nc,j,0) = -i*(E_- - B_-)  */
 	    tri[site].offd[0][elem_ij] = B_minus - E_minus;
@@ -537,15 +547,17 @@ namespace Chroma
       QDP_abort(1);
     }
   
-    U f0 = f[0] * getCloverCoeff(0,1);
-    U f1 = f[1] * getCloverCoeff(0,2);
-    U f2 = f[2] * getCloverCoeff(0,3);
-    U f3 = f[3] * getCloverCoeff(1,2);
-    U f4 = f[4] * getCloverCoeff(1,3);
-    U f5 = f[5] * getCloverCoeff(2,3);    
+    // The site loop still fills one triangle at a time. Only the
+    // coefficients moved into it, which saves six scaled copies of the
+    // field strength
+    const int mu_nu[6][2] = { {0,1}, {0,2}, {0,3}, {1,2}, {1,3}, {2,3} };
 
     const int nodeSites = QDP::Layout::sitesOnNode();
-    QDPCloverEnv::QDPCloverMakeClovArg<U> arg = {diag_mass, f0,f1,f2,f3,f4,f5,tri };
+    QDPCloverEnv::QDPCloverMakeClovArg<U> arg = {diag_mass, f[0],f[1],f[2],f[3],f[4],f[5] };
+    for(int i=0; i < 6; ++i) {
+      arg.coeff[i].elem() = getCloverCoeff(mu_nu[i][0], mu_nu[i][1]).elem().elem().elem().elem();
+    }
+    arg.tri = tri;
     dispatch_to_threads(nodeSites, arg, QDPCloverEnv::makeClovSiteLoop<U>);
               
 
@@ -616,6 +628,14 @@ namespace Chroma
       int cb;
     };
 
+    //! Sites handled together by the LDL^dag inversion
+    /*! One 512 bit register of REALT per value, the loops over the
+     *  lanes are left to the compiler to vectorize */
+    template<typename R>
+    struct CloverLanes {
+      enum { value = 64/sizeof(R) };
+    };
+
     template<typename U>
     inline 
     void LDagDLInvSiteLoop(int lo, int hi, int myId, LDagDLInvArgs<U>* a) 
@@ -628,113 +648,107 @@ namespace Chroma
       PrimitiveClovTriang < REALT>* tri = a->tri;
       int cb = a->cb;
       
-      
-      RScalar<REALT> zip=0;
-      int N = 2*Nc;
-      
-      // Loop through the sites.
-      for(int ssite=lo; ssite < hi; ++ssite)  {
+      enum { N = 2*Nc, NOFFD = 2*Nc*Nc-Nc, W = CloverLanes<REALT>::value };
+
+      // Triangular storage with the sites of a batch running fastest.
+      // A(i,i) = d[i], A(i,j) = offd[i*(i-1)/2+j] for i > j
+      REALT d[N][W] QDP_ALIGN16;
+      REALT o_re[NOFFD][W] QDP_ALIGN16;
+      REALT o_im[NOFFD][W] QDP_ALIGN16;
+      REALT v_re[N][W] QDP_ALIGN16;
+      REALT v_im[N][W] QDP_ALIGN16;
+      REALT diag_g[N][W] QDP_ALIGN16;
+      int sites[W];
+
+      // Loop through the sites, W at a time
+      for(int ssite=lo; ssite < hi; ssite += W)  {
+
+	// A short last batch repeats its last site, which is not written back
+	int nsites = (hi - ssite < W) ? hi - ssite : W;
+	for(int l=0; l < W; ++l) {
+	  sites[l] = rb[cb].siteTable()[ssite + (l < nsites ? l : nsites-1)];
+	}
+
+	int site_neg_logdet[W];
+	for(int l=0; l < W; ++l) {
+	  site_neg_logdet[l] = 0;
+	}
 
-	int site = rb[cb].siteTable()[ssite];
-	
-	int site_neg_logdet=0;
 	// Loop through the blocks on the site.
 	for(int block=0; block < 2; block++) { 
-	  
-	  // Triangular storage 
-	  RScalar<REALT> inv_d[N] QDP_ALIGN16;
-	  RComplex<REALT> inv_offd[2*Nc*Nc-Nc] QDP_ALIGN16;
-	  RComplex<REALT> v[N] QDP_ALIGN16;
-	  RScalar<REALT>  diag_g[N] QDP_ALIGN16;
+
+	  for(int l=0; l < W; ++l) {
+	    const PrimitiveClovTriang<REALT>& t = tri[sites[l]];
+	    for(int i=0; i < N; i++) { 
+	      d[i][l] = t.diag[block][i].elem();
+	    }
+	    for(int i=0; i < NOFFD; i++) { 
+	      o_re[i][l] = t.offd[block][i].real();
+	      o_im[i][l] = t.offd[block][i].imag();
+	    }
+	  }
+
 	  // Algorithm 4.1.2 LDL^\dagger Decomposition
 	  // From Golub, van Loan 3rd ed, page 139
-	  for(int i=0; i < N; i++) { 
-	    inv_d[i] = tri[site].diag[block][i];
-	  }
-	  
-	  for(int i=0; i < 2*Nc*Nc-Nc; i++) { 
-	    inv_offd[i]  =tri[site].offd[block][i];
-	  }
-	  
 	  for(int j=0; j < N; ++j) { 
-	    
-	    // Compute v(0:j-1)
-	    //
-	    // for i=0:j-2
-	    //   v(i) = A(j,i) A(i,i)
-	    // end
-	    
-	    
+
+	    // v(i) = A(i,i) A*(j,i),  i < j
 	    for(int i=0; i < j; i++) { 
 	      int elem_ji = j*(j-1)/2 + i;
-	      
-	      RComplex<REALT> A_ii = cmplx( inv_d[i], zip );
-	      v[i] = A_ii*adj(inv_offd[elem_ji]);
+	      for(int l=0; l < W; ++l) {
+		v_re[i][l] =  d[i][l]*o_re[elem_ji][l];
+		v_im[i][l] = -d[i][l]*o_im[elem_ji][l];
+	      }
 	    }
-	    
-	    // v(j) = A(j,j) - A(j, 0:j-2) v(0:j-2)
-	    //                 ^ This is done with a loop over k ie:
-	    //
-	    // v(j) = A(j,j) - sum_k A*(j,k) v(k)     k=0...j-2
-	    //
-	    //      = A(j,j) - sum_k A*(j,k) A(j,k) A(k,k)
+
+	    // v(j) = A(j,j) - sum_k A(j,k) v(k)
 	    //      = A(j,j) - sum_k | A(j,k) |^2 A(k,k)
-	    
-	    v[j] = cmplx(inv_d[j],zip);
-	    
+	    //
+	    // is real, so only the real part is kept and it is the
+	    // diagonal element of D
 	    for(int k=0; k < j; k++) { 
 	      int elem_jk = j*(j-1)/2 + k;
-	      v[j] -= inv_offd[elem_jk]*v[k];
+	      for(int l=0; l < W; ++l) {
+		d[j][l] -= o_re[elem_jk][l]*v_re[k][l] - o_im[elem_jk][l]*v_im[k][l];
+	      }
 	    }
-	    
-	    
-	    // At this point in time v[j] has to be real, since
-	    // A(j,j) is from diag ie real and all | A(j,k) |^2 is real
-	    // as is A(k,k)
-	    
-	    // A(j,j) is the diagonal element - so store it.
-	    inv_d[j] = real( v[j] );
-	    
-	    // Last line of algorithm:
-	    // A( j+1 : n, j) = ( A(j+1:n, j) - A(j+1:n, 1:j-1)v(1:k-1) ) / v(j)
-	    //
-	    // use k as first colon notation and l as second so
-	    // 
-	    // for k=j+1 < n-1
-	    //      A(k,j) = A(k,j) ;
-	    //      for l=0 < j-1
-	    //         A(k,j) -= A(k, l) v(l)
-	    //      end
-	    //      A(k,j) /= v(j);
-	    //
+
+	    for(int l=0; l < W; ++l) {
+	      diag_g[j][l] = REALT(1)/d[j][l];
+	    }
+
+	    // A(k,j) = ( A(k,j) - sum_l A(k,l) v(l) ) / v(j),  k > j
 	    for(int k=j+1; k < N; k++) { 
 	      int elem_kj = k*(k-1)/2 + j;
-	      for(int l=0; l < j; l++) { 
-		int elem_kl = k*(k-1)/2 + l;
-		inv_offd[elem_kj] -= inv_offd[elem_kl] * v[l];
+	      for(int m=0; m < j; m++) { 
+		int elem_km = k*(k-1)/2 + m;
+		for(int l=0; l < W; ++l) {
+		  o_re[elem_kj][l] -= o_re[elem_km][l]*v_re[m][l] - o_im[elem_km][l]*v_im[m][l];
+		  o_im[elem_kj][l] -= o_re[elem_km][l]*v_im[m][l] + o_im[elem_km][l]*v_re[m][l];
+		}
+	      }
+	      for(int l=0; l < W; ++l) {
+		o_re[elem_kj][l] *= diag_g[j][l];
+		o_im[elem_kj][l] *= diag_g[j][l];
 	      }
-	      inv_offd[elem_kj] /= v[j];
 	    }
 	  }
 	  
-	  // Now fix up the inverse
-	  RScalar<REALT> one;
-	  one.elem() = (REALT)1;
-	  
-	  for(int i=0; i < N; i++) { 
-	    diag_g[i] = one/inv_d[i];
-	    
-	    // Compute the trace log
-	    // NB we are always doing trace log | A | 
-	    // (because we are always working with actually A^\dagger A
-	    //  even in one flavour case where we square root)
-	    tr_log_diag.elem(site).elem().elem().elem() += log(fabs(inv_d[i].elem()));
-	    // However, it is worth counting just the no of negative logdets
-	    // on site
-	    if( inv_d[i].elem() < 0 ) { 
-	      site_neg_logdet++;
+	  // Compute the trace log
+	  // NB we are always doing trace log | A | 
+	  // (because we are always working with actually A^\dagger A
+	  //  even in one flavour case where we square root)
+	  // However, it is worth counting just the no of negative logdets
+	  // on site
+	  for(int l=0; l < nsites; ++l) {
+	    for(int i=0; i < N; i++) { 
+	      tr_log_diag.elem(sites[l]).elem().elem().elem() += log(fabs(d[i][l]));
+	      if( d[i][l] < 0 ) { 
+		site_neg_logdet[l]++;
+	      }
 	    }
 	  }
+
 	  // Now we need to invert the L D L^\dagger 
 	  // We can do this by solving:
 	  //
@@ -749,68 +763,90 @@ namespace Chroma
 	  //
 	  // Likewise L^\dagger is strictly upper triagonal and so
 	  // L^\dagger M^{-1} = X can be solved by forward substitution.
-	  RComplex<REALT> sum;
+	  //
+	  // Column k overwrites entries that later columns do not read.
 	  for(int k = 0; k < N; ++k) {
 
-	    for(int i = 0; i < k; ++i) {
-	      zero_rep(v[i]);
-	    }
-	    
 	    /*# Forward substitution */
 	    
 	    // The first element is the inverse of the diagonal
-	    v[k] = cmplx(diag_g[k],zip);
+	    for(int l=0; l < W; ++l) {
+	      v_re[k][l] = diag_g[k][l];
+	      v_im[k][l] = 0;
+	    }
 	    
 	    for(int i = k+1; i < N; ++i) {
-	      zero_rep(v[i]);
-	      
+	      REALT s_re[W], s_im[W];
+	      for(int l=0; l < W; ++l) {
+		s_re[l] = 0;
+		s_im[l] = 0;
+	      }
+
+	      // subtract l_ij*d_j*x_{kj}
 	      for(int j = k; j < i; ++j) {
 		int elem_ij = i*(i-1)/2+j;	
-		
-		// subtract l_ij*d_j*x_{kj}
-		v[i] -= inv_offd[elem_ij] *inv_d[j]*v[j];
-		
+		for(int l=0; l < W; ++l) {
+		  REALT lr = o_re[elem_ij][l]*d[j][l];
+		  REALT li = o_im[elem_ij][l]*d[j][l];
+		  s_re[l] -= lr*v_re[j][l] - li*v_im[j][l];
+		  s_im[l] -= lr*v_im[j][l] + li*v_re[j][l];
+		}
 	      }
 	      
 	      // scale out by 1/d_i
-	      v[i] *= diag_g[i];
+	      for(int l=0; l < W; ++l) {
+		v_re[i][l] = s_re[l]*diag_g[i][l];
+		v_im[i][l] = s_im[l]*diag_g[i][l];
+	      }
 	    }
 	    
 	    /*# Backward substitution */
 	    // V[N-1] remains unchanged
 	    // Start from V[N-2]
 	    
-	    for(int i = N-2; (int)i >= (int)k; --i) {
+	    for(int i = N-2; i >= k; --i) {
 	      for(int j = i+1; j < N; ++j) {
 		int elem_ji = j*(j-1)/2 + i;
 		// Subtract terms of typ (l_ji)*x_kj
-		v[i] -= adj(inv_offd[elem_ji]) * v[j];
+		for(int l=0; l < W; ++l) {
+		  v_re[i][l] -= o_re[elem_ji][l]*v_re[j][l] + o_im[elem_ji][l]*v_im[j][l];
+		  v_im[i][l] -= o_re[elem_ji][l]*v_im[j][l] - o_im[elem_ji][l]*v_re[j][l];
+		}
 	      }
 	    }
 	    
 	    /*# Overwrite column k of invcl.offd */
-	    inv_d[k] = real(v[k]);
+	    for(int l=0; l < W; ++l) {
+	      d[k][l] = v_re[k][l];
+	    }
 	    for(int i = k+1; i < N; ++i) {
-
 	      int elem_ik = i*(i-1)/2+k;
-	      inv_offd[elem_ik] = v[i];
+	      for(int l=0; l < W; ++l) {
+		o_re[elem_ik][l] = v_re[i][l];
+		o_im[elem_ik][l] = v_im[i][l];
+	      }
 	    }
 	  }
 	  
-	  
 	  // Overwrite original data
-	  for(int i=0; i < N; i++) { 
-	    tri[site].diag[block][i] = inv_d[i];
-	  }
-	  for(int i=0; i < 2*Nc*Nc-Nc; i++) { 
-	    tri[site].offd[block][i] = inv_offd[i];
+	  for(int l=0; l < nsites; ++l) {
+	    PrimitiveClovTriang<REALT>& t = tri[sites[l]];
+	    for(int i=0; i < N; i++) { 
+	      t.diag[block][i].elem() = d[i][l];
+	    }
+	    for(int i=0; i < NOFFD; i++) { 
+	      t.offd[block][i].real() = o_re[i][l];
+	      t.offd[block][i].imag() = o_im[i][l];
+	    }
 	  }
 	}
 	
-	if( site_neg_logdet != 0 ) { 
-	  // Report if site has any negative terms. (-ve def)
-	  std::cout << "WARNING: found " << site_neg_logdet
-		    << " negative eigenvalues in Clover DET at site: " << site << std::endl;
+	for(int l=0; l < nsites; ++l) {
+	  if( site_neg_logdet[l] != 0 ) { 
+	    // Report if site has any negative terms. (-ve def)
+	    std::cout << "WARNING: found " << site_neg_logdet[l]
+		      << " negative eigenvalues in Clover DET at site: " << sites[l] << std::endl;
+	  }
 	}
       }/* End Site Loop */
     } /* End Function */
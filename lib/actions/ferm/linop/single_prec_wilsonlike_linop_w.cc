@@ -0,0 +1,884 @@
+/*! \file
+ *  \brief Single precision copies of Wilson like linear operators
+ */
+
+#include "actions/ferm/linop/single_prec_wilsonlike_linop_w.h"
+#include "actions/ferm/fermstates/periodic_fermstate.h"
+
+#include <cmath>
+
+namespace Chroma
+{
+  typedef SinglePrecWilsonLikeLinOp::CmplxF  CmplxF;
+
+  // Anonymous namespace
+  namespace
+  {
+    typedef std::complex<double>          Cmplx;
+    typedef multi1d<LatticeColorMatrix>   P;
+    typedef multi1d<LatticeColorMatrixF>  PF;
+
+    //! The operator on the whole lattice
+    void unprecApply(const LinearOperator<LatticeFermion>& A,
+		     const EvenOddPrecLinearOperator<LatticeFermion,P,P>* eo,
+		     LatticeFermion& chi, const LatticeFermion& psi)
+    {
+      if (eo != 0)
+	eo->unprecLinOp(chi, psi, PLUS);
+      else
+	A(chi, psi, PLUS);
+    }
+
+
+    //! The 5D operator on the whole lattice
+    void unprecApply(const LinearOperatorArray<LatticeFermion>& A,
+		     const EvenOddPrecLinearOperatorArray<LatticeFermion,P,P>* eo,
+		     multi1d<LatticeFermion>& chi, const multi1d<LatticeFermion>& psi)
+    {
+      if (eo != 0)
+	eo->unprecLinOp(chi, psi, PLUS);
+      else
+	A(chi, psi, PLUS);
+    }
+
+
+    //! Invert a dense n x n matrix by Gauss-Jordan with partial pivoting
+    bool invertSiteMatrix(std::vector<Cmplx>& a, std::vector<Cmplx>& inv, int n)
+    {
+      inv.assign(n*n, Cmplx(0));
+      for(int i=0; i < n; ++i)
+	inv[i*n + i] = 1;
+
+      for(int col=0; col < n; ++col)
+      {
+	int piv = col;
+	for(int row=col+1; row < n; ++row)
+	  if (std::abs(a[row*n + col]) > std::abs(a[piv*n + col]))
+	    piv = row;
+
+	if (std::abs(a[piv*n + col]) == 0)
+	  return false;
+
+	if (piv != col)
+	  for(int k=0; k < n; ++k)
+	  {
+	    std::swap(a[piv*n + k], a[col*n + k]);
+	    std::swap(inv[piv*n + k], inv[col*n + k]);
+	  }
+
+	const Cmplx p = Cmplx(1) / a[col*n + col];
+	for(int k=0; k < n; ++k)
+	{
+	  a[col*n + k]   *= p;
+	  inv[col*n + k] *= p;
+	}
+
+	for(int row=0; row < n; ++row)
+	{
+	  if (row == col)
+	    continue;
+
+	  const Cmplx f = a[row*n + col];
+	  for(int k=0; k < n; ++k)
+	  {
+	    a[row*n + k]   -= f * a[col*n + k];
+	    inv[row*n + k] -= f * inv[col*n + k];
+	  }
+	}
+      }
+
+      return true;
+    }
+
+
+    //! The hopping term of each direction without its coefficient
+    /*! H = -1/2 sum_mu c_mu h[mu] */
+    void hopDirs(multi1d<LatticeFermion>& h, const LatticeFermion& x,
+		 const multi1d<LatticeColorMatrix>& u)
+    {
+      h.resize(Nd);
+      for(int mu=0; mu < Nd; ++mu)
+      {
+	LatticeFermion fw = u[mu] * shift(x, FORWARD, mu);
+	LatticeFermion bw = shift(adj(u[mu]) * x, BACKWARD, mu);
+	h[mu] = fw + bw + Gamma(1 << mu) * (bw - fw);
+      }
+    }
+
+
+    //! Single precision Wilson dslash with the hopping coefficients folded in
+    Handle<WilsonDslashF> makeDslash(const multi1d<LatticeColorMatrix>& u,
+				     const std::vector<double>& coeff)
+    {
+      PF u_f(Nd);
+      multi1d<Real> c(Nd);
+      for(int mu=0; mu < Nd; ++mu)
+      {
+	u_f[mu] = u[mu];
+	c[mu]   = coeff[mu];
+      }
+
+      // Links hold the boundary conditions already
+      Handle< FermState<LatticeFermionF,PF,PF> > fs(new PeriodicFermState<LatticeFermionF,PF,PF>(u_f));
+
+      return Handle<WilsonDslashF>(new WilsonDslashF(fs, c));
+    }
+
+
+#ifndef QDP_IS_QDPJIT
+    //! Arguments for the site matrices
+    struct SiteMatArgs
+    {
+      LatticeFermionF&            chi;
+      const LatticeFermionF&      psi;
+      const std::vector<CmplxF>&  m;
+      const multi1d<int>&         tab;
+      bool                        dag;
+    };
+
+    //! Chiral blocks on a range of sites of a subset
+    /*! Block b holds the spins 2b and 2b+1, the rows are (spin%2)*Nc + color */
+    inline
+    void siteMatLoop(int lo, int hi, int myId, SiteMatArgs* a)
+    {
+      const int n = 2*Nc;
+      CmplxF v[2*Nc];
+
+      for(int j=lo; j < hi; ++j)
+      {
+	const int site = a->tab[j];
+
+	for(int blk=0; blk < 2; ++blk)
+	{
+	  const CmplxF* m = &(a->m[(j*2 + blk)*n*n]);
+
+	  for(int col=0; col < n; ++col)
+	  {
+	    const RComplex<REAL32>& p = a->psi.elem(site).elem(2*blk + col / Nc).elem(col % Nc);
+	    v[col] = CmplxF(p.real(), p.imag());
+	  }
+
+	  for(int row=0; row < n; ++row)
+	  {
+	    CmplxF sum = 0;
+	    if (a->dag)
+	      for(int col=0; col < n; ++col)
+		sum += std::conj(m[col*n + row]) * v[col];
+	    else
+	      for(int col=0; col < n; ++col)
+		sum += m[row*n + col] * v[col];
+
+	    RComplex<REAL32>& c = a->chi.elem(site).elem(2*blk + row / Nc).elem(row % Nc);
+	    c.real() = sum.real();
+	    c.imag() = sum.imag();
+	  }
+	}
+      }
+    }
+#endif
+  }
+
+
+  // Copy the operator
+  SinglePrecWilsonLikeLinOp::SinglePrecWilsonLikeLinOp(const LinearOperator<LatticeFermion>& A,
+						       const multi1d<LatticeColorMatrix>& u) :
+    eoprec(false), scale(1.0), scalar(false)
+  {
+    START_CODE();
+
+#ifndef QDP_IS_QDPJIT
+    const EvenOddPrecLinearOperator<LatticeFermion,P,P>* eo =
+      dynamic_cast<const EvenOddPrecLinearOperator<LatticeFermion,P,P>*>(&A);
+
+    if (eo != 0)
+      eoprec = true;
+    else if (A.subset().numSiteTable() != Layout::sitesOnNode())
+    {
+      QDPIO::cerr << __func__ << ": only unpreconditioned or even-odd preconditioned operators can be copied" << std::endl;
+      QDP_abort(1);
+    }
+
+    if (Ns != 4)
+    {
+      QDPIO::cerr << __func__ << ": needs Ns=4" << std::endl;
+      QDP_abort(1);
+    }
+
+    const int n = 2*Nc;
+
+    // Unit vectors on one checkerboard see only the diagonal there
+    LatticeFermion y, r;
+    double dmax = 0, offmax = 0;
+
+    for(int cb=0; cb < 2; ++cb)
+    {
+      const multi1d<int>& tab = rb[cb].siteTable();
+      diag[cb].assign(tab.size()*2*n*n, CmplxF(0));
+
+      for(int k=0; k < Ns*Nc; ++k)
+      {
+	const int blk = (k / Nc) / 2;
+	const int col = ((k / Nc) % 2)*Nc + k % Nc;
+
+	y = zero;
+	for(int j=0; j < tab.size(); ++j)
+	  y.elem(tab[j]).elem(k / Nc).elem(k % Nc).real() = 1;
+
+	unprecApply(A, eo, r, y);
+
+	for(int j=0; j < tab.size(); ++j)
+	  for(int row=0; row < Ns*Nc; ++row)
+	  {
+	    const RComplex<REAL>& v = r.elem(tab[j]).elem(row / Nc).elem(row % Nc);
+	    const Cmplx z(v.real(), v.imag());
+
+	    if ((row / Nc) / 2 == blk)
+	    {
+	      diag[cb][(j*2 + blk)*n*n + (((row / Nc) % 2)*Nc + row % Nc)*n + col] = CmplxF(z.real(), z.imag());
+	      dmax = std::max(dmax, std::abs(z));
+	    }
+	    else
+	      offmax = std::max(offmax, std::abs(z));
+	  }
+      }
+    }
+
+    QDPInternal::globalMax(dmax);
+    QDPInternal::globalMax(offmax);
+
+    if (offmax > 1.0e-6 * dmax)
+    {
+      QDPIO::cerr << __func__ << ": site diagonal does not commute with gamma_5, relative size= "
+		  << offmax / dmax << std::endl;
+      QDP_abort(1);
+    }
+
+    // A multiple of the identity is kept as a single number
+    {
+      double re = 0, im = 0;
+      if (diag[0].size() > 0)
+      {
+	re = diag[0][0].real();
+	im = diag[0][0].imag();
+      }
+
+      QDPInternal::globalSum(re);
+      QDPInternal::globalSum(im);
+      const CmplxF lambda(re / Layout::numNodes(), im / Layout::numNodes());
+
+      double dev = 0;
+      for(int cb=0; cb < 2; ++cb)
+	for(int i=0; i < diag[cb].size(); ++i)
+	{
+	  const int row = (i / n) % n;
+	  const int col = i % n;
+	  dev = std::max(dev, double(std::abs(diag[cb][i] - ((row == col) ? lambda : CmplxF(0)))));
+	}
+
+      QDPInternal::globalMax(dev);
+
+      if (dev <= 1.0e-6 * std::abs(lambda))
+      {
+	scalar = true;
+	for(int cb=0; cb < 2; ++cb)
+	{
+	  diag_scalar[cb] = lambda;
+	  std::vector<CmplxF>().swap(diag[cb]);
+	}
+      }
+    }
+
+    // Fit the hopping coefficients on a random vector
+    Seed ran_seed;
+    QDP::RNG::savern(ran_seed);
+
+    LatticeFermion x;
+    gaussian(x);
+
+    QDP::RNG::setrn(ran_seed);
+
+    LatticeFermion Ax, dx;
+    unprecApply(A, eo, Ax, x);
+
+    {
+      LatticeFermionF xf = x;
+      LatticeFermionF dxf;
+      diagLinOp(dxf, xf, 0, PLUS);
+      diagLinOp(dxf, xf, 1, PLUS);
+      dx = dxf;
+    }
+
+    LatticeFermion rhs = Real(2) * (dx - Ax);
+    multi1d<LatticeFermion> h;
+    hopDirs(h, x, u);
+
+    // Normal equations G c = b
+    std::vector<double> coeff(Nd, 0.0);
+    std::vector<double> G(Nd*Nd), b(Nd);
+    for(int mu=0; mu < Nd; ++mu)
+    {
+      b[mu] = toDouble(real(innerProduct(h[mu], rhs)));
+      for(int nu=0; nu < Nd; ++nu)
+	G[mu*Nd + nu] = toDouble(real(innerProduct(h[mu], h[nu])));
+    }
+
+    for(int mu=0; mu < Nd; ++mu)
+    {
+      if (G[mu*Nd + mu] <= 0)
+      {
+	QDPIO::cerr << __func__ << ": no hopping term in direction " << mu << std::endl;
+	QDP_abort(1);
+      }
+
+      for(int nu=mu+1; nu < Nd; ++nu)
+      {
+	const double f = G[nu*Nd + mu] / G[mu*Nd + mu];
+	for(int k=mu; k < Nd; ++k)
+	  G[nu*Nd + k] -= f * G[mu*Nd + k];
+	b[nu] -= f * b[mu];
+      }
+    }
+
+    for(int mu=Nd-1; mu >= 0; --mu)
+    {
+      double sum = b[mu];
+      for(int nu=mu+1; nu < Nd; ++nu)
+	sum -= G[mu*Nd + nu] * coeff[nu];
+      coeff[mu] = sum / G[mu*Nd + mu];
+    }
+
+    LatticeFermion model = dx;
+    for(int mu=0; mu < Nd; ++mu)
+      model -= Real(0.5*coeff[mu]) * h[mu];
+
+    {
+      const double diff = toDouble(norm2(Ax - model));
+      const double ref  = toDouble(norm2(Ax));
+      if (diff > 1.0e-6 * ref)
+      {
+	QDPIO::cerr << __func__ << ": operator is not Wilson like, relative difference= "
+		    << std::sqrt(diff / ref) << std::endl;
+	QDP_abort(1);
+      }
+    }
+
+    D = makeDslash(u, coeff);
+
+    if (eoprec)
+    {
+      // Only the inverse is needed on the even sites
+      if (scalar)
+	diag_scalar[0] = CmplxF(1) / diag_scalar[0];
+      else
+      {
+	std::vector<Cmplx> a(n*n), inv;
+	for(int k=0; k < diag[0].size() / (n*n); ++k)
+	{
+	  CmplxF* m = &(diag[0][k*n*n]);
+	  for(int i=0; i < n*n; ++i)
+	    a[i] = Cmplx(m[i].real(), m[i].imag());
+
+	  if (! invertSiteMatrix(a, inv, n))
+	  {
+	    QDPIO::cerr << __func__ << ": singular diagonal term on site " << rb[0].siteTable()[k/2] << std::endl;
+	    QDP_abort(1);
+	  }
+
+	  for(int i=0; i < n*n; ++i)
+	    m[i] = CmplxF(inv[i].real(), inv[i].imag());
+	}
+      }
+
+      // Overall factor of the Schur complement
+      LatticeFermion xo = zero;
+      xo[rb[1]] = x;
+      A(Ax, xo, PLUS);
+
+      LatticeFermionF xf = xo;
+      LatticeFermionF mf;
+      (*this)(mf, xf, PLUS);
+      LatticeFermion m = mf;
+
+      scale = toDouble(real(innerProduct(m, Ax, rb[1]))) / toDouble(norm2(m, rb[1]));
+
+      const double diff = toDouble(norm2(Ax - Real(scale)*m, rb[1]));
+      const double ref  = toDouble(norm2(Ax, rb[1]));
+      if (diff > 1.0e-6 * ref)
+      {
+	QDPIO::cerr << __func__ << ": preconditioned operator is not the Schur complement, relative difference= "
+		    << std::sqrt(diff / ref) << std::endl;
+	QDP_abort(1);
+      }
+    }
+    else
+    {
+      LatticeFermionF xf = x;
+      LatticeFermionF mf;
+      (*this)(mf, xf, PLUS);
+      LatticeFermion m = mf;
+
+      const double diff = toDouble(norm2(Ax - m));
+      const double ref  = toDouble(norm2(Ax));
+      if (diff > 1.0e-6 * ref)
+      {
+	QDPIO::cerr << __func__ << ": single precision copy does not match, relative difference= "
+		    << std::sqrt(diff / ref) << std::endl;
+	QDP_abort(1);
+      }
+    }
+
+    QDPIO::cout << __func__ << ": copied " << ((eoprec) ? "even-odd preconditioned" : "unpreconditioned")
+		<< " operator, " << ((scalar) ? "scalar" : "chiral block") << " diagonal, hopping coefficients";
+    for(int mu=0; mu < Nd; ++mu)
+      QDPIO::cout << " " << coeff[mu];
+    QDPIO::cout << std::endl;
+#else
+    QDPIO::cerr << __func__ << ": needs site access, not available with QDP-JIT" << std::endl;
+    QDP_abort(1);
+#endif
+
+    END_CODE();
+  }
+
+
+  // Site diagonal onto the sites of a checkerboard
+  void SinglePrecWilsonLikeLinOp::diagLinOp(LatticeFermionF& chi, const LatticeFermionF& psi,
+					    int cb, enum PlusMinus isign) const
+  {
+    if (scalar)
+    {
+      const CmplxF z = (isign == PLUS) ? diag_scalar[cb] : std::conj(diag_scalar[cb]);
+      if (z.imag() == 0)
+	chi[rb[cb]] = RealF(z.real()) * psi;
+      else
+	chi[rb[cb]] = cmplx(RealF(z.real()), RealF(z.imag())) * psi;
+      return;
+    }
+
+#ifndef QDP_IS_QDPJIT
+    SiteMatArgs args = {chi, psi, diag[cb], rb[cb].siteTable(), isign == MINUS};
+    dispatch_to_threads(rb[cb].numSiteTable(), args, siteMatLoop);
+#endif
+  }
+
+
+  // Apply the operator
+  void SinglePrecWilsonLikeLinOp::operator()(LatticeFermionF& chi, const LatticeFermionF& psi,
+					     enum PlusMinus isign) const
+  {
+    START_CODE();
+
+    LatticeFermionF t1, t2;
+
+    if (! eoprec)
+    {
+      //  chi = D psi - 1/2 Dslash psi
+      D->apply(t1, psi, isign, 0);
+      D->apply(t1, psi, isign, 1);
+      diagLinOp(chi, psi, 0, isign);
+      diagLinOp(chi, psi, 1, isign);
+      chi -= RealF(0.5) * t1;
+    }
+    else
+    {
+      //  chi_o = s (D_oo psi_o - 1/4 Dslash_oe D_ee^-1 Dslash_eo psi_o)
+      D->apply(t1, psi, isign, 0);
+      diagLinOp(t2, t1, 0, isign);
+      D->apply(t1, t2, isign, 1);
+      diagLinOp(chi, psi, 1, isign);
+
+      chi[rb[1]] = RealF(scale) * chi - RealF(0.25*scale) * t1;
+    }
+
+    END_CODE();
+  }
+
+
+  //----------------------------------------------------------------------------
+  // Copy the 5D operator
+  SinglePrecWilsonLikeLinOpArray::SinglePrecWilsonLikeLinOpArray(const LinearOperatorArray<LatticeFermion>& A,
+								 const multi1d<LatticeColorMatrix>& u) :
+    N5(A.size()), eoprec(false), scale(1.0)
+  {
+    START_CODE();
+
+    const EvenOddPrecLinearOperatorArray<LatticeFermion,P,P>* eo =
+      dynamic_cast<const EvenOddPrecLinearOperatorArray<LatticeFermion,P,P>*>(&A);
+
+    if (eo != 0)
+      eoprec = true;
+    else if (A.subset().numSiteTable() != Layout::sitesOnNode())
+    {
+      QDPIO::cerr << __func__ << ": only unpreconditioned or even-odd preconditioned operators can be copied" << std::endl;
+      QDP_abort(1);
+    }
+
+    const int G5 = Ns*Ns-1;
+    const int nv = Nd + 1;
+
+    Seed ran_seed;
+    QDP::RNG::savern(ran_seed);
+
+    LatticeFermion x;
+    gaussian(x);
+
+    // Fit (M e_s' phi)_s = alpha phi + sum_mu beta_mu h[mu] phi for each chirality
+    std::vector<Cmplx> alpha[2], beta[2];
+    multi1d<LatticeFermion> y(N5), r(N5);
+
+    for(int chir=0; chir < 2; ++chir)
+    {
+      alpha[chir].resize(N5*N5);
+      beta[chir].resize(N5*N5*Nd);
+
+      LatticeFermion phi;
+      if (chir == 0)
+	phi = Real(0.5) * (x + Gamma(G5) * x);
+      else
+	phi = Real(0.5) * (x - Gamma(G5) * x);
+
+      multi1d<LatticeFermion> v(nv);
+      {
+	multi1d<LatticeFermion> h;
+	hopDirs(h, phi, u);
+	v[0] = phi;
+	for(int mu=0; mu < Nd; ++mu)
+	  v[1+mu] = h[mu];
+      }
+
+      std::vector<Cmplx> G(nv*nv), Ginv;
+      for(int k=0; k < nv; ++k)
+	for(int l=0; l < nv; ++l)
+	{
+	  DComplex z = innerProduct(v[k], v[l]);
+	  G[k*nv + l] = Cmplx(toDouble(real(z)), toDouble(imag(z)));
+	}
+
+      if (! invertSiteMatrix(G, Ginv, nv))
+      {
+	QDPIO::cerr << __func__ << ": degenerate probe" << std::endl;
+	QDP_abort(1);
+      }
+
+      for(int sp=0; sp < N5; ++sp)
+      {
+	for(int s=0; s < N5; ++s)
+	  y[s] = zero;
+	y[sp] = phi;
+
+	unprecApply(A, eo, r, y);
+
+	for(int s=0; s < N5; ++s)
+	{
+	  std::vector<Cmplx> rhs(nv);
+	  for(int k=0; k < nv; ++k)
+	  {
+	    DComplex z = innerProduct(v[k], r[s]);
+	    rhs[k] = Cmplx(toDouble(real(z)), toDouble(imag(z)));
+	  }
+
+	  for(int k=0; k < nv; ++k)
+	  {
+	    Cmplx sum = 0;
+	    for(int l=0; l < nv; ++l)
+	      sum += Ginv[k*nv + l] * rhs[l];
+
+	    if (k == 0)
+	      alpha[chir][s*N5 + sp] = sum;
+	    else
+	      beta[chir][(s*N5 + sp)*Nd + k-1] = sum;
+	  }
+	}
+      }
+    }
+
+    // The c_mu from the largest hopping term, then B = -2 beta / c
+    int ref = 0;
+    double bmax = 0, amax = 0;
+    for(int chir=0; chir < 2; ++chir)
+      for(int i=0; i < N5*N5; ++i)
+      {
+	amax = std::max(amax, std::abs(alpha[chir][i]));
+
+	double sum = 0;
+	for(int mu=0; mu < Nd; ++mu)
+	  sum += std::norm(beta[chir][i*Nd + mu]);
+
+	if (sum > bmax)
+	{
+	  bmax = sum;
+	  ref  = chir*N5*N5 + i;
+	}
+      }
+
+    if (bmax == 0)
+    {
+      QDPIO::cerr << __func__ << ": no hopping term" << std::endl;
+      QDP_abort(1);
+    }
+
+    std::vector<double> coeff(Nd);
+    {
+      const Cmplx* br = &(beta[ref / (N5*N5)][(ref % (N5*N5))*Nd]);
+      int mu0 = 0;
+      for(int mu=1; mu < Nd; ++mu)
+	if (std::abs(br[mu]) > std::abs(br[mu0]))
+	  mu0 = mu;
+
+      for(int mu=0; mu < Nd; ++mu)
+      {
+	const Cmplx c = br[mu] / br[mu0];
+	if (std::abs(c.imag()) > 1.0e-6)
+	{
+	  QDPIO::cerr << __func__ << ": operator is not domain wall like, complex hopping coefficient in direction " << mu << std::endl;
+	  QDP_abort(1);
+	}
+	coeff[mu] = c.real();
+      }
+    }
+
+    double cnorm = 0;
+    for(int mu=0; mu < Nd; ++mu)
+      cnorm += coeff[mu]*coeff[mu];
+
+    std::vector<Cmplx> bm[2];
+    for(int chir=0; chir < 2; ++chir)
+    {
+      bm[chir].resize(N5*N5);
+      for(int i=0; i < N5*N5; ++i)
+      {
+	Cmplx sum = 0;
+	for(int mu=0; mu < Nd; ++mu)
+	  sum += coeff[mu] * beta[chir][i*Nd + mu];
+	bm[chir][i] = -2.0 * sum / cnorm;
+      }
+    }
+
+    // Keep the non-zero entries, with the -1/2 of H folded into B
+    const double bscale = std::sqrt(bmax / cnorm);
+    auto entries = [this](std::vector<Entry>& e, const std::vector<Cmplx>* m, double f, double cut)
+    {
+      e.clear();
+      for(int s=0; s < N5; ++s)
+	for(int sp=0; sp < N5; ++sp)
+	{
+	  const Cmplx p = m[0][s*N5 + sp];
+	  const Cmplx q = m[1][s*N5 + sp];
+	  if (std::abs(p) > cut || std::abs(q) > cut)
+	  {
+	    Entry en = {s, sp, CmplxF(f*p.real(), f*p.imag()), CmplxF(f*q.real(), f*q.imag())};
+	    e.push_back(en);
+	  }
+	}
+    };
+
+    entries(a, alpha, 1.0, 1.0e-6 * amax);
+    entries(b, bm, -0.5, 1.0e-6 * bscale);
+
+    D = makeDslash(u, coeff);
+
+    if (eoprec)
+    {
+      // B A^-1 for each chirality
+      std::vector<Cmplx> c[2];
+      for(int chir=0; chir < 2; ++chir)
+      {
+	std::vector<Cmplx> am = alpha[chir], ainv;
+	if (! invertSiteMatrix(am, ainv, N5))
+	{
+	  QDPIO::cerr << __func__ << ": singular even-even block" << std::endl;
+	  QDP_abort(1);
+	}
+
+	c[chir].assign(N5*N5, Cmplx(0));
+	for(int s=0; s < N5; ++s)
+	  for(int sp=0; sp < N5; ++sp)
+	    for(int k=0; k < N5; ++k)
+	      c[chir][s*N5 + sp] += bm[chir][s*N5 + k] * ainv[k*N5 + sp];
+      }
+
+      double cmax = 0;
+      for(int chir=0; chir < 2; ++chir)
+	for(int i=0; i < N5*N5; ++i)
+	  cmax = std::max(cmax, std::abs(c[chir][i]));
+
+      entries(b_ainv, c, -0.5, 1.0e-6 * cmax);
+    }
+
+    // Check the copy on a random vector
+    multi1d<LatticeFermion> x5(N5), Ax(N5);
+    for(int s=0; s < N5; ++s)
+    {
+      x5[s] = zero;
+      gaussian(x5[s], subset());
+    }
+
+    QDP::RNG::setrn(ran_seed);
+
+    A(Ax, x5, PLUS);
+
+    multi1d<LatticeFermionF> xf(N5), mf(N5);
+    for(int s=0; s < N5; ++s)
+      xf[s] = x5[s];
+    (*this)(mf, xf, PLUS);
+
+    multi1d<LatticeFermion> m(N5);
+    double num = 0, den = 0;
+    for(int s=0; s < N5; ++s)
+    {
+      m[s] = mf[s];
+      num += toDouble(real(innerProduct(m[s], Ax[s], subset())));
+      den += toDouble(norm2(m[s], subset()));
+    }
+
+    if (eoprec)
+      scale = num / den;
+
+    double diff = 0, nref = 0;
+    for(int s=0; s < N5; ++s)
+    {
+      diff += toDouble(norm2(Ax[s] - Real(scale)*m[s], subset()));
+      nref += toDouble(norm2(Ax[s], subset()));
+    }
+
+    if (diff > 1.0e-6 * nref)
+    {
+      QDPIO::cerr << __func__ << ": operator is not domain wall like"
+		  << ((eoprec) ? " or not the Schur complement" : "")
+		  << ", relative difference= " << std::sqrt(diff / nref) << std::endl;
+      QDP_abort(1);
+    }
+
+    QDPIO::cout << __func__ << ": copied " << ((eoprec) ? "even-odd preconditioned" : "unpreconditioned")
+		<< " operator, N5= " << N5 << ", non-zero entries A " << a.size() << " B " << b.size()
+		<< ", hopping coefficients";
+    for(int mu=0; mu < Nd; ++mu)
+      QDPIO::cout << " " << coeff[mu];
+    QDPIO::cout << std::endl;
+
+    END_CODE();
+  }
+
+
+  // A chiral 5D matrix onto the sites of a subset
+  void SinglePrecWilsonLikeLinOpArray::chiralLinOp(multi1d<LatticeFermionF>& chi,
+						   const multi1d<LatticeFermionF>& psi,
+						   const std::vector<Entry>& m, const Subset& sub,
+						   enum PlusMinus isign) const
+  {
+    const int G5 = Ns*Ns-1;
+    std::vector<bool> first(N5, true);
+
+    for(int i=0; i < m.size(); ++i)
+    {
+      const Entry& e = m[i];
+      const int row = (isign == PLUS) ? e.s  : e.sp;
+      const int col = (isign == PLUS) ? e.sp : e.s;
+
+      // c_+ P_+ + c_- P_- = (c_+ + c_-)/2 + (c_+ - c_-)/2 gamma_5
+      CmplxF p = 0.5f*(e.plus + e.minus);
+      CmplxF q = 0.5f*(e.plus - e.minus);
+      if (isign == MINUS)
+      {
+	p = std::conj(p);
+	q = std::conj(q);
+      }
+
+      if (first[row])
+      {
+	chi[row][sub] = zero;
+	first[row] = false;
+      }
+
+      if (p.imag() == 0 && q.imag() == 0)
+      {
+	if (q.real() == 0)
+	  chi[row][sub] += RealF(p.real()) * psi[col];
+	else
+	  chi[row][sub] += RealF(p.real()) * psi[col] + RealF(q.real()) * (Gamma(G5) * psi[col]);
+      }
+      else
+	chi[row][sub] += cmplx(RealF(p.real()), RealF(p.imag())) * psi[col]
+	  + cmplx(RealF(q.real()), RealF(q.imag())) * (Gamma(G5) * psi[col]);
+    }
+
+    for(int s=0; s < N5; ++s)
+      if (first[s])
+	chi[s][sub] = zero;
+  }
+
+
+  // Hopping term onto the sites of a checkerboard
+  void SinglePrecWilsonLikeLinOpArray::hopLinOp(multi1d<LatticeFermionF>& chi,
+						const multi1d<LatticeFermionF>& psi,
+						int cb, enum PlusMinus isign) const
+  {
+    for(int s=0; s < N5; ++s)
+      D->apply(chi[s], psi[s], isign, cb);
+  }
+
+
+  // Apply the 5D operator
+  void SinglePrecWilsonLikeLinOpArray::operator()(multi1d<LatticeFermionF>& chi,
+						  const multi1d<LatticeFermionF>& psi,
+						  enum PlusMinus isign) const
+  {
+    START_CODE();
+
+    if (chi.size() != N5)
+      chi.resize(N5);
+
+    multi1d<LatticeFermionF> y(N5), t(N5);
+
+    // The -1/2 of H is folded into b and b_ainv
+    if (! eoprec)
+    {
+      if (isign == PLUS)
+      {
+	//  chi = A psi + H B psi
+	chiralLinOp(y, psi, b, all, PLUS);
+	hopLinOp(t, y, 0, PLUS);
+	hopLinOp(t, y, 1, PLUS);
+	chiralLinOp(chi, psi, a, all, PLUS);
+      }
+      else
+      {
+	//  chi = A^dag psi + B^dag H^dag psi
+	hopLinOp(y, psi, 0, MINUS);
+	hopLinOp(y, psi, 1, MINUS);
+	chiralLinOp(t, y, b, all, MINUS);
+	chiralLinOp(chi, psi, a, all, MINUS);
+      }
+
+      for(int s=0; s < N5; ++s)
+	chi[s] += t[s];
+    }
+    else
+    {
+      if (isign == PLUS)
+      {
+	//  chi_o = s (A psi_o - H_oe (B A^-1) H_eo B psi_o)
+	chiralLinOp(y, psi, b, rb[1], PLUS);
+	hopLinOp(t, y, 0, PLUS);
+	chiralLinOp(y, t, b_ainv, rb[0], PLUS);
+	hopLinOp(t, y, 1, PLUS);
+	chiralLinOp(chi, psi, a, rb[1], PLUS);
+      }
+      else
+      {
+	//  chi_o = s (A^dag psi_o - B^dag H_eo^dag (B A^-1)^dag H_oe^dag psi_o)
+	hopLinOp(y, psi, 0, MINUS);
+	chiralLinOp(t, y, b_ainv, rb[0], MINUS);
+	hopLinOp(y, t, 1, MINUS);
+	chiralLinOp(t, y, b, rb[1], MINUS);
+	chiralLinOp(chi, psi, a, rb[1], MINUS);
+      }
+
+      for(int s=0; s < N5; ++s)
+	chi[s][rb[1]] = RealF(scale) * (chi[s] - t[s]);
+    }
+
+    END_CODE();
+  }
+
+}
@@ -0,0 +1,160 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Single precision copies of Wilson like linear operators
+ */
+
+#ifndef __single_prec_wilsonlike_linop_w_h__
+#define __single_prec_wilsonlike_linop_w_h__
+
+#include "chromabase.h"
+#include "handle.h"
+#include "linearop.h"
+#include "eoprec_linop.h"
+#include "actions/ferm/linop/dslash_w.h"
+
+#include <vector>
+#include <complex>
+
+namespace Chroma
+{
+
+  //! Single precision copy of a Wilson like linear operator
+  /*! \ingroup linop
+   *
+   * Any operator of the form
+   *
+   *  M = D(x) - 1/2 sum_mu c_mu [ (1 - gamma_mu) U_mu(x) delta_{x+mu,y}
+   *                              + (1 + gamma_mu) U^dag_mu(x-mu) delta_{x-mu,y} ]
+   *
+   * with a site diagonal D(x) that commutes with gamma_5 is copied, so the
+   * Wilson, clover and twisted mass operators with or without anisotropy
+   * are covered without a single precision version of every action. The
+   * diagonal is probed through the operator, the c_mu are fitted and the
+   * copy is checked against the operator, aborting if it does not match.
+   *
+   * D(x) is kept as a single number when it is the same multiple of the
+   * identity on every site, otherwise as its two chiral 2Nc x 2Nc blocks.
+   * The hopping term is the single precision WilsonDslashF.
+   *
+   * An even-odd preconditioned operator is copied through its
+   * unprecLinOp() as the Schur complement s (M_oo - M_oe M_ee^-1 M_eo),
+   * with the overall factor s fitted as well. Only D_oo and D_ee^-1 are
+   * kept then.
+   */
+  class SinglePrecWilsonLikeLinOp : public LinearOperator<LatticeFermionF>
+  {
+  public:
+    //! Single precision complex number of the site matrices
+    typedef std::complex<float>    CmplxF;
+
+    //! Copy the operator
+    /*!
+     * \param A   operator to copy ( Read )
+     * \param u   links of A with the boundary conditions applied ( Read )
+     */
+    SinglePrecWilsonLikeLinOp(const LinearOperator<LatticeFermion>& A,
+			      const multi1d<LatticeColorMatrix>& u);
+
+    //! Destructor is automatic
+    ~SinglePrecWilsonLikeLinOp() {}
+
+    //! Subset of the copied operator
+    const Subset& subset() const {return (eoprec) ? rb[1] : all;}
+
+    //! Apply the operator onto a source std::vector
+    void operator() (LatticeFermionF& chi, const LatticeFermionF& psi,
+		     enum PlusMinus isign) const;
+
+  private:
+    //! Site diagonal onto the sites of a checkerboard
+    void diagLinOp(LatticeFermionF& chi, const LatticeFermionF& psi,
+		   int cb, enum PlusMinus isign) const;
+
+  private:
+    bool                          eoprec;
+    Handle<WilsonDslashF>         D;          /*!< hopping term with the c_mu */
+    double                        scale;      /*!< s of the Schur complement */
+    bool                          scalar;     /*!< D(x) is a multiple of the identity */
+    CmplxF                        diag_scalar[2];
+    std::vector<CmplxF>           diag[2];    /*!< [site of rb[cb]][2][2Nc][2Nc] */
+  };
+
+
+  //! Single precision copy of a domain wall like linear operator
+  /*! \ingroup linop
+   *
+   * Any 5D operator of the form
+   *
+   *  (M psi)_s = sum_s' [ A^+_{ss'} P_+ + A^-_{ss'} P_- ] psi_s'
+   *            + H sum_s' [ B^+_{ss'} P_+ + B^-_{ss'} P_- ] psi_s'
+   *
+   * with P_+- = (1 +- gamma_5)/2 and H the 4D Wilson hopping term with
+   * coefficients c_mu is copied. This covers the Shamir, Moebius and
+   * general NEF domain wall operators. The A, B and c_mu are fitted to the
+   * operator on chiral probes, one per slice, and the copy is checked
+   * against the operator, aborting if it does not match. A and B are
+   * kept as their non-zero entries.
+   *
+   * An even-odd preconditioned operator is copied through its
+   * unprecLinOp() as the Schur complement as in SinglePrecWilsonLikeLinOp,
+   * where M_oe M_ee^-1 M_eo = H (B A^-1) H B and B A^-1 is kept.
+   */
+  class SinglePrecWilsonLikeLinOpArray : public LinearOperatorArray<LatticeFermionF>
+  {
+  public:
+    //! Single precision complex number of the coefficients
+    typedef std::complex<float>    CmplxF;
+
+    //! Non-zero entry of a chiral 5D matrix
+    struct Entry
+    {
+      int      s;           /*!< row */
+      int      sp;          /*!< column */
+      CmplxF   plus;        /*!< coefficient of P_+ */
+      CmplxF   minus;       /*!< coefficient of P_- */
+    };
+
+    //! Copy the operator
+    /*!
+     * \param A   operator to copy ( Read )
+     * \param u   links of A with the boundary conditions applied ( Read )
+     */
+    SinglePrecWilsonLikeLinOpArray(const LinearOperatorArray<LatticeFermion>& A,
+				   const multi1d<LatticeColorMatrix>& u);
+
+    //! Destructor is automatic
+    ~SinglePrecWilsonLikeLinOpArray() {}
+
+    //! Length of the 5th dimension
+    int size() const {return N5;}
+
+    //! Subset of the copied operator
+    const Subset& subset() const {return (eoprec) ? rb[1] : all;}
+
+    //! Apply the operator onto a source std::vector
+    void operator() (multi1d<LatticeFermionF>& chi, const multi1d<LatticeFermionF>& psi,
+		     enum PlusMinus isign) const;
+
+  private:
+    //! A chiral 5D matrix onto the sites of a subset
+    void chiralLinOp(multi1d<LatticeFermionF>& chi, const multi1d<LatticeFermionF>& psi,
+		     const std::vector<Entry>& m, const Subset& sub,
+		     enum PlusMinus isign) const;
+
+    //! Hopping term onto the sites of a checkerboard
+    void hopLinOp(multi1d<LatticeFermionF>& chi, const multi1d<LatticeFermionF>& psi,
+		  int cb, enum PlusMinus isign) const;
+
+  private:
+    int                   N5;
+    bool                  eoprec;
+    Handle<WilsonDslashF> D;          /*!< 4D hopping term with the c_mu */
+    double                scale;      /*!< s of the Schur complement */
+    std::vector<Entry>    a;          /*!< A */
+    std::vector<Entry>    b;          /*!< B */
+    std::vector<Entry>    b_ainv;     /*!< B A^-1 for the Schur complement */
+  };
+
+} // End namespace
+
+#endif
@@ -5,6 +5,7 @@
  */
 
 #include "eoprec_wilstype_fermact_w.h"
+#include "util/info/profiler.h"
 
 namespace Chroma 
 { 
@@ -42,6 +43,8 @@ namespace Chroma
     {
       START_CODE();
 
+      ProfileRegion region("qprop");
+
       /* Step (i) */
       /* chi_tmp =  chi_o - D_oe * A_ee^-1 * chi_e */
       T chi_tmp;
@@ -54,7 +57,11 @@ namespace Chroma
       }
 
       // Call inverter
-      SystemSolverResults_t res = (*invA)(psi, chi_tmp);
+      SystemSolverResults_t res;
+      {
+	ProfileRegion solve_region("solve");
+	res = (*invA)(psi, chi_tmp);
+      }
 
       /* Step (ii) */
       /* psi_e = A_ee^-1 * [chi_e  -  D_eo * psi_o] */
@@ -6,6 +6,7 @@
 
 #include "fermact.h"
 #include "actions/ferm/invert/invcg2.h"
+#include "util/info/profiler.h"
 
 
 namespace Chroma 
@@ -49,8 +50,14 @@ namespace Chroma
     {
       START_CODE();
 
+      ProfileRegion region("qprop");
+
       // Call inverter
-      SystemSolverResults_t res = (*invA)(psi, chi);
+      SystemSolverResults_t res;
+      {
+	ProfileRegion solve_region("solve");
+	res = (*invA)(psi, chi);
+      }
   
       // Compute residual
       {
@@ -8,6 +8,7 @@
 
 #include "chromabase.h"
 #include "linearop.h"
+#include "util/info/profiler.h"
 
 using namespace QDP::Hints;
 
@@ -125,6 +126,8 @@ namespace Chroma
     virtual void operator() (T& chi, const T& psi, 
 			     enum PlusMinus isign) const
     {
+      ProfileRegion region("linop", Profiler::TIME_ONLY);
+
       T   tmp1, tmp2; moveToFastMemoryHint(tmp1); moveToFastMemoryHint(tmp2);
 
       /*  Tmp1   =  D     A^(-1)     D    Psi  */
@@ -0,0 +1,37 @@
+/*! \file
+ * \brief Enum for the storage codec of propagators and color vectors
+ */
+
+#include "enum_storage_codec_io.h"
+
+namespace Chroma 
+{ 
+  namespace StorageCodecEnv 
+  { 
+    bool registerAll(void) 
+    {
+      bool success = true; 
+      success &= theStorageCodecMap::Instance().registerPair(std::string("NONE"), STORAGE_CODEC_NONE);
+      success &= theStorageCodecMap::Instance().registerPair(std::string("SINGLE"), STORAGE_CODEC_SINGLE);
+      success &= theStorageCodecMap::Instance().registerPair(std::string("HALF_NORM"), STORAGE_CODEC_HALF_NORM);
+      success &= theStorageCodecMap::Instance().registerPair(std::string("SHUFFLE_LZ"), STORAGE_CODEC_SHUFFLE_LZ);
+      return success;
+    }
+
+    bool registered = registerAll();
+    const std::string typeIDString = "StorageCodec";
+  }
+  using namespace StorageCodecEnv;
+
+  //! Read a storage codec enum
+  void read(XMLReader& xml_in,  const std::string& path, StorageCodec& t) 
+  {
+    theStorageCodecMap::Instance().read(typeIDString, xml_in, path,t);
+  }
+  
+  //! Write a storage codec enum
+  void write(XMLWriter& xml_out, const std::string& path, const StorageCodec& t) 
+  {
+    theStorageCodecMap::Instance().write(typeIDString, xml_out, path, t);
+  }
+}
@@ -0,0 +1,64 @@
+// -*- C++ -*-
+
+/*! \file
+ * \brief Enum for the storage codec of propagators and color vectors
+ *
+ */
+
+#ifndef enum_storage_codec_io_h
+#define enum_storage_codec_io_h
+
+#include "chromabase.h"
+#include <string>
+#include "singleton.h"
+#include "io/enum_io/enum_type_map.h"
+
+
+namespace Chroma 
+{
+  // StorageCodec --------------------------------------
+  /*!
+   * Types and structures
+   *
+   * \ingroup io
+   *
+   * @{
+   */
+ 
+  //! Storage codec
+  /*! \ingroup io */
+  enum StorageCodec 
+  {
+    STORAGE_CODEC_NONE,         /*!< as written by QDP++ */
+    STORAGE_CODEC_SINGLE,       /*!< single precision */
+    STORAGE_CODEC_HALF_NORM,    /*!< 16 bits per number with a norm per site */
+    STORAGE_CODEC_SHUFFLE_LZ    /*!< lossless byte shuffle and LZ compression */
+  };
+
+
+  //! Storage codec env
+  /*! \ingroup io */
+  namespace StorageCodecEnv 
+  { 
+    extern const std::string typeIDString;
+    extern bool registered; 
+    bool registerAll(void);   // Forward declaration
+  }
+
+  //! A singleton to hold the typemap
+  /*! \ingroup io */
+  typedef SingletonHolder<EnumTypeMap<StorageCodec> > theStorageCodecMap;
+
+  // Reader and writer
+  //! Read a storage codec enum
+  /*! \ingroup io */
+  void read(XMLReader& r, const std::string& path, StorageCodec& t);
+
+  //! Write a storage codec enum
+  /*! \ingroup io */
+  void write(XMLWriter& w, const std::string& path, const StorageCodec& t);
+
+  /*! @} */   // end of group io
+
+}
+#endif
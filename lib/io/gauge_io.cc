@@ -4,6 +4,7 @@
 
 #include "chromabase.h"
 #include "io/gauge_io.h"
+#include "util/info/profiler.h"
 
 namespace Chroma {
 
@@ -22,6 +23,8 @@ void readGauge(XMLReader& file_xml,
 	       const std::string& file, 
 	       QDP_serialparallel_t serpar)
 {
+  ProfileRegion region("read_gauge");
+
   QDPFileReader to(file_xml,file,serpar);
 
   /* 
@@ -64,6 +67,8 @@ void writeGauge(XMLBufferWriter& file_xml,
 		QDP_volfmt_t volfmt, 
 		QDP_serialparallel_t serpar)
 {
+  ProfileRegion region("write_gauge");
+
   QDPFileWriter to(file_xml,file,volfmt,serpar,QDPIO_OPEN);
   if (to.bad())
   {
@@ -0,0 +1,124 @@
+/*! \file
+ *  \brief Read the site data of foreign gauge files in large slabs
+ */
+
+#include "io/gauge_slab_reader.h"
+#include "qdp_util.h"    // from QDP
+
+#include <cstring>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#define CHROMA_GAUGE_SLAB_MMAP
+#endif
+
+namespace Chroma {
+
+// Read through a file positioned at the start of the site data
+GaugeSlabReader::GaugeSlabReader(BinaryFileReader& cfg_in_, bool byterev_, int floats_per_site_) :
+  cfg_in(cfg_in_), byterev(byterev_), floats_per_site(floats_per_site_),
+  map(0), map_size(0), map_pos(0), map_swap(false)
+{
+  init();
+}
+
+
+// As above, memory mapping the file on a single node
+GaugeSlabReader::GaugeSlabReader(BinaryFileReader& cfg_in_, bool byterev_, int floats_per_site_,
+				 const std::string& cfg_file, size_t data_offset) :
+  cfg_in(cfg_in_), byterev(byterev_), floats_per_site(floats_per_site_),
+  map(0), map_size(0), map_pos(0), map_swap(false)
+{
+  init();
+
+#ifdef CHROMA_GAUGE_SLAB_MMAP
+  if (Layout::numNodes() != 1)
+    return;
+
+  int fd = open(cfg_file.c_str(), O_RDONLY);
+  if (fd < 0)
+    return;
+
+  struct stat st;
+  if (fstat(fd, &st) == 0 && size_t(st.st_size) > data_offset)
+  {
+    void* p = mmap(0, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (p != MAP_FAILED)
+    {
+      map      = p;
+      map_size = st.st_size;
+      map_pos  = data_offset;
+
+      // The values read through cfg_in are first taken as big endian
+      map_swap = (! QDPUtil::big_endian()) != byterev;
+
+#ifdef MADV_SEQUENTIAL
+      madvise(map, map_size, MADV_SEQUENTIAL);
+#endif
+    }
+  }
+
+  close(fd);
+#endif
+}
+
+
+GaugeSlabReader::~GaugeSlabReader()
+{
+#ifdef CHROMA_GAUGE_SLAB_MMAP
+  if (map != 0)
+    munmap(map, map_size);
+#endif
+}
+
+
+// Slab size
+void GaugeSlabReader::init()
+{
+  // About 16 MB per slab
+  const size_t slab_bytes = 16*1024*1024;
+  slab_sites = slab_bytes / (floats_per_site*sizeof(float));
+
+  if (slab_sites < 1)
+    slab_sites = 1;
+  if (slab_sites > Layout::vol())
+    slab_sites = Layout::vol();
+}
+
+
+// Next nsites sites on all nodes
+const float* GaugeSlabReader::read(int nsites)
+{
+  const size_t nfloat = size_t(nsites) * floats_per_site;
+  buf.resize(nfloat);
+
+  if (map != 0)
+  {
+    if (map_pos + nfloat*sizeof(float) > map_size)
+    {
+      QDPIO::cerr << __func__ << ": unexpected end of gauge file" << std::endl;
+      QDP_abort(1);
+    }
+
+    std::memcpy(&buf[0], (const char*)map + map_pos, nfloat*sizeof(float));
+    map_pos += nfloat*sizeof(float);
+
+    if (map_swap)
+      QDPUtil::byte_swap((void *)&buf[0], sizeof(float), nfloat);
+  }
+  else
+  {
+    // The primary node reads, all nodes receive the slab
+    cfg_in.readArray((char*)&buf[0], sizeof(float), nfloat);
+
+    if (byterev)
+      QDPUtil::byte_swap((void *)&buf[0], sizeof(float), nfloat);
+  }
+
+  return &buf[0];
+}
+
+}  // end namespace Chroma
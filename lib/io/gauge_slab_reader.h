@@ -0,0 +1,74 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Read the site data of foreign gauge files in large slabs
+ */
+
+#ifndef __gauge_slab_reader_h__
+#define __gauge_slab_reader_h__
+
+#include "chromabase.h"
+
+#include <vector>
+
+namespace Chroma {
+
+//! Read the site data of foreign gauge files in large slabs
+/*!
+ * \ingroup io
+ *
+ * The site data of MILC and SZIN files are single precision floats. The
+ * primary node reads a slab of consecutive sites in one call, the slab is
+ * sent to all nodes at once, and every node byte swaps it and picks out
+ * its own sites. This replaces one read and one message per site.
+ *
+ * On a single node the file can instead be memory mapped, so the slabs
+ * are copied straight out of the page cache.
+ */
+class GaugeSlabReader
+{
+public:
+  //! Read through a file positioned at the start of the site data
+  /*!
+   * \param cfg_in            open file ( Modify )
+   * \param byterev           swap the values read with cfg_in ( Read )
+   * \param floats_per_site   floats stored per site ( Read )
+   */
+  GaugeSlabReader(BinaryFileReader& cfg_in, bool byterev, int floats_per_site);
+
+  //! As above, memory mapping the file on a single node
+  /*!
+   * \param cfg_file          path of the file ( Read )
+   * \param data_offset       bytes before the site data ( Read )
+   */
+  GaugeSlabReader(BinaryFileReader& cfg_in, bool byterev, int floats_per_site,
+		  const std::string& cfg_file, size_t data_offset);
+
+  ~GaugeSlabReader();
+
+  //! Number of sites in a full slab
+  int slabSites() const {return slab_sites;}
+
+  //! Is the file memory mapped
+  bool mapped() const {return map != 0;}
+
+  //! Next nsites sites on all nodes, in native byte order
+  const float* read(int nsites);
+
+private:
+  BinaryFileReader&   cfg_in;
+  bool                byterev;
+  int                 floats_per_site;
+  int                 slab_sites;
+  std::vector<float>  buf;
+
+  void*               map;         /*!< mapped file, or 0 */
+  size_t              map_size;
+  size_t              map_pos;     /*!< next byte to read */
+  bool                map_swap;    /*!< mapped data not in native order */
+
+  void init();
+};
+
+}  // end namespace Chroma
+
+#endif
@@ -1,10 +1,36 @@
 #include "chromabase.h"
 #include "io/inline_io.h"
 #include "meas/inline/abs_inline_measurement_factory.h"
+#include "util/info/profiler.h"
 
 
 namespace Chroma { 
 
+  // Anonymous namespace
+  namespace
+  {
+    //! Runs a measurement inside a profiler region named after it
+    class ProfiledInlineMeasurement : public AbsInlineMeasurement
+    {
+    public:
+      ProfiledInlineMeasurement(const std::string& name_, AbsInlineMeasurement* meas_) :
+	name(name_), meas(meas_) {}
+
+      unsigned long getFrequency(void) const {return meas->getFrequency();}
+
+      void operator()(unsigned long update_no, XMLWriter& xml_out)
+      {
+	ProfileRegion region(name);
+	(*meas)(update_no, xml_out);
+      }
+
+    private:
+      std::string                    name;
+      Handle<AbsInlineMeasurement>   meas;
+    };
+  }
+
+
   // Read an inline measurement
   void read(XMLReader& xml,
 	    const std::string& path,
@@ -29,10 +55,16 @@ namespace Chroma {
       QDP_abort(1);
     }
     
-    return TheInlineMeasurementFactory::Instance().createObject(measurement_name, 
-								xml,
-								path);
-    
+    AbsInlineMeasurement* meas = 
+      TheInlineMeasurementFactory::Instance().createObject(measurement_name, 
+							   xml,
+							   path);
+
+    // Only wrapped when profiling, so nothing changes otherwise
+    if (TheProfiler::Instance().enabled())
+      meas = new ProfiledInlineMeasurement(measurement_name, meas);
+
+    return meas;
   }
   
 }
@@ -42,6 +42,7 @@ void read(XMLReader& xml_in, const std::string& path, OverlapStateInfo& info)
   int  NWilsVec;
   bool load_eigenP;
   EigenIO_t eigen_io;
+  std::string eigen_id;
   RitzParams_t ritzery;
 
 
@@ -106,6 +107,11 @@ void read(XMLReader& xml_in, const std::string& path, OverlapStateInfo& info)
     ApproxMin =0;
     ApproxMax =0;
 
+    if( reader.count("Eig") + reader.count("Ritz") + reader.count("EigenId") > 1 ) {
+      QDPIO::cerr << "Specify only one of Eig, Ritz and EigenId " << std::endl;
+      QDP_abort(1);
+    }
+
     if( reader.count("Eig") == 1 ) {
       if( reader.count("Ritz") == 1 ) {
 	QDPIO::cerr << "Cannot specify both Eig and Ritz " << std::endl;
@@ -152,9 +158,20 @@ void read(XMLReader& xml_in, const std::string& path, OverlapStateInfo& info)
       ritzery.Neig = NWilsVec;
       load_eigenP = false;
     }
+    else if ( reader.count("EigenId") == 1 ) {
+      // Eigenpairs held in a named EigenInfo object
+      try { 
+	read(reader, "EigenId", eigen_id);
+      }
+      catch( const std::string& e ) { 
+	QDPIO::cerr << "Caught exception: " << e << std::endl;
+	QDP_abort(1);
+      }
+      load_eigenP = true;
+    }
     else { 
-      QDPIO::cerr << "Must specify either Eig for loadable eigenvalues or "
-		  << "Ritz Parameters for compuing eigenvalues" << std::endl;
+      QDPIO::cerr << "Must specify either Eig for loadable eigenvalues, EigenId for "
+		  << "a named object or Ritz Parameters for compuing eigenvalues" << std::endl;
       QDP_abort(1);
     }
 
@@ -165,7 +182,8 @@ void read(XMLReader& xml_in, const std::string& path, OverlapStateInfo& info)
 	    NWilsVec,
 	    load_eigenP,
 	    eigen_io,
-	    ritzery);
+	    ritzery,
+	    eigen_id);
 
 }
 
@@ -184,7 +202,10 @@ void write(XMLWriter& xml_out, const std::string& path, const OverlapStateInfo&
   }
   else {
     if( info.loadEigVec() ) { 
-      write(xml_out, "Eig", info.getEigenIO());
+      if( info.getEigenId() != "" )
+	write(xml_out, "EigenId", info.getEigenId());
+      else
+	write(xml_out, "Eig", info.getEigenIO());
     }
     else if ( info.computeEigVec() ) { 
       
@@ -16,6 +16,7 @@ namespace Chroma
     int  NWilsVec;
     bool load_eigenP;
     EigenIO_t eigen_io;
+    std::string eigen_id;
     RitzParams_t ritzery;
 
     void notInited(void) const { 
@@ -43,13 +44,15 @@ namespace Chroma
 	      const int&  _NWilsVec,
 	      const bool& _load_eigenP,
 	      const EigenIO_t& _eigen_io,
-	      const RitzParams_t& _ritzery) {
+	      const RitzParams_t& _ritzery,
+	      const std::string& _eigen_id = "") {
       ApproxMin = _ApproxMin;
       ApproxMax =_ApproxMax;
       NWilsVec= _NWilsVec;
       load_eigenP = _load_eigenP;
       eigen_io = _eigen_io;
       ritzery = _ritzery;
+      eigen_id = _eigen_id;
       initedP = true; 
     }
 
@@ -94,6 +97,17 @@ namespace Chroma
       return eigen_io; 
     }
 
+    //! Named EigenInfo object holding the eigenpairs, empty if they are in a file
+    const std::string& getEigenId(void) const {
+      if( ! initedP)
+	notInited();
+
+      if( ! loadEigVec() )
+	notLoadEig();
+
+      return eigen_id;
+    }
+
     const RitzParams_t& getRitzParams(void) const {
       if (! initedP)
 	notInited();
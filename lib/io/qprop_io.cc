@@ -5,6 +5,7 @@
 #include "chromabase.h"
 #include "io/param_io.h"
 #include "io/qprop_io.h"
+#include "io/storage_codec.h"
 
 #include "meas/smear/simple_quark_displacement.h"
 #include "meas/smear/ape_link_smearing.h"
@@ -1123,6 +1124,16 @@ namespace Chroma
   }
 
 
+  // CoherentSeqSource header reader
+  void read(XMLReader& xml, const std::string& path, CoherentSeqSource_t& param)
+  {
+    XMLReader paramtop(xml, path);
+
+    read(paramtop, "SeqSource", param.seqsource_header);
+    read(paramtop, "ForwardProps", param.forward_props);
+  }
+
+
   // SequentialSource header reader
   void read(XMLReader& xml, const std::string& path, SequentialSource_t& param)
   {
@@ -1132,6 +1143,11 @@ namespace Chroma
     read(paramtop, "SeqSource", param.seqsource_header);
     read(paramtop, "ForwardProps", param.forward_props);
     readGaugeHeader(paramtop, "Config_info", param.gauge_header);
+
+    if (paramtop.count("CoherentSources") != 0)
+      read(paramtop, "CoherentSources", param.coherent_sources);
+    else
+      param.coherent_sources.resize(0);
   }
 
 
@@ -1145,6 +1161,47 @@ namespace Chroma
     read(paramtop, "SeqSource", param.seqsource_header);
     read(paramtop, "ForwardProps", param.forward_props);
     readGaugeHeader(paramtop, "Config_info", param.gauge_header);
+
+    if (paramtop.count("CoherentSources") != 0)
+      read(paramtop, "CoherentSources", param.coherent_sources);
+    else
+      param.coherent_sources.resize(0);
+  }
+
+
+  // Number of coherent groups in a sequential prop
+  int numCoherentGroups(const SequentialProp_t& header)
+  {
+    return 1 + header.coherent_sources.size();
+  }
+
+
+  // Extract one coherent group of a sequential prop
+  SequentialProp_t coherentSeqPropGroup(const SequentialProp_t& header, int group)
+  {
+    if (group < 0 || group >= numCoherentGroups(header))
+    {
+      QDPIO::cerr << __func__ << ": coherent group " << group << " out of bounds" << std::endl;
+      QDP_abort(1);
+    }
+
+    SequentialProp_t new_header;
+    new_header.seqprop_header = header.seqprop_header;
+    new_header.sink_header    = header.sink_header;
+    new_header.gauge_header   = header.gauge_header;
+
+    if (group == 0)
+    {
+      new_header.seqsource_header = header.seqsource_header;
+      new_header.forward_props    = header.forward_props;
+    }
+    else
+    {
+      new_header.seqsource_header = header.coherent_sources[group-1].seqsource_header;
+      new_header.forward_props    = header.coherent_sources[group-1].forward_props;
+    }
+
+    return new_header;
   }
 
 
@@ -1417,6 +1474,18 @@ namespace Chroma
   }
 
 
+  //! CoherentSeqSource header writer
+  void write(XMLWriter& xml, const std::string& path, const CoherentSeqSource_t& param)
+  {
+    push(xml, path);
+
+    write(xml, "SeqSource", param.seqsource_header);
+    write(xml, "ForwardProps", param.forward_props);
+
+    pop(xml);
+  }
+
+
   //! SequentialSource header writer
   void write(XMLWriter& xml, const std::string& path, const SequentialSource_t& param)
   {
@@ -1430,6 +1499,10 @@ namespace Chroma
     write(xml, "ForwardProps", param.forward_props);
     write(xml, "Config_info", param.gauge_header);
 
+    // Only coherent seqsources carry the extra groups
+    if (param.coherent_sources.size() > 0)
+      write(xml, "CoherentSources", param.coherent_sources);
+
 //    if( path != "." )
     pop(xml);
   }
@@ -1449,6 +1522,10 @@ namespace Chroma
     write(xml, "ForwardProps", param.forward_props);
     write(xml, "Config_info", param.gauge_header);
 
+    // Only coherent seqsources carry the extra groups
+    if (param.coherent_sources.size() > 0)
+      write(xml, "CoherentSources", param.coherent_sources);
+
 //    if( path != "." )
     pop(xml);
   }
@@ -1520,6 +1597,65 @@ namespace Chroma
 
 
 
+  // Anonymous namespace
+  namespace
+  {
+    //! Write a lattice object, through a storage codec unless it is NONE
+    template<typename T>
+    void writeLatObj(XMLBufferWriter& file_xml,
+		     XMLBufferWriter& record_xml, const OLattice<T>& obj,
+		     const std::string& file, 
+		     QDP_volfmt_t volfmt, QDP_serialparallel_t serpar,
+		     StorageCodec codec)
+    {
+      if (codec == STORAGE_CODEC_NONE)
+      {
+	QDPFileWriter to(file_xml,file,volfmt,serpar,QDPIO_OPEN);
+	write(to,record_xml,obj);
+	close(to);
+	return;
+      }
+
+      // The codec goes in the file xml, around the original
+      XMLBufferWriter codec_file_xml;
+      StorageCodecEnv::writeCodecFileXML(codec_file_xml, codec, file_xml);
+
+      QDPFileWriter to(codec_file_xml,file,volfmt,serpar,QDPIO_OPEN);
+      StorageCodecEnv::write(to,record_xml,obj,codec);
+      close(to);
+    }
+
+    //! Read a lattice object, decoding it if it was written through a storage codec
+    /*! The file xml returned is the original one in either case */
+    template<typename T>
+    void readLatObj(XMLReader& file_xml,
+		    XMLReader& record_xml, OLattice<T>& obj,
+		    const std::string& file, 
+		    QDP_serialparallel_t serpar)
+    {
+      QDPFileReader to(file_xml,file,serpar);
+
+      if (! StorageCodecEnv::isCodecFile(file_xml))
+      {
+	read(to,record_xml,obj);
+	close(to);
+	return;
+      }
+
+      StorageCodecEnv::read(to,record_xml,obj,StorageCodecEnv::codecFromFileXML(file_xml));
+      close(to);
+
+      XMLReader orig_file_xml(file_xml, StorageCodecEnv::file_xml_path);
+      std::ostringstream os;
+      orig_file_xml.print(os);
+
+      std::istringstream is(os.str());
+      file_xml.close();
+      file_xml.open(is);
+    }
+  }
+
+
   // Write a Chroma propagator
   /*
    * \param file_xml     file header ( Read )
@@ -1528,15 +1664,15 @@ namespace Chroma
    * \param file         path ( Read )
    * \param volfmt       either QDPIO_SINGLEFILE, QDPIO_MULTIFILE ( Read )
    * \param serpar       either QDPIO_SERIAL, QDPIO_PARALLEL ( Read )
+   * \param codec        storage codec ( Read )
    */    
   void writeQprop(XMLBufferWriter& file_xml,
 		  XMLBufferWriter& record_xml, const LatticePropagator& quark_prop,
 		  const std::string& file, 
-		  QDP_volfmt_t volfmt, QDP_serialparallel_t serpar)
+		  QDP_volfmt_t volfmt, QDP_serialparallel_t serpar,
+		  StorageCodec codec)
   {
-    QDPFileWriter to(file_xml,file,volfmt,serpar,QDPIO_OPEN);
-    write(to,record_xml,quark_prop);
-    close(to);
+    writeLatObj(file_xml, record_xml, quark_prop, file, volfmt, serpar, codec);
   }
 
 
@@ -1575,9 +1711,7 @@ namespace Chroma
 		 const std::string& file, 
 		 QDP_serialparallel_t serpar)
   {
-    QDPFileReader to(file_xml,file,serpar);
-    read(to,record_xml,quark_prop);
-    close(to);
+    readLatObj(file_xml, record_xml, quark_prop, file, serpar);
   }
 
   // Read a Chroma propagator
@@ -1609,15 +1743,15 @@ namespace Chroma
    * \param file         path ( Read )
    * \param volfmt       either QDPIO_SINGLEFILE, QDPIO_MULTIFILE ( Read )
    * \param serpar       either QDPIO_SERIAL, QDPIO_PARALLEL ( Read )
+   * \param codec        storage codec ( Read )
    */    
   void writeFermion(XMLBufferWriter& file_xml,
 		    XMLBufferWriter& record_xml, const LatticeFermion& fermion,
 		    const std::string& file, 
-		    QDP_volfmt_t volfmt, QDP_serialparallel_t serpar)
+		    QDP_volfmt_t volfmt, QDP_serialparallel_t serpar,
+		    StorageCodec codec)
   {
-    QDPFileWriter to(file_xml,file,volfmt,serpar,QDPIO_OPEN);
-    write(to,record_xml,fermion);
-    close(to);
+    writeLatObj(file_xml, record_xml, fermion, file, volfmt, serpar, codec);
   }
 
   // Read a Chroma Fermion Field
@@ -1634,9 +1768,7 @@ namespace Chroma
 		   const std::string& file, 
 		   QDP_serialparallel_t serpar)
   {
-    QDPFileReader to(file_xml,file,serpar);
-    read(to,record_xml,fermion);
-    close(to);
+    readLatObj(file_xml, record_xml, fermion, file, serpar);
   }
 
 }  // end namespace Chroma
@@ -9,6 +9,7 @@
 #include "io/xml_group_reader.h"
 #include "io/enum_io/enum_qdpvolfmt_io.h"
 #include "io/enum_io/enum_quarkspintype_io.h"
+#include "io/enum_io/enum_storage_codec_io.h"
 
 namespace Chroma 
 {
@@ -125,6 +126,20 @@ namespace Chroma
   };
 
 
+  //! One extra group of a coherent sequential source
+  /*!
+   * A coherent sequential source is the sum of sequential sources built
+   * from forward props at well-separated source positions. The first group
+   * lives in the usual seqsource_header/forward_props slots, any further
+   * groups are held in this structure.
+   */
+  struct CoherentSeqSource_t
+  {
+    SeqSource_t             seqsource_header;
+    multi1d<ForwardProp_t>  forward_props;
+  };
+
+
   //! Mega structure holding a full sequential source
   struct SequentialSource_t
   {
@@ -132,6 +147,7 @@ namespace Chroma
     SeqSource_t             seqsource_header;
     multi1d<ForwardProp_t>  forward_props;
     std::string             gauge_header;
+    multi1d<CoherentSeqSource_t>  coherent_sources;   /*!< extra coherent groups (may be empty) */
   };
 
 
@@ -143,6 +159,7 @@ namespace Chroma
     SeqSource_t            seqsource_header;
     multi1d<ForwardProp_t> forward_props;
     std::string            gauge_header;
+    multi1d<CoherentSeqSource_t>  coherent_sources;   /*!< extra coherent groups (may be empty) */
   };
 
 
@@ -264,6 +281,13 @@ namespace Chroma
   void write(XMLWriter& xml, const std::string& path, const ForwardProp_t& header);
 
 
+  //! CoherentSeqSource reader
+  void read(XMLReader& xml, const std::string& path, CoherentSeqSource_t& header);
+
+  //! CoherentSeqSource writer
+  void write(XMLWriter& xml, const std::string& path, const CoherentSeqSource_t& header);
+
+
   //! SequentialSource reader
   void read(XMLReader& xml, const std::string& path, SequentialSource_t& header);
 
@@ -278,6 +302,17 @@ namespace Chroma
   void write(XMLWriter& xml, const std::string& path, const SequentialProp_t& header);
 
 
+  //! Number of coherent groups in a sequential prop (1 for a plain seqprop)
+  int numCoherentGroups(const SequentialProp_t& header);
+
+  //! Extract one coherent group of a sequential prop as a plain seqprop header
+  /*!
+   * Group 0 is the primary group. The returned header has no coherent_sources,
+   * so things like HadronSeqSource::tieBack see a single source position.
+   */
+  SequentialProp_t coherentSeqPropGroup(const SequentialProp_t& header, int group);
+
+
   //! Source/sink spin indices
   void read(XMLReader& xml, const std::string& path, QQQSpinIndices_t& input);
 
@@ -314,15 +349,18 @@ namespace Chroma
    * \param file         path ( Read )
    * \param volfmt       either QDP_SINGLEFILE, QDP_MULTIFILE ( Read )
    * \param serpar       either QDP_SERIAL, QDP_PARALLEL ( Read )
+   * \param codec        storage codec, optional ( Read )
    */    
   void writeQprop(XMLBufferWriter& file_xml,
 		  XMLBufferWriter& record_xml, const LatticePropagator& quark_prop,
 		  const std::string& file, 
-		  QDP_volfmt_t volfmt, QDP_serialparallel_t serpar);
+		  QDP_volfmt_t volfmt, QDP_serialparallel_t serpar,
+		  StorageCodec codec = STORAGE_CODEC_NONE);
 
 
   //! Read a Chroma propagator
-  /*
+  /*! Propagators written through a storage codec are decoded
+   *
    * \param file_xml     file header ( Write )
    * \param record_xml   xml holding propagator info ( Write )
    * \param quark_prop   propagator ( Write )
@@ -342,15 +380,18 @@ namespace Chroma
    * \param file         path ( Read )
    * \param volfmt       either QDPIO_SINGLEFILE, QDPIO_MULTIFILE ( Read )
    * \param serpar       either QDPIO_SERIAL, QDPIO_PARALLEL ( Read )
+   * \param codec        storage codec, optional ( Read )
    */    
   void writeFermion(XMLBufferWriter& file_xml,
 		    XMLBufferWriter& record_xml, const LatticeFermion& fermion,
 		    const std::string& file, 
-		    QDP_volfmt_t volfmt, QDP_serialparallel_t serpar);
+		    QDP_volfmt_t volfmt, QDP_serialparallel_t serpar,
+		    StorageCodec codec = STORAGE_CODEC_NONE);
 
 
   // Read a Chroma Fermion Field
-  /*
+  /* Fermions written through a storage codec are decoded
+   *
    * \param file_xml     file header ( Write )
    * \param record_xml   xml holding propagator info ( Write )
    * \param fermion      The Fermion ( Write )
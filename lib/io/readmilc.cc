@@ -6,10 +6,70 @@
 #include "chromabase.h"
 #include "io/milc_io.h"
 #include "io/readmilc.h"
+#include "io/gauge_slab_reader.h"
 #include "qdp_util.h"    // from QDP
 
+#include <cstring>
+#include <stdint.h>
+#include <algorithm>
+
 namespace Chroma {
 
+namespace
+{
+  //! MILC checksums
+  struct MILCChecksum_t
+  {
+    unsigned int sum29;
+    unsigned int sum31;
+  };
+
+  //! Rotate left by r < 32 bits
+  inline unsigned int rotl(unsigned int w, int r)
+  {
+    return (r == 0) ? w : ((w << r) | (w >> (32-r)));
+  }
+
+  //! Add the 32-bit words of a site to the checksums
+  /*! Word k of the file is rotated by k mod 29 and k mod 31 bits */
+  inline void milcChecksumSite(MILCChecksum_t& check, const float* p, int nwords, int site)
+  {
+    int r29 = (size_t(nwords)*site) % 29;
+    int r31 = (size_t(nwords)*site) % 31;
+
+    for(int k=0; k < nwords; ++k)
+    {
+      uint32_t w;
+      std::memcpy(&w, p+k, sizeof(w));
+
+      check.sum29 ^= rotl(w, r29);
+      check.sum31 ^= rotl(w, r31);
+      if (++r29 >= 29) r29 = 0;
+      if (++r31 >= 31) r31 = 0;
+    }
+  }
+
+  //! Xor the checksums of all nodes
+  void globalChecksum(MILCChecksum_t& check)
+  {
+    multi1d<REAL64> bits(64);
+    for(int b=0; b < 32; ++b)
+    {
+      bits[b]    = (check.sum29 >> b) & 1;
+      bits[32+b] = (check.sum31 >> b) & 1;
+    }
+
+    QDPInternal::globalSumArray(bits.slice(), bits.size());
+
+    check.sum29 = check.sum31 = 0;
+    for(int b=0; b < 32; ++b)
+    {
+      check.sum29 |= (((unsigned int)(bits[b]) & 1) << b);
+      check.sum31 |= (((unsigned int)(bits[32+b]) & 1) << b);
+    }
+  }
+}
+
 //! Read a MILC configuration file
 /*!
  * \ingroup io
@@ -66,7 +126,7 @@ void readMILC(MILCGauge_t& header, multi1d<LatticeColorMatrixF>& u, const std::s
     QDP_error_exit("readMILC: only support non-sitelist format");
 
 
-  // Go ahead an read checksums, but will not use for now
+  // Checksums, verified against the data below
   unsigned int sum29, sum31;
   read(cfg_in, sum29);
   read(cfg_in, sum31);
@@ -80,6 +140,55 @@ void readMILC(MILCGauge_t& header, multi1d<LatticeColorMatrixF>& u, const std::s
    * Read away...
    */
   
+#ifndef QDP_IS_QDPJIT
+  // MILC format has the directions inside the sites
+  const int nreal = 2*Nc*Nc;
+  const size_t data_offset = sizeof(int)*(1 + Nd + 1 + 2) + 64;
+
+  GaugeSlabReader slab_in(cfg_in, byterev, Nd*nreal, cfg_file, data_offset);
+  if (slab_in.mapped())
+    QDPIO::cout << "readMILC: reading memory mapped file" << std::endl;
+
+  MILCChecksum_t check;
+  check.sum29 = check.sum31 = 0;
+
+  for(int first=0; first < Layout::vol(); first += slab_in.slabSites())
+  {
+    int nsites = std::min(slab_in.slabSites(), Layout::vol() - first);
+    const float* slab = slab_in.read(nsites);
+
+    // Each node takes its own sites
+    for(int i=0; i < nsites; ++i)
+    {
+      multi1d<int> coord = crtesn(first+i, Layout::lattSize()); // The coordinate
+      if (Layout::nodeNumber(coord) != Layout::nodeNumber())
+	continue;
+
+      int linear = Layout::linearSiteIndex(coord);
+      const float* p = slab + size_t(i)*Nd*nreal;
+
+      // NOTE: the su3_matrix layout should be the same as in QDP
+      for(int mu=0; mu < Nd; ++mu)
+	std::memcpy(&(u[mu].elem(linear).elem().elem(0,0).real()), p + mu*nreal, nreal*sizeof(float));
+
+      milcChecksumSite(check, p, Nd*nreal, first+i);
+    }
+  }
+
+  cfg_in.close();
+
+  // The checksums are xor-ed over all sites, so combine the nodes bitwise
+  globalChecksum(check);
+
+  if (check.sum29 != sum29 || check.sum31 != sum31)
+  {
+    QDPIO::cerr << "readMILC: checksum mismatch: computed (sum29, sum31) = "
+		<< check.sum29 << " " << check.sum31 << std::endl;
+    QDP_abort(1);
+  }
+  QDPIO::cout << "readMILC: checksums agree" << std::endl;
+
+#else
   // MILC format has the directions inside the sites
   for(int site=0; site < Layout::vol(); ++site)
   {
@@ -93,7 +202,6 @@ void readMILC(MILCGauge_t& header, multi1d<LatticeColorMatrixF>& u, const std::s
 
   cfg_in.close();
   
-  //QDPUtil::byte_swap((void *)&buf[0], sizeof(Real64), latt_size[0]*Nc*Nc*2 );
   if(byterev){
     QDPIO::cout<<"Doing bytereversal on the links...\n" ;
     for(int mu(0);mu<Nd;mu++)
@@ -101,6 +209,7 @@ void readMILC(MILCGauge_t& header, multi1d<LatticeColorMatrixF>& u, const std::s
       for(int s(0); s < Layout::sitesOnNode(); s++)
 	QDPUtil::byte_swap((void *)&u[mu].elem(s).elem(),sizeof(RealF),2*Nc*Nc);
   }
+#endif
 
   END_CODE();
 }
@@ -7,8 +7,12 @@
 #include "io/szin_io.h"
 #include "io/readszin.h"
 // #include "io/param_io.h"
+#include "io/gauge_slab_reader.h"
 #include "qdp_util.h"    // from QDP
 
+#include <cstring>
+#include <algorithm>
+
 namespace Chroma {
 
 #define SZIN_WILSON_FERMIONS  1
@@ -260,12 +264,45 @@ void readSzin(SzinGauge_t& header, multi1d<LatticeColorMatrix>& u, const std::st
   multi1d<int> lattsize_cb = Layout::lattSize();
   lattsize_cb[0] /= 2;		// Evaluate the coords on the checkerboard lattice
 
+#ifndef QDP_IS_QDPJIT
+  // Read the sites in slabs, each node takes its own
+  const int nreal = 2*Nc*Nc;
+  GaugeSlabReader slab_in(cfg_in, false, nreal);
+#endif
+
   // The slowest moving index is the direction
   for(int j = 0; j < Nd; j++)
   {
     LatticeColorMatrixF u_old;
   
     for(int cb=0; cb < 2; ++cb) { 
+#ifndef QDP_IS_QDPJIT
+      for(int first=0; first < Layout::vol()/2; first += slab_in.slabSites())
+      {
+	int nsites = std::min(slab_in.slabSites(), Layout::vol()/2 - first);
+	const float* slab = slab_in.read(nsites);
+
+	for(int i=0; i < nsites; ++i)
+	{
+	  multi1d<int> coord = crtesn(first+i, lattsize_cb); // The coordinate
+      
+	  // construct the checkerboard offset
+	  int sum = 0;
+	  for(int m=1; m<Nd; m++)
+	    sum += coord[m];
+
+	  // The true lattice x-coord
+	  coord[0] = 2*coord[0] + ((sum + cb) & 1);
+
+	  if (Layout::nodeNumber(coord) != Layout::nodeNumber())
+	    continue;
+
+	  // An SU(3) matrix into coord
+	  std::memcpy(&(u_old.elem(Layout::linearSiteIndex(coord)).elem().elem(0,0).real()),
+		      slab + size_t(i)*nreal, nreal*sizeof(float));
+	}
+      }
+#else
       for(int sitecb=0; sitecb < Layout::vol()/2; ++sitecb)
       {
 	multi1d<int> coord = crtesn(sitecb, lattsize_cb); // The coordinate
@@ -280,6 +317,7 @@ void readSzin(SzinGauge_t& header, multi1d<LatticeColorMatrix>& u, const std::st
 
 	read(cfg_in, u_old, coord); 	// Read in an SU(3) matrix into coord
       }
+#endif
     }
     LatticeColorMatrix u_old_prec(u_old);
    
@@ -0,0 +1,524 @@
+/*! \file
+ * \brief Reduced precision and compressed storage of lattice objects
+ */
+
+#include "io/storage_codec.h"
+
+#include <vector>
+#include <cmath>
+#include <cstring>
+#include <stdint.h>
+
+namespace Chroma
+{
+  namespace StorageCodecEnv
+  {
+    // Anonymous namespace
+    namespace
+    {
+      //! Identifies an encoded stream
+      const char magic[8] = {'C','H','R','C','O','D','E','C'};
+
+      //! Magic, codec, word size, words per site, number of words, payload size
+      const int header_size = 8 + 3*4 + 2*8;
+
+      //! Append a big-endian unsigned integer of n bytes
+      void putUInt(std::string& s, uint64_t v, int n)
+      {
+	for(int b=n-1; b >= 0; --b)
+	  s.push_back(char((v >> (8*b)) & 0xff));
+      }
+
+      //! Big-endian unsigned integer of n bytes
+      uint64_t getUInt(const char* p, int n)
+      {
+	uint64_t v = 0;
+	for(int b=0; b < n; ++b)
+	  v = (v << 8) | uint64_t((unsigned char)p[b]);
+	return v;
+      }
+
+      //! Big-endian word of 4 or 8 bytes
+      double getWord(const char* p, int word_size)
+      {
+	if (word_size == 4)
+	{
+	  uint32_t u = uint32_t(getUInt(p, 4));
+	  float f;
+	  std::memcpy(&f, &u, 4);
+	  return f;
+	}
+	else
+	{
+	  uint64_t u = getUInt(p, 8);
+	  double d;
+	  std::memcpy(&d, &u, 8);
+	  return d;
+	}
+      }
+
+      //! Append a big-endian word of 4 or 8 bytes
+      void putWord(std::string& s, double v, int word_size)
+      {
+	if (word_size == 4)
+	{
+	  float f = v;
+	  uint32_t u;
+	  std::memcpy(&u, &f, 4);
+	  putUInt(s, u, 4);
+	}
+	else
+	{
+	  uint64_t u;
+	  std::memcpy(&u, &v, 8);
+	  putUInt(s, u, 8);
+	}
+      }
+
+      //! Append a variable length integer
+      void putVarInt(std::string& s, uint64_t v)
+      {
+	while (v >= 0x80)
+	{
+	  s.push_back(char((v & 0x7f) | 0x80));
+	  v >>= 7;
+	}
+	s.push_back(char(v));
+      }
+
+      //! Variable length integer
+      uint64_t getVarInt(const std::string& s, size_t& pos)
+      {
+	uint64_t v = 0;
+	int shift = 0;
+	while (pos < s.size())
+	{
+	  unsigned char c = s[pos++];
+	  v |= uint64_t(c & 0x7f) << shift;
+	  if ((c & 0x80) == 0)
+	    break;
+	  shift += 7;
+	}
+	return v;
+      }
+
+      //! LZ77 compression
+      /*! Sequences of literals, each but the last followed by a match */
+      std::string lzCompress(const std::string& in)
+      {
+	const int hash_bits = 16;
+	const size_t min_match = 4;
+	std::vector<int64_t> table(size_t(1) << hash_bits, -1);
+
+	std::string out;
+	const size_t n = in.size();
+	const char* p = in.data();
+	size_t anchor = 0;
+	size_t i = 0;
+
+	while (i + min_match <= n)
+	{
+	  uint32_t w;
+	  std::memcpy(&w, p+i, 4);
+	  uint32_t h = (w * 2654435761u) >> (32 - hash_bits);
+
+	  int64_t cand = table[h];
+	  table[h] = i;
+
+	  if (cand < 0 || std::memcmp(p+cand, p+i, min_match) != 0)
+	  {
+	    ++i;
+	    continue;
+	  }
+
+	  size_t len = min_match;
+	  while (i + len < n && p[cand+len] == p[i+len])
+	    ++len;
+
+	  putVarInt(out, i - anchor);
+	  out.append(p+anchor, i - anchor);
+	  putVarInt(out, len - min_match);
+	  putVarInt(out, i - cand);
+
+	  i += len;
+	  anchor = i;
+	}
+
+	putVarInt(out, n - anchor);
+	out.append(p+anchor, n - anchor);
+
+	return out;
+      }
+
+      //! LZ77 decompression
+      std::string lzDecompress(const std::string& in, size_t n)
+      {
+	const size_t min_match = 4;
+	std::string out;
+	out.reserve(n);
+
+	size_t pos = 0;
+	while (pos < in.size())
+	{
+	  size_t lit = getVarInt(in, pos);
+	  out.append(in, pos, lit);
+	  pos += lit;
+
+	  if (out.size() >= n || pos >= in.size())
+	    break;
+
+	  size_t len = getVarInt(in, pos) + min_match;
+	  size_t off = getVarInt(in, pos);
+
+	  if (off == 0 || off > out.size())
+	  {
+	    QDPIO::cerr << "StorageCodec: corrupt compressed stream" << std::endl;
+	    QDP_abort(1);
+	  }
+
+	  // Byte by byte, the match may overlap what it copies
+	  size_t from = out.size() - off;
+	  for(size_t k=0; k < len; ++k)
+	    out.push_back(out[from+k]);
+	}
+
+	return out;
+      }
+    }
+
+
+    // Encode a stream of words
+    std::string encode(const std::string& raw, StorageCodec codec, int word_size, int nsites)
+    {
+      if (word_size != 4 && word_size != 8)
+      {
+	QDPIO::cerr << __func__ << ": unsupported word size " << word_size << std::endl;
+	QDP_abort(1);
+      }
+
+      const size_t nwords   = raw.size() / word_size;
+      const size_t site_len = (nsites > 0 && nwords > 0) ? std::max(size_t(1), nwords / nsites) : 1;
+      const char*  p        = raw.data();
+
+      std::string payload;
+
+      switch (codec)
+      {
+      case STORAGE_CODEC_NONE:
+	payload = raw;
+	break;
+
+      case STORAGE_CODEC_SINGLE:
+	payload.reserve(4*nwords);
+	for(size_t i=0; i < nwords; ++i)
+	  putWord(payload, getWord(p + i*word_size, word_size), 4);
+	break;
+
+      case STORAGE_CODEC_HALF_NORM:
+	payload.reserve(4*(nwords/site_len + 1) + 2*nwords);
+	for(size_t s=0; s < nwords; s += site_len)
+	{
+	  const size_t len = std::min(site_len, nwords - s);
+
+	  float norm = 0;
+	  for(size_t i=0; i < len; ++i)
+	    norm = std::max(norm, float(std::fabs(getWord(p + (s+i)*word_size, word_size))));
+	  putWord(payload, norm, 4);
+
+	  for(size_t i=0; i < len; ++i)
+	  {
+	    double v = (norm > 0) ? getWord(p + (s+i)*word_size, word_size) / norm : 0;
+	    int32_t q = int32_t(std::floor(v * 32767.0 + 0.5));
+	    q = std::max(-32767, std::min(32767, q));
+	    putUInt(payload, uint16_t(int16_t(q)), 2);
+	  }
+	}
+	break;
+
+      case STORAGE_CODEC_SHUFFLE_LZ:
+      {
+	// Bytes of the same significance are next to each other
+	std::string shuffled(nwords*word_size, '\0');
+	for(size_t i=0; i < nwords; ++i)
+	  for(int b=0; b < word_size; ++b)
+	    shuffled[b*nwords + i] = p[i*word_size + b];
+
+	payload = lzCompress(shuffled);
+      }
+      break;
+
+      default:
+	QDPIO::cerr << __func__ << ": unknown storage codec" << std::endl;
+	QDP_abort(1);
+      }
+
+      std::string enc(magic, 8);
+      putUInt(enc, codec, 4);
+      putUInt(enc, word_size, 4);
+      putUInt(enc, site_len, 4);
+      putUInt(enc, nwords, 8);
+      putUInt(enc, payload.size(), 8);
+      enc += payload;
+
+      return enc;
+    }
+
+
+    // Decode a stream of words
+    std::string decode(const std::string& enc, int word_size)
+    {
+      // Nodes that do not hold the data
+      if (enc.size() == 0)
+	return enc;
+
+      if (enc.size() < header_size || std::memcmp(enc.data(), magic, 8) != 0)
+      {
+	QDPIO::cerr << __func__ << ": not an encoded stream" << std::endl;
+	QDP_abort(1);
+      }
+
+      const char* h = enc.data() + 8;
+      StorageCodec codec  = StorageCodec(getUInt(h, 4));
+      const int enc_word  = getUInt(h+4, 4);
+      const size_t site_len = getUInt(h+8, 4);
+      const size_t nwords = getUInt(h+12, 8);
+      const char* p = enc.data() + header_size;
+
+      std::string raw;
+      raw.reserve(nwords*word_size);
+
+      switch (codec)
+      {
+      case STORAGE_CODEC_NONE:
+	for(size_t i=0; i < nwords; ++i)
+	  putWord(raw, getWord(p + i*enc_word, enc_word), word_size);
+	break;
+
+      case STORAGE_CODEC_SINGLE:
+	for(size_t i=0; i < nwords; ++i)
+	  putWord(raw, getWord(p + 4*i, 4), word_size);
+	break;
+
+      case STORAGE_CODEC_HALF_NORM:
+	for(size_t s=0; s < nwords; s += site_len)
+	{
+	  const size_t len = std::min(site_len, nwords - s);
+
+	  double norm = getWord(p, 4);
+	  p += 4;
+
+	  for(size_t i=0; i < len; ++i, p += 2)
+	    putWord(raw, norm * int16_t(uint16_t(getUInt(p, 2))) / 32767.0, word_size);
+	}
+	break;
+
+      case STORAGE_CODEC_SHUFFLE_LZ:
+      {
+	std::string shuffled = lzDecompress(enc.substr(header_size), nwords*enc_word);
+	if (shuffled.size() != nwords*enc_word)
+	{
+	  QDPIO::cerr << __func__ << ": corrupt compressed stream" << std::endl;
+	  QDP_abort(1);
+	}
+
+	std::string word(enc_word, '\0');
+	for(size_t i=0; i < nwords; ++i)
+	{
+	  for(int b=0; b < enc_word; ++b)
+	    word[b] = shuffled[b*nwords + i];
+
+	  if (enc_word == word_size)
+	    raw += word;
+	  else
+	    putWord(raw, getWord(word.data(), enc_word), word_size);
+	}
+      }
+      break;
+
+      default:
+	QDPIO::cerr << __func__ << ": unknown storage codec " << int(codec) << std::endl;
+	QDP_abort(1);
+      }
+
+      return raw;
+    }
+
+
+    // Write an encoded stream
+    void writeEncoded(BinaryWriter& bin, const std::string& enc)
+    {
+      bin.writeArray(enc.data(), 1, enc.size());
+    }
+
+
+    // Read an encoded stream
+    void readEncoded(BinaryReader& bin, std::string& enc)
+    {
+      std::vector<char> header(header_size);
+      bin.readArray(&header[0], 1, header_size);
+
+      const size_t payload = getUInt(&header[8+12+8], 8);
+
+      enc.assign(&header[0], header_size);
+      if (payload > 0)
+      {
+	std::vector<char> data(payload);
+	bin.readArray(&data[0], 1, payload);
+	enc.append(&data[0], payload);
+      }
+    }
+
+
+    // The codec in the metadata of a file, NONE if there is none
+    StorageCodec codecFromMetaData(const std::string& meta_data)
+    {
+      StorageCodec codec = STORAGE_CODEC_NONE;
+
+      if (meta_data.empty())
+	return codec;
+
+      try
+      {
+	std::istringstream is(meta_data);
+	XMLReader xml(is);
+
+	if (xml.count("/*/StorageCodec") != 0)
+	  read(xml, "/*/StorageCodec", codec);
+      }
+      catch(const std::string& e)
+      {
+	// Not XML, so it was not written with a codec
+      }
+
+      return codec;
+    }
+
+
+    // Abort if the metadata of a file holds a codec
+    void checkNoCodec(const std::string& meta_data, const std::string& file)
+    {
+      if (codecFromMetaData(meta_data) != STORAGE_CODEC_NONE)
+      {
+	QDPIO::cerr << __func__ << ": " << file << " was written with a storage codec, but this reader does not decode" << std::endl;
+	QDP_abort(1);
+      }
+    }
+
+
+    //! Root of the file XML of a QIO file written with a codec
+    const std::string file_xml_root = "StorageCodecFile";
+
+    //! Path to the original file XML of a QIO file written with a codec
+    const std::string file_xml_path = "/StorageCodecFile/FileXML/*";
+
+
+    // Was the QIO file written with a codec
+    bool isCodecFile(XMLReader& file_xml)
+    {
+      return file_xml.count("/" + file_xml_root) != 0;
+    }
+
+
+    // The codec of a QIO file written with a codec
+    StorageCodec codecFromFileXML(XMLReader& file_xml)
+    {
+      StorageCodec codec = STORAGE_CODEC_NONE;
+      if (isCodecFile(file_xml))
+	read(file_xml, "/" + file_xml_root + "/StorageCodec", codec);
+
+      return codec;
+    }
+
+
+    // File XML of a QIO file written with a codec
+    void writeCodecFileXML(XMLBufferWriter& codec_xml, StorageCodec codec, XMLBufferWriter& file_xml)
+    {
+      push(codec_xml, file_xml_root);
+      write(codec_xml, "StorageCodec", codec);
+      write(codec_xml, "FileXML", file_xml);
+      pop(codec_xml);
+    }
+
+
+    // Number of single precision planes a site is encoded to
+    int numPlanes(StorageCodec codec, int site_len)
+    {
+      switch (codec)
+      {
+      case STORAGE_CODEC_SINGLE:
+	return site_len;
+
+      case STORAGE_CODEC_HALF_NORM:
+	// The norm, then two 16 bit words per plane
+	return 1 + (site_len + 1) / 2;
+
+      default:
+	QDPIO::cerr << __func__ << ": storage codec " << int(codec)
+		    << " has no fixed length per site, it is only supported for map objects" << std::endl;
+	QDP_abort(1);
+      }
+
+      return 0;
+    }
+
+
+    // Encode the words of a site into planes
+    void encodeSite(const double* words, int site_len, StorageCodec codec, float* planes)
+    {
+      if (codec == STORAGE_CODEC_SINGLE)
+      {
+	for(int i=0; i < site_len; ++i)
+	  planes[i] = words[i];
+	return;
+      }
+
+      // HALF_NORM, quantized as in encode
+      float norm = 0;
+      for(int i=0; i < site_len; ++i)
+	norm = std::max(norm, float(std::fabs(words[i])));
+      planes[0] = norm;
+
+      for(int i=0; i < site_len; i += 2)
+      {
+	uint32_t packed = 0;
+	for(int j=i; j < i+2; ++j)
+	{
+	  int32_t q = 0;
+	  if (j < site_len && norm > 0)
+	  {
+	    q = int32_t(std::floor(words[j] / norm * 32767.0 + 0.5));
+	    q = std::max(-32767, std::min(32767, q));
+	  }
+	  packed = (packed << 16) | uint16_t(int16_t(q));
+	}
+	std::memcpy(&planes[1 + i/2], &packed, 4);
+      }
+    }
+
+
+    // Decode the words of a site from planes
+    void decodeSite(const float* planes, int site_len, StorageCodec codec, double* words)
+    {
+      if (codec == STORAGE_CODEC_SINGLE)
+      {
+	for(int i=0; i < site_len; ++i)
+	  words[i] = planes[i];
+	return;
+      }
+
+      // HALF_NORM
+      const double norm = planes[0];
+
+      for(int i=0; i < site_len; i += 2)
+      {
+	uint32_t packed;
+	std::memcpy(&packed, &planes[1 + i/2], 4);
+
+	words[i] = norm * int16_t(uint16_t(packed >> 16)) / 32767.0;
+	if (i+1 < site_len)
+	  words[i+1] = norm * int16_t(uint16_t(packed & 0xffff)) / 32767.0;
+      }
+    }
+  }
+
+}
@@ -0,0 +1,170 @@
+// -*- C++ -*-
+/*! \file
+ * \brief Reduced precision and compressed storage of lattice objects
+ */
+
+#ifndef __storage_codec_h__
+#define __storage_codec_h__
+
+#include "chromabase.h"
+#include "io/enum_io/enum_storage_codec_io.h"
+
+#include <string>
+#include <vector>
+#include <cstring>
+
+namespace Chroma
+{
+  //! Reduced precision and compressed storage of lattice objects
+  /*! \ingroup io
+   *
+   * A codec works on the binary stream QDP++ writes for a lattice object,
+   * that is a sequence of big-endian floating point words, site after site.
+   * The encoded stream starts with a header holding the codec, the word
+   * size, the number of words per site and the number of words, so it
+   * decodes without any other information, to any word size.
+   *
+   *  SINGLE      - the words are stored as floats
+   *  HALF_NORM   - per site the largest magnitude as a float, and every word
+   *                as a 16 bit integer relative to it
+   *  SHUFFLE_LZ  - the bytes are regrouped by their position in the word,
+   *                then compressed with LZ77. This one is lossless.
+   *
+   * Where an object is stored with a codec, the file metadata holds a
+   * StorageCodec element so the readers can decode it.
+   *
+   * Map object records (one time slice each) are encoded as a stream. QIO
+   * files are encoded site by site on the node holding the site, into
+   * single precision planes that QIO writes in parallel like any lattice
+   * object. This needs a fixed length per site, so SHUFFLE_LZ is only
+   * available for map objects.
+   */
+  namespace StorageCodecEnv
+  {
+    //! Encode a stream of words
+    /*!
+     * \param raw        stream written by QDP++ ( Read )
+     * \param codec      the codec ( Read )
+     * \param word_size  bytes per word of raw ( Read )
+     * \param nsites     number of sites in raw ( Read )
+     * \return the encoded stream
+     */
+    std::string encode(const std::string& raw, StorageCodec codec, int word_size, int nsites);
+
+    //! Decode a stream of words
+    /*!
+     * \param enc        encoded stream ( Read )
+     * \param word_size  bytes per word of the result ( Read )
+     * \return the stream as QDP++ reads it
+     */
+    std::string decode(const std::string& enc, int word_size);
+
+    //! Write an encoded stream
+    void writeEncoded(BinaryWriter& bin, const std::string& enc);
+
+    //! Read an encoded stream
+    void readEncoded(BinaryReader& bin, std::string& enc);
+
+    //! The codec in the metadata of a file, NONE if there is none
+    StorageCodec codecFromMetaData(const std::string& meta_data);
+
+    //! Abort if the metadata of a file holds a codec
+    /*! For the readers of files that are never written with a codec */
+    void checkNoCodec(const std::string& meta_data, const std::string& file);
+
+    //! Root of the file XML of a QIO file written with a codec
+    extern const std::string file_xml_root;
+
+    //! Path to the original file XML of a QIO file written with a codec
+    extern const std::string file_xml_path;
+
+    //! Was the QIO file written with a codec
+    bool isCodecFile(XMLReader& file_xml);
+
+    //! The codec of a QIO file written with a codec
+    StorageCodec codecFromFileXML(XMLReader& file_xml);
+
+    //! File XML of a QIO file written with a codec
+    void writeCodecFileXML(XMLBufferWriter& codec_xml, StorageCodec codec, XMLBufferWriter& file_xml);
+
+
+    //! Number of single precision planes a site of site_len words is encoded to
+    int numPlanes(StorageCodec codec, int site_len);
+
+    //! Encode the words of a site into numPlanes(codec, site_len) planes
+    void encodeSite(const double* words, int site_len, StorageCodec codec, float* planes);
+
+    //! Decode the words of a site from numPlanes(codec, site_len) planes
+    void decodeSite(const float* planes, int site_len, StorageCodec codec, double* words);
+
+
+    //! Write a lattice object to a QIO file with a codec
+    /*! Every node encodes its own sites, the record is written in parallel */
+    template<typename T>
+    void write(QDPFileWriter& to, XMLBufferWriter& record_xml, const OLattice<T>& obj, StorageCodec codec)
+    {
+#if defined(QDP_IS_QDPJIT)
+      QDPIO::cerr << __func__ << ": storage codecs of QIO files are not supported with QDP-JIT" << std::endl;
+      QDP_abort(1);
+#else
+      typedef typename WordType<T>::Type_t W;
+      const int site_len = sizeof(T) / sizeof(W);
+      const int nplanes  = numPlanes(codec, site_len);
+
+      multi1d<LatticeRealF> planes(nplanes);
+      std::vector<double> words(site_len);
+      std::vector<float>  enc(nplanes);
+
+      for(int site=0; site < Layout::sitesOnNode(); ++site)
+      {
+	const W* w = reinterpret_cast<const W*>(&obj.elem(site));
+	for(int i=0; i < site_len; ++i)
+	  words[i] = w[i];
+
+	encodeSite(&words[0], site_len, codec, &enc[0]);
+
+	// The planes may hold bit patterns that are not numbers, so they are copied as bytes
+	for(int k=0; k < nplanes; ++k)
+	  std::memcpy(&planes[k].elem(site).elem().elem().elem(), &enc[k], sizeof(float));
+      }
+
+      QDP::write(to, record_xml, planes);
+#endif
+    }
+
+    //! Read a lattice object written to a QIO file with a codec
+    template<typename T>
+    void read(QDPFileReader& to, XMLReader& record_xml, OLattice<T>& obj, StorageCodec codec)
+    {
+#if defined(QDP_IS_QDPJIT)
+      QDPIO::cerr << __func__ << ": storage codecs of QIO files are not supported with QDP-JIT" << std::endl;
+      QDP_abort(1);
+#else
+      typedef typename WordType<T>::Type_t W;
+      const int site_len = sizeof(T) / sizeof(W);
+      const int nplanes  = numPlanes(codec, site_len);
+
+      multi1d<LatticeRealF> planes(nplanes);
+      QDP::read(to, record_xml, planes);
+
+      std::vector<double> words(site_len);
+      std::vector<float>  enc(nplanes);
+
+      for(int site=0; site < Layout::sitesOnNode(); ++site)
+      {
+	for(int k=0; k < nplanes; ++k)
+	  std::memcpy(&enc[k], &planes[k].elem(site).elem().elem().elem(), sizeof(float));
+
+	decodeSite(&enc[0], site_len, codec, &words[0]);
+
+	W* w = reinterpret_cast<W*>(&obj.elem(site));
+	for(int i=0; i < site_len; ++i)
+	  w[i] = words[i];
+      }
+#endif
+    }
+  }
+
+}
+
+#endif
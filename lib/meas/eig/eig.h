@@ -24,6 +24,7 @@
 #include "ritz_array.h"
 #include "eig_spec.h"
 #include "eig_spec_array.h"
+#include "eig_krylov_schur.h"
 
 #include "eig_w.h"
 #include "eig_s.h"
@@ -0,0 +1,632 @@
+/*! \file
+ *  \brief Chebyshev filtered thick-restart block Lanczos eigensolver
+ */
+
+#include <qdp-lapack.h>
+
+#include "meas/eig/eig_krylov_schur.h"
+#include "actions/ferm/invert/fused_blas.h"
+
+#include <vector>
+#include <algorithm>
+
+namespace Chroma
+{
+
+  // Default parameters
+  KrylovSchurParams_t::KrylovSchurParams_t()
+  {
+    Nstop       = 0;
+    Nk          = 0;
+    Nm          = 0;
+    BlockSize   = 1;
+    MaxRestarts = 100;
+    RsdR        = 1.0e-6;
+    RsdA        = 0;
+    ChebyOrder  = 1;
+    ChebyLo     = 0;
+    ChebyHi     = 0;
+  }
+
+
+  // Read parameters
+  void read(XMLReader& xml, const std::string& path, KrylovSchurParams_t& param)
+  {
+    XMLReader paramtop(xml, path);
+
+    param = KrylovSchurParams_t();
+
+    read(paramtop, "Nstop", param.Nstop);
+    read(paramtop, "Nk", param.Nk);
+    read(paramtop, "Nm", param.Nm);
+    read(paramtop, "RsdR", param.RsdR);
+    read(paramtop, "MaxRestarts", param.MaxRestarts);
+
+    if (paramtop.count("RsdA") != 0)
+      read(paramtop, "RsdA", param.RsdA);
+
+    if (paramtop.count("BlockSize") != 0)
+      read(paramtop, "BlockSize", param.BlockSize);
+
+    if (paramtop.count("ChebyOrder") != 0)
+      read(paramtop, "ChebyOrder", param.ChebyOrder);
+
+    if (paramtop.count("ChebyLo") != 0)
+      read(paramtop, "ChebyLo", param.ChebyLo);
+
+    if (paramtop.count("ChebyHi") != 0)
+      read(paramtop, "ChebyHi", param.ChebyHi);
+
+    if (param.Nstop < 1 || param.Nk < param.Nstop || param.BlockSize < 1
+	|| param.Nk < param.BlockSize || param.Nm < param.Nk + param.BlockSize)
+    {
+      QDPIO::cerr << __func__ << ": need 1 <= Nstop <= Nk, BlockSize <= Nk and Nk + BlockSize <= Nm" << std::endl;
+      QDP_abort(1);
+    }
+
+    if (param.ChebyOrder < 1)
+    {
+      QDPIO::cerr << __func__ << ": ChebyOrder must be at least 1" << std::endl;
+      QDP_abort(1);
+    }
+  }
+
+
+  // Write parameters
+  void write(XMLWriter& xml, const std::string& path, const KrylovSchurParams_t& param)
+  {
+    push(xml, path);
+
+    write(xml, "Nstop", param.Nstop);
+    write(xml, "Nk", param.Nk);
+    write(xml, "Nm", param.Nm);
+    write(xml, "RsdR", param.RsdR);
+    write(xml, "MaxRestarts", param.MaxRestarts);
+
+    if (toBool(param.RsdA != Real(0)))
+      write(xml, "RsdA", param.RsdA);
+
+    if (param.BlockSize != 1)
+      write(xml, "BlockSize", param.BlockSize);
+
+    if (param.ChebyOrder != 1)
+      write(xml, "ChebyOrder", param.ChebyOrder);
+
+    if (toBool(param.ChebyLo > Real(0)))
+      write(xml, "ChebyLo", param.ChebyLo);
+
+    if (toBool(param.ChebyHi > Real(0)))
+      write(xml, "ChebyHi", param.ChebyHi);
+
+    pop(xml);
+  }
+
+
+  namespace
+  {
+    //! Real scalar with the precision of T
+    template<typename T>
+    struct RealScalar
+    {
+      typedef OScalar< PScalar< PScalar< RScalar<typename WordType<T>::Type_t> > > >  Type_t;
+    };
+
+
+    //! Chebyshev filter T_n(y(x)) / T_n(y0) with y(x) = (c - x)/e
+    /*!
+     * The interval [c-e, c+e] is damped and the spectrum below it
+     * amplified, y0 >= 1 keeps the iterates of order one.
+     */
+    struct Filter
+    {
+      int    order;
+      double c;
+      double e;
+      double y0;
+    };
+
+
+    //! out = p(A) in
+    template<typename T>
+    void chebyshev(const LinearOperator<T>& A, T& out, const T& in,
+		   const Filter& f, int& n_matvec)
+    {
+      typedef typename WordType<T>::Type_t W;
+      typedef typename RealScalar<T>::Type_t R;
+
+      const Subset& s = A.subset();
+
+      T t0, t1, t_a;
+      T* prev = &t0;
+      T* cur  = &t1;
+
+      A(t_a, in, PLUS);
+      ++n_matvec;
+
+      // s_1 = y(A) s_0 / y0
+      double rho = 1.0 / f.y0;
+      *prev = zero;
+      (*prev)[s] = in;
+      *cur = zero;
+      (*cur)[s] = R(W(f.c*rho/f.e))*in - R(W(rho/f.e))*t_a;
+
+      // s_{k+1} = 2 rho_{k+1} y(A) s_k - rho_{k+1} rho_k s_{k-1}
+      for(int k=1; k < f.order; ++k)
+      {
+	double rho_next = 1.0 / (2.0*f.y0 - rho);
+
+	A(t_a, *cur, PLUS);
+	++n_matvec;
+
+	(*prev)[s] = R(W(2*rho_next*f.c/f.e))*(*cur) - R(W(2*rho_next/f.e))*t_a
+	  - R(W(rho_next*rho))*(*prev);
+
+	std::swap(prev, cur);
+	rho = rho_next;
+      }
+
+      out[s] = *cur;
+    }
+
+
+    //! Orthogonalizes the vectors w against the orthonormal q
+    /*! Classical Gram-Schmidt done twice, each pass takes one global sum */
+    template<typename T>
+    void orthogonalize(const std::vector<T*>& w, const std::vector<const T*>& q, const Subset& s)
+    {
+      typedef typename FusedBLAS::Scalar<T>::Complex_t C;
+
+      if (q.size() == 0 || w.size() == 0)
+	return;
+
+      std::vector<const T*> a, b;
+      for(int j=0; j < w.size(); ++j)
+	for(int i=0; i < q.size(); ++i)
+	{
+	  a.push_back(q[i]);
+	  b.push_back(w[j]);
+	}
+
+      std::vector<DComplex> h;
+      for(int pass=0; pass < 2; ++pass)
+      {
+	FusedBLAS::blockDot(h, a, b, s);
+
+	for(int j=0; j < w.size(); ++j)
+	  for(int i=0; i < q.size(); ++i)
+	  {
+	    C c = h[j*q.size() + i];
+	    (*w[j])[s] -= c*(*q[i]);
+	  }
+      }
+    }
+
+
+    //! Orthonormalizes the block w against L, V and itself and appends it to V
+    /*! A vector that is lost in the orthogonalization is replaced by a gaussian one */
+    template<typename T>
+    int appendBlock(multi1d<T>& V, int n, multi1d<T>& w, int nw,
+		    const multi1d<T>& L, int nlock, const Subset& s)
+    {
+      typedef typename WordType<T>::Type_t W;
+      typedef typename RealScalar<T>::Type_t R;
+
+      std::vector<const T*> q;
+      for(int i=0; i < nlock; ++i)
+	q.push_back(&L[i]);
+      for(int i=0; i < n; ++i)
+	q.push_back(&V[i]);
+
+      multi1d<Double> nrm0(nw);
+      std::vector<T*> blk;
+      for(int j=0; j < nw; ++j)
+      {
+	nrm0[j] = sqrt(norm2(w[j], s));
+	blk.push_back(&w[j]);
+      }
+
+      orthogonalize(blk, q, s);
+
+      std::vector<const T*> q_new;
+      for(int j=0; j < nw; ++j)
+      {
+	std::vector<T*> wj(1, &w[j]);
+	orthogonalize(wj, q_new, s);
+
+	Double nrm = sqrt(norm2(w[j], s));
+	if (toBool(nrm <= Double(1.0e-10)*nrm0[j]))
+	{
+	  QDPIO::cout << "EigSpecKrylovSchur: breakdown, restarting vector " << n << " at random" << std::endl;
+	  gaussian(w[j], s);
+	  orthogonalize(wj, q, s);
+	  orthogonalize(wj, q_new, s);
+	  nrm = sqrt(norm2(w[j], s));
+	}
+
+	V[n] = zero;
+	V[n][s] = R(W(1.0/toDouble(nrm)))*w[j];
+
+	q.push_back(&V[n]);
+	q_new.push_back(&V[n]);
+	++n;
+      }
+
+      return n;
+    }
+
+
+    //! Upper bound of the spectrum from a short Lanczos run
+    template<typename T>
+    Double spectrumBound(const LinearOperator<T>& A, int& n_matvec)
+    {
+      typedef typename WordType<T>::Type_t W;
+      typedef typename RealScalar<T>::Type_t R;
+
+      const Subset& s = A.subset();
+      const int n_lanczos = 20;
+
+      T v, v_old, w;
+      v = zero;
+      v_old = zero;
+      gaussian(v, s);
+      v[s] *= R(W(1.0/toDouble(sqrt(norm2(v, s)))));
+
+      multi2d<DComplex> Tm(n_lanczos, n_lanczos);
+      Tm = 0.0;
+
+      Double beta = zero;
+      int m = 0;
+      for(; m < n_lanczos; ++m)
+      {
+	A(w, v, PLUS);
+	++n_matvec;
+
+	Double alpha = real(innerProduct(v, w, s));
+	w[s] -= R(W(toDouble(alpha)))*v + R(W(toDouble(beta)))*v_old;
+	Tm(m,m) = alpha;
+
+	beta = sqrt(norm2(w, s));
+	if (toBool(beta < Double(1.0e-10)*fabs(alpha)))
+	{
+	  ++m;
+	  break;
+	}
+
+	if (m+1 < n_lanczos)
+	{
+	  Tm(m,m+1) = beta;
+	  Tm(m+1,m) = beta;
+	}
+
+	v_old[s] = v;
+	v[s] = R(W(1.0/toDouble(beta)))*w;
+      }
+
+      multi1d<Double> theta;
+      char jobz = 'V';
+      char uplo = 'U';
+      QDPLapack::zheev(jobz, uplo, m, Tm, theta);
+
+      // The largest Ritz value is below the top of the spectrum, beta bounds the gap
+      return theta[m-1] + beta;
+    }
+
+
+    //! Chebyshev filtered thick-restart block Lanczos
+    /*!
+     * Krylov-Schur form of the filtered operator p(A):
+     * p(A) V = V H + P B^dag, with P the block of orthonormal vectors
+     * pending beyond the search space V. The restart keeps the Ritz
+     * vectors of the Nk largest Ritz values of p(A) together with P.
+     */
+    template<typename T>
+    void krylovSchur_a(const LinearOperator<T>& A,
+		       multi1d<Real>& lambda,
+		       multi1d<T>& evec,
+		       const KrylovSchurParams_t& param,
+		       Real& lambda_hi,
+		       int& n_matvec,
+		       XMLWriter& xml_out)
+    {
+      START_CODE();
+
+      typedef typename FusedBLAS::Scalar<T>::Complex_t C;
+      typedef typename WordType<T>::Type_t W;
+      typedef typename RealScalar<T>::Type_t R;
+
+      const Subset& s = A.subset();
+
+      const int Nstop = param.Nstop;
+      const int Nk    = param.Nk;
+      const int Nm    = param.Nm;
+      const int nb    = param.BlockSize;
+
+      push(xml_out, "EigSpecKrylovSchur");
+
+      n_matvec = 0;
+
+      // Top of the spectrum
+      Double hi = param.ChebyHi;
+      if (toBool(hi <= Double(0)))
+	hi = spectrumBound(A, n_matvec);
+
+      lambda_hi = hi;
+      QDPIO::cout << "EigSpecKrylovSchur: top of the spectrum = " << hi << std::endl;
+
+      // Search space with the pending block, the locked eigenpairs and
+      // the columns H(i,j) = <V_i, p(A) V_j> of the projected filter
+      multi1d<T> V(Nm + nb);
+      multi1d<T> L(Nstop);
+      multi1d<Double> L_val(Nstop);
+      multi1d<Double> L_res(Nstop);
+      multi1d<T> w(nb);
+      multi1d<T> pw(nb);
+      multi2d<DComplex> H(Nm + nb, Nm + nb);
+      H = 0.0;
+
+      int nlock = 0;
+
+      // Gaussian starting block
+      for(int j=0; j < nb; ++j)
+      {
+	w[j] = zero;
+	gaussian(w[j], s);
+      }
+      int n = appendBlock(V, 0, w, nb, L, nlock, s);
+
+      // Without ChebyLo the first cycle is plain Lanczos, its Ritz
+      // values place the filter used from then on
+      bool adapt = toBool(param.ChebyLo <= Real(0));
+
+      Filter f;
+      f.order = 1;
+      f.c = toDouble(hi) / 2;
+      f.e = toDouble(hi) / 2;
+      f.y0 = 1;
+
+      if (! adapt)
+      {
+	f.order = param.ChebyOrder;
+	f.c = toDouble(hi + param.ChebyLo) / 2;
+	f.e = toDouble(hi - param.ChebyLo) / 2;
+      }
+
+      int restart = 0;
+      for(;;)
+      {
+	// Grow the search space from its last block
+	for(;;)
+	{
+	  for(int j=0; j < nb; ++j)
+	  {
+	    chebyshev(A, w[j], V[n-nb+j], f, n_matvec);
+	    pw[j] = w[j];
+	  }
+
+	  appendBlock(V, n, w, nb, L, nlock, s);
+
+	  std::vector<const T*> a, b;
+	  for(int j=0; j < nb; ++j)
+	    for(int i=0; i < n+nb; ++i)
+	    {
+	      a.push_back(&V[i]);
+	      b.push_back(&pw[j]);
+	    }
+
+	  std::vector<DComplex> h;
+	  FusedBLAS::blockDot(h, a, b, s);
+
+	  for(int j=0; j < nb; ++j)
+	    for(int i=0; i < n+nb; ++i)
+	      H(i,n-nb+j) = h[j*(n+nb) + i];
+
+	  // The new block stays pending once the search space is full
+	  if (n + nb > Nm)
+	    break;
+
+	  n += nb;
+	}
+
+	// Rayleigh-Ritz with the hermitian part, ascending Ritz values
+	multi2d<DComplex> Q(n, n);
+	for(int i=0; i < n; ++i)
+	  for(int j=0; j < n; ++j)
+	    Q(i,j) = Double(0.5)*(H(i,j) + conj(H(j,i)));
+
+	multi1d<Double> theta;
+	char jobz = 'V';
+	char uplo = 'U';
+	QDPLapack::zheev(jobz, uplo, n, Q, theta);
+
+	// Ritz vectors of the candidates for locking and of the ones kept,
+	// the largest values of p(A) are the lowest of A
+	const int n_cand = (Nstop - nlock < n - Nk) ? Nstop - nlock : n - Nk;
+	const int m = n_cand + Nk;
+
+	multi1d<T> Y(m);
+	for(int k=0; k < m; ++k)
+	{
+	  Y[k] = zero;
+	  for(int j=0; j < n; ++j)
+	  {
+	    C c = conj(Q(n-1-k,j));
+	    Y[k][s] += c*V[j];
+	  }
+	}
+
+	// Lock the converged lowest ones
+	int nconv = 0;
+	Double theta_A = zero;
+	for(; nconv < n_cand; ++nconv)
+	{
+	  T r;
+	  A(r, Y[nconv], PLUS);
+	  ++n_matvec;
+
+	  theta_A = real(innerProduct(Y[nconv], r, s));
+	  r[s] -= R(W(toDouble(theta_A)))*Y[nconv];
+	  Double res = sqrt(norm2(r, s));
+
+	  Double tol = param.RsdR * fabs(theta_A);
+	  if (toBool(tol < Double(param.RsdA)))
+	    tol = param.RsdA;
+
+	  if (toBool(res > tol))
+	    break;
+
+	  L[nlock] = Y[nconv];
+	  L_val[nlock] = theta_A;
+	  L_res[nlock] = res;
+	  ++nlock;
+	}
+
+	QDPIO::cout << "EigSpecKrylovSchur: restart " << restart
+		    << "  locked = " << nlock
+		    << "  theta = " << theta_A
+		    << "  matvecs = " << n_matvec << std::endl;
+
+	if (nlock >= Nstop)
+	  break;
+
+	if (restart >= param.MaxRestarts)
+	{
+	  QDPIO::cerr << "EigSpecKrylovSchur: no convergence after " << restart
+		      << " restarts, " << nlock << " of " << Nstop << " eigenpairs locked" << std::endl;
+
+	  // Best approximations for the rest
+	  for(int k=nconv; nlock < Nstop; ++k, ++nlock)
+	  {
+	    T r;
+	    A(r, Y[k], PLUS);
+	    ++n_matvec;
+
+	    L[nlock] = Y[k];
+	    L_val[nlock] = real(innerProduct(Y[k], r, s));
+	    L_res[nlock] = Double(-1);
+	  }
+	  break;
+	}
+
+	++restart;
+
+	if (adapt)
+	{
+	  // The first cycle had p(x) = (c - x)/e, so the Ritz values of A
+	  // place the filter. It damps the spectrum above the kept ones.
+	  int k_lo = nconv + Nk;
+	  if (k_lo > n-1)
+	    k_lo = n-1;
+
+	  double lo    = f.c - f.e*toDouble(theta[n-1-k_lo]);
+	  double t_min = f.c - f.e*toDouble(theta[n-1-nconv]);
+
+	  if (lo < toDouble(hi))
+	  {
+	    f.order = param.ChebyOrder;
+	    f.c = (toDouble(hi) + lo) / 2;
+	    f.e = (toDouble(hi) - lo) / 2;
+	    f.y0 = (f.c - t_min) / f.e;
+	    if (f.y0 < 1)
+	      f.y0 = 1;
+	  }
+
+	  QDPIO::cout << "EigSpecKrylovSchur: Chebyshev filter of order " << f.order
+		      << " damping [" << f.c - f.e << ", " << f.c + f.e << "]" << std::endl;
+	  adapt = false;
+
+	  // A new operator, so start afresh from the lowest Ritz vectors
+	  H = 0.0;
+	  for(int k=0; k < nb; ++k)
+	    V[k] = Y[nconv+k];
+	  n = nb;
+	  continue;
+	}
+
+	// Coupling of the kept Ritz vectors to the pending block
+	multi2d<DComplex> B(nb, Nk);
+	for(int j=0; j < nb; ++j)
+	  for(int k=0; k < Nk; ++k)
+	  {
+	    B(j,k) = zero;
+	    for(int i=0; i < n; ++i)
+	      B(j,k) += conj(Q(n-1-(nconv+k),i)) * H(n+j,i);
+	  }
+
+	// Thick restart with the next Nk Ritz vectors and the pending block
+	H = 0.0;
+	for(int k=0; k < Nk; ++k)
+	{
+	  V[k] = Y[nconv+k];
+	  H(k,k) = theta[n-1-(nconv+k)];
+	}
+
+	for(int j=0; j < nb; ++j)
+	{
+	  V[Nk+j] = V[n+j];
+	  for(int k=0; k < Nk; ++k)
+	  {
+	    H(Nk+j,k) = B(j,k);
+	    H(k,Nk+j) = conj(B(j,k));
+	  }
+	}
+	n = Nk + nb;
+      }
+
+      // Sort the locked eigenpairs
+      multi1d<int> idx(Nstop);
+      for(int i=0; i < Nstop; ++i)
+	idx[i] = i;
+
+      for(int i=1; i < Nstop; ++i)
+	for(int j=i; j > 0 && toBool(L_val[idx[j]] < L_val[idx[j-1]]); --j)
+	  std::swap(idx[j], idx[j-1]);
+
+      lambda.resize(Nstop);
+      evec.resize(Nstop);
+      multi1d<Double> resid(Nstop);
+      for(int i=0; i < Nstop; ++i)
+      {
+	lambda[i] = L_val[idx[i]];
+	resid[i] = L_res[idx[i]];
+	evec[i] = L[idx[i]];
+      }
+
+      write(xml_out, "lambda_hi", lambda_hi);
+      write(xml_out, "lambda", lambda);
+      write(xml_out, "resid", resid);
+      write(xml_out, "n_restart", restart);
+      write(xml_out, "n_matvec", n_matvec);
+
+      pop(xml_out);
+
+      END_CODE();
+    }
+
+  } // anonymous namespace
+
+
+  // Single precision
+  void EigSpecKrylovSchur(const LinearOperator<LatticeFermionF>& A,
+			  multi1d<Real>& lambda,
+			  multi1d<LatticeFermionF>& evec,
+			  const KrylovSchurParams_t& param,
+			  Real& lambda_hi,
+			  int& n_matvec,
+			  XMLWriter& xml_out)
+  {
+    krylovSchur_a(A, lambda, evec, param, lambda_hi, n_matvec, xml_out);
+  }
+
+  // Double precision
+  void EigSpecKrylovSchur(const LinearOperator<LatticeFermionD>& A,
+			  multi1d<Real>& lambda,
+			  multi1d<LatticeFermionD>& evec,
+			  const KrylovSchurParams_t& param,
+			  Real& lambda_hi,
+			  int& n_matvec,
+			  XMLWriter& xml_out)
+  {
+    krylovSchur_a(A, lambda, evec, param, lambda_hi, n_matvec, xml_out);
+  }
+
+} // end namespace Chroma
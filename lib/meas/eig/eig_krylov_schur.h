@@ -0,0 +1,82 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Chebyshev filtered thick-restart block Lanczos eigensolver
+ */
+
+#ifndef __eig_krylov_schur_h__
+#define __eig_krylov_schur_h__
+
+#include "chromabase.h"
+#include "linearop.h"
+
+namespace Chroma
+{
+
+  //! Parameters of the thick-restart block Lanczos eigensolver
+  /*! \ingroup eig */
+  struct KrylovSchurParams_t
+  {
+    KrylovSchurParams_t();
+
+    int  Nstop;        /*!< number of eigenpairs wanted */
+    int  Nk;           /*!< number of Ritz vectors kept at a restart */
+    int  Nm;           /*!< maximum dimension of the search space */
+    int  BlockSize;    /*!< number of vectors added at a time */
+    int  MaxRestarts;  /*!< maximum number of restarts */
+    Real RsdR;         /*!< relative residual of the eigenpairs */
+    Real RsdA;         /*!< absolute residual of the eigenpairs */
+    int  ChebyOrder;   /*!< degree of the Chebyshev filter, 1 is plain Lanczos */
+    Real ChebyLo;      /*!< lower end of the damped interval, <= 0 adapts it */
+    Real ChebyHi;      /*!< upper end of the spectrum, <= 0 estimates it */
+  };
+
+  /*!
+   * \ingroup eig
+   * @{
+   */
+  void read(XMLReader& xml, const std::string& path, KrylovSchurParams_t& param);
+  void write(XMLWriter& xml, const std::string& path, const KrylovSchurParams_t& param);
+  /*! @} */
+
+
+  //! Lowest eigenpairs of a hermitian operator
+  /*!
+   * \ingroup eig
+   *
+   * A thick-restart block Lanczos of a Chebyshev polynomial p(A), which
+   * damps the spectrum between ChebyLo and ChebyHi and amplifies the one
+   * below. The search space of Nm vectors is grown BlockSize vectors at a
+   * time and fully reorthogonalized against the locked vectors and itself.
+   * At a restart the converged lowest eigenpairs are locked and the Ritz
+   * vectors of the next Nk are kept in Krylov-Schur form. Without ChebyLo
+   * the first cycle is plain Lanczos and its Ritz values place the filter.
+   *
+   * \param A          hermitian operator                    (Read)
+   * \param lambda     eigenvalues in ascending order        (Write)
+   * \param evec       orthonormal eigenvectors              (Write)
+   * \param param      solver parameters                     (Read)
+   * \param lambda_hi  upper bound of the spectrum           (Write)
+   * \param n_matvec   number of operator applications       (Write)
+   * \param xml_out    diagnostics                           (Write)
+   */
+  void EigSpecKrylovSchur(const LinearOperator<LatticeFermionF>& A,
+			  multi1d<Real>& lambda,
+			  multi1d<LatticeFermionF>& evec,
+			  const KrylovSchurParams_t& param,
+			  Real& lambda_hi,
+			  int& n_matvec,
+			  XMLWriter& xml_out);
+
+  //! Lowest eigenpairs of a hermitian operator
+  /*! \ingroup eig */
+  void EigSpecKrylovSchur(const LinearOperator<LatticeFermionD>& A,
+			  multi1d<Real>& lambda,
+			  multi1d<LatticeFermionD>& evec,
+			  const KrylovSchurParams_t& param,
+			  Real& lambda_hi,
+			  int& n_matvec,
+			  XMLWriter& xml_out);
+
+}  // end namespace Chroma
+
+#endif
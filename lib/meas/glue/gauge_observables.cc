@@ -0,0 +1,354 @@
+/*! \file
+ *  \brief Plaquettes, link, Polyakov loops and clover observables in one sweep
+ */
+
+#include "chromabase.h"
+#include "meas/glue/gauge_observables.h"
+
+#include <cmath>
+
+namespace Chroma
+{
+
+  // Anonymous namespace
+  namespace
+  {
+    //! Offsets of the sums in the reduction array
+    struct GaugeObsLayout
+    {
+      GaugeObsLayout() :
+	nplane(Nd*(Nd-1)/2),
+	plaq(0), link(nplane), poly(nplane+1), energy(nplane+1+2*Nd),
+	qtop(2*nplane+1+2*Nd), size(2*nplane+2+2*Nd) {}
+
+      int nplane;
+      int plaq;      /*!< one per plane */
+      int link;
+      int poly;      /*!< real and imaginary part per direction */
+      int energy;    /*!< one per plane */
+      int qtop;
+      int size;
+    };
+
+#ifndef QDP_IS_QDPJIT
+    //! Re tr(a)
+    template<typename M>
+    inline double reTrace(const M& a)
+    {
+      double s = 0;
+      for(int i=0; i < Nc; ++i)
+	s += a.elem(i,i).real();
+      return s;
+    }
+
+    //! Im tr(a)
+    template<typename M>
+    inline double imTrace(const M& a)
+    {
+      double s = 0;
+      for(int i=0; i < Nc; ++i)
+	s += a.elem(i,i).imag();
+      return s;
+    }
+
+    //! Re tr(a*b)
+    template<typename M>
+    inline double reTraceProd(const M& a, const M& b)
+    {
+      double s = 0;
+      for(int i=0; i < Nc; ++i)
+	for(int j=0; j < Nc; ++j)
+	  s += a.elem(i,j).real()*b.elem(j,i).real() - a.elem(i,j).imag()*b.elem(j,i).imag();
+      return s;
+    }
+
+    //! Arguments for the site loop
+    template<typename U>
+    struct GaugeObsArgs
+    {
+      const multi1d<U>&   u;
+      const multi1d<U>&   plaq;       /*!< plaquette per plane */
+      const multi1d<U>&   poly;       /*!< Polyakov lines, or empty */
+      const multi1d<U>&   f;          /*!< clover field strength per plane, or empty */
+      multi2d<double>&    partial;    /*!< sums per thread */
+    };
+
+    //! All the traces of a range of sites
+    template<typename U>
+    void gaugeObsSiteLoop(int lo, int hi, int myId, GaugeObsArgs<U>* a)
+    {
+      GaugeObsLayout lay;
+      double* s = &(a->partial(myId,0));
+
+      for(int site=lo; site < hi; ++site)
+      {
+	for(int p=0; p < lay.nplane; ++p)
+	  s[lay.plaq+p] += reTrace(a->plaq[p].elem(site).elem());
+
+	for(int mu=0; mu < a->u.size(); ++mu)
+	  s[lay.link] += reTrace(a->u[mu].elem(site).elem());
+
+	for(int mu=0; mu < a->poly.size(); ++mu)
+	{
+	  s[lay.poly+2*mu]   += reTrace(a->poly[mu].elem(site).elem());
+	  s[lay.poly+2*mu+1] += imTrace(a->poly[mu].elem(site).elem());
+	}
+
+	if (a->f.size() == 0)
+	  continue;
+
+	for(int p=0; p < lay.nplane; ++p)
+	  s[lay.energy+p] += reTraceProd(a->f[p].elem(site).elem(), a->f[p].elem(site).elem());
+
+	// Planes are ordered 01, 02, 03, 12, 13, 23
+	if (Nd == 4)
+	  s[lay.qtop] += reTraceProd(a->f[0].elem(site).elem(), a->f[5].elem(site).elem())
+	    - reTraceProd(a->f[1].elem(site).elem(), a->f[4].elem(site).elem())
+	    + reTraceProd(a->f[2].elem(site).elem(), a->f[3].elem(site).elem());
+      }
+    }
+#endif
+
+
+    //! Measure the gauge observables
+    template<typename U>
+    void gaugeObservables_t(const multi1d<U>& u, GaugeObservables_t& obs,
+			    bool do_poly, bool do_clover, int t_dir)
+    {
+      START_CODE();
+
+      GaugeObsLayout lay;
+
+      multi1d<U> plaq(lay.nplane);
+      multi1d<U> f;
+      multi1d<U> poly;
+
+      if (do_clover)
+	f.resize(lay.nplane);
+
+      // Plaquettes and clover field strength, as in mesField
+      {
+	U tmp_0, tmp_1, tmp_2, tmp_3, tmp_4;
+	Real fact = 0.125;
+	int offset = 0;
+
+	for(int mu=0; mu < Nd-1; ++mu)
+	{
+	  for(int nu=mu+1; nu < Nd; ++nu)
+	  {
+	    tmp_3 = shift(u[nu], FORWARD, mu);
+	    tmp_4 = shift(u[mu], FORWARD, nu);
+	    tmp_0 = u[nu] * tmp_4;
+	    tmp_1 = u[mu] * tmp_3;
+	    plaq[offset] = tmp_1 * adj(tmp_0);
+
+	    if (do_clover)
+	    {
+	      f[offset] = plaq[offset];
+	      tmp_2 = adj(tmp_0) * tmp_1;
+	      tmp_1 = shift(tmp_2, BACKWARD, nu);
+	      f[offset] += shift(tmp_1, BACKWARD, mu);
+	      tmp_1 = tmp_4 * adj(tmp_3);
+	      tmp_0 = adj(u[nu]) * u[mu];
+	      f[offset] += shift(tmp_0*adj(tmp_1), BACKWARD, nu);
+	      f[offset] += shift(adj(tmp_1)*tmp_0, BACKWARD, mu);
+	      tmp_0 = adj(f[offset]);
+	      f[offset] -= tmp_0;
+	      f[offset] *= fact;
+	    }
+
+	    ++offset;
+	  }
+	}
+      }
+
+      // Polyakov lines, as in polylp
+      if (do_poly)
+      {
+	poly.resize(Nd);
+
+	for(int mu=0; mu < Nd; ++mu)
+	{
+	  poly[mu] = u[mu];
+	  for(int n = 1; n < Layout::lattSize()[mu]; ++n)
+	  {
+	    U tmp = shift(poly[mu], FORWARD, mu);
+	    poly[mu] = u[mu] * tmp;
+	  }
+	}
+      }
+
+      // All the traces and one global sum
+      multi1d<double> sums(lay.size);
+
+#ifndef QDP_IS_QDPJIT
+      {
+	const int nthr = qdpNumThreads();
+	multi2d<double> partial(nthr, lay.size);
+	for(int t=0; t < nthr; ++t)
+	  for(int i=0; i < lay.size; ++i)
+	    partial(t,i) = 0;
+
+	GaugeObsArgs<U> args = {u, plaq, poly, f, partial};
+
+	dispatch_to_threads(Layout::sitesOnNode(), args, gaugeObsSiteLoop<U>);
+
+	for(int i=0; i < lay.size; ++i)
+	{
+	  sums[i] = 0;
+	  for(int t=0; t < nthr; ++t)
+	    sums[i] += partial(t,i);
+	}
+      }
+#else
+      {
+	sums = 0;
+
+	multi1d<LatticeReal> fields(lay.size);
+	for(int i=0; i < lay.size; ++i)
+	  fields[i] = zero;
+
+	for(int p=0; p < lay.nplane; ++p)
+	  fields[lay.plaq+p] = real(trace(plaq[p]));
+
+	for(int mu=0; mu < Nd; ++mu)
+	  fields[lay.link] += real(trace(u[mu]));
+
+	for(int mu=0; mu < poly.size(); ++mu)
+	{
+	  fields[lay.poly+2*mu]   = real(trace(poly[mu]));
+	  fields[lay.poly+2*mu+1] = imag(trace(poly[mu]));
+	}
+
+	if (do_clover)
+	{
+	  for(int p=0; p < lay.nplane; ++p)
+	    fields[lay.energy+p] = real(trace(f[p]*f[p]));
+
+	  if (Nd == 4)
+	    fields[lay.qtop] = real(trace(f[0]*f[5] - f[1]*f[4] + f[2]*f[3]));
+	}
+
+	for(int i=0; i < lay.size; ++i)
+	  sums[i] = toDouble(sum(fields[i]));
+      }
+#endif
+
+      QDPInternal::globalSumArray(sums.slice(), sums.size());
+
+      // Normalize
+      const double vol = Layout::vol();
+
+      obs.plane_plaq.resize(Nd,Nd);
+      obs.w_plaq = obs.s_plaq = obs.t_plaq = zero;
+      obs.energy_s = obs.energy_t = zero;
+
+      {
+	int offset = 0;
+	for(int mu=0; mu < Nd-1; ++mu)
+	{
+	  for(int nu=mu+1; nu < Nd; ++nu)
+	  {
+	    Double tmp = sums[lay.plaq+offset] / (vol*Nc);
+	    obs.plane_plaq[mu][nu] = tmp;
+	    obs.plane_plaq[nu][mu] = tmp;
+
+	    obs.w_plaq += tmp;
+	    if (mu == t_dir || nu == t_dir)
+	    {
+	      obs.t_plaq   += tmp;
+	      obs.energy_t -= sums[lay.energy+offset] / vol;
+	    }
+	    else
+	    {
+	      obs.s_plaq   += tmp;
+	      obs.energy_s -= sums[lay.energy+offset] / vol;
+	    }
+
+	    ++offset;
+	  }
+	}
+      }
+
+      obs.w_plaq *= 2.0 / Double(Nd*(Nd-1));
+
+      if (Nd > 2)
+	obs.s_plaq *= 2.0 / Double((Nd-1)*(Nd-2));
+
+      obs.t_plaq /= Double(Nd-1);
+
+      obs.link = sums[lay.link] / (vol*Nd*Nc);
+
+      obs.poly = do_poly;
+      obs.pollp.resize(do_poly ? Nd : 0);
+      for(int mu=0; mu < obs.pollp.size(); ++mu)
+	obs.pollp[mu] = cmplx(Double(sums[lay.poly+2*mu]), Double(sums[lay.poly+2*mu+1])) / Double(Nc*vol);
+
+      obs.clover = do_clover;
+      obs.energy = obs.energy_s + obs.energy_t;
+      obs.qtop   = -sums[lay.qtop] / (4*M_PI*M_PI);
+
+      END_CODE();
+    }
+  }
+
+
+  void gaugeObservables(const multi1d<LatticeColorMatrixFNC>& u,
+			GaugeObservables_t& obs,
+			bool do_poly, bool do_clover, int t_dir)
+  {
+    gaugeObservables_t(u, obs, do_poly, do_clover, t_dir);
+  }
+
+  void gaugeObservables(const multi1d<LatticeColorMatrixDNC>& u,
+			GaugeObservables_t& obs,
+			bool do_poly, bool do_clover, int t_dir)
+  {
+    gaugeObservables_t(u, obs, do_poly, do_clover, t_dir);
+  }
+
+
+  //! Write the observables that were measured
+  void write(XMLWriter& xml, const std::string& path, const GaugeObservables_t& obs)
+  {
+    push(xml, path);
+
+    write(xml, "w_plaq", obs.w_plaq);
+    write(xml, "s_plaq", obs.s_plaq);
+    write(xml, "t_plaq", obs.t_plaq);
+
+    if (Nd >= 2)
+    {
+      write(xml, "plane_01_plaq", obs.plane_plaq[0][1]);
+    }
+
+    if (Nd >= 3)
+    {
+      write(xml, "plane_02_plaq", obs.plane_plaq[0][2]);
+      write(xml, "plane_12_plaq", obs.plane_plaq[1][2]);
+    }
+
+    if (Nd >= 4)
+    {
+      write(xml, "plane_03_plaq", obs.plane_plaq[0][3]);
+      write(xml, "plane_13_plaq", obs.plane_plaq[1][3]);
+      write(xml, "plane_23_plaq", obs.plane_plaq[2][3]);
+    }
+
+    write(xml, "link", obs.link);
+
+    if (obs.poly)
+      write(xml, "pollp", obs.pollp);
+
+    if (obs.clover)
+    {
+      write(xml, "energy_s", obs.energy_s);
+      write(xml, "energy_t", obs.energy_t);
+      write(xml, "energy", obs.energy);
+      write(xml, "qtop", obs.qtop);
+    }
+
+    pop(xml);
+  }
+
+}  // end namespace Chroma
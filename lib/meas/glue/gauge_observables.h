@@ -0,0 +1,68 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Plaquettes, link, Polyakov loops and clover observables in one sweep
+ */
+
+#ifndef __gauge_observables_h__
+#define __gauge_observables_h__
+
+#include "chromabase.h"
+
+namespace Chroma
+{
+
+  //! Gauge observables measured together
+  /*! \ingroup glue */
+  struct GaugeObservables_t
+  {
+    Double             w_plaq;       /*!< plaquette average */
+    Double             s_plaq;       /*!< space-like plaquette average */
+    Double             t_plaq;       /*!< time-like plaquette average */
+    multi2d<Double>    plane_plaq;   /*!< plane plaquette average */
+    Double             link;         /*!< space-time average link */
+
+    bool               poly;         /*!< were the Polyakov loops measured */
+    multi1d<DComplex>  pollp;        /*!< Polyakov loop average per direction */
+
+    bool               clover;       /*!< were the clover observables measured */
+    Double             energy_s;     /*!< space-space part of the energy density */
+    Double             energy_t;     /*!< space-time part of the energy density */
+    Double             energy;       /*!< clover energy density */
+    Double             qtop;         /*!< clover topological charge */
+  };
+
+
+  //! Measure the gauge observables in one sweep
+  /*!
+   * \ingroup glue
+   *
+   * The plaquettes, the Polyakov loops and the clover field strength are
+   * built first, then a single threaded sweep over the sites takes all the
+   * traces, followed by one global sum.
+   *
+   * The clover field strength is that of mesField. The energy density is
+   * E = -sum_{mu<nu} Re tr(F_{mu nu}^2) averaged over the lattice, and the
+   * topological charge is Q = -1/(4 pi^2) sum_x Re tr(F_01 F_23 - F_02 F_13
+   * + F_03 F_12), only measured for Nd = 4.
+   *
+   * \param u          gauge field (Read)
+   * \param obs        observables (Write)
+   * \param do_poly    measure the Polyakov loops (Read)
+   * \param do_clover  measure the clover energy and charge (Read)
+   * \param t_dir      time direction (Read)
+   */
+  void gaugeObservables(const multi1d<LatticeColorMatrixFNC>& u,
+			GaugeObservables_t& obs,
+			bool do_poly, bool do_clover, int t_dir = Nd-1);
+
+  void gaugeObservables(const multi1d<LatticeColorMatrixDNC>& u,
+			GaugeObservables_t& obs,
+			bool do_poly, bool do_clover, int t_dir = Nd-1);
+
+  //! Write the observables that were measured
+  /*! \ingroup glue */
+  void write(XMLWriter& xml, const std::string& path, const GaugeObservables_t& obs);
+
+}  // end namespace Chroma
+
+#endif
@@ -18,6 +18,7 @@
 
 #include "mesplq.h"
 #include "polylp.h"
+#include "gauge_observables.h"
 #include "fuzwilp.h" 
 #include "wilslp.h" 
 #include "wloop.h"
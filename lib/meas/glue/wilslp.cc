@@ -5,6 +5,7 @@
 #include "chromabase.h"
 #include "meas/glue/wilslp.h"
 #include "meas/gfix/axgauge.h"
+#include "meas/glue/wilslp_engine.h"
 
 namespace Chroma 
 {
@@ -40,15 +41,10 @@ namespace Chroma
     
     multi1d<LatticeColorMatrix> ug(Nd);
     multi1d<int> space_dir(Nd);
-    LatticeColorMatrix   u_t;
     LatticeColorMatrix   u_tmp;
     LatticeColorMatrix   u_diag;
-    LatticeColorMatrix   u_space;
     LatticeColorMatrix tmp_2;
     LatticeColorMatrix tmp_3;
-    LatticeReal wl_trace;
-    LatticeInteger t_coord;
-    LatticeBoolean btmp;
     Double dummy;
     Real ftmp;
 
@@ -62,7 +58,6 @@ namespace Chroma
     int rho;
     int r;
     int t;
-    int tt;
     int nr;
     int i;
     int j;
@@ -153,57 +148,22 @@ namespace Chroma
 	/*- */
 	ug = u;
 	axGauge (ug, nu);
-	t_coord = Layout::latticeCoordinate(nu);
+
+	WilsonLoopEngine engine(ug, nu, lengthr);
+	multi2d<Double> wl_tmp(lengthr, lengthr);
+	wl_tmp = 0;
 
 	for(i = 0;i  < ( j); ++i )
 	{
 	  mu = space_dir[i];
 
-	  for(r = 0;r  < ( lengthr); ++r )
-	  {
-	    /* Gather t-links (i.e. nu-links) from r-direction (i.e. mu) */
-	    /* and make "r-links" */
-
-	    if ( r == 0 )
-	    {
-	      u_t = shift(ug[nu], FORWARD, mu);
-	      u_space = ug[mu];
-	    }
-	    else
-	    {
-	      tmp_2 = shift(u_t, FORWARD, mu);
-	      u_t = tmp_2;
-
-	      tmp_2 = shift(u_space, FORWARD, mu);
-	      u_space = ug[mu] * tmp_2;
-	    }
-
-	    for(t = 0;t  < ( lengthr); ++t )
-	    {
-	      /* Gather r-link from t-direction (i.e. nu) */
-
-	      if ( t == 0 )
-	      {
-		u_tmp = shift(u_space, FORWARD, nu);
-	      }
-	      else
-	      {
-		tmp_2 = shift(u_tmp, FORWARD, nu);
-		u_tmp = tmp_2;
-	      }
-
-	      tt = lsizer - t - 1;
-	      btmp = t_coord < tt;
-
-	      tmp_2 = ug[nu] * u_tmp;
-	      tmp_3 = tmp_2 * adj(u_t);
-	      copymask(tmp_3, btmp, u_tmp);
-	      tmp_2 = tmp_3 * adj(u_space);
-	      wl_trace = real(trace(tmp_2));
-	      wils_loop1[r][t] += sum(wl_trace);
-	    }   /* end t loop */
-	  }     /* end r loop */
+	  engine.addLoops(wl_tmp, 0, lengthr, ug[mu],
+			  WilsonLoopEngine::makePath(FORWARD, mu));
 	}       /* end i loop (for mu) */
+
+	for(r = 0;r  < ( lengthr); ++r )
+	  for(t = 0;t  < ( lengthr); ++t )
+	    wils_loop1[r][t] += wl_tmp[t][r];
       }         /* end j loop (for nu) */
 
       dummy = 2.0 / double (Layout::vol()*Nc*nspace*(nspace-1)) ;
@@ -236,7 +196,8 @@ namespace Chroma
     /* Fix to axial gauge */
     ug = u;
     axGauge (ug, j_decay);
-    t_coord = Layout::latticeCoordinate(j_decay);
+
+    WilsonLoopEngine engine(ug, j_decay, lengtht);
 
     /* Compute "time-like" planar Wilson loops, if desired */
     if ( (kind & 2) != 0 )
@@ -249,51 +210,8 @@ namespace Chroma
       for(i = 0;i  < ( nspace); ++i )
       {
 	mu = space_dir[i];
-	for(r = 0;r  < ( lengthr); ++r )
-	{
-	  /* Gather t-links from space-direction (i.e. mu) */
-	  /* and make "space-links" */
-
-	  if ( r == 0 )
-	  {
-	    u_t = shift(ug[j_decay], FORWARD, mu);
-	    u_space = ug[mu];
-	  }
-	  else
-	  {
-	    tmp_2 = shift(u_t, FORWARD, mu);
-	    u_t   = tmp_2;
-
-	    tmp_2 = shift(u_space, FORWARD, mu);
-	    tmp_3 = ug[mu] * tmp_2;
-	    u_space = tmp_3;
-	  }
-
-	  for(t = 0;t  < ( lengtht); ++t )
-	  {
-	    /* Gather space-link from t-direction (i.e. j_decay) */
-
-	    if ( t == 0 )
-	    {
-	      u_tmp = shift(u_space, FORWARD, j_decay);
-	    }
-	    else
-	    {
-	      tmp_2 = shift(u_tmp, FORWARD, j_decay);
-	      u_tmp = tmp_2;
-	    }
-	    tt = lsizet - t - 1;
-	    btmp = t_coord < tt;
-
-	    tmp_2 = ug[j_decay] * u_tmp;
-	    tmp_3 = tmp_2 * adj(u_t);
-	    copymask(tmp_3, btmp, u_tmp);
-	    tmp_2 = tmp_3 * adj(u_space);
-	    wl_trace = real(trace(tmp_2));
-	    wils_loop2[t][r] += sum(wl_trace);
-
-	  }    /* end t loop */
-	}      /* end r loop */
+	engine.addLoops(wils_loop2, 0, lengthr, ug[mu],
+			WilsonLoopEngine::makePath(FORWARD, mu));
       }        /* end i loop (for mu) */
 
       dummy = 1.0 / double (Layout::vol()*Nc*nspace) ;
@@ -366,49 +284,8 @@ namespace Chroma
 	  u_diag += ug[nu] * tmp_2;
 	  u_diag = u_diag * ftmp;
 
-	  for(r = 0;r  < ( lengthr); ++r )
-	  {
-	    /* Gather t-links from space-directions (i.e. mu and nu) */
-	    /* and make "space-links" */
-
-	    if ( r == 0 )
-	    {
-	      tmp_2 = shift(ug[j_decay], FORWARD, mu);
-	      u_t   = shift(tmp_2, FORWARD, nu);
-	      u_space = u_diag;
-	    }
-	    else
-	    {
-	      tmp_2 = shift(u_t, FORWARD, mu);
-	      u_t   = shift(tmp_2, FORWARD, nu);
-	      tmp_2 = shift(u_space, FORWARD, mu);
-	      tmp_3 = shift(tmp_2, FORWARD, nu);
-	      u_space = u_diag * tmp_3;
-	    }
-
-	    for(t = 0;t  < ( lengtht); ++t )
-	    {
-	      /* Gather space-link from t-direction (i.e. j_decay) */
-	      if ( t == 0 )
-	      {
-		u_tmp = shift(u_space, FORWARD, j_decay);
-	      }
-	      else
-	      {
-		tmp_2 = shift(u_tmp, FORWARD, j_decay);
-		u_tmp = tmp_2;
-	      }
-
-	      tt = lsizet - t - 1;
-	      btmp = t_coord < tt;
-	      tmp_2 = ug[j_decay] * u_tmp;
-	      tmp_3 = tmp_2 * adj(u_t);
-	      copymask(tmp_3, btmp, u_tmp);
-	      tmp_2 = tmp_3 * adj(u_space);
-	      wl_trace = real(trace(tmp_2));
-	      wils_loop3[t][r] += sum(wl_trace);
-	    }        /* end t loop */
-	  }          /* end r loop */
+	  engine.addLoops(wils_loop3, 0, lengthr, u_diag,
+			  WilsonLoopEngine::makePath(FORWARD, mu, FORWARD, nu));
 
 	  /*+ */
 	  /* Do off-axis "sqrt(2)" loops in (mu,-nu)-plane */
@@ -423,50 +300,8 @@ namespace Chroma
 	  u_diag += ug[mu] * adj(tmp_3);
 	  u_diag = u_diag * ftmp;
 
-	  for(r = 0;r  < ( lengthr); ++r )
-	  {
-	    /* Gather t-links from space-directions (i.e. mu and -nu) */
-	    /* and make "space-links" */
-
-	    if ( r == 0 )
-	    {
-	      tmp_2 = shift(ug[j_decay], FORWARD, mu);
-	      u_t   = shift(tmp_2, BACKWARD, nu);
-	      u_space = u_diag;
-	    }
-	    else
-	    {
-	      tmp_2 = shift(u_t, FORWARD, mu);
-	      u_t   = shift(tmp_2, BACKWARD, nu);
-	      tmp_2 = shift(u_space, FORWARD, mu);
-	      tmp_3 = shift(tmp_2, BACKWARD, nu);
-	      u_space = u_diag * tmp_3;
-	    }
-
-	    for(t = 0;t  < ( lengtht); ++t )
-	    {
-	      /* Gather space-link from t-direction (i.e. j_decay) */
-	      if ( t == 0 )
-	      {
-		u_tmp = shift(u_space, FORWARD, j_decay);
-	      }
-	      else
-	      {
-		tmp_2 = shift(u_tmp, FORWARD, j_decay);
-		u_tmp = tmp_2;
-	      }
-
-	      tt = lsizet - t - 1;
-	      btmp = t_coord < tt;
-	      tmp_2 = ug[j_decay] * u_tmp;
-	      tmp_3 = tmp_2 * adj(u_t);
-	      copymask(tmp_3, btmp, u_tmp);
-	      tmp_2 = tmp_3 * adj(u_space);
-	      wl_trace = real(trace(tmp_2));
-	      wils_loop3[t][r] += sum(wl_trace);
-
-	    }        /* end t loop */
-	  }          /* end r loop */
+	  engine.addLoops(wils_loop3, 0, lengthr, u_diag,
+			  WilsonLoopEngine::makePath(FORWARD, mu, BACKWARD, nu));
 
 	  /*+ */
 	  /* Do off-axis "sqrt(5)" loops in (2*mu,nu)-plane */
@@ -488,56 +323,8 @@ namespace Chroma
 
 	  u_diag = u_diag * ftmp;
 
-	  for(r = 0;r  < ( lengthr/2); ++r )
-	  {
-	    /* Gather t-links from space-directions (i.e. 2*mu and nu) */
-	    /* and make "space-links" */
-
-	    if ( r == 0 )
-	    {
-	      tmp_2 = shift(ug[j_decay], FORWARD, mu);
-	      tmp_3 = shift(tmp_2, FORWARD, mu);
-	      u_t   = shift(tmp_3, FORWARD, nu);
-	      u_space = u_diag;
-	    }
-	    else
-	    {
-	      tmp_2 = shift(u_t, FORWARD, mu);
-	      tmp_3 = shift(tmp_2, FORWARD, mu);
-	      u_tmp = shift(tmp_3, FORWARD, nu);
-	      u_t = u_tmp;
-
-	      tmp_2 = shift(u_space, FORWARD, mu);
-	      tmp_3 = shift(tmp_2, FORWARD, mu);
-	      tmp_2 = shift(tmp_3, FORWARD, nu);
-	      u_tmp = u_diag * tmp_2;
-	      u_space = u_tmp;
-	    }
-
-	    for(t = 0;t  < ( lengtht); ++t )
-	    {
-	      /* Gather space-link from t-direction (i.e. j_decay) */
-	      if ( t == 0 )
-	      {
-		u_tmp = shift(u_space, FORWARD, j_decay);
-	      }
-	      else
-	      {
-		tmp_2 = shift(u_tmp, FORWARD, j_decay);
-		u_tmp = tmp_2;
-	      }
-
-	      tt = lsizet - t - 1;
-	      btmp = t_coord < tt;
-	      tmp_2 = ug[j_decay] * u_tmp;
-	      tmp_3 = tmp_2 * adj(u_t);
-	      copymask(tmp_3, btmp, u_tmp);
-	      tmp_2 = tmp_3 * adj(u_space);
-	      wl_trace = real(trace(tmp_2));
-	      wils_loop3[t][r_off+r] += sum(wl_trace);
-
-	    }        /* end t loop */
-	  }          /* end r loop */
+	  engine.addLoops(wils_loop3, r_off, lengthr/2, u_diag,
+			  WilsonLoopEngine::makePath(FORWARD, mu, FORWARD, mu, FORWARD, nu));
 
 	  /*+ */
 	  /* Do off-axis "sqrt(5)" loops in (2*mu,-nu)-plane */
@@ -559,57 +346,8 @@ namespace Chroma
 
 	  u_diag = u_diag * ftmp;
 
-	  for(r = 0;r  < ( lengthr/2); ++r )
-	  {
-	    /* Gather t-links from space-directions (i.e. 2*mu and -nu) */
-	    /* and make "space-links" */
-
-	    if ( r == 0 )
-	    {
-	      tmp_2 = shift(ug[j_decay], FORWARD, mu);
-	      tmp_3 = shift(tmp_2, FORWARD, mu);
-	      u_t   = shift(tmp_3, BACKWARD, nu);
-	      u_space = u_diag;
-	    }
-	    else
-	    {
-	      tmp_2 = shift(u_t, FORWARD, mu);
-	      tmp_3 = shift(tmp_2, FORWARD, mu);
-	      u_tmp = shift(tmp_3, BACKWARD, nu);
-	      u_t = u_tmp;
-
-	      tmp_2 = shift(u_space, FORWARD, mu);
-	      tmp_3 = shift(tmp_2, FORWARD, mu);
-	      tmp_2 = shift(tmp_3, BACKWARD, nu);
-	      u_tmp = u_diag * tmp_2;
-	      u_space = u_tmp;
-	    }
-
-	    for(t = 0;t  < ( lengtht); ++t )
-	    {
-	      /* Gather space-link from t-direction (i.e. j_decay) */
-	      if ( t == 0 )
-	      {
-		u_tmp = shift(u_space, FORWARD, j_decay);
-	      }
-	      else
-	      {
-		tmp_2 = shift(u_tmp, FORWARD, j_decay);
-		u_tmp = tmp_2;
-	      }
-
-
-	      tt = lsizet - t - 1;
-	      btmp = t_coord < tt;
-
-	      tmp_2 = ug[j_decay] * u_tmp;
-	      tmp_3 = tmp_2 * adj(u_t);
-	      copymask(tmp_3, btmp, u_tmp);
-	      tmp_2 = tmp_3 * adj(u_space);
-	      wl_trace = real(trace(tmp_2));
-	      wils_loop3[t][r_off+r] += sum(wl_trace);
-	    }        /* end t loop */
-	  }          /* end r loop */
+	  engine.addLoops(wils_loop3, r_off, lengthr/2, u_diag,
+			  WilsonLoopEngine::makePath(FORWARD, mu, FORWARD, mu, BACKWARD, nu));
 
 
 	  /*+ */
@@ -631,56 +369,8 @@ namespace Chroma
 
 	  u_diag = u_diag * ftmp;
 
-	  for(r = 0;r  < ( lengthr/2); ++r )
-	  {
-	    /* Gather t-links from space-directions (i.e. 2*nu and mu) */
-	    /* and make "space-links" */
-
-	    if ( r == 0 )
-	    {
-	      tmp_2 = shift(ug[j_decay], FORWARD, nu);
-	      tmp_3 = shift(tmp_2, FORWARD, nu);
-	      u_t   = shift(tmp_3, FORWARD, mu);
-	      u_space = u_diag;
-	    }
-	    else
-	    {
-	      tmp_2 = shift(u_t, FORWARD, nu);
-	      tmp_3 = shift(tmp_2, FORWARD, nu);
-	      u_tmp = shift(tmp_3, FORWARD, mu);
-	      u_t = u_tmp;
-
-	      tmp_2 = shift(u_space, FORWARD, nu);
-	      tmp_3 = shift(tmp_2, FORWARD, nu);
-	      tmp_2 = shift(tmp_3, FORWARD, mu);
-	      u_tmp = u_diag * tmp_2;
-	      u_space = u_tmp;
-	    }
-
-	    for(t = 0;t  < ( lengtht); ++t )
-	    {
-	      /* Gather space-link from t-direction (i.e. j_decay) */
-	      if ( t == 0 )
-	      {
-		u_tmp = shift(u_space, FORWARD, j_decay);
-	      }
-	      else
-	      {
-		tmp_2 = shift(u_tmp, FORWARD, j_decay);
-		u_tmp = tmp_2;
-	      }
-
-	      tt = lsizet - t - 1;
-	      btmp = t_coord < tt;
-
-	      tmp_2 = ug[j_decay] * u_tmp;
-	      tmp_3 = tmp_2 * adj(u_t);
-	      copymask(tmp_3, btmp, u_tmp);
-	      tmp_2 = tmp_3 * adj(u_space);
-	      wl_trace = real(trace(tmp_2));
-	      wils_loop3[t][r_off+r] += sum(wl_trace);
-	    }        /* end t loop */
-	  }          /* end r loop */
+	  engine.addLoops(wils_loop3, r_off, lengthr/2, u_diag,
+			  WilsonLoopEngine::makePath(FORWARD, nu, FORWARD, nu, FORWARD, mu));
 
 
 	  /*+ */
@@ -702,57 +392,8 @@ namespace Chroma
 
 	  u_diag = u_diag * ftmp;
 
-	  for(r = 0;r  < ( lengthr/2); ++r )
-	  {
-	    /* Gather t-links from space-directions (i.e. 2*nu and -mu) */
-	    /* and make "space-links" */
-
-	    if ( r == 0 )
-	    {
-	      tmp_2 = shift(ug[j_decay], FORWARD, nu);
-	      tmp_3 = shift(tmp_2, FORWARD, nu);
-	      u_t   = shift(tmp_3, BACKWARD, mu);
-	      u_space = u_diag;
-	    }
-	    else
-	    {
-	      tmp_2 = shift(u_t, FORWARD, nu);
-	      tmp_3 = shift(tmp_2, FORWARD, nu);
-	      u_tmp = shift(tmp_3, BACKWARD, mu);
-	      u_t   = u_tmp;
-
-	      tmp_2 = shift(u_space, FORWARD, nu);
-	      tmp_3 = shift(tmp_2, FORWARD, nu);
-	      tmp_2 = shift(tmp_3, BACKWARD, mu);
-	      u_tmp = u_diag * tmp_2;
-	      u_space = u_tmp;
-	    }
-
-	    for(t = 0;t  < ( lengtht); ++t )
-	    {
-	      /* Gather space-link from t-direction (i.e. j_decay) */
-	      if ( t == 0 )
-	      {
-		u_tmp = shift(u_space, FORWARD, j_decay);
-	      }
-	      else
-	      {
-		tmp_2 = shift(u_tmp, FORWARD, j_decay);
-		u_tmp = tmp_2;
-	      }
-
-	      tt = lsizet - t - 1;
-	      btmp = t_coord < tt;
-
-	      tmp_2 = ug[j_decay] * u_tmp;
-	      tmp_3 = tmp_2 * adj(u_t);
-	      copymask(tmp_3, btmp, u_tmp);
-	      tmp_2 = tmp_3 * adj(u_space);
-	      wl_trace = real(trace(tmp_2));
-	      wils_loop3[t][r_off+r] += sum(wl_trace);
-
-	    }        /* end t loop */
-	  }          /* end r loop */
+	  engine.addLoops(wils_loop3, r_off, lengthr/2, u_diag,
+			  WilsonLoopEngine::makePath(FORWARD, nu, FORWARD, nu, BACKWARD, mu));
 	}            /* end i loop (for mu) */
       }              /* end j loop (for nu) */
 
@@ -821,57 +462,8 @@ namespace Chroma
 
 	      u_diag = u_diag * ftmp;
 
-	      for(r = 0;r  < ( lengthr); ++r )
-	      {
-		/* Gather t-links from space-directions (i.e. mu, nu and rho) */
-		/* and make "space-links" */
-
-		if ( r == 0 )
-		{
-		  tmp_2 = shift(ug[j_decay], FORWARD, mu);
-		  tmp_3 = shift(tmp_2, FORWARD, nu);
-		  u_t   = shift(tmp_3, FORWARD, rho);
-
-		  u_space = u_diag;
-		}
-		else
-		{
-		  tmp_2 = shift(u_t, FORWARD, mu);
-		  tmp_3 = shift(tmp_2, FORWARD, nu);
-		  u_tmp = shift(tmp_3, FORWARD, rho);
-		  u_t   = u_tmp;
-
-		  tmp_2 = shift(u_space, FORWARD, mu);
-		  tmp_3 = shift(tmp_2, FORWARD, nu);
-		  tmp_2 = shift(tmp_3, FORWARD, rho);
-		  u_tmp = u_diag * tmp_2;
-		  u_space = u_tmp;
-		}
-
-		for(t = 0;t  < ( lengtht); ++t )
-		{
-		  /* Gather space-link from t-direction (i.e. j_decay) */
-		  if ( t == 0 )
-		  {
-		    u_tmp = shift(u_space, FORWARD, j_decay);
-		  }
-		  else
-		  {
-		    tmp_2 = shift(u_tmp, FORWARD, j_decay);
-		    u_tmp = tmp_2;  
-		  }
-
-		  tt = lsizet - t - 1;
-		  btmp = t_coord < tt;
-
-		  tmp_2 = ug[j_decay] * u_tmp;
-		  tmp_3 = tmp_2 * adj(u_t);
-		  copymask(tmp_3, btmp, u_tmp);
-		  tmp_2 = tmp_3 * adj(u_space);
-		  wl_trace = real(trace(tmp_2));
-		  wils_loop3[t][r_off+r] += sum(wl_trace);
-		}    /* end t loop */
-	      }      /* end r loop */
+	      engine.addLoops(wils_loop3, r_off, lengthr, u_diag,
+			      WilsonLoopEngine::makePath(FORWARD, mu, FORWARD, nu, FORWARD, rho));
 
 	      /*+ */
 	      /* Do off-axis "sqrt(3)" loops in (mu,nu,-rho)-plane */
@@ -910,57 +502,8 @@ namespace Chroma
 
 	      u_diag = u_diag * ftmp;
 
-	      for(r = 0;r  < ( lengthr); ++r )
-	      {
-		/* Gather t-links from space-directions (i.e. mu, nu and -rho) */
-		/* and make "space-links" */
-
-		if ( r == 0 )
-		{
-		  tmp_2 = shift(ug[j_decay], FORWARD, mu);
-		  tmp_3 = shift(tmp_2, FORWARD, nu);
-		  u_t   = shift(tmp_3, BACKWARD, rho);
-		  u_space = u_diag;
-		}
-		else
-		{
-		  tmp_2 = shift(u_t, FORWARD, mu);
-		  tmp_3 = shift(tmp_2, FORWARD, nu);
-		  u_tmp = shift(tmp_3, BACKWARD, rho);
-		  u_t = u_tmp;
-
-		  tmp_2 = shift(u_space, FORWARD, mu);
-		  tmp_3 = shift(tmp_2, FORWARD, nu);
-		  tmp_2 = shift(tmp_3, BACKWARD, rho);
-		  u_tmp = u_diag * tmp_2;
-		  u_space = u_tmp;
-		}
-
-		for(t = 0;t  < ( lengtht); ++t )
-		{
-		  /* Gather space-link from t-direction (i.e. j_decay) */
-		  if ( t == 0 )
-		  {
-		    u_tmp = shift(u_space, FORWARD, j_decay);
-		  }
-		  else
-		  {
-		    tmp_2 = shift(u_tmp, FORWARD, j_decay);
-		    u_tmp = tmp_2;
-		  }
-
-		  tt = lsizet - t - 1;
-		  btmp = t_coord < tt;
-
-		  tmp_2 = ug[j_decay] * u_tmp;
-		  tmp_3 = tmp_2 * adj(u_t);
-		  copymask(tmp_3, btmp, u_tmp);
-		  tmp_2 = tmp_3 * adj(u_space);
-		  wl_trace = real(trace(tmp_2));
-		  wils_loop3[t][r_off+r] += sum(wl_trace);
-
-		}    /* end t loop */
-	      }      /* end r loop */
+	      engine.addLoops(wils_loop3, r_off, lengthr, u_diag,
+			      WilsonLoopEngine::makePath(FORWARD, mu, FORWARD, nu, BACKWARD, rho));
 
 	      /*+ */
 	      /* Do off-axis "sqrt(3)" loops in (mu,-nu,rho)-plane */
@@ -999,57 +542,8 @@ namespace Chroma
 
 	      u_diag = u_diag * ftmp;
 
-	      for(r = 0;r  < ( lengthr); ++r )
-	      {
-		/* Gather t-links from space-directions (i.e. mu, -nu and rho) */
-		/* and make "space-links" */
-
-		if ( r == 0 )
-		{
-		  tmp_2 = shift(ug[j_decay], FORWARD, mu);
-		  tmp_3 = shift(tmp_2, BACKWARD, nu);
-		  u_t   = shift(tmp_3, FORWARD, rho);
-		  u_space = u_diag;
-		}
-		else
-		{
-		  tmp_2 = shift(u_t, FORWARD, mu);
-		  tmp_3 = shift(tmp_2, BACKWARD, nu);
-		  u_tmp = shift(tmp_3, FORWARD, rho);
-		  u_t   = u_tmp;
-
-		  tmp_2 = shift(u_space, FORWARD, mu);
-		  tmp_3 = shift(tmp_2, BACKWARD, nu);
-		  tmp_2 = shift(tmp_3, FORWARD, rho);
-		  u_tmp = u_diag * tmp_2;
-		  u_space = u_tmp;
-		}
-
-		for(t = 0;t  < ( lengtht); ++t )
-		{
-		  /* Gather space-link from t-direction (i.e. j_decay) */
-		  if ( t == 0 )
-		  {
-		    u_tmp = shift(u_space, FORWARD, j_decay);
-		  }
-		  else
-		  {
-		    tmp_2 = shift(u_tmp, FORWARD, j_decay);
-		    u_tmp = tmp_2;
-		  }
-
-		  tt = lsizet - t - 1;
-		  btmp = t_coord < tt;
-
-		  tmp_2 = ug[j_decay] * u_tmp;
-		  tmp_3 = tmp_2 * adj(u_t);
-		  copymask(tmp_3, btmp, u_tmp);
-		  tmp_2 = tmp_3 * adj(u_space);
-		  wl_trace = real(trace(tmp_2));
-		  wils_loop3[t][r_off+r] += sum(wl_trace);
-
-		}    /* end t loop */
-	      }      /* end r loop */
+	      engine.addLoops(wils_loop3, r_off, lengthr, u_diag,
+			      WilsonLoopEngine::makePath(FORWARD, mu, BACKWARD, nu, FORWARD, rho));
 
 	      /*+ */
 	      /* Do off-axis "sqrt(3)" loops in (mu,-nu,-rho)-plane */
@@ -1093,57 +587,8 @@ namespace Chroma
 
 	      u_diag = u_diag * ftmp;
 
-	      for(r = 0;r  < ( lengthr); ++r )
-	      {
-		/* Gather t-links from space-directions (i.e. mu, -nu and -rho) */
-		/* and make "space-links" */
-
-		if ( r == 0 )
-		{
-		  tmp_2 = shift(ug[j_decay], FORWARD, mu);
-		  tmp_3 = shift(tmp_2, BACKWARD, nu);
-		  u_t   = shift(tmp_3, BACKWARD, rho);
-		  u_space = u_diag;
-		}
-		else
-		{
-		  tmp_2 = shift(u_t, FORWARD, mu);
-		  tmp_3 = shift(tmp_2, BACKWARD, nu);
-		  u_tmp = shift(tmp_3, BACKWARD, rho);
-		  u_t   = u_tmp;
-
-		  tmp_2 = shift(u_space, FORWARD, mu);
-		  tmp_3 = shift(tmp_2, BACKWARD, nu);
-		  tmp_2 = shift(tmp_3, BACKWARD, rho);
-		  u_tmp = u_diag * tmp_2;
-		  u_space = u_tmp;
-		}
-
-		for(t = 0;t  < ( lengtht); ++t )
-		{
-		  /* Gather space-link from t-direction (i.e. j_decay) */
-		  if ( t == 0 )
-		  {
-		    u_tmp = shift(u_space, FORWARD, j_decay);
-		  }
-		  else
-		  {
-		    tmp_2 = shift(u_tmp, FORWARD, j_decay);
-		    u_tmp = tmp_2;
-		  }
-
-		  tt = lsizet - t - 1;
-		  btmp = t_coord < tt;
-
-		  tmp_2 = ug[j_decay] * u_tmp;
-		  tmp_3 = tmp_2 * adj(u_t);
-		  copymask(tmp_3, btmp, u_tmp);
-		  tmp_2 = tmp_3 * adj(u_space);
-		  wl_trace = real(trace(tmp_2));
-		  wils_loop3[t][r_off+r] += sum(wl_trace);
-
-		}    /* end t loop */
-	      }      /* end r loop */
+	      engine.addLoops(wils_loop3, r_off, lengthr, u_diag,
+			      WilsonLoopEngine::makePath(FORWARD, mu, BACKWARD, nu, BACKWARD, rho));
 	    }        /* end i loop (for mu) */
 	  }          /* end j loop (for nu) */
 	}            /* end k loop (for rho) */
@@ -0,0 +1,231 @@
+/*! \file
+ *  \brief Incremental Wilson loop engine for static potentials
+ */
+
+#include "meas/glue/wilslp_engine.h"
+
+namespace Chroma
+{
+
+  // Anonymous namespace
+  namespace
+  {
+#ifndef QDP_IS_QDPJIT
+    typedef PColorMatrix< RComplex<REAL>, Nc>  SiteColorMat_t;
+
+    //! Arguments for the loop trace site loop
+    struct LoopTraceArgs
+    {
+      const LatticeColorMatrix&    u_j;       /*!< axial gauge time links */
+      const LatticeColorMatrix&    u_tmp;     /*!< spatial line at x + (t+1) */
+      const LatticeColorMatrix&    u_t;       /*!< time link at x + r */
+      const LatticeColorMatrix&    u_space;   /*!< spatial line at x */
+      const multi1d<int>&          t_coord;
+      int                          tt;
+      multi1d<REAL64>&             partial;   /*!< one sum per thread */
+    };
+
+    //! Re tr(A * adj(B))
+    inline
+    REAL64 reTraceAdj(const SiteColorMat_t& A, const SiteColorMat_t& B)
+    {
+      REAL64 s = 0;
+      for(int a=0; a < Nc; ++a)
+	for(int b=0; b < Nc; ++b)
+	  s += A.elem(a,b).real()*B.elem(a,b).real() + A.elem(a,b).imag()*B.elem(a,b).imag();
+      return s;
+    }
+
+    //! Local sum of the loop traces
+    /*!
+     * Away from the time boundary the axial gauge time links are unity and
+     * the loop is just tr(u_tmp adj(u_space)). Only the sites whose time
+     * lines cross the boundary need the time links.
+     */
+    inline
+    void loopTraceSiteLoop(int lo, int hi, int myId, LoopTraceArgs* a)
+    {
+      REAL64 s = 0;
+
+      for(int site=lo; site < hi; ++site)
+      {
+	const SiteColorMat_t& us   = a->u_space.elem(site).elem();
+	const SiteColorMat_t& utmp = a->u_tmp.elem(site).elem();
+
+	if (a->t_coord[site] < a->tt)
+	{
+	  s += reTraceAdj(utmp, us);
+	}
+	else
+	{
+	  SiteColorMat_t m = a->u_j.elem(site).elem() * utmp;
+	  SiteColorMat_t w = m * adj(a->u_t.elem(site).elem());
+	  s += reTraceAdj(w, us);
+	}
+      }
+
+      a->partial[myId] += s;
+    }
+#endif
+  }
+
+
+  // Paths of one, two and three shifts
+  WilsonLoopEngine::Path_t
+  WilsonLoopEngine::makePath(int isign0, int dir0)
+  {
+    Step_t s0 = {isign0, dir0};
+    return Path_t(1, s0);
+  }
+
+  WilsonLoopEngine::Path_t
+  WilsonLoopEngine::makePath(int isign0, int dir0, int isign1, int dir1)
+  {
+    Path_t p = makePath(isign0, dir0);
+    Step_t s1 = {isign1, dir1};
+    p.push_back(s1);
+    return p;
+  }
+
+  WilsonLoopEngine::Path_t
+  WilsonLoopEngine::makePath(int isign0, int dir0, int isign1, int dir1, int isign2, int dir2)
+  {
+    Path_t p = makePath(isign0, dir0, isign1, dir1);
+    Step_t s2 = {isign2, dir2};
+    p.push_back(s2);
+    return p;
+  }
+
+
+  // Constructor
+  WilsonLoopEngine::WilsonLoopEngine(const multi1d<LatticeColorMatrix>& ug_, int t_dir_, int lengtht_) :
+    ug(ug_), t_dir(t_dir_), lengtht(lengtht_)
+  {
+    lsizet = Layout::lattSize()[t_dir];
+
+    t_coord.resize(Layout::sitesOnNode());
+    for(int site=0; site < t_coord.size(); ++site)
+      t_coord[site] = Layout::siteCoords(Layout::nodeNumber(), site)[t_dir];
+  }
+
+
+  // dest(x) = src(x + path)
+  void WilsonLoopEngine::shiftPath(LatticeColorMatrix& dest, const LatticeColorMatrix& src,
+				   const Path_t& path) const
+  {
+    LatticeColorMatrix tmp[2];
+    int cur = 0;
+
+    for(int n=0; n < path.size(); ++n)
+    {
+      const LatticeColorMatrix& from = (n == 0) ? src : tmp[cur];
+      LatticeColorMatrix& to = (n == path.size()-1) ? dest : tmp[1-cur];
+      to = shift(from, path[n].isign, path[n].dir);
+      cur = 1-cur;
+    }
+  }
+
+
+  // Accumulate loops along a spatial path
+  void WilsonLoopEngine::addLoops(multi2d<Double>& wl, int r_off, int nr,
+				  const LatticeColorMatrix& step, const Path_t& path) const
+  {
+    START_CODE();
+
+    // The trace sums of all (r,t), reduced over the nodes at the end
+    multi1d<REAL64> local(nr*lengtht);
+    local = 0;
+
+    LatticeColorMatrix u_t;           // time link at x + r
+    LatticeColorMatrix u_space;       // spatial line at x
+    LatticeColorMatrix u_tmp[2];      // spatial line at x + (t+1)
+    LatticeColorMatrix tmp;
+
+    for(int r=0; r < nr; ++r)
+    {
+      // Extend the time link and the spatial line by one step of the path
+      if (r == 0)
+      {
+	shiftPath(u_t, ug[t_dir], path);
+	u_space = step;
+      }
+      else
+      {
+	shiftPath(tmp, u_t, path);
+	u_t = tmp;
+
+	shiftPath(tmp, u_space, path);
+	u_space = step * tmp;
+      }
+
+      int cur = 0;
+      for(int t=0; t < lengtht; ++t)
+      {
+	// Move the spatial line one more step up in time
+	u_tmp[1-cur] = shift((t == 0) ? u_space : u_tmp[cur], FORWARD, t_dir);
+	cur = 1-cur;
+
+	int tt = lsizet - t - 1;
+
+#ifndef QDP_IS_QDPJIT
+	multi1d<REAL64> partial(qdpNumThreads());
+	partial = 0;
+
+	LoopTraceArgs args = {ug[t_dir], u_tmp[cur], u_t, u_space, t_coord, tt, partial};
+	dispatch_to_threads(Layout::sitesOnNode(), args, loopTraceSiteLoop);
+
+	for(int i=0; i < partial.size(); ++i)
+	  local[t*nr + r] += partial[i];
+#else
+	LatticeBoolean btmp = Layout::latticeCoordinate(t_dir) < tt;
+	LatticeColorMatrix tmp_3 = ug[t_dir] * u_tmp[cur] * adj(u_t);
+	copymask(tmp_3, btmp, u_tmp[cur]);
+	local[t*nr + r] += toDouble(sum(real(trace(tmp_3 * adj(u_space)))));
+#endif
+      }
+    }
+
+#ifndef QDP_IS_QDPJIT
+    QDPInternal::globalSumArray(local.slice(), local.size());
+#endif
+
+    for(int t=0; t < lengtht; ++t)
+      for(int r=0; r < nr; ++r)
+	wl[t][r_off+r] += Double(local[t*nr + r]);
+
+    END_CODE();
+  }
+
+
+  // Static (temporal) Wilson line from a point
+  void staticLine(multi1d<ColorMatrix>& Q,
+		  const multi1d<LatticeColorMatrix>& u,
+		  const multi1d<int>& src, int length)
+  {
+    START_CODE();
+
+    const int t0 = src[Nd-1];
+
+    Q.resize(length);
+    for(int t=0; t <= t0 && t < length; ++t)
+      Q[t] = zero;
+
+    if (t0 >= length)
+      return;
+
+    // Only the links of the time column through src are needed
+    ColorMatrix line = 1.0;
+    Q[t0] = line;
+
+    multi1d<int> coord = src;
+    for(int t=t0+1; t < length; ++t)
+    {
+      coord[Nd-1] = t-1;
+      line = line * peekSite(u[Nd-1], coord);
+      Q[t] = adj(line);
+    }
+
+    END_CODE();
+  }
+
+}  // end namespace Chroma
@@ -0,0 +1,98 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Incremental Wilson loop engine for static potentials
+ */
+
+#ifndef __wilslp_engine_h__
+#define __wilslp_engine_h__
+
+#include "chromabase.h"
+#include <vector>
+
+namespace Chroma
+{
+
+  //! Incremental Wilson loop engine
+  /*!
+   * \ingroup glue
+   *
+   * Computes all W(r,t) for a spatial path at once, for a gauge field in
+   * axial gauge along the time direction. The spatial Wilson line of
+   * length r is built once from the line of length r-1, and the line at
+   * distance t from the one at distance t-1, so every step costs a
+   * single shift. The traces are accumulated locally, and all (r,t) of a
+   * path are summed over the nodes with one global reduction.
+   */
+  class WilsonLoopEngine
+  {
+  public:
+    //! One shift of a spatial path
+    struct Step_t
+    {
+      int isign;     /*!< FORWARD or BACKWARD */
+      int dir;       /*!< direction */
+    };
+
+    //! Displacement of one step of a spatial Wilson line
+    typedef std::vector<Step_t> Path_t;
+
+    //! Paths of one, two and three shifts
+    static Path_t makePath(int isign0, int dir0);
+    static Path_t makePath(int isign0, int dir0, int isign1, int dir1);
+    static Path_t makePath(int isign0, int dir0, int isign1, int dir1, int isign2, int dir2);
+
+    //! Constructor
+    /*!
+     * \param ug        gauge field in axial gauge along t_dir ( Read )
+     * \param t_dir     time direction of the loops ( Read )
+     * \param lengtht   number of time extents ( Read )
+     */
+    WilsonLoopEngine(const multi1d<LatticeColorMatrix>& ug, int t_dir, int lengtht);
+
+    //! Accumulate loops along a spatial path
+    /*!
+     * For r < nr and t < lengtht adds the summed real trace of the loop
+     * with spatial extent r+1 steps and time extent t+1 to wl[t][r_off+r].
+     *
+     * \param wl        Wilson loops ( Modify )
+     * \param r_off     offset of the spatial extents in wl ( Read )
+     * \param nr        number of spatial extents ( Read )
+     * \param step      link product of one step of the path ( Read )
+     * \param path      displacement of one step ( Read )
+     */
+    void addLoops(multi2d<Double>& wl, int r_off, int nr,
+		  const LatticeColorMatrix& step, const Path_t& path) const;
+
+  private:
+    //! dest(x) = src(x + path)
+    void shiftPath(LatticeColorMatrix& dest, const LatticeColorMatrix& src, const Path_t& path) const;
+
+    const multi1d<LatticeColorMatrix>& ug;
+    int              t_dir;
+    int              lengtht;
+    int              lsizet;
+    multi1d<int>     t_coord;     /*!< time coordinate of each site on this node */
+  };
+
+
+  //! Static (temporal) Wilson line from a point
+  /*!
+   * \ingroup glue
+   *
+   * The heavy quark propagator of HeavyQuarkProp at the spatial site of
+   * src, built by cumulative product of the temporal links along the
+   * time column instead of full lattice shifts:
+   * Q[t] = 0 for t < t_src, 1 at t_src and adj(U(t_src)...U(t-1)) after.
+   *
+   * \param Q        static line for each time slice ( Write )
+   * \param u        gauge field ( Read )
+   * \param src      source coordinates, time in Nd-1 ( Read )
+   * \param length   number of time slices ( Read )
+   */
+  void staticLine(multi1d<ColorMatrix>& Q,
+		  const multi1d<LatticeColorMatrix>& u,
+		  const multi1d<int>& src, int length);
+
+}  // end namespace Chroma
+
+#endif
@@ -29,7 +29,7 @@
  */
 
 #include "meas/glue/wilson_flow_w.h"
-#include "meas/glue/mesfield.h"
+#include "meas/glue/gauge_observables.h"
 #include "util/gauge/stout_utils.h"
 #include "util/gauge/expmat.h"
 #include "util/gauge/taproj.h"
@@ -50,47 +50,12 @@ namespace Chroma
 			    int t_dir)
   {
 
-    multi1d<LatticeColorMatrix> field_st(10) ;
-    LatticeColorMatrix tmp ; 
+    // Clover energy density split into space-space and space-time planes
+    GaugeObservables_t obs;
+    gaugeObservables(u, obs, false, true, t_dir);
 
-    mesField( field_st,u); 
-
-    int offset = 0;
-
-    gtime  = 0.0 ;
-    gspace = 0.0 ;
-
-    Double tr ; 
-
-    //  for(int mu=0; mu < Nd-1; ++mu)
-
-    for(int mu=0; mu < Nd; ++mu)
-    {
-      for(int nu=mu+1; nu < Nd; ++nu)
-      {
-	//	  tr = real(sum(trace(field_st[offset]))) ;
-	//	  tr = imag(sum(trace(field_st[offset]))) ;
-	tmp = field_st[offset] * field_st[offset] ;
-	tr = real(sum(trace(tmp))) ; 
-
-	// Real tt = 2.0 * tr ; 
-	//	  std::cout << "DEBUG " << mu << " " << nu  << " " << tt << std::endl ;
-
-	if (nu==t_dir)
-	{
-	  gtime += 2.0*(tr);
-	}
-	else
-	{
-	  gspace += 2.0*(tr);
-	}
-
-	++offset  ; 
-      }
-    }
-
-    gspace /= -2.0*Layout::vol() ;
-    gtime /= -2.0*Layout::vol() ;
+    gspace = obs.energy_s;
+    gtime  = obs.energy_t;
 
   }
 
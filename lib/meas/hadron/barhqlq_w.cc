@@ -5,6 +5,7 @@
 
 #include "meas/hadron/barhqlq_w.h"
 #include "meas/hadron/barspinmat_w.h"
+#include "meas/hadron/baryon_contract_engine_w.h"
 
 namespace Chroma 
 {
@@ -352,245 +353,39 @@ namespace Chroma
       return;
 
     // Setup the return stuff
-    const int num_baryons = 17;
+    const int num_baryons = BaryonContractEngine::num_barhqlq;
     int num_mom = phases.numMom();
     barprop.resize(num_baryons,num_mom,length);
 
 
-    // T_mixed = (1 + \Sigma_3)*(1 + gamma_4) / 2 
-    //         = (1 + Gamma(8) - i G(3) - i G(11)) / 2
-    SpinMatrix T_mixed = BaryonSpinMats::Tmixed();
+    // All baryons are contracted in a single sweep over the lattice, with the
+    // diquarks of each C gamma shared between the channels that use them.
+    // Baryon n is
+    //   0,3,6    Sigma^+_k       T_mixed, C gamma_5 {1, gamma_4, NR}
+    //   1,4,7    Lambda_k        T_mixed, C gamma_5 {1, gamma_4, NR}
+    //   2,5,8    Sigma^{*+}_k    T_mixed, C {gamma_-, gamma_4 gamma_-, gamma_- NR}
+    //                            (the last with the old szin factor of 4)
+    //   9,10,11  Sigma^+_{4,5,6} T_unpol, C gamma_5 {1, gamma_4, NR}
+    //   12,14    Lambda_{4,5}    naive Lambda, T_unpol, C gamma_5
+    //   13       Xi_1            T_unpol, C gamma_5
+    //   15       Xi_2            T_mixed, C gamma_5
+    //   16       Proton_negpar_3 T_mixed_negpar, C gamma_5 NR negpar
+    multi1d<LatticeComplex> b_prop;
+    BaryonContractEngine::barhqlqChannels(b_prop, quark_propagator_1, quark_propagator_2);
+
+    // Project all baryons onto zero and if desired non-zero momentum
+    // with a single global reduction
+    multi3d<DComplex> hsum;
+    hsum = phases.sft(b_prop);
 
-    // T_unpol = (1/2)(1 + gamma_4)
-    SpinMatrix T_unpol = BaryonSpinMats::Tunpol();
-
-    // C gamma_5 = Gamma(5)
-    SpinMatrix Cg5 = BaryonSpinMats::Cg5();
-
-    // C gamma_5 gamma_4 = - Gamma(13)
-    SpinMatrix Cg5g4 = BaryonSpinMats::Cg5g4();
-
-    // C g_5 NR = (1/2)*C gamma_5 * ( 1 + g_4 )
-    SpinMatrix Cg5NR = BaryonSpinMats::Cg5NR();
-
-    LatticeComplex b_prop;
-
-    // Loop over baryons
     for(int baryons = 0; baryons < num_baryons; ++baryons)
-    {
-      LatticePropagator di_quark;
-
-      switch (baryons)
-      {
-      case 0:
-	// Sigma^+_1 (or proton); use also for Lambda_1!
-	// |S_1, s_z=1/2> = (s C gamma_5 u) "u_up"
-	// C gamma_5 = Gamma(5)
-	// Polarized:
-	// T_mixed = T = (1 + \Sigma_3)*(1 + gamma_4) / 2 
-	//             = (1 + Gamma(8) - i G(3) - i G(11)) / 2
-	b_prop = Baryon2PtContractions::sigma2pt(quark_propagator_1, quark_propagator_2, 
-						 T_mixed, Cg5);
-	break;
-
-      case 1:
-	// Lambda_1
-	// |L_1, s_z=1/2> = 2*(u C gamma_5 d) "s_up" + (s C gamma_5 d) "u_up"
-	//                  + (u C gamma_5 s) "d_up" , see comments at top   
-	// C gamma_5 = Gamma(5)
-	// Polarized:
-	// T_mixed = T = (1 + \Sigma_3)*(1 + gamma_4) / 2 
-	//             = (1 + Gamma(8) - i G(3) - i G(11)) / 2
-	b_prop = Baryon2PtContractions::lambda2pt(quark_propagator_1, quark_propagator_2, 
-						  T_mixed, Cg5);
-	break;
-
-      case 2:
-	// Sigma^{*+}_1
-	// |S*_1, s_z=3/2> = 2*(s C gamma_- u) "u_up" + (u C gamma_- u) "s_up"
-	// Polarized:
-	// T_mixed = T = (1 + \Sigma_3)*(1 + gamma_4) / 2 
-	//             = (1 + Gamma(8) - i G(3) - i G(11)) / 2
-	b_prop = Baryon2PtContractions::sigmast2pt(quark_propagator_1, quark_propagator_2, 
-						   T_mixed, BaryonSpinMats::Cgm());
-	break;
-
-      case 3:
-	// Sigma^+_2; use also for Lambda_2!
-	// |S_2, s_z=1/2> = (s C gamma_4 gamma_5 u) "u_up"
-	// C gamma_5 gamma_4 = - Gamma(13)
-	// Polarized:
-	// T_mixed = T = (1 + \Sigma_3)*(1 + gamma_4) / 2 
-	//             = (1 + Gamma(8) - i G(3) - i G(11)) / 2
-	b_prop = Baryon2PtContractions::sigma2pt(quark_propagator_1, quark_propagator_2, 
-						 T_mixed, Cg5g4);
-	break;
-
-      case 4:
-	// Lambda_2
-	// |L_2, s_z=1/2> = 2*(u C gamma_4 gamma_5 d) "s_up"
-	//                  + (s C gamma_4 gamma_5 d) "u_up"
-	//                  + (u C gamma_4 gamma_5 s) "d_up"
-	// Polarized:
-	// T_mixed = T = (1 + \Sigma_3)*(1 + gamma_4) / 2 
-	//             = (1 + Gamma(8) - i G(3) - i G(11)) / 2
-	b_prop = Baryon2PtContractions::lambda2pt(quark_propagator_1, quark_propagator_2, 
-						  T_mixed, Cg5g4);
-	break;
-
-      case 5:
-	// Sigma^{*+}_2
-	// |S*_2, s_z=3/2> = 2*(s C gamma_4 gamma_- u) "u_up" + (u C gamma_4 gamma_- u) "s_up"
-	// Polarized:
-	// T_mixed = T = (1 + \Sigma_3)*(1 + gamma_4) / 2 
-	//             = (1 + Gamma(8) - i G(3) - i G(11)) / 2
-	b_prop = Baryon2PtContractions::sigmast2pt(quark_propagator_1, quark_propagator_2, 
-						   T_mixed, BaryonSpinMats::Cg4m());
-	break;
-
-      case 6:
-	// Sigma^+_3; use also for Lambda_3!
-	// |S_3, s_z=1/2> = (s C (1/2)(1 + gamma_4) gamma_5 u) "u_up"
-	// C gamma_5 gamma_4 = - Gamma(13)
-	// Polarized:
-	// T_mixed = T = (1 + \Sigma_3)*(1 + gamma_4) / 2 
-	//             = (1 + Gamma(8) - i G(3) - i G(11)) / 2
-	b_prop = Baryon2PtContractions::sigma2pt(quark_propagator_1, quark_propagator_2, 
-						 T_mixed, Cg5NR);
-	break;
-
-      case 7:
-	// Lambda_3
-	// |L_3, s_z=1/2> = 2*(u C (1/2)(1 + gamma_4) gamma_5 d) "s_up"
-	//                  + (s C (1/2)(1 + gamma_4) gamma_5 d) "u_up"
-	//                  + (u C (1/2)(1 + gamma_4) gamma_5 s) "d_up"
-	// Polarized:
-	// T_mixed = T = (1 + \Sigma_3)*(1 + gamma_4) / 2 
-	//             = (1 + Gamma(8) - i G(3) - i G(11)) / 2
-	b_prop = Baryon2PtContractions::lambda2pt(quark_propagator_1, quark_propagator_2, 
-						  T_mixed, Cg5NR);
-	break;
-
-      case 8:
-	// Sigma^{*+}_3
-	// |S*_3, s_z=3/2> = 2*(s C (1/2)(1+gamma_4) gamma_- u) "u_up" 
-	//                   + (u C (1/2)(1+gamma_4) gamma_- u) "s_up"
-	// Polarized:
-	// T_mixed = T = (1 + \Sigma_3)*(1 + gamma_4) / 2 
-	//             = (1 + Gamma(8) - i G(3) - i G(11)) / 2
-	// Arrgh, goofy CgmNR normalization again from szin code. 
-	b_prop = Baryon2PtContractions::sigmast2pt(quark_propagator_1, quark_propagator_2, 
-						   T_mixed, BaryonSpinMats::CgmNR());
-
-	// Agghh, we have a goofy factor of 4 normalization factor here. The
-	// ancient szin way didn't care about norms, so it happily made it
-	// 4 times too big. There is a missing 0.5 in the NR normalization
-	// in the old szin code.
-	// So, we compensate to keep the same normalization
-	b_prop *= 4.0;
-	break;
-
-
-      case 9:
-	// Sigma^+_4 -- but unpolarised
-	// |S_4, s_z=1/2> = (s C gamma_5 u) "u_up", see comments at top
-	// C gamma_5 = Gamma(5)
-	// Unpolarized:
-	// T_unpol = T = (1/2)(1 + gamma_4)
-	b_prop = Baryon2PtContractions::sigma2pt(quark_propagator_1, quark_propagator_2, 
-						 T_unpol, Cg5);
-	break;
-
-      case 10:
-	// Sigma^+_5
-	// |S_5, s_z=1/2> = (s C gamma_4 gamma_5 u) "u_up", see comments at top
-	// C gamma_5 gamma_4 = - Gamma(13)
-	// Unpolarized:
-	// T_unpol = T = (1/2)(1 + gamma_4)
-	b_prop = Baryon2PtContractions::sigma2pt(quark_propagator_1, quark_propagator_2, 
-						 T_unpol, Cg5g4);
-	break;
-    
-      case 11:
-	// Sigma^+_6
-	// |S_6, s_z=1/2> = (s C (1/2)(1 + gamma_4) gamma_5 u) "u_up", see comments at top
-	// C gamma_5 = Gamma(5)
-	// Unpolarized:
-	// T_unpol = T = (1/2)(1 + gamma_4)
-	b_prop = Baryon2PtContractions::sigma2pt(quark_propagator_1, quark_propagator_2, 
-						 T_unpol, Cg5NR);
-	break;
-
-      case 12:
-	// Lambda_4 : naive Lambda interpolating field
-	// |L_4 > = (d C gamma_5 u) s
-	// C gamma_5 = Gamma(5)
-	// UnPolarized:
-	// T_unpol = T = (1/2)(1 + gamma_4)
-	b_prop = Baryon2PtContractions::lambdaNaive2pt(quark_propagator_1, quark_propagator_2, 
-						       T_unpol, Cg5);
-	break;
-      
-      case 13:
-	// Xi_1
-	// |X_1 > = (s C gamma_5 u) s
-	// C gamma_5 = Gamma(5)
-	// UnPolarized:
-	// T_unpol = T = (1/2)(1 + gamma_4)
-	b_prop = Baryon2PtContractions::xi2pt(quark_propagator_1, quark_propagator_2, 
-					      T_unpol, Cg5);
-	break;
-
-      case 14:
-	// Lambda_5 : naive Lambda interpolating field
-	// |L_5 > = (d C gamma_5 u) "s_up"
-	// C gamma_5 = Gamma(5)
-	// UnPolarized: 
-	// T_mixed = T = (1 + \Sigma_3)*(1 + gamma_4) / 2 
-	//             = (1 + Gamma(8) - i G(3) - i G(11)) / 2
-	b_prop = Baryon2PtContractions::lambdaNaive2pt(quark_propagator_1, quark_propagator_2, 
-						       T_unpol, Cg5);
-	break;
-      
-      case 15:
-	// Xi_2
-	// |X_2 > = (s C gamma_5 u) "s_up"
-	// C gamma_5 = Gamma(5)
-	// UnPolarized:
-	// T_mixed = T = (1 + \Sigma_3)*(1 + gamma_4) / 2 
-	//             = (1 + Gamma(8) - i G(3) - i G(11)) / 2
-	b_prop = Baryon2PtContractions::xi2pt(quark_propagator_1, quark_propagator_2, 
-					      T_mixed, Cg5);
-	break;
-
-      case 16:
-	// Proton_negpar_3; use also for Lambda_negpar_3!
-	// |P_7, s_z=1/2> = (d C gamma_5 (1/2)(1 - g_4) u) "u_up", see comments at top
-	// C g_5 NR negpar = (1/2)*C gamma_5 * ( 1 - g_4 )
-	// T = (1 + \Sigma_3)*(1 - gamma_4) / 2 
-	//   = (1 - Gamma(8) + i G(3) - i G(11)) / 2
-	b_prop = Baryon2PtContractions::sigma2pt(quark_propagator_1, quark_propagator_2, 
-						 BaryonSpinMats::TmixedNegPar(), 
-						 BaryonSpinMats::Cg5NRnegPar());
-	break;
-		  
-      default:
-	QDP_error_exit("Unknown baryon", baryons);
-      }
-                        
-      // Project onto zero and if desired non-zero momentum
-      multi2d<DComplex> hsum;
-      hsum = phases.sft(b_prop);
-
       for(int sink_mom_num=0; sink_mom_num < num_mom; ++sink_mom_num) 
 	for(int t = 0; t < length; ++t)
 	{
 	  // NOTE: there is NO  1/2  multiplying hsum
-	  barprop[baryons][sink_mom_num][t] = hsum[sink_mom_num][t];
+	  barprop[baryons][sink_mom_num][t] = hsum[baryons][sink_mom_num][t];
 	}
 
-    } // end loop over baryons
-
     END_CODE();
   }
 
@@ -0,0 +1,468 @@
+/*! \file
+ *  \brief Site-local baryon 2-pt contraction engine
+ */
+
+#include "meas/hadron/baryon_contract_engine_w.h"
+#include "meas/hadron/barspinmat_w.h"
+#include "meas/hadron/barhqlq_w.h"
+
+#include <map>
+
+namespace Chroma
+{
+
+  namespace BaryonContractEngine
+  {
+
+    // Anonymous namespace
+    namespace
+    {
+      //! A spin component term is keyed by its six spin indices
+      inline
+      int termKey(const SpinTerm_t& t)
+      {
+	int k = 0;
+	for(int i=0; i < 3; ++i)
+	  k = (k*Ns + t.snk[i])*Ns + t.src[i];
+	return k;
+      }
+
+      //! Even and odd permutations of (0,1,2) for the color epsilons
+      const int eps_perm[6][3] = {{0,1,2},{1,2,0},{2,0,1},{0,2,1},{2,1,0},{1,0,2}};
+      const int eps_sgn[6] = {1,1,1,-1,-1,-1};
+
+#ifndef QDP_IS_QDPJIT
+      typedef PSpinMatrix< PColorMatrix< RComplex<REAL>, Nc>, Ns>  SiteProp_t;
+      typedef PSpinMatrix< PScalar< RComplex<REAL> >, Ns>           SiteSpin_t;
+
+      //! The diquark spin matrices used by barhqlq
+      enum {SP_CG5=0, SP_CG5G4, SP_CG5NR, SP_CGM, SP_CG4M, SP_CGMNR, SP_CG5NR_NEGPAR, NUM_SP};
+
+      //! The parity/polarisation projectors used by barhqlq
+      enum {T_MIXED=0, T_UNPOL, T_MIXED_NEGPAR, NUM_T};
+
+      //! Arguments for the barhqlq site loop
+      struct BarhqlqArgs
+      {
+	const LatticePropagator&  q1;
+	const LatticePropagator&  q2;
+	multi1d<LatticeComplex>&  b_prop;
+	SiteSpin_t                sp[NUM_SP];
+	SiteSpin_t                T[NUM_T];
+      };
+
+
+      //! traceColor(q * traceSpin(di))
+      inline
+      SiteSpin_t blockTr(const SiteProp_t& q, const SiteProp_t& di)
+      {
+	return traceColor(q * traceSpin(di));
+      }
+
+      //! traceColor(q * di)
+      inline
+      SiteSpin_t blockNoTr(const SiteProp_t& q, const SiteProp_t& di)
+      {
+	return traceColor(q * di);
+      }
+
+      //! trace(T * S)
+      inline
+      RComplex<REAL> traceProd(const SiteSpin_t& T, const SiteSpin_t& S)
+      {
+	RComplex<REAL> r;
+	zero_rep(r);
+
+	for(int i=0; i < Ns; ++i)
+	  for(int j=0; j < Ns; ++j)
+	    r += T.elem(i,j).elem() * S.elem(j,i).elem();
+
+	return r;
+      }
+
+      //! The three diquarks needed for one diquark spin matrix
+      /*!
+       * d12 = quarkContract13(q1 sp, sp q2)
+       * d21 = quarkContract13(q2 sp, sp q1)
+       * d22 = quarkContract13(q2 sp, sp q2)
+       */
+      inline
+      void diquarks(const SiteProp_t& q1, const SiteProp_t& q2, const SiteSpin_t& sp,
+		    SiteProp_t& d12, SiteProp_t& d21, SiteProp_t& d22)
+      {
+	SiteProp_t q2sp = q2 * sp;
+	SiteProp_t spq1 = sp * q1;
+	SiteProp_t spq2 = sp * q2;
+
+	d12 = quarkContract13(q1 * sp, spq2);
+	d21 = quarkContract13(q2sp, spq1);
+	d22 = quarkContract13(q2sp, spq2);
+      }
+
+
+      //! Sigma block, see Baryon2PtContractions::sigma2pt
+      inline
+      SiteSpin_t sigmaBlock(const SiteProp_t& q2, const SiteProp_t& d12)
+      {
+	SiteSpin_t b = blockTr(q2, d12);
+	b += blockNoTr(q2, d12);
+	return b;
+      }
+
+      //! Lambda block, see Baryon2PtContractions::lambda2pt
+      inline
+      SiteSpin_t lambdaBlock(const SiteProp_t& q1, const SiteProp_t& q2,
+			     const SiteSpin_t& tr_q1_d22,
+			     const SiteProp_t& d21, const SiteProp_t& d22)
+      {
+	SiteSpin_t b = tr_q1_d22;
+	b += blockNoTr(q1, d22);
+	b += blockNoTr(q2, d21);
+	return b;
+      }
+
+      //! Sigma^* block, see Baryon2PtContractions::sigmast2pt
+      inline
+      SiteSpin_t sigmastBlock(const SiteProp_t& q1, const SiteProp_t& q2,
+			      const SiteProp_t& d12, const SiteProp_t& d21, const SiteProp_t& d22)
+      {
+	SiteSpin_t b = sigmaBlock(q2, d12);
+	b += blockNoTr(q2, d21);
+	b += blockNoTr(q1, d22);
+	b += b;
+	b += blockTr(q1, d22);
+	return b;
+      }
+
+
+      //! Site loop for all barhqlq channels
+      inline
+      void barhqlqSiteLoop(int lo, int hi, int myId, BarhqlqArgs* a)
+      {
+	const SiteSpin_t& T_mixed = a->T[T_MIXED];
+	const SiteSpin_t& T_unpol = a->T[T_UNPOL];
+
+	SiteProp_t d12, d21, d22;
+
+	for(int site=lo; site < hi; ++site)
+	{
+	  const SiteProp_t& q1 = a->q1.elem(site);
+	  const SiteProp_t& q2 = a->q2.elem(site);
+
+	  multi1d<LatticeComplex>& b = a->b_prop;
+
+	  // C gamma_5: Sigma_1, Lambda_1, Sigma_4, Lambda_4, Xi_1, Lambda_5, Xi_2
+	  {
+	    diquarks(q1, q2, a->sp[SP_CG5], d12, d21, d22);
+
+	    SiteSpin_t tr_q1_d22 = blockTr(q1, d22);
+	    SiteSpin_t sigma     = sigmaBlock(q2, d12);
+	    SiteSpin_t lambda    = lambdaBlock(q1, q2, tr_q1_d22, d21, d22);
+	    SiteSpin_t xi        = sigmaBlock(q1, d12);
+
+	    b[0].elem(site).elem().elem()  = traceProd(T_mixed, sigma);
+	    b[1].elem(site).elem().elem()  = traceProd(T_mixed, lambda);
+	    b[9].elem(site).elem().elem()  = traceProd(T_unpol, sigma);
+	    b[12].elem(site).elem().elem() = traceProd(T_unpol, tr_q1_d22);
+	    b[13].elem(site).elem().elem() = traceProd(T_unpol, xi);
+	    b[14].elem(site).elem().elem() = b[12].elem(site).elem().elem();
+	    b[15].elem(site).elem().elem() = traceProd(T_mixed, xi);
+	  }
+
+	  // C gamma_5 gamma_4: Sigma_2, Lambda_2, Sigma_5
+	  {
+	    diquarks(q1, q2, a->sp[SP_CG5G4], d12, d21, d22);
+
+	    SiteSpin_t sigma  = sigmaBlock(q2, d12);
+	    SiteSpin_t lambda = lambdaBlock(q1, q2, blockTr(q1, d22), d21, d22);
+
+	    b[3].elem(site).elem().elem()  = traceProd(T_mixed, sigma);
+	    b[4].elem(site).elem().elem()  = traceProd(T_mixed, lambda);
+	    b[10].elem(site).elem().elem() = traceProd(T_unpol, sigma);
+	  }
+
+	  // C gamma_5 NR: Sigma_3, Lambda_3, Sigma_6
+	  {
+	    diquarks(q1, q2, a->sp[SP_CG5NR], d12, d21, d22);
+
+	    SiteSpin_t sigma  = sigmaBlock(q2, d12);
+	    SiteSpin_t lambda = lambdaBlock(q1, q2, blockTr(q1, d22), d21, d22);
+
+	    b[6].elem(site).elem().elem()  = traceProd(T_mixed, sigma);
+	    b[7].elem(site).elem().elem()  = traceProd(T_mixed, lambda);
+	    b[11].elem(site).elem().elem() = traceProd(T_unpol, sigma);
+	  }
+
+	  // C gamma_-, C gamma_4 gamma_-, C gamma_- NR: Sigma^*_1, Sigma^*_2, Sigma^*_3
+	  {
+	    diquarks(q1, q2, a->sp[SP_CGM], d12, d21, d22);
+	    b[2].elem(site).elem().elem() = traceProd(T_mixed, sigmastBlock(q1, q2, d12, d21, d22));
+
+	    diquarks(q1, q2, a->sp[SP_CG4M], d12, d21, d22);
+	    b[5].elem(site).elem().elem() = traceProd(T_mixed, sigmastBlock(q1, q2, d12, d21, d22));
+
+	    // Same goofy factor of 4 as in barhqlq
+	    diquarks(q1, q2, a->sp[SP_CGMNR], d12, d21, d22);
+	    RComplex<REAL> c = traceProd(T_mixed, sigmastBlock(q1, q2, d12, d21, d22));
+	    c.real() *= 4;
+	    c.imag() *= 4;
+	    b[8].elem(site).elem().elem() = c;
+	  }
+
+	  // Negative parity proton, only needs the first diquark
+	  {
+	    const SiteSpin_t& sp = a->sp[SP_CG5NR_NEGPAR];
+	    SiteProp_t spq2 = sp * q2;
+	    d12 = quarkContract13(q1 * sp, spq2);
+
+	    b[16].elem(site).elem().elem() = traceProd(a->T[T_MIXED_NEGPAR], sigmaBlock(q2, d12));
+	  }
+	}
+      }
+
+
+      //! Arguments for the epsilon channel site loop
+      struct EpsArgs
+      {
+	const LatticePropagator&  q1;
+	const LatticePropagator&  q2;
+	const LatticePropagator&  q3;
+	multi1d<LatticeComplex>&  b_prop;
+	const std::vector<SpinTerm_t>&  terms;        /*!< unique terms, weights unused */
+	const std::vector< std::vector< std::pair<int,double> > >&  chan_terms;   /*!< (term, weight) per channel */
+      };
+
+      //! Site loop for arbitrary three-quark channels
+      inline
+      void epsSiteLoop(int lo, int hi, int myId, EpsArgs* a)
+      {
+#if QDP_NC == 3
+	const int num_terms = a->terms.size();
+	multi1d< RComplex<REAL64> > val(num_terms);
+
+	for(int site=lo; site < hi; ++site)
+	{
+	  const SiteProp_t& q1 = a->q1.elem(site);
+	  const SiteProp_t& q2 = a->q2.elem(site);
+	  const SiteProp_t& q3 = a->q3.elem(site);
+
+	  for(int n=0; n < num_terms; ++n)
+	  {
+	    const SpinTerm_t& t = a->terms[n];
+	    const PColorMatrix< RComplex<REAL>, Nc>& l = q1.elem(t.snk[0],t.src[0]);
+	    const PColorMatrix< RComplex<REAL>, Nc>& m = q2.elem(t.snk[1],t.src[1]);
+	    const PColorMatrix< RComplex<REAL>, Nc>& r = q3.elem(t.snk[2],t.src[2]);
+
+	    REAL64 re = 0, im = 0;
+	    for(int i=0; i < 6; ++i)
+	    {
+	      for(int j=0; j < 6; ++j)
+	      {
+		const RComplex<REAL>& x = l.elem(eps_perm[i][0],eps_perm[j][0]);
+		const RComplex<REAL>& y = m.elem(eps_perm[i][1],eps_perm[j][1]);
+		const RComplex<REAL>& z = r.elem(eps_perm[i][2],eps_perm[j][2]);
+
+		REAL64 xy_re = x.real()*y.real() - x.imag()*y.imag();
+		REAL64 xy_im = x.real()*y.imag() + x.imag()*y.real();
+		REAL64 s = eps_sgn[i]*eps_sgn[j];
+
+		re += s*(xy_re*z.real() - xy_im*z.imag());
+		im += s*(xy_re*z.imag() + xy_im*z.real());
+	      }
+	    }
+	    val[n].real() = re;
+	    val[n].imag() = im;
+	  }
+
+	  for(int c=0; c < a->chan_terms.size(); ++c)
+	  {
+	    REAL64 re = 0, im = 0;
+	    for(int k=0; k < a->chan_terms[c].size(); ++k)
+	    {
+	      const RComplex<REAL64>& v = val[a->chan_terms[c][k].first];
+	      re += a->chan_terms[c][k].second * v.real();
+	      im += a->chan_terms[c][k].second * v.imag();
+	    }
+	    a->b_prop[c].elem(site).elem().elem().real() = re;
+	    a->b_prop[c].elem(site).elem().elem().imag() = im;
+	  }
+	}
+#endif
+      }
+
+#else
+      //! Color components of one spin component of a propagator
+      void colorComponents(multi2d<LatticeComplex>& c, const LatticePropagator& q, int snk, int src)
+      {
+	LatticeColorMatrix qs = peekSpin(q, snk, src);
+
+	c.resize(Nc,Nc);
+	for(int i=0; i < Nc; ++i)
+	  for(int j=0; j < Nc; ++j)
+	    c(i,j) = peekColor(qs, i, j);
+      }
+
+      //! eps_{abc} eps_{a'b'c'} l(a,a') m(b,b') r(c,c') as a whole lattice expression
+      void epsilonContract(LatticeComplex& res,
+			   const multi2d<LatticeComplex>& l,
+			   const multi2d<LatticeComplex>& m,
+			   const multi2d<LatticeComplex>& r)
+      {
+	res = zero;
+	for(int i=0; i < 6; ++i)
+	{
+	  for(int j=0; j < 6; ++j)
+	  {
+	    const int* p = eps_perm[i];
+	    const int* q = eps_perm[j];
+
+	    if (eps_sgn[i]*eps_sgn[j] > 0)
+	      res += l(p[0],q[0]) * m(p[1],q[1]) * r(p[2],q[2]);
+	    else
+	      res -= l(p[0],q[0]) * m(p[1],q[1]) * r(p[2],q[2]);
+	  }
+	}
+      }
+#endif
+
+    } // end anonymous namespace
+
+
+    // All heavy-light baryon channels of barhqlq in one pass
+    void barhqlqChannels(multi1d<LatticeComplex>& b_prop,
+			 const LatticePropagator& quark_propagator_1,
+			 const LatticePropagator& quark_propagator_2)
+    {
+      START_CODE();
+
+      b_prop.resize(num_barhqlq);
+
+      if ( Ns != 4 || Nc != 3 )		/* Code is specific to Ns=4 and Nc=3. */
+	return;
+
+#ifndef QDP_IS_QDPJIT
+      BarhqlqArgs args = {quark_propagator_1, quark_propagator_2, b_prop};
+
+      args.sp[SP_CG5]         = BaryonSpinMats::Cg5().elem();
+      args.sp[SP_CG5G4]       = BaryonSpinMats::Cg5g4().elem();
+      args.sp[SP_CG5NR]       = BaryonSpinMats::Cg5NR().elem();
+      args.sp[SP_CGM]         = BaryonSpinMats::Cgm().elem();
+      args.sp[SP_CG4M]        = BaryonSpinMats::Cg4m().elem();
+      args.sp[SP_CGMNR]       = BaryonSpinMats::CgmNR().elem();
+      args.sp[SP_CG5NR_NEGPAR] = BaryonSpinMats::Cg5NRnegPar().elem();
+
+      args.T[T_MIXED]        = BaryonSpinMats::Tmixed().elem();
+      args.T[T_UNPOL]        = BaryonSpinMats::Tunpol().elem();
+      args.T[T_MIXED_NEGPAR] = BaryonSpinMats::TmixedNegPar().elem();
+
+      dispatch_to_threads(Layout::sitesOnNode(), args, barhqlqSiteLoop);
+#else
+      // No site access under the JIT, so build the channels as whole lattice expressions
+      const LatticePropagator& q1 = quark_propagator_1;
+      const LatticePropagator& q2 = quark_propagator_2;
+
+      SpinMatrix T_mixed = BaryonSpinMats::Tmixed();
+      SpinMatrix T_unpol = BaryonSpinMats::Tunpol();
+
+      using namespace Baryon2PtContractions;
+
+      b_prop[0]  = sigma2pt(q1, q2, T_mixed, BaryonSpinMats::Cg5());
+      b_prop[1]  = lambda2pt(q1, q2, T_mixed, BaryonSpinMats::Cg5());
+      b_prop[2]  = sigmast2pt(q1, q2, T_mixed, BaryonSpinMats::Cgm());
+      b_prop[3]  = sigma2pt(q1, q2, T_mixed, BaryonSpinMats::Cg5g4());
+      b_prop[4]  = lambda2pt(q1, q2, T_mixed, BaryonSpinMats::Cg5g4());
+      b_prop[5]  = sigmast2pt(q1, q2, T_mixed, BaryonSpinMats::Cg4m());
+      b_prop[6]  = sigma2pt(q1, q2, T_mixed, BaryonSpinMats::Cg5NR());
+      b_prop[7]  = lambda2pt(q1, q2, T_mixed, BaryonSpinMats::Cg5NR());
+      b_prop[8]  = 4.0 * sigmast2pt(q1, q2, T_mixed, BaryonSpinMats::CgmNR());
+      b_prop[9]  = sigma2pt(q1, q2, T_unpol, BaryonSpinMats::Cg5());
+      b_prop[10] = sigma2pt(q1, q2, T_unpol, BaryonSpinMats::Cg5g4());
+      b_prop[11] = sigma2pt(q1, q2, T_unpol, BaryonSpinMats::Cg5NR());
+      b_prop[12] = lambdaNaive2pt(q1, q2, T_unpol, BaryonSpinMats::Cg5());
+      b_prop[13] = xi2pt(q1, q2, T_unpol, BaryonSpinMats::Cg5());
+      b_prop[14] = b_prop[12];
+      b_prop[15] = xi2pt(q1, q2, T_mixed, BaryonSpinMats::Cg5());
+      b_prop[16] = sigma2pt(q1, q2, BaryonSpinMats::TmixedNegPar(), BaryonSpinMats::Cg5NRnegPar());
+#endif
+
+      END_CODE();
+    }
+
+
+    // Arbitrary three-quark channels in one pass
+    void epsilonChannels(multi1d<LatticeComplex>& b_prop,
+			 const LatticePropagator& q1,
+			 const LatticePropagator& q2,
+			 const LatticePropagator& q3,
+			 const std::vector<SpinChannel_t>& channels)
+    {
+      START_CODE();
+
+      b_prop.resize(channels.size());
+
+      // Find the distinct spin component terms over all channels
+      std::vector<SpinTerm_t> terms;
+      std::vector< std::vector< std::pair<int,double> > > chan_terms(channels.size());
+      std::map<int,int> term_index;
+
+      for(int c=0; c < channels.size(); ++c)
+      {
+	for(int k=0; k < channels[c].size(); ++k)
+	{
+	  const SpinTerm_t& t = channels[c][k];
+	  int key = termKey(t);
+
+	  std::map<int,int>::const_iterator it = term_index.find(key);
+	  int n;
+	  if (it == term_index.end())
+	  {
+	    n = terms.size();
+	    term_index[key] = n;
+	    terms.push_back(t);
+	  }
+	  else
+	  {
+	    n = it->second;
+	  }
+
+	  chan_terms[c].push_back(std::make_pair(n, t.weight));
+	}
+      }
+
+      QDPIO::cout << __func__ << ": " << channels.size() << " channels from "
+		  << terms.size() << " distinct spin terms" << std::endl;
+
+#ifndef QDP_IS_QDPJIT
+      EpsArgs args = {q1, q2, q3, b_prop, terms, chan_terms};
+      dispatch_to_threads(Layout::sitesOnNode(), args, epsSiteLoop);
+#else
+      // No site access under the JIT, so contract the terms as whole lattice expressions
+#if QDP_NC == 3
+      multi1d<LatticeComplex> val(terms.size());
+      multi2d<LatticeComplex> l, m, r;
+
+      for(int n=0; n < terms.size(); ++n)
+      {
+	const SpinTerm_t& t = terms[n];
+	colorComponents(l, q1, t.snk[0], t.src[0]);
+	colorComponents(m, q2, t.snk[1], t.src[1]);
+	colorComponents(r, q3, t.snk[2], t.src[2]);
+
+	epsilonContract(val[n], l, m, r);
+      }
+
+      for(int c=0; c < chan_terms.size(); ++c)
+      {
+	b_prop[c] = zero;
+	for(int k=0; k < chan_terms[c].size(); ++k)
+	  b_prop[c] += Real(chan_terms[c][k].second) * val[chan_terms[c][k].first];
+      }
+#endif
+#endif
+
+      END_CODE();
+    }
+
+  }  // namespace BaryonContractEngine
+
+}  // end namespace Chroma
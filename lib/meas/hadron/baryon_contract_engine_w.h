@@ -0,0 +1,84 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Site-local baryon 2-pt contraction engine
+ *
+ *  All baryon channels of a set of propagators are contracted in a single
+ *  sweep over the lattice. Diquarks are built once per site and reused by
+ *  every channel and parity projection that needs them, so no whole-lattice
+ *  diquark temporaries are formed. The outputs are meant to be fed to the
+ *  batched SftMom::sft().
+ */
+
+#ifndef __baryon_contract_engine_w_h__
+#define __baryon_contract_engine_w_h__
+
+#include "chromabase.h"
+#include <vector>
+
+namespace Chroma
+{
+
+  //! Site-local baryon contraction engine
+  /*! \ingroup hadron */
+  namespace BaryonContractEngine
+  {
+    //! Number of channels produced by barhqlqChannels
+    const int num_barhqlq = 17;
+
+    //! All heavy-light baryon channels of barhqlq in one pass
+    /*!
+     * \ingroup hadron
+     *
+     * Channel n is exactly the LatticeComplex that barhqlq() projects for
+     * baryon n, i.e. Sigma, Lambda and Sigma^* for the relativistic,
+     * gamma_4 and non-relativistic diquarks, the unpolarised variants,
+     * the naive Lambda, the Xi and the negative parity proton.
+     *
+     * \param b_prop               the 17 channels ( Write )
+     * \param quark_propagator_1   "s" quark propagator ( Read )
+     * \param quark_propagator_2   "u" quark propagator ( Read )
+     */
+    void barhqlqChannels(multi1d<LatticeComplex>& b_prop,
+			 const LatticePropagator& quark_propagator_1,
+			 const LatticePropagator& quark_propagator_2);
+
+
+    //! One spin component term of a baryon channel
+    /*!
+     * weight * eps_{abc} eps_{a'b'c'} q1(snk[0],src[0])_{aa'} q2(snk[1],src[1])_{bb'} q3(snk[2],src[2])_{cc'}
+     */
+    struct SpinTerm_t
+    {
+      int     snk[3];
+      int     src[3];
+      double  weight;
+    };
+
+    //! A baryon channel is a weighted sum of spin component terms
+    typedef std::vector<SpinTerm_t> SpinChannel_t;
+
+    //! Arbitrary three-quark channels in one pass
+    /*!
+     * \ingroup hadron
+     *
+     * Identical spin component terms appearing in several channels are
+     * contracted only once per site.
+     *
+     * \param b_prop     one LatticeComplex per channel ( Write )
+     * \param q1         first quark propagator ( Read )
+     * \param q2         second quark propagator ( Read )
+     * \param q3         third quark propagator ( Read )
+     * \param channels   the spin wavefunction of each channel ( Read )
+     */
+    void epsilonChannels(multi1d<LatticeComplex>& b_prop,
+			 const LatticePropagator& q1,
+			 const LatticePropagator& q2,
+			 const LatticePropagator& q3,
+			 const std::vector<SpinChannel_t>& channels);
+
+  }  // namespace BaryonContractEngine
+
+}  // end namespace Chroma
+
+
+#endif
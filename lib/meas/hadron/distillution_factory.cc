@@ -5,6 +5,7 @@
  */
 
 #include "meas/hadron/distillution_factory.h"
+#include "io/storage_codec.h"
 
 namespace Chroma 
 { 
@@ -212,6 +213,9 @@ namespace Chroma
 	  dist_noise_obj(dist_noise_obj_), source_obj(source_obj_), time_slice_set(time_slice_set_),
 	  quark_line(quark_line_), mass(mass_)
       {
+	std::string source_meta_data;
+	source_obj.getUserdata(source_meta_data);
+	StorageCodecEnv::checkNoCodec(source_meta_data, "distillution source");
       }
 
       //----------------------------------------------------------------------------
@@ -541,6 +545,10 @@ namespace Chroma
 	  dist_noise_obj(dist_noise_obj_), source_obj(source_obj_), time_slice_set(time_slice_set_),
 	  quark_line(quark_line_), mass(mass_)
       {
+	std::string source_meta_data;
+	source_obj.getUserdata(source_meta_data);
+	StorageCodecEnv::checkNoCodec(source_meta_data, "distillution source");
+
 	// Reset/barf if bogus
 	params.num_time_dils  = checkTimeDils(params.num_time_dils, Layout::lattSize()[dist_noise_obj.getDecayDir()]);
       }
@@ -13,6 +13,7 @@
 #include "barQll_w.h"
 #include "mesQl_w.h"
 #include "heavy_hadron_potentials_w.h"
+#include "meas/glue/wilslp_engine.h"
 
 namespace Chroma
 {
@@ -81,20 +82,17 @@ namespace Chroma
     SpinMatrix G5PEP = G5 * PosEnergyProj;
 
 
-    // Make heavy quark propagators
-    LatticeColorMatrix Qprop1;
-    LatticeColorMatrix Qprop2;
-    HeavyQuarkProp(Qprop1,u,src1,length);
-    HeavyQuarkProp(Qprop2,u,src2,length);
-
     //peek propagators: reduce lattice problem to two site problem
     multi1d<DPropagator> U1,U2,U3,U4;
     multi1d<DPropagator> D1,D2,D3,D4;
     multi1d<DPropagator> antiU1,antiU2,antiU3,antiU4;
     multi1d<DPropagator> antiD1,antiD2,antiD3,antiD4;
     multi1d<ColorMatrix> Q1, Q2, antiQ1, antiQ2;
-    Q1.resize(length);
-    Q2.resize(length);
+
+    // Make heavy quark propagators: only the time columns through the
+    // sources are needed
+    staticLine(Q1,u,src1,length);  // HQ prop from src1 == "0"
+    staticLine(Q2,u,src2,length);  // HQ prop from src2 == "R"
     antiQ1.resize(length);
     antiQ2.resize(length);
     U1.resize(length); U2.resize(length); U3.resize(length);U4.resize(length);
@@ -108,8 +106,6 @@ namespace Chroma
     {
       currsrc1[Nd-1]=t;
       currsrc2[Nd-1]=t;
-      Q1[t] = peekSite(Qprop1,currsrc1);  // HQ prop from src1 == "0"
-      Q2[t] = peekSite(Qprop2,currsrc2);  // HQ prop from src2 == "R"
       antiQ1[t] = adj(Q1[t]);  // antiHQ prop from src1 == "0"
       antiQ2[t] = adj(Q2[t]);  // antiHQ prop from src2 == "R"
 
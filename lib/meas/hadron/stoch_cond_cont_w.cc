@@ -102,7 +102,6 @@ namespace Chroma
       //! Structure holding solutions
       struct QuarkSolution_t
       {
-	LatticeFermion     source;
 	LatticeFermion     soln;
 	PropSourceConst_t  source_header;
 	ChromaProp_t       prop_header;
@@ -114,6 +113,20 @@ namespace Chroma
     };
 
 
+    //! Make the source of a dilution again instead of keeping it
+    LatticeFermion dilutedSource(const QuarkSourceSolutions_t::QuarkSolution_t& qq,
+				 const multi1d<LatticeColorMatrix>& u)
+    {
+      std::istringstream  xml_s(qq.source_header.source.xml);
+      XMLReader  sourcetop(xml_s);
+
+      DiluteZNQuarkSourceConstEnv::Params  srcParams(sourcetop, qq.source_header.source.path);
+      DiluteZNQuarkSourceConstEnv::SourceConst<LatticeFermion>  srcConst(srcParams);
+
+      return srcConst(u);
+    }
+
+
     //--------------------------------------------------------------
     // Construct some condensates
     std::list< Handle<HadronContractResult_t> >
@@ -186,6 +199,7 @@ namespace Chroma
 	bool first = true;
 	int  N;
 	LatticeFermion quark_noise;      // noisy source on entire lattice
+	DiluteZNQuarkSourceConstEnv::Params  noise_params;
 
 	for(int i=0; i < quark.dilutions.size(); ++i)
 	{
@@ -215,16 +229,15 @@ namespace Chroma
 	    // Grab N
 	    N = srcParams.N;
 
-	    // Set the seed to desired value
 	    quark.seed = srcParams.ran_seed;
-	    QDP::RNG::setrn(quark.seed);
+	    noise_params = srcParams;
 
 	    // Create the noisy quark source on the entire lattice
-	    zN_src(quark_noise, N);
+	    DiluteZNQuarkSourceConstEnv::makeNoise(quark_noise, srcParams);
 	  }
 
 	  // The seeds must always agree - here the seed is the unique id of the source
-	  if ( toBool(srcParams.ran_seed != quark.seed) )
+	  if (! DiluteZNQuarkSourceConstEnv::sameNoise(srcParams, noise_params))
 	  {
 	    QDPIO::cerr << "dilution=" << i << " seed does not match" << std::endl;
 	    QDP_abort(1);
@@ -240,8 +253,9 @@ namespace Chroma
 	  // Use a trick here, create the source and subtract it from the global noisy
 	  // Check at the end that the global noisy is zero everywhere.
 	  // NOTE: the seed will be set every call
-	  quark.dilutions[i].source = srcConst(u);
-	  quark_noise -= quark.dilutions[i].source;
+	  // The sources are not kept, they are made again for the contractions
+	  LatticeFermion source = srcConst(u);
+	  quark_noise -= source;
 
 #if 0
 	  // Diagnostic
@@ -249,7 +263,7 @@ namespace Chroma
 	    // Keep a copy of the phases with NO momenta
 	    SftMom phases_nomom(0, true, quark.dilutions[i].source_header.j_decay);
 
-	    multi1d<Double> source_corr = sumMulti(localNorm2(quark.dilutions[i].source), 
+	    multi1d<Double> source_corr = sumMulti(localNorm2(source), 
 						   phases_nomom.getSet());
 	      
 	    multi1d<Double> soln_corr = sumMulti(localNorm2(quark.dilutions[i].soln), 
@@ -297,6 +311,18 @@ namespace Chroma
 
       std::list< Handle<Hadron2PtContract_t> > hadron;   // holds the contract lattice correlator
 
+      // One dilution at a time, so only one source is alive
+      multi1d<LatticeComplex> corr(Ns*Ns);
+      corr = zero;
+
+      for(int i=0; i < quark.dilutions.size(); ++i)
+      {
+	LatticeFermion source = dilutedSource(quark.dilutions[i], u);
+
+	for(int gamma_value=0; gamma_value < Ns*Ns; ++gamma_value)
+	  corr[gamma_value] += localInnerProduct(source, Gamma(gamma_value) * quark.dilutions[i].soln);
+      } // end for i
+
       for(int gamma_value=0; gamma_value < Ns*Ns; ++gamma_value)
       {
 	Handle<Hadron2PtContract_t> had(new Hadron2PtContract_t);
@@ -309,12 +335,7 @@ namespace Chroma
 	write(had->xml, "decay_dir", sft_params.decay_dir);
 	pop(had->xml);
 
-	had->corr = zero;
-	for(int i=0; i < quark.dilutions.size(); ++i)
-	{
-	  had->corr += 
-	    localInnerProduct(quark.dilutions[i].source, Gamma(gamma_value) * quark.dilutions[i].soln);
-	} // end for i
+	had->corr = corr[gamma_value];
 	
 	hadron.push_back(had);  // push onto end of list
       }
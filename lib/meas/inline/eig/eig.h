@@ -20,5 +20,6 @@
 
 #include "inline_eigbnds.h"
 #include "inline_ritz_H_w.h"
+#include "inline_krylov_schur_w.h"
 
 #endif
@@ -5,6 +5,7 @@
 #include "meas/inline/eig/inline_eig_aggregate.h"
 #include "meas/inline/eig/inline_eigbnds.h"
 #include "meas/inline/eig/inline_ritz_H_w.h"
+#include "meas/inline/eig/inline_krylov_schur_w.h"
 
 // Grab all fermacts to make sure they are registered
 #include "actions/ferm/fermacts/fermacts_aggregate_w.h"
@@ -33,6 +34,7 @@ namespace Chroma
 	// Eig stuff
 	success &= InlineEigBndsMdagMEnv::registerAll();
 	success &= InlineRitzEnv::registerAll();
+	success &= InlineKrylovSchurEnv::registerAll();
 
 	registered = true;
       }
@@ -0,0 +1,403 @@
+/*! \file
+ * \brief Inline construction of eigenvalues (Krylov-Schur)
+ *
+ * Eigenvalue calculations with the Chebyshev filtered thick-restart
+ * block Lanczos
+ */
+
+#include "fermact.h"
+#include "meas/inline/eig/inline_krylov_schur_w.h"
+#include "meas/inline/abs_inline_measurement_factory.h"
+#include "actions/ferm/fermacts/fermact_factory_w.h"
+#include "actions/ferm/fermacts/fermacts_aggregate_w.h"
+#include "meas/glue/mesplq.h"
+#include "util/info/proginfo.h"
+#include "util/info/unique_id.h"
+#include "util/ferm/eigeninfo.h"
+#include "meas/inline/make_xml_file.h"
+#include "meas/inline/io/named_objmap.h"
+#include "meas/eig/eig_spec.h"
+#include "io/xml_group_reader.h"
+
+
+namespace Chroma
+{
+  //! Eigeninfo input
+  void read(XMLReader& xml, const std::string& path, InlineKrylovSchurEnv::Params::Param_t& input)
+  {
+    XMLReader inputtop(xml, path);
+
+    read(inputtop, "version", input.version);
+    input.fermact = readXMLGroup(inputtop, "FermionAction", "FermAct");
+    read(inputtop, "KrylovSchurParams", input.eig_params);
+
+    input.op = "H";
+    if (inputtop.count("Operator") != 0)
+      read(inputtop, "Operator", input.op);
+
+    if (input.op != "H" && input.op != "MdagM")
+    {
+      QDPIO::cerr << InlineKrylovSchurEnv::name << ": Operator must be H or MdagM, found " << input.op << std::endl;
+      QDP_abort(1);
+    }
+
+    input.RsdZero = 1.0e-8;
+    if (inputtop.count("RsdZero") != 0)
+      read(inputtop, "RsdZero", input.RsdZero);
+  }
+
+  //! Eigeninfo output
+  void write(XMLWriter& xml, const std::string& path, const InlineKrylovSchurEnv::Params::Param_t& input)
+  {
+    push(xml, path);
+
+    write(xml, "version", input.version);
+    xml << input.fermact.xml;
+    write(xml, "KrylovSchurParams", input.eig_params);
+
+    if (input.op != "H")
+      write(xml, "Operator", input.op);
+
+    if (toBool(input.RsdZero != Real(1.0e-8)))
+      write(xml, "RsdZero", input.RsdZero);
+
+    pop(xml);
+  }
+
+
+  //! Eigeninfo input
+  void read(XMLReader& xml, const std::string& path, InlineKrylovSchurEnv::Params::NamedObject_t& input)
+  {
+    XMLReader inputtop(xml, path);
+
+    read(inputtop, "gauge_id", input.gauge_id);
+    read(inputtop, "eigen_id", input.eigen_id);
+  }
+
+  //! Eigeninfo output
+  void write(XMLWriter& xml, const std::string& path, const InlineKrylovSchurEnv::Params::NamedObject_t& input)
+  {
+    push(xml, path);
+
+    write(xml, "gauge_id", input.gauge_id);
+    write(xml, "eigen_id", input.eigen_id);
+
+    pop(xml);
+  }
+
+
+  namespace InlineKrylovSchurEnv
+  {
+    namespace
+    {
+      AbsInlineMeasurement* createMeasurement(XMLReader& xml_in,
+					      const std::string& path)
+      {
+	return new InlineMeas(Params(xml_in, path));
+      }
+
+      //! Local registration flag
+      bool registered = false;
+    }
+
+    const std::string name = "KRYLOV_SCHUR_HERM_WILSON";
+
+    //! Register all the factories
+    bool registerAll()
+    {
+      bool success = true;
+      if (! registered)
+      {
+	success &= WilsonTypeFermActsEnv::registerAll();
+	success &= TheInlineMeasurementFactory::Instance().registerObject(name, createMeasurement);
+	registered = true;
+      }
+      return success;
+    }
+
+
+    // Param stuff
+    Params::Params()
+    {
+      frequency = 0;
+    }
+
+    Params::Params(XMLReader& xml_in, const std::string& path)
+    {
+      try
+      {
+	XMLReader inputtop(xml_in, path);
+
+	if (inputtop.count("Frequency") == 1)
+	  read(inputtop, "Frequency", frequency);
+	else
+	  frequency = 1;
+
+	// Parameters for source construction
+	read(inputtop, "Param", param);
+
+	// Read any auxiliary state information
+	if( inputtop.count("Param/StateInfo") == 1 ) {
+	  XMLReader xml_state_info(inputtop, "Param/StateInfo");
+	  std::ostringstream os;
+	  xml_state_info.print(os);
+	  stateInfo = os.str();
+	}
+	else {
+	  XMLBufferWriter s_i_xml;
+	  push(s_i_xml, "StateInfo");
+	  pop(s_i_xml);
+	  stateInfo = s_i_xml.printCurrentContext();
+	}
+
+	// Read in the output propagator/source configuration info
+	read(inputtop, "NamedObject", named_obj);
+
+	// Possible alternate XML file pattern
+	if (inputtop.count("xml_file") != 0)
+	{
+	  read(inputtop, "xml_file", xml_file);
+	}
+      }
+      catch(const std::string& e)
+      {
+	QDPIO::cerr << __func__ << ": Caught Exception reading XML: " << e << std::endl;
+	QDP_abort(1);
+      }
+    }
+
+
+    void
+    Params::writeXML(XMLWriter& xml_out, const std::string& path)
+    {
+      push(xml_out, path);
+
+      write(xml_out, "Frequency", frequency);
+      write(xml_out, "Param", param);
+      {
+	std::istringstream header_is(stateInfo);
+	XMLReader xml_header(header_is);
+	xml_out << xml_header;
+      }
+      write(xml_out, "NamedObject", named_obj);
+
+      pop(xml_out); //  Path
+    }
+
+
+    //! Lowest eigenpairs of M^dag M, or of H through those of H^2 = M^dag M
+    void KrylovSchurCode4DHw(Handle< LinearOperator<LatticeFermion> >& MM,
+			     Handle< LinearOperator<LatticeFermion> >& H,
+			     const Params::Param_t& param,
+			     XMLWriter& xml_out,
+			     EigenInfo<LatticeFermion>& eigenvec_val)
+    {
+      const Subset& s = MM->subset();
+      const int n_eig = param.eig_params.Nstop;
+
+      multi1d<Real> lambda;
+      multi1d<LatticeFermion> psi;
+      Real lambda_hi;
+      int n_matvec;
+
+      EigSpecKrylovSchur(*MM, lambda, psi, param.eig_params, lambda_hi, n_matvec, xml_out);
+      write(xml_out, "lambda_Msq", lambda);
+
+      if (param.op == "H")
+      {
+	// Fix to ev-s of gamma_5 wilson
+	multi1d<bool> valid_eig(n_eig);
+	int n_valid;
+	int n_jacob;
+
+	fixMMev2Mev(*H,
+		    lambda,
+		    psi,
+		    n_eig,
+		    param.eig_params.RsdR,
+		    param.eig_params.RsdA,
+		    param.RsdZero,
+		    valid_eig,
+		    n_valid,
+		    n_jacob);
+
+	multi1d<Real> check_norm(n_eig);
+	for(int i=0; i < n_eig; i++) {
+	  LatticeFermion r_norm;
+	  (*H)(r_norm, psi[i], PLUS);
+	  r_norm[s] -= lambda[i]*psi[i];
+
+	  check_norm[i] = sqrt(norm2(r_norm,s));
+	  QDPIO::cout << "lambda_lo[" << i << "] = " << lambda[i] << "  ";
+	  QDPIO::cout << "check_norm["<<i<<"] = " << check_norm[i] << std::endl;
+	}
+
+	push(xml_out, "eigFix");
+	write(xml_out, "lambda_Hw", lambda);
+	write(xml_out, "n_valid", n_valid);
+	write(xml_out, "valid_eig", valid_eig);
+	write(xml_out, "check_norm", check_norm);
+	pop(xml_out);
+
+	// |H| is bounded by the root of the top of M^dag M
+	lambda_hi = sqrt(lambda_hi);
+      }
+
+      push(xml_out, "Highest");
+      write(xml_out, "lambda_hi", lambda_hi);
+      pop(xml_out);
+
+      eigenvec_val.getEvalues() = lambda;
+      eigenvec_val.getEvectors() = psi;
+      eigenvec_val.getLargest() = lambda_hi;
+    }
+
+
+    // Function call
+    void
+    InlineMeas::operator()(unsigned long update_no,
+			   XMLWriter& xml_out)
+    {
+      // If xml file not empty, then use alternate
+      if (params.xml_file != "")
+      {
+	std::string xml_file = makeXMLFileName(params.xml_file, update_no);
+
+	push(xml_out, "KrylovSchurEigen");
+	write(xml_out, "update_no", update_no);
+	write(xml_out, "xml_file", xml_file);
+	pop(xml_out);
+
+	XMLFileWriter xml(xml_file);
+	func(update_no, xml);
+      }
+      else
+      {
+	func(update_no, xml_out);
+      }
+    }
+
+
+    // Real work done here
+    void
+    InlineMeas::func(unsigned long update_no,
+		     XMLWriter& xml_out)
+    {
+      START_CODE();
+
+      QDP::StopWatch snoop;
+      snoop.reset();
+      snoop.start();
+
+      // Grab the gauge field
+      XMLBufferWriter gauge_xml;
+      multi1d<LatticeColorMatrix> u =
+	TheNamedObjMap::Instance().getData< multi1d<LatticeColorMatrix> >(params.named_obj.gauge_id);
+      TheNamedObjMap::Instance().get(params.named_obj.gauge_id).getRecordXML(gauge_xml);
+
+      push(xml_out, "KrylovSchurEigen");
+      write(xml_out, "update_no", update_no);
+
+      QDPIO::cout << name << ": Krylov-Schur eigenpairs" << std::endl;
+
+      proginfo(xml_out);    // Print out basic program info
+
+      // Write out the input
+      params.writeXML(xml_out, "Input");
+
+      XMLBufferWriter record_xml;
+      params.writeXML(record_xml, "RecordXML");
+
+      // Write out the config header
+      write(xml_out, "Config_info", gauge_xml);
+
+      push(xml_out, "Output_version");
+      write(xml_out, "out_version", 1);
+      pop(xml_out);
+
+      // Calculate some gauge invariant observables just for info.
+      MesPlq(xml_out, "Observables", u);
+
+      TheNamedObjMap::Instance().create< EigenInfo<LatticeFermion> >(params.named_obj.eigen_id);
+      EigenInfo<LatticeFermion>& eigenvec_val =
+	TheNamedObjMap::Instance().getData< EigenInfo<LatticeFermion> >(params.named_obj.eigen_id);
+
+      // File XML - the name of the measurement and and ID
+      XMLBufferWriter file_xml;
+      push(file_xml, "KrylovSchurEigen");
+      write(file_xml, "id", uniqueId());  // NOTE: new ID form
+      pop(file_xml);
+
+      TheNamedObjMap::Instance().get(params.named_obj.eigen_id).setFileXML(file_xml);
+      TheNamedObjMap::Instance().get(params.named_obj.eigen_id).setRecordXML(record_xml);
+
+      //
+      // Initialize fermion action
+      //
+      std::istringstream  xml_s(params.param.fermact.xml);
+      XMLReader  fermacttop(xml_s);
+
+      // Make a reader for the stateInfo
+      std::istringstream state_info_is(params.stateInfo);
+      XMLReader state_info_xml(state_info_is);
+      std::string state_info_path="/StateInfo";
+
+      bool success = false;
+
+      try {
+	StopWatch swatch;
+	swatch.reset();
+
+	// Typedefs to save typing
+	typedef LatticeFermion               T;
+	typedef multi1d<LatticeColorMatrix>  P;
+	typedef multi1d<LatticeColorMatrix>  Q;
+
+	Handle< WilsonTypeFermAct<T,P,Q> >
+	  S_f(TheWilsonTypeFermActFactory::Instance().createObject(params.param.fermact.id,
+								   fermacttop,
+								   params.param.fermact.path));
+
+	Handle< FermState<T,P,Q> > state(S_f->createState(u,
+							  state_info_xml,
+							  state_info_path));
+
+	Handle< LinearOperator<LatticeFermion> > MM(S_f->lMdagM(state));
+	Handle< LinearOperator<LatticeFermion> > H(S_f->hermitianLinOp(state));
+
+	swatch.start();
+	KrylovSchurCode4DHw(MM, H, params.param, xml_out, eigenvec_val);
+	swatch.stop();
+
+	QDPIO::cout << "Eigenvalues/-vectors computed: time= "
+		    << swatch.getTimeInSeconds()
+		    << " secs" << std::endl;
+
+	success = true;
+      }
+      catch (const std::string& e)
+      {
+	QDPIO::cout << name << ": caught exception: " << e << std::endl;
+      }
+
+      if (! success)
+      {
+	QDPIO::cerr << "Error: no fermact found" << std::endl;
+	QDP_abort(1);
+      }
+
+      snoop.stop();
+      QDPIO::cout << name << ": total time = "
+		  << snoop.getTimeInSeconds()
+		  << " secs" << std::endl;
+
+      QDPIO::cout << name << ": ran successfully" << std::endl;
+
+      pop(xml_out);
+
+      END_CODE();
+    }
+
+  } // namespace InlineKrylovSchurEnv
+
+} // namespace Chroma
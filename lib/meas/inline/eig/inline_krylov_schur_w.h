@@ -0,0 +1,81 @@
+// -*- C++ -*-
+/*! \file
+ * \brief Inline construction of eigenvalues (Krylov-Schur)
+ *
+ * Eigenvalue calculations with the Chebyshev filtered thick-restart
+ * block Lanczos
+ */
+
+#ifndef __inline_krylov_schur_w_h__
+#define __inline_krylov_schur_w_h__
+
+#include "chromabase.h"
+#include "meas/inline/abs_inline_measurement.h"
+#include "meas/eig/eig_krylov_schur.h"
+
+namespace Chroma
+{
+  /*! \ingroup inlinehadron */
+  namespace InlineKrylovSchurEnv
+  {
+    extern const std::string name;
+    bool registerAll();
+
+
+    //! Parameter structure
+    /*! \ingroup inlinehadron */
+    struct Params
+    {
+      Params();
+      Params(XMLReader& xml_in, const std::string& path);
+      void writeXML(XMLWriter& xml_out, const std::string& path);
+
+      unsigned long     frequency;
+
+      struct Param_t
+      {
+	int                  version;
+	GroupXML_t           fermact;       /*!< fermion action */
+	std::string          op;            /*!< H for the hermitian Wilson operator, MdagM for M^dag M */
+	Real                 RsdZero;       /*!< eigenvalues of H below are taken as zero */
+	KrylovSchurParams_t  eig_params;
+      } param;
+      std::string       stateInfo;
+
+      struct NamedObject_t
+      {
+	std::string     gauge_id;
+	std::string     eigen_id;
+      } named_obj;
+
+      std::string xml_file;  // Alternate XML file pattern
+    };
+
+    //! Inline measurement of eigenvalues
+    /*! \ingroup inlinehadron */
+    class InlineMeas : public AbsInlineMeasurement
+    {
+    public:
+      ~InlineMeas() {}
+      InlineMeas(const Params& p) : params(p) {}
+      InlineMeas(const InlineMeas& p) : params(p.params) {}
+
+      unsigned long getFrequency(void) const {return params.frequency;}
+
+      //! Do the measurement
+      void operator()(const unsigned long update_no,
+		      XMLWriter& xml_out);
+
+    protected:
+      //! Do the measurement
+      void func(const unsigned long update_no,
+		XMLWriter& xml_out);
+
+    private:
+      Params params;
+    };
+
+  } // namespace InlineKrylovSchurEnv
+
+} // namespace Chroma
+#endif
@@ -5,7 +5,7 @@
 #include "meas/inline/glue/inline_plaquette.h"
 #include "meas/inline/abs_inline_measurement_factory.h"
 #include "meas/inline/make_xml_file.h"
-#include "meas/glue/mesplq.h"
+#include "meas/glue/gauge_observables.h"
 #include "meas/inline/io/named_objmap.h"
 
 #include "meas/inline/io/default_gauge_field.h"
@@ -23,12 +23,15 @@ namespace Chroma
     int version;
     read(paramtop, "version", version);
     param.cgs = CreateGaugeStateEnv::nullXMLGroup();
+    param.clover = false;
 
     switch (version) 
     {
     case 2:
       if (paramtop.count("GaugeState") != 0)
 	param.cgs = readXMLGroup(paramtop, "GaugeState", "Name");
+      if (paramtop.count("CloverObservables") != 0)
+	read(paramtop, "CloverObservables", param.clover);
       break;
 
     default:
@@ -46,6 +49,8 @@ namespace Chroma
     int version = 2;
     write(xml, "version", version);
     xml << param.cgs.xml;
+    if (param.clover)
+      write(xml, "CloverObservables", param.clover);
 
     pop(xml);
   }
@@ -105,6 +110,7 @@ namespace Chroma
     { 
       frequency = 0; 
       param.cgs          = CreateGaugeStateEnv::nullXMLGroup();
+      param.clover       = false;
       named_obj.gauge_id = InlineDefaultGaugeField::getId();
       xml_file ="";
     }
@@ -210,33 +216,41 @@ namespace Chroma
       push(xml_out, "Plaquette");
       write(xml_out, "update_no", update_no);
 
-      Double w_plaq, s_plaq, t_plaq, link; 
-      multi2d<Double> plane_plaq;
+      // Everything in one sweep over the lattice
+      GaugeObservables_t obs;
+      gaugeObservables(u, obs, false, params.param.clover);
 
-      MesPlq(u, w_plaq, s_plaq, t_plaq, plane_plaq, link);
-      write(xml_out, "w_plaq", w_plaq);
-      write(xml_out, "s_plaq", s_plaq);
-      write(xml_out, "t_plaq", t_plaq);
+      write(xml_out, "w_plaq", obs.w_plaq);
+      write(xml_out, "s_plaq", obs.s_plaq);
+      write(xml_out, "t_plaq", obs.t_plaq);
 
       if (Nd >= 2)
       {
-	write(xml_out, "plane_01_plaq", plane_plaq[0][1]);
+	write(xml_out, "plane_01_plaq", obs.plane_plaq[0][1]);
       }
 
       if (Nd >= 3)
       {
-	write(xml_out, "plane_02_plaq", plane_plaq[0][2]);
-	write(xml_out, "plane_12_plaq", plane_plaq[1][2]);
+	write(xml_out, "plane_02_plaq", obs.plane_plaq[0][2]);
+	write(xml_out, "plane_12_plaq", obs.plane_plaq[1][2]);
       }
 
       if (Nd >= 4)
       {
-	write(xml_out, "plane_03_plaq", plane_plaq[0][3]);
-	write(xml_out, "plane_13_plaq", plane_plaq[1][3]);
-	write(xml_out, "plane_23_plaq", plane_plaq[2][3]);
+	write(xml_out, "plane_03_plaq", obs.plane_plaq[0][3]);
+	write(xml_out, "plane_13_plaq", obs.plane_plaq[1][3]);
+	write(xml_out, "plane_23_plaq", obs.plane_plaq[2][3]);
       }
 
-      write(xml_out, "link", link);
+      write(xml_out, "link", obs.link);
+
+      if (params.param.clover)
+      {
+	write(xml_out, "energy_s", obs.energy_s);
+	write(xml_out, "energy_t", obs.energy_t);
+	write(xml_out, "energy", obs.energy);
+	write(xml_out, "qtop", obs.qtop);
+      }
     
       pop(xml_out); // pop("Plaquette");
     
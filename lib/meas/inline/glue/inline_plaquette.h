@@ -29,6 +29,7 @@ namespace Chroma
       struct Param_t
       {
 	GroupXML_t    cgs;      /*!< Gauge State */
+	bool          clover;   /*!< also the clover energy density and charge */
       } param;
 
       struct NamedObject_t
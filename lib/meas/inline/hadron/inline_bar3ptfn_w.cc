@@ -53,6 +53,11 @@ namespace Chroma
 
     read(inputtop, "seqprop_id", input.seqprop_id);
     read(inputtop, "gamma_insertion", input.gamma_insertion);
+
+    if (inputtop.count("coherent_prop_ids") != 0)
+      read(inputtop, "coherent_prop_ids", input.coherent_prop_ids);
+    else
+      input.coherent_prop_ids.resize(0);
   }
 
   //! Propagator parameters
@@ -63,6 +68,9 @@ namespace Chroma
     write(xml, "seqprop_id", input.seqprop_id);
     write(xml, "gamma_insertion", input.gamma_insertion);
 
+    if (input.coherent_prop_ids.size() > 0)
+      write(xml, "coherent_prop_ids", input.coherent_prop_ids);
+
     pop(xml);
   }
 
@@ -385,12 +393,19 @@ namespace Chroma
 
     // Big nested structure that is image of all form-factors
 //    FormFac_Wilson_3Pt_fn_measurements_t  formfacs;
-    bar3pt.bar.output_version = 4;  // bump this up everytime something changes
-    bar3pt.bar.seqsrc.resize(params.named_obj.seqprops.size());
+    bar3pt.bar.output_version = 5;  // bump this up everytime something changes
+
+    // A coherent seqprop contributes one entry per group
+    int num_seqsrc = 0;
+    for (int seq_src_ctr = 0; seq_src_ctr < params.named_obj.seqprops.size(); ++seq_src_ctr) 
+      num_seqsrc += 1 + params.named_obj.seqprops[seq_src_ctr].coherent_prop_ids.size();
+
+    bar3pt.bar.seqsrc.resize(num_seqsrc);
 
-    XMLArrayWriter  xml_seq_src(xml_out, params.named_obj.seqprops.size());
+    XMLArrayWriter  xml_seq_src(xml_out, num_seqsrc);
     push(xml_seq_src, "Sequential_source");
 
+    int out_ctr = 0;
     for (int seq_src_ctr = 0; seq_src_ctr < params.named_obj.seqprops.size(); ++seq_src_ctr) 
     {
       push(xml_seq_src);
@@ -400,6 +415,7 @@ namespace Chroma
       // Read the quark propagator and extract headers
       LatticePropagator seq_quark_prop;
       SeqSource_t seqsource_header;
+      multi1d<CoherentSeqSource_t> coherent_sources;
       QDPIO::cout << "Attempt to parse sequential propagator" << std::endl;
       try
       {
@@ -419,6 +435,9 @@ namespace Chroma
 	// NEED SECURITY HERE - need a way to cross check props. Use the ID.
 	{
 	  read(seqprop_record_xml, "/SequentialProp/SeqSource", seqsource_header);
+
+	  if (seqprop_record_xml.count("/SequentialProp/CoherentSources") != 0)
+	    read(seqprop_record_xml, "/SequentialProp/CoherentSources", coherent_sources);
 	}
 
 	// Save seqprop input
@@ -439,6 +458,15 @@ namespace Chroma
       }
       QDPIO::cout << "Sequential propagator successfully parsed" << std::endl;
 
+      if (coherent_sources.size() != params.named_obj.seqprops[seq_src_ctr].coherent_prop_ids.size())
+      {
+	QDPIO::cerr << InlineBar3ptfnEnv::name << ": seqprop has " << coherent_sources.size()
+		    << " extra coherent groups, but " 
+		    << params.named_obj.seqprops[seq_src_ctr].coherent_prop_ids.size()
+		    << " coherent_prop_ids were given" << std::endl;
+	QDP_abort(1);
+      }
+
       // Sanity check - write out the norm2 of the forward prop in the j_decay direction
       // Use this for any possible verification
       {
@@ -456,33 +484,99 @@ namespace Chroma
       // Use extra gamma insertion
       int gamma_insertion = params.named_obj.seqprops[seq_src_ctr].gamma_insertion;
 
-      // Derived from input seqprop
-      std::string   seqsrc_type = seqsource_header.seqsrc.id;
-      QDPIO::cout << "Seqsource name = " << seqsrc_type  << std::endl;
-      int           t_sink   = seqsource_header.t_sink;
-      multi1d<int>  sink_mom = seqsource_header.sink_mom;
-
-      write(xml_seq_src, "hadron_type", "HADRON");
-      write(xml_seq_src, "seqsrc_type", seqsrc_type);
-      write(xml_seq_src, "t_source", t_source);
-      write(xml_seq_src, "t_sink", t_sink);
-      write(xml_seq_src, "sink_mom", sink_mom);
-      write(xml_seq_src, "gamma_insertion", gamma_insertion);
+      //
+      // Loop over the coherent groups. Each group is contracted with its own
+      // forward prop at its own source position. The other groups only 
+      // contribute gauge variant pieces, which average to zero.
+      //
+      for (int grp = 0; grp <= coherent_sources.size(); ++grp)
+      {
+	if (grp > 0)
+	{
+	  push(xml_seq_src);
+	  write(xml_seq_src, "seq_src_ctr", seq_src_ctr);
+	  write(xml_seq_src, "coherent_group", grp);
+	}
+
+	const SeqSource_t& grp_seqsource_header = (grp == 0) ? seqsource_header : coherent_sources[grp-1].seqsource_header;
+
+	// The forward prop and source position of this group
+	multi1d<int> grp_t_srce = t_srce;
+	int          grp_t_source = t_source;
+
+	if (grp > 0)
+	{
+	  std::string prop_id = params.named_obj.seqprops[seq_src_ctr].coherent_prop_ids[grp-1];
+	  PropSourceConst_t grp_source_header;
+	  try
+	  {
+	    XMLReader grp_prop_record_xml;
+	    TheNamedObjMap::Instance().get(prop_id).getRecordXML(grp_prop_record_xml);
+	    read(grp_prop_record_xml, "/Propagator/PropSource", grp_source_header);
+	  }
+	  catch (const std::string& e) 
+	  {
+	    QDPIO::cerr << InlineBar3ptfnEnv::name << ": error reading coherent forward prop: " << e 
+			<< std::endl;
+	    QDP_abort(1);
+	  }
+
+	  grp_t_srce   = grp_source_header.getTSrce();
+	  grp_t_source = grp_source_header.t_source;
+
+	  // Cross check against what went into the seqsource
+	  multi1d<int> hdr_t_srce = coherent_sources[grp-1].forward_props[0].source_header.getTSrce();
+	  for(int mu=0; mu < hdr_t_srce.size(); ++mu)
+	  {
+	    if (hdr_t_srce[mu] != grp_t_srce[mu])
+	    {
+	      QDPIO::cerr << InlineBar3ptfnEnv::name << ": coherent forward prop " << prop_id 
+			  << " does not match the source position of group " << grp << std::endl;
+	      QDP_abort(1);
+	    }
+	  }
+	}
+
+	// Derived from input seqprop
+	std::string   seqsrc_type = grp_seqsource_header.seqsrc.id;
+	QDPIO::cout << "Seqsource name = " << seqsrc_type  << std::endl;
+	int           t_sink   = grp_seqsource_header.t_sink;
+	multi1d<int>  sink_mom = grp_seqsource_header.sink_mom;
+
+	write(xml_seq_src, "hadron_type", "HADRON");
+	write(xml_seq_src, "seqsrc_type", seqsrc_type);
+	write(xml_seq_src, "t_source", grp_t_source);
+	write(xml_seq_src, "t_sink", t_sink);
+	write(xml_seq_src, "sink_mom", sink_mom);
+	write(xml_seq_src, "gamma_insertion", gamma_insertion);
 	
-      bar3pt.bar.seqsrc[seq_src_ctr].seqsrc_type   = seqsrc_type;
-      bar3pt.bar.seqsrc[seq_src_ctr].t_source      = t_source;
-      bar3pt.bar.seqsrc[seq_src_ctr].t_sink        = t_sink;
-      bar3pt.bar.seqsrc[seq_src_ctr].sink_mom      = sink_mom;
-      bar3pt.bar.seqsrc[seq_src_ctr].gamma_insertion = gamma_insertion;
+	bar3pt.bar.seqsrc[out_ctr].seqsrc_type   = seqsrc_type;
+	bar3pt.bar.seqsrc[out_ctr].t_source      = grp_t_source;
+	bar3pt.bar.seqsrc[out_ctr].t_sink        = t_sink;
+	bar3pt.bar.seqsrc[out_ctr].sink_mom      = sink_mom;
+	bar3pt.bar.seqsrc[out_ctr].gamma_insertion = gamma_insertion;
 	
 
-      // Now the 3pt contractions
-      SftMom phases(params.param.mom2_max, t_srce, sink_mom, false, j_decay);
-      FormFac(bar3pt.bar.seqsrc[seq_src_ctr].formFacs, 
-	      u, quark_propagator, seq_quark_prop, gamma_insertion,
-	      phases, t_source);
+	// Now the 3pt contractions
+	SftMom phases(params.param.mom2_max, grp_t_srce, sink_mom, false, j_decay);
+	if (grp == 0)
+	{
+	  FormFac(bar3pt.bar.seqsrc[out_ctr].formFacs, 
+		  u, quark_propagator, seq_quark_prop, gamma_insertion,
+		  phases, grp_t_source);
+	}
+	else
+	{
+	  std::string prop_id = params.named_obj.seqprops[seq_src_ctr].coherent_prop_ids[grp-1];
+	  FormFac(bar3pt.bar.seqsrc[out_ctr].formFacs, 
+		  u, TheNamedObjMap::Instance().getData<LatticePropagator>(prop_id), 
+		  seq_quark_prop, gamma_insertion,
+		  phases, grp_t_source);
+	}
 
-      pop(xml_seq_src);   // elem
+	++out_ctr;
+	pop(xml_seq_src);   // elem
+      } // end loop over coherent groups
     } // end loop over sequential sources
 
     pop(xml_seq_src);  // Sequential_source
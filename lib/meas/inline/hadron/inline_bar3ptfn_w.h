@@ -41,6 +41,14 @@ namespace Chroma
     {
       std::string      seqprop_id;
       int              gamma_insertion;    /*!< second gamma insertion */
+
+      //! Forward props of the extra groups of a coherent seqprop
+      /*! 
+       * One id per extra group, in the order of the seqprop's CoherentSources.
+       * Each group is contracted only with its own forward prop, so the
+       * group becomes a separate entry in the output.
+       */
+      multi1d<std::string>  coherent_prop_ids;
     };
 
     struct NamedObject_t
@@ -17,6 +17,7 @@
 #include "io/qprop_io.h"
 #include "meas/hadron/mesons2_w.h"
 #include "meas/hadron/barhqlq_w.h"
+#include "meas/hadron/baryon_contract_engine_w.h"
 #include "meas/hadron/curcor2_w.h"
 #include "meas/inline/make_xml_file.h"
 #include "meas/inline/io/named_objmap.h"
@@ -280,53 +281,6 @@ namespace Chroma
     }
 
 
-    void epsilon_contract(LatticeComplex& res,
-			  const multi2d<LatticeComplex>& l,
-			  const multi2d<LatticeComplex>& m,
-			  const multi2d<LatticeComplex>& r){
-      //LatticeComplex res = 0.0;
-    
-      //generated by : make_epsilon_contr.pl | sort                
-
-      res  = l(0,0)*m(1,1)*r(2,2);
-      res -= l(0,0)*m(1,2)*r(2,1);
-      res -= l(0,0)*m(2,1)*r(1,2);
-      res += l(0,0)*m(2,2)*r(1,1);
-      res -= l(0,1)*m(1,0)*r(2,2);
-      res += l(0,1)*m(1,2)*r(2,0);
-      res += l(0,1)*m(2,0)*r(1,2);
-      res -= l(0,1)*m(2,2)*r(1,0);
-      res += l(0,2)*m(1,0)*r(2,1);
-      res -= l(0,2)*m(1,1)*r(2,0);
-      res -= l(0,2)*m(2,0)*r(1,1);
-      res += l(0,2)*m(2,1)*r(1,0);
-      res -= l(1,0)*m(0,1)*r(2,2);
-      res += l(1,0)*m(0,2)*r(2,1);
-      res += l(1,0)*m(2,1)*r(0,2);
-      res -= l(1,0)*m(2,2)*r(0,1);
-      res += l(1,1)*m(0,0)*r(2,2);
-      res -= l(1,1)*m(0,2)*r(2,0);
-      res -= l(1,1)*m(2,0)*r(0,2);
-      res += l(1,1)*m(2,2)*r(0,0);
-      res -= l(1,2)*m(0,0)*r(2,1);
-      res += l(1,2)*m(0,1)*r(2,0);
-      res += l(1,2)*m(2,0)*r(0,1);
-      res -= l(1,2)*m(2,1)*r(0,0);
-      res += l(2,0)*m(0,1)*r(1,2);
-      res -= l(2,0)*m(0,2)*r(1,1);
-      res -= l(2,0)*m(1,1)*r(0,2);
-      res += l(2,0)*m(1,2)*r(0,1);
-      res -= l(2,1)*m(0,0)*r(1,2);
-      res += l(2,1)*m(0,2)*r(1,0);
-      res += l(2,1)*m(1,0)*r(0,2);
-      res -= l(2,1)*m(1,2)*r(0,0);
-      res += l(2,2)*m(0,0)*r(1,1);
-      res -= l(2,2)*m(0,1)*r(1,0);
-      res -= l(2,2)*m(1,0)*r(0,1);
-      res += l(2,2)*m(1,1)*r(0,0);
-
-      //return res ;
-    }
 
     // Anonymous namespace
     namespace 
@@ -477,6 +431,15 @@ namespace Chroma
 
 
 
+      //! Rotate a propagator to the Dirac basis the spin wavefunctions are written in
+      void convertToDirac(LatticePropagator& dprop, const LatticePropagator& prop)
+      {
+	QDPIO::cout<<__func__<<": Converting to Dirac Basis"<<std::endl ;
+	SpinMatrix U = DiracToDRMat();
+	dprop = adj(U)*prop*U ;
+      }
+
+
       //! Useful structure holding sink props
       struct AllSinkProps_t
       {
@@ -485,14 +448,14 @@ namespace Chroma
 	multi1d<int> t_srce ;
 	int bc_spec ;
 	std::map<std::string,SinkPropContainer_t>  prop;
-	std::map<std::string,BarSpec::RPropagator> rprop;
+	std::map<std::string,LatticePropagator> rprop;   /*!< Dirac basis props */
 
 	//! Read all sinks
 	AllSinkProps_t(const Params::NamedObject_t::Props_t& p){
 
 	  QDPIO::cout<<"Attempt to parse forward propagator= "<<p.up_id<<std::endl;
 	  prop["up"].readSinkProp(p.up_id);
-	  rprop[p.up_id].ConvertProp(TheNamedObjMap::Instance().getData<LatticePropagator>(p.up_id));
+	  convertToDirac(rprop[p.up_id], TheNamedObjMap::Instance().getData<LatticePropagator>(p.up_id));
 	  QDPIO::cout<<"up quark  propagator successfully parsed" << std::endl;
 	  j_decay = prop["up"].prop_header.source_header.j_decay;
 	  t0      = prop["up"].prop_header.source_header.t_source;
@@ -506,7 +469,7 @@ namespace Chroma
 	  if(rprop.find(p.down_id) == rprop.end()){
 	    QDPIO::cout<<__func__<<": Need to convert prop id: "
 		       <<p.down_id<<std::endl;
-	    rprop[p.down_id].ConvertProp(TheNamedObjMap::Instance().getData<LatticePropagator>(p.down_id));
+	    convertToDirac(rprop[p.down_id], TheNamedObjMap::Instance().getData<LatticePropagator>(p.down_id));
 	  }
 	  QDPIO::cout<<"Attempt to parse forward propagator= "<<p.strange_id<<std::endl;
 	  prop["strange"].readSinkProp(p.strange_id);
@@ -515,7 +478,7 @@ namespace Chroma
 	    if(rprop.find(p.strange_id) == rprop.end()){
 	      QDPIO::cout<<__func__<<": Need to convert prop id: "
 			 <<p.strange_id<<std::endl;
-	      rprop[p.strange_id].ConvertProp(TheNamedObjMap::Instance().getData<LatticePropagator>(p.strange_id));
+	      convertToDirac(rprop[p.strange_id], TheNamedObjMap::Instance().getData<LatticePropagator>(p.strange_id));
 	    }
 	  }
 
@@ -526,7 +489,7 @@ namespace Chroma
 	    if(rprop.find(p.charm_id) == rprop.end()){
 	      QDPIO::cout<<__func__<<": Need to convert prop id: "
 			 <<p.charm_id<<std::endl;
-	      rprop[p.charm_id].ConvertProp(TheNamedObjMap::Instance().getData<LatticePropagator>(p.charm_id));
+	      convertToDirac(rprop[p.charm_id], TheNamedObjMap::Instance().getData<LatticePropagator>(p.charm_id));
 	    }
 	  }
 	
@@ -548,7 +511,7 @@ namespace Chroma
 	  return prop[flavor].source_type ;
 	}
 
-	const BarSpec::RPropagator& prop_ref(const std::string& flavor){
+	const LatticePropagator& prop_ref(const std::string& flavor){
 
 	  return  rprop[prop[flavor].quark_propagator_id] ;
       
@@ -618,24 +581,6 @@ namespace Chroma
 	return sign_ ;
       }
 
-      void contract(LatticeComplex& latC, 
-		    const RPropagator& q1,
-		    const RPropagator& q2,
-		    const RPropagator& q3,
-		    const SpinWF_t& snk,
-		    const SpinWF_t& src){
-	LatticeComplex cc ;
-	latC = 0.0;
-	for(int s(0);s<src.terms.size();s++)
-	  for(int ss(0);ss<snk.terms.size();ss++){
-	    epsilon_contract(cc,
-			     q1.p(snk.terms[ss].spin[0],src.terms[s].spin[0]),
-			     q2.p(snk.terms[ss].spin[1],src.terms[s].spin[1]),
-			     q3.p(snk.terms[ss].spin[2],src.terms[s].spin[2]) );
-	    latC += (snk.terms[ss].weight*src.terms[s].weight)*cc ;
-	  }// loop over source sink wavefunction components
-	latC *= (snk.norm*src.norm) ;
-      }
     }//barspec name space
 
 
@@ -775,7 +720,6 @@ namespace Chroma
 
 	int Nt = Layout::lattSize()[j_decay];
 
-	LatticeComplex latC ;
 	StopWatch tictoc;
 	tictoc.reset();
 	tictoc.start();
@@ -815,9 +759,9 @@ namespace Chroma
 
 
 	  // References for use later 
-	  const BarSpec::RPropagator& q1 = all_sinks.prop_ref(prop_id[0]) ;
-	  const BarSpec::RPropagator& q2 = all_sinks.prop_ref(prop_id[1]) ;
-	  const BarSpec::RPropagator& q3 = all_sinks.prop_ref(prop_id[2]) ;
+	  const LatticePropagator& q1 = all_sinks.prop_ref(prop_id[0]) ;
+	  const LatticePropagator& q2 = all_sinks.prop_ref(prop_id[1]) ;
+	  const LatticePropagator& q3 = all_sinks.prop_ref(prop_id[2]) ;
 
 	  KeyHadron2PtCorr_t key  ;
 
@@ -843,22 +787,44 @@ namespace Chroma
 	  key.snk_lorentz.resize(0);
 	  //key.snk_lorentz =  key.snk_spin  ;
 
-	  //loop over momenta goes here
-	  for(int oi(0);oi<params.param.states[s].ops.size();oi++){ //sink
+	  // Spin wavefunctions of all sink/source operator pairs. Channel
+	  // oi*nops+oj holds sink op oi and source op oj.
+	  const int nops = params.param.states[s].ops.size();
+	  std::vector<BaryonContractEngine::SpinChannel_t> channels(nops*nops);
+	  for(int oi(0);oi<nops;oi++){ //sink
 	    BarSpec::SpinWF_t snk(params.param.states[s].ops[oi].spinWF);
 	    snk.permutations(prop_id);
-	    for(int oj(0);oj<params.param.states[s].ops.size();oj++){//source
-
+	    for(int oj(0);oj<nops;oj++){//source
 	      BarSpec::SpinWF_t src(params.param.states[s].ops[oj].spinWF);
+	      BaryonContractEngine::SpinChannel_t& chan = channels[oi*nops+oj];
+	      for(int ss(0);ss<snk.terms.size();ss++)
+		for(int sr(0);sr<src.terms.size();sr++){
+		  BaryonContractEngine::SpinTerm_t t;
+		  for(int k(0);k<3;k++){
+		    t.snk[k] = snk.terms[ss].spin[k];
+		    t.src[k] = src.terms[sr].spin[k];
+		  }
+		  t.weight = snk.terms[ss].weight*src.terms[sr].weight*snk.norm*src.norm;
+		  chan.push_back(t);
+		}
+	    }
+	  }
+
+	  // Contract all pairs in one sweep and project them with one reduction
+	  multi1d<LatticeComplex> latC;
+	  BaryonContractEngine::epsilonChannels(latC, q1, q2, q3, channels);
+
+	  multi3d<DComplex> hsum;
+	  hsum = phases.sft(latC) ;
+
+	  //loop over momenta goes here
+	  for(int oi(0);oi<nops;oi++){ //sink
+	    for(int oj(0);oj<nops;oj++){//source
+	      const int c = oi*nops+oj;
 
 	      key.src_name    = params.param.states[s].ops[oj].name;
 	      key.snk_name    = params.param.states[s].ops[oi].name;
 	    
-	      BarSpec::contract(latC,q1,q2,q3,snk,src);
-
-	      multi2d<ComplexD> hsum;
-	      hsum = phases.sft(latC) ;
-	    
 	      for(int mom(0);mom<phases.numMom();mom++){
 		key.mom = phases.numToMom(mom);    /*<! Momentum  */
 		SerialDBKey<KeyHadron2PtCorr_t> K;
@@ -868,9 +834,9 @@ namespace Chroma
 		for(int t(0);t<Nt;t++){
 		  int t_eff = (t - t0 + Nt) % Nt;
 		  if ( bc_spec < 0 && (t_eff+t0) >= Nt)
-		    V.data()[t_eff] = -hsum[mom][t];
+		    V.data()[t_eff] = -hsum[c][mom][t];
 		  else
-		    V.data()[t_eff] =  hsum[mom][t];
+		    V.data()[t_eff] =  hsum[c][mom][t];
 		}//loop over time
 		qdp_db.insert(K,V);
 	      }// loop over momenta
@@ -189,68 +189,6 @@ namespace Chroma
       
       } ;
     
-      //My own propagator class                                              
-      template<int N>
-      class BasePropagator
-      {
-      public:
-	multi2d<multi2d<LatticeComplex> > p ;
-      
-	BasePropagator(){
-	  p.resize(N,N);
-	  for(int s(0);s<N;s++)
-	    for(int ss(0);ss<N;ss++)
-	      p(s,ss).resize(Nc,Nc) ;
-	}
-      
-	void ConvertProp(const LatticePropagator& prop, int spin_offset){
-	  QDPIO::cout<<__func__<<": Converting to Dirac Basis"<<std::endl ;
-	  SpinMatrix U = DiracToDRMat();
-	  LatticePropagator foo = adj(U)*prop*U ;
-	
-	  p.resize(N,N);
-	  int Noff = N+spin_offset;
-	  if(Noff>Ns)
-	    Noff=Ns ; 
-	  for(int s(spin_offset);s<Noff;s++)
-	    for(int ss(0);ss<Noff;ss++){
-	      p(s,ss).resize(Nc,Nc) ;
-	      LatticeColorMatrix Cmat = peekSpin(foo,s,ss) ;
-	      for(int c(0);c<Nc;c++)
-		for(int cc(0);cc<Nc;cc++)
-		  p(s,ss)(c,cc) = peekColor(Cmat,c,cc);
-	    }
-	
-	}
-      
-	void ConvertProp(const LatticePropagator& prop){
-	  ConvertProp(prop,0);
-	}
-
-	void ConvertPropUpper(const LatticePropagator& prop){
-	  ConvertProp(prop,0);
-	}
-
-	void ConvertPropLowerr(const LatticePropagator& prop){
-	  ConvertProp(prop,2);
-	}
-
-      };
-
-      typedef BasePropagator<Ns  >  RPropagator ;
-      typedef BasePropagator<Ns/2> NRPropagator ;
-
-
-      void contract(LatticeComplex& latC, 
-		    const RPropagator& q1,
-		    const RPropagator& q2,
-		    const RPropagator& q3,
-		    const SpinWF_t& snk,
-		    const SpinWF_t& src);
-
-		    
-
-
     }// namespace BarSpec
 
 
@@ -20,6 +20,7 @@
 #include "util/ferm/key_prop_colorvec.h"
 #include "util/ferm/key_prop_matelem.h"
 #include "util/ferm/key_val_db.h"
+#include "util/ferm/timeslice_codec_io.h"
 #include "util/ferm/transf.h"
 #include "util/ferm/spin_rep.h"
 #include "util/ferm/diractodr.h"
@@ -201,10 +202,10 @@ namespace Chroma
   {
     //----------------------------------------------------------------------------
     // Convenience type
-    typedef QDP::MapObjectDisk<KeyTimeSliceColorVec_t, TimeSliceIO<LatticeColorVectorF> > MOD_t;
+    typedef QDP::MapObjectDisk<KeyTimeSliceColorVec_t, TimeSliceCodecIO<LatticeColorVectorF> > MOD_t;
 
     // Convenience type
-    typedef QDP::MapObjectDiskMultiple<KeyTimeSliceColorVec_t, TimeSliceIO<LatticeColorVectorF> > MODS_t;
+    typedef QDP::MapObjectDiskMultiple<KeyTimeSliceColorVec_t, TimeSliceCodecIO<LatticeColorVectorF> > MODS_t;
 
     // Convenience type
     typedef QDP::MapObjectMemory<KeyTimeSliceColorVec_t, SubLatticeColorVectorF> SUB_MOD_t;
@@ -220,7 +221,7 @@ namespace Chroma
       {
       public:
 	//! Constructor
-	SubEigenMap(MODS_t& eigen_source_, int decay_dir, bool zero_colorvecs, int t_offset, int lt_orig) : eigen_source(eigen_source_), time_slice_set(decay_dir), zero_colorvecs(zero_colorvecs), t_offset(t_offset), lt_orig(lt_orig) {}
+	SubEigenMap(MODS_t& eigen_source_, int decay_dir, bool zero_colorvecs, int t_offset, int lt_orig, StorageCodec codec_) : eigen_source(eigen_source_), time_slice_set(decay_dir), zero_colorvecs(zero_colorvecs), t_offset(t_offset), lt_orig(lt_orig), codec(codec_) {}
 
 	//! Getter
 	const SubLatticeColorVectorF& getVec(int t_source, int colorvec_src) const;
@@ -241,6 +242,9 @@ namespace Chroma
 	bool zero_colorvecs;
 	int t_offset;
 	int lt_orig;
+
+	//! Storage codec of the color vector files
+	StorageCodec codec;
       };
 
       //----------------------------------------------------------------------------
@@ -260,7 +264,7 @@ namespace Chroma
 
 	  if (!zero_colorvecs)
 	    {
-	      TimeSliceIO<LatticeColorVectorF> time_slice_io(vec_srce, t_source );
+	      TimeSliceCodecIO<LatticeColorVectorF> time_slice_io(vec_srce, t_source, codec);
 	      eigen_source.get(src_key, time_slice_io);
 	    }
 	  
@@ -485,6 +489,10 @@ namespace Chroma
       else
       {
 	prop_obj.open(params.named_obj.prop_file, std::ios_base::in);
+
+	std::string prop_meta_data;
+	prop_obj.getUserdata(prop_meta_data);
+	StorageCodecEnv::checkNoCodec(prop_meta_data, params.named_obj.prop_file);
       }
 
       QDPIO::cout << "Finished opening solution file" << std::endl;
@@ -549,7 +557,8 @@ namespace Chroma
 
       // The sub-lattice eigenstd::vector std::map
       QDPIO::cout << "Initialize sub-lattice std::map" << std::endl;
-      SubEigenMap sub_eigen_map(eigen_source, decay_dir, params.param.contract.zero_colorvecs, t_offset , lt_orig );
+      SubEigenMap sub_eigen_map(eigen_source, decay_dir, params.param.contract.zero_colorvecs, t_offset , lt_orig,
+				StorageCodecEnv::codecFromMetaData(eigen_meta_data));
       QDPIO::cout << "Finished initializing sub-lattice std::map" << std::endl;
 
 
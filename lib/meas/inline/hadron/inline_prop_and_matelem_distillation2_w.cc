@@ -19,6 +19,7 @@
 #include "util/ferm/key_prop_colorvec.h"
 #include "util/ferm/key_prop_matelem.h"
 #include "util/ferm/key_val_db.h"
+#include "util/ferm/timeslice_codec_io.h"
 #include "util/ferm/transf.h"
 #include "util/ferm/spin_rep.h"
 #include "util/ferm/diractodr.h"
@@ -174,10 +175,10 @@ namespace Chroma
   {
     //----------------------------------------------------------------------------
     // Convenience type
-    typedef QDP::MapObjectDisk<KeyTimeSliceColorVec_t, TimeSliceIO<LatticeColorVectorF> > MOD_t;
+    typedef QDP::MapObjectDisk<KeyTimeSliceColorVec_t, TimeSliceCodecIO<LatticeColorVectorF> > MOD_t;
 
     // Convenience type
-    typedef QDP::MapObjectDiskMultiple<KeyTimeSliceColorVec_t, TimeSliceIO<LatticeColorVectorF> > MODS_t;
+    typedef QDP::MapObjectDiskMultiple<KeyTimeSliceColorVec_t, TimeSliceCodecIO<LatticeColorVectorF> > MODS_t;
 
     // Convenience type
     typedef QDP::MapObjectMemory<KeyTimeSliceColorVec_t, SubLatticeColorVectorF> SUB_MOD_t;
@@ -199,7 +200,7 @@ namespace Chroma
 
 	
 	//! Constructor
-	SubEigenMap(MODS_t& eigen_source_, int decay_dir) : eigen_source(eigen_source_), time_slice_set(decay_dir) {}
+	SubEigenMap(MODS_t& eigen_source_, int decay_dir, StorageCodec codec_) : eigen_source(eigen_source_), time_slice_set(decay_dir), codec(codec_) {}
 
 	//! Getter
 	const SubLatticeColorVectorF& getVec(int t_source, int colorvec_src) const;
@@ -216,6 +217,9 @@ namespace Chroma
 	// The time-slice set
 	TimeSliceSet time_slice_set;
 
+	//! Storage codec of the color vector files
+	StorageCodec codec;
+
       private:
 	//! Where we store the sublattice versions
 	//mutable SUB_MOD_t sub_eigen;
@@ -249,7 +253,7 @@ namespace Chroma
 
 	  LatticeColorVectorF vec_srce = zero;
 
-	  TimeSliceIO<LatticeColorVectorF> time_slice_io(vec_srce, t_source);
+	  TimeSliceCodecIO<LatticeColorVectorF> time_slice_io(vec_srce, t_source, codec);
 	  eigen_source.get(src_key, time_slice_io);
 
 	  SubLatticeColorVectorF tmp(getSet()[t_source], vec_srce);
@@ -282,7 +286,7 @@ namespace Chroma
 
 	  LatticeColorVectorF vec_srce = zero;
 
-	  TimeSliceIO<LatticeColorVectorF> time_slice_io(vec_srce, t_source);
+	  TimeSliceCodecIO<LatticeColorVectorF> time_slice_io(vec_srce, t_source, codec);
 	  eigen_source.get(src_key, time_slice_io);
 
 	  SubLatticeColorVectorF tmp(getSet()[t_source], vec_srce);
@@ -655,7 +659,7 @@ namespace Chroma
 
       // The sub-lattice eigenstd::vector std::map
       QDPIO::cout << "Initialize sub-lattice std::map" << std::endl;
-      SubEigenMap sub_eigen_map(eigen_source, decay_dir);
+      SubEigenMap sub_eigen_map(eigen_source, decay_dir, StorageCodecEnv::codecFromMetaData(eigen_meta_data));
       QDPIO::cout << "Finished initializing sub-lattice std::map" << std::endl;
 
 
@@ -20,6 +20,8 @@
 #include "util/ferm/key_prop_colorvec.h"
 #include "util/ferm/key_prop_matelem.h"
 #include "util/ferm/key_val_db.h"
+#include "util/ferm/timeslice_io_cache.h"
+#include "util/ferm/timeslice_codec_io.h"
 #include "util/ferm/transf.h"
 #include "util/ferm/spin_rep.h"
 #include "util/ferm/diractodr.h"
@@ -36,6 +38,8 @@
 
 #include "chroma_config.h"
 
+#include <set>
+
 #ifndef QDP_IS_QDPJIT_NO_NVPTX
 
 #ifdef BUILD_JIT_CONTRACTION_KERNELS
@@ -201,10 +205,10 @@ namespace Chroma
   {
     //----------------------------------------------------------------------------
     // Convenience type
-    typedef QDP::MapObjectDisk<KeyTimeSliceColorVec_t, TimeSliceIO<LatticeColorVector> > MOD_t;
+    typedef QDP::MapObjectDisk<KeyTimeSliceColorVec_t, TimeSliceCodecIO<LatticeColorVector> > MOD_t;
 
     // Convenience type
-    typedef QDP::MapObjectDiskMultiple<KeyTimeSliceColorVec_t, TimeSliceIO<LatticeColorVector> > MODS_t;
+    typedef QDP::MapObjectDiskMultiple<KeyTimeSliceColorVec_t, TimeSliceCodecIO<LatticeColorVector> > MODS_t;
 
     // Convenience type
     typedef QDP::MapObjectMemory<KeyTimeSliceColorVec_t, SubLatticeColorVector> SUB_MOD_t;
@@ -218,11 +222,18 @@ namespace Chroma
       {
       public:
 	//! Constructor
-	SubEigenMap(MODS_t& eigen_source_, int decay_dir, bool zero_colorvecs) : eigen_source(eigen_source_), time_slice_set(decay_dir), zero_colorvecs(zero_colorvecs) {}
+	SubEigenMap(MODS_t& eigen_source_, int decay_dir, bool zero_colorvecs, StorageCodec codec_) : eigen_source(eigen_source_), time_slice_set(decay_dir), zero_colorvecs(zero_colorvecs), codec(codec_),
+	  read_ahead([this](const KeyTimeSliceColorVec_t& key, LatticeColorVector& vec) {
+	      TimeSliceCodecIO<LatticeColorVector> time_slice_io(vec, key.t_slice, codec);
+	      eigen_source.get(key, time_slice_io);
+	    }, 8) {}
 
 	//! Getter
 	const SubLatticeColorVector& getVec(int t_source, int colorvec_src) const;
 
+	//! Start reading the vectors of these time slices in this order
+	void readAhead(const std::vector<int>& t_slices, int num_vecs) const;
+
 	//! The set to be used in sumMulti
 	const Set& getSet() const {return time_slice_set.getSet();}
 
@@ -237,8 +248,40 @@ namespace Chroma
 	//! Where we store the sublattice versions
 	mutable SUB_MOD_t sub_eigen;
 	bool zero_colorvecs;
+
+	//! Storage codec of the color vector files
+	StorageCodec codec;
+
+	//! Reads the vectors from disk while the solves run
+	mutable TimeSliceReadAhead read_ahead;
       };
 
+      //----------------------------------------------------------------------------
+      //! Start reading the vectors of these time slices in this order
+      void SubEigenMap::readAhead(const std::vector<int>& t_slices, int num_vecs) const
+      {
+	if (zero_colorvecs)
+	  return;
+
+	std::vector<KeyTimeSliceColorVec_t> order;
+	std::set<int> seen;
+
+	for(int i=0; i < t_slices.size(); ++i)
+	{
+	  if (! seen.insert(t_slices[i]).second)
+	    continue;
+
+	  for(int n=0; n < num_vecs; ++n)
+	  {
+	    KeyTimeSliceColorVec_t key(t_slices[i], n);
+	    if (! sub_eigen.exist(key))
+	      order.push_back(key);
+	  }
+	}
+
+	read_ahead.start(order);
+      }
+
       //----------------------------------------------------------------------------
       //! Getter
       const SubLatticeColorVector& SubEigenMap::getVec(int t_source, int colorvec_src) const
@@ -255,8 +298,7 @@ namespace Chroma
 
 	  if (!zero_colorvecs)
 	    {
-	      TimeSliceIO<LatticeColorVector> time_slice_io(vec_srce, t_source);
-	      eigen_source.get(src_key, time_slice_io);
+	      read_ahead.get(src_key, vec_srce);
 	    }
 	  
 	  SubLatticeColorVector tmp(getSet()[t_source], vec_srce);
@@ -557,7 +599,8 @@ namespace Chroma
 
       // The sub-lattice eigenstd::vector std::map
       QDPIO::cout << "Initialize sub-lattice std::map" << std::endl;
-      SubEigenMap sub_eigen_map(eigen_source, decay_dir, params.param.contract.zero_colorvecs);
+      SubEigenMap sub_eigen_map(eigen_source, decay_dir, params.param.contract.zero_colorvecs,
+				StorageCodecEnv::codecFromMetaData(eigen_meta_data));
       QDPIO::cout << "Finished initializing sub-lattice std::map" << std::endl;
 
 
@@ -687,6 +730,17 @@ namespace Chroma
 		} // key
 	      QDPIO::cout << "peram initialized! " << std::endl; 
 
+	      // Read the source and sink vectors in the order they are used
+	      {
+		std::vector<int> t_slices(1, t_source);
+		for(std::list<KeyPropElementalOperator_t>::const_iterator key = snk_keys.begin();
+		    key != snk_keys.end();
+		    ++key)
+		  t_slices.push_back(key->t_slice);
+
+		sub_eigen_map.readAhead(t_slices, num_vecs);
+	      }
+
 	      //
 	      // The space distillation loop
 	      //
@@ -12,6 +12,7 @@
 #include "qdp_map_obj_disk.h"
 #include "qdp_disk_map_slice.h"
 #include "util/ferm/key_prop_distillation.h"
+#include "io/storage_codec.h"
 #include "util/ferm/transf.h"
 #include "util/ferm/spin_rep.h"
 #include "util/ferm/diractodr.h"
@@ -607,6 +608,10 @@ namespace Chroma
       else
       {
 	source_obj.open(params.named_obj.src_file, std::ios_base::in);
+
+	std::string source_meta_data;
+	source_obj.getUserdata(source_meta_data);
+	StorageCodecEnv::checkNoCodec(source_meta_data, params.named_obj.src_file);
       }
 
       QDPIO::cout << "Finished opening solution file" << std::endl;
@@ -628,6 +633,10 @@ namespace Chroma
       else
       {
 	soln_obj.open(params.named_obj.soln_file, std::ios_base::in);
+
+	std::string soln_meta_data;
+	soln_obj.getUserdata(soln_meta_data);
+	StorageCodecEnv::checkNoCodec(soln_meta_data, params.named_obj.soln_file);
       }
       
       QDPIO::cout << "Finished opening solution file" << std::endl;
@@ -14,6 +14,7 @@
 #include "qdp_disk_map_slice.h"
 #include "util/ferm/key_prop_distillation.h"
 #include "util/ferm/key_timeslice_colorvec.h"
+#include "util/ferm/timeslice_codec_io.h"
 #include "util/ferm/transf.h"
 #include "util/ferm/spin_rep.h"
 #include "util/ferm/diractodr.h"
@@ -135,7 +136,7 @@ namespace Chroma
     {
       // Convenience type
       //typedef QDP::MapObjectDisk<KeyTimeSliceColorVec_t, TimeSliceIO<LatticeColorVector> > MOD_t;
-      typedef QDP::MapObjectDiskMultiple<KeyTimeSliceColorVec_t, TimeSliceIO<LatticeColorVector> > MODS_t;
+      typedef QDP::MapObjectDiskMultiple<KeyTimeSliceColorVec_t, TimeSliceCodecIO<LatticeColorVector> > MODS_t;
 
       //----------------------------------------------------------------------------
       //! Get source key
@@ -152,7 +153,7 @@ namespace Chroma
 	
       //----------------------------------------------------------------------------
       //! Read a source std::vector
-      LatticeColorVector getSrc(MODS_t& source_obj, int t_source, int colorvec_src)
+      LatticeColorVector getSrc(MODS_t& source_obj, int t_source, int colorvec_src, StorageCodec codec)
       {
 	QDPIO::cout << __func__ << ": on t_source= " << t_source << "  colorvec_src= " << colorvec_src << std::endl;
 
@@ -160,7 +161,7 @@ namespace Chroma
 	KeyTimeSliceColorVec_t src_key = getSrcKey(t_source, colorvec_src);
 	LatticeColorVector vec_srce = zero;
 
-	TimeSliceIO<LatticeColorVector> time_slice_io(vec_srce, t_source);
+	TimeSliceCodecIO<LatticeColorVector> time_slice_io(vec_srce, t_source, codec);
 	source_obj.get(src_key, time_slice_io);
 
 	return vec_srce;
@@ -548,6 +549,9 @@ namespace Chroma
       MODS_t source_obj;
       source_obj.setDebug(0);
 
+      // Storage codec of the source file
+      StorageCodec codec = STORAGE_CODEC_NONE;
+
       try
 	{
 	  QDPIO::cout << "Open source file" << std::endl;
@@ -558,6 +562,7 @@ namespace Chroma
 	  std::string eigen_meta_data;   // holds the eigenvalues
 	  QDPIO::cout << "Get user data" << std::endl;
 	  source_obj.getUserdata(eigen_meta_data);
+	  codec = StorageCodecEnv::codecFromMetaData(eigen_meta_data);
 	}    
 	  catch (std::bad_cast) {
 	    QDPIO::cerr << name << ": caught dynamic cast error" << std::endl;
@@ -686,7 +691,7 @@ namespace Chroma
 	    QDPIO::cout << "colorvec_src = " << colorvec_src << std::endl; 
 
 	    // Get the source std::vector
-	    LatticeColorVector vec_srce = getSrc(source_obj, t_source, colorvec_src);
+	    LatticeColorVector vec_srce = getSrc(source_obj, t_source, colorvec_src, codec);
 
 	    //
 	    // Loop over each spin source and invert. 
@@ -430,6 +430,7 @@ namespace Chroma
 	new_header.seqsource_header = orig_header.seqsource_header;
 	new_header.forward_props    = orig_header.forward_props;
 	new_header.gauge_header     = orig_header.gauge_header;
+	new_header.coherent_sources = orig_header.coherent_sources;
 	write(record_xml, "SequentialProp", new_header);  
       }
 
@@ -28,6 +28,10 @@ namespace Chroma
     read(inputtop, "sink_ids", input.sink_ids);
     read(inputtop, "seqprop_id", input.seqprop_id);
     read(inputtop, "gamma_insertion", input.gamma_insertion);
+
+    input.coherent_group = 0;
+    if (inputtop.count("coherent_group") != 0)
+      read(inputtop, "coherent_group", input.coherent_group);
   }
 
   //! Propagator output
@@ -40,6 +44,9 @@ namespace Chroma
     write(xml, "seqprop_id", input.seqprop_id);
     write(xml, "gamma_insertion", input.gamma_insertion);
 
+    if (input.coherent_group != 0)
+      write(xml, "coherent_group", input.coherent_group);
+
     pop(xml);
   }
 
@@ -277,6 +284,11 @@ namespace Chroma
 	// Try to invert this record XML into a SequentialSource_t struct
 	// Also pull out the id of this source
 	read(prop_record_xml, "/SequentialProp", seqprop_header);
+
+	// For a coherent seqprop only look at the group belonging to the sink_ids.
+	// The tie-back then peeks at that group's source position.
+	if (seqprop_header.coherent_sources.size() > 0)
+	  seqprop_header = coherentSeqPropGroup(seqprop_header, params.named_obj.coherent_group);
       }
       catch( std::bad_cast ) 
       {
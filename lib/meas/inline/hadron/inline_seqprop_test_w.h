@@ -39,6 +39,7 @@ namespace Chroma
 	multi1d<std::string>   sink_ids;  /*!< forward sink smeared propagators needed for 2-pt function */
 	std::string   seqprop_id;         /*!< backward propagator */
 	int           gamma_insertion;    /*!< second gamma insertion */
+	int           coherent_group;     /*!< group of a coherent seqprop that sink_ids belong to (default 0) */
       } named_obj;
 
       std::string xml_file;  /*!< Alternate XML file pattern */
@@ -42,6 +42,27 @@ namespace Chroma
   }
 
 
+  //! Coherent source group input
+  void read(XMLReader& xml, const std::string& path, InlineSeqSourceEnv::Params::CoherentSource_t& input)
+  {
+    XMLReader inputtop(xml, path);
+
+    read(inputtop, "Param", input.param);
+    read(inputtop, "prop_ids", input.prop_ids);
+  }
+
+  //! Coherent source group output
+  void write(XMLWriter& xml, const std::string& path, const InlineSeqSourceEnv::Params::CoherentSource_t& input)
+  {
+    push(xml, path);
+
+    write(xml, "Param", input.param);
+    write(xml, "prop_ids", input.prop_ids);
+
+    pop(xml);
+  }
+
+
   namespace InlineSeqSourceEnv 
   { 
     namespace
@@ -52,6 +73,104 @@ namespace Chroma
 	return new InlineMeas(Params(xml_in, path));
       }
 
+
+      //! Snarf forward props and their headers out of the named object map
+      void readForwardProps(XMLWriter& xml_out,
+			    const multi1d<std::string>& prop_ids,
+			    multi1d<LatticePropagator>& forward_props,
+			    multi1d<ForwardProp_t>& forward_headers)
+      {
+	forward_props.resize(prop_ids.size());
+	forward_headers.resize(prop_ids.size());
+
+	push(xml_out, "Forward_prop_infos");
+	for(int loop=0; loop < prop_ids.size(); ++loop)
+	{
+	  push(xml_out, "elem");
+	  try
+	  {
+	    // Snarf the data into a copy
+	    forward_props[loop] =
+	      TheNamedObjMap::Instance().getData<LatticePropagator>(prop_ids[loop]);
+	
+	    // Snarf the source info. This is will throw if the source_id is not there
+	    XMLReader prop_file_xml, prop_record_xml;
+	    TheNamedObjMap::Instance().get(prop_ids[loop]).getFileXML(prop_file_xml);
+	    TheNamedObjMap::Instance().get(prop_ids[loop]).getRecordXML(prop_record_xml);
+   
+	    // Try to invert this record XML into a ChromaProp struct
+	    {
+	      Propagator_t  header;
+	      read(prop_record_xml, "/Propagator", header);
+
+	      forward_headers[loop].prop_header   = header.prop_header;
+	      forward_headers[loop].source_header = header.source_header;
+	      forward_headers[loop].gauge_header  = header.gauge_header;
+	    }
+
+	    // Save prop input
+	    write(xml_out, "Propagator_info", prop_record_xml);
+	  }
+	  catch( std::bad_cast ) 
+	  {
+	    QDPIO::cerr << name << ": caught dynamic cast error" 
+			<< std::endl;
+	    QDP_abort(1);
+	  }
+	  catch (const std::string& e) 
+	  {
+	    QDPIO::cerr << name << ": std::map call failed: " << e 
+			<< std::endl;
+	    QDP_abort(1);
+	  }
+	  pop(xml_out);
+	}
+	pop(xml_out);
+      }
+
+
+      //! Construct the (not yet sink smeared) sequential source of one group
+      LatticePropagator makeSeqSource(const multi1d<LatticeColorMatrix>& u,
+				      const SeqSource_t& param,
+				      const PropSinkSmear_t& sink_header,
+				      QuarkSourceSink<LatticePropagator>& sinkSmearing,
+				      multi1d<ForwardProp_t>& forward_headers,
+				      multi1d<LatticePropagator>& forward_props)
+      {
+	// Do the sink smearing BEFORE the interpolating operator
+	for(int loop=0; loop < forward_props.size(); ++loop)
+	{
+	  forward_headers[loop].sink_header = sink_header;
+	  sinkSmearing(forward_props[loop]);
+	}
+    
+	//
+	// Construct the sequential source
+	//
+	QDPIO::cout << "Sequential source = " << param.seqsrc.xml << std::endl;
+
+	std::istringstream  xml_seq(param.seqsrc.xml);
+	XMLReader  seqsrctop(xml_seq);
+	QDPIO::cout << "SeqSource = " << param.seqsrc.id << std::endl;
+	
+	Handle< HadronSeqSource<LatticePropagator> >
+	  hadSeqSource(TheWilsonHadronSeqSourceFactory::Instance().createObject(param.seqsrc.id,
+										seqsrctop,
+										param.seqsrc.path));
+
+	StopWatch swatch;
+	swatch.reset();
+	swatch.start();
+	LatticePropagator quark_prop_src = (*hadSeqSource)(u, forward_headers, forward_props);
+	swatch.stop();
+    
+	QDPIO::cout << "Hadron sequential source computed: time= " 
+		    << swatch.getTimeInSeconds() 
+		    << " secs" << std::endl;
+
+	return quark_prop_src;
+      }
+
       //! Local registration flag
       bool registered = false;
     }
@@ -95,6 +214,12 @@ namespace Chroma
 
 	// Read in the forward_prop/seqsource info
 	read(paramtop, "NamedObject", named_obj);
+
+	// Optional extra groups making this a coherent sequential source
+	if (paramtop.count("CoherentSources") != 0)
+	  read(paramtop, "CoherentSources", coherent);
+	else
+	  coherent.resize(0);
       }
       catch(const std::string& e) 
       {
@@ -112,6 +237,9 @@ namespace Chroma
       write(xml_out, "Param", param);
       write(xml_out, "PropSink", sink_header);
       write(xml_out, "NamedObject", named_obj);
+
+      if (coherent.size() > 0)
+	write(xml_out, "CoherentSources", coherent);
     
       pop(xml_out);
     }
@@ -181,51 +309,9 @@ namespace Chroma
       //
       // Read the quark propagator and extract headers
       //
-      multi1d<LatticePropagator> forward_props(params.named_obj.prop_ids.size());
-      multi1d<ForwardProp_t> forward_headers(params.named_obj.prop_ids.size());
-      push(xml_out, "Forward_prop_infos");
-      for(int loop=0; loop < params.named_obj.prop_ids.size(); ++loop)
-      {
-	push(xml_out, "elem");
-	try
-	{
-	  // Snarf the data into a copy
-	  forward_props[loop] =
-	    TheNamedObjMap::Instance().getData<LatticePropagator>(params.named_obj.prop_ids[loop]);
-	
-	  // Snarf the source info. This is will throw if the source_id is not there
-	  XMLReader prop_file_xml, prop_record_xml;
-	  TheNamedObjMap::Instance().get(params.named_obj.prop_ids[loop]).getFileXML(prop_file_xml);
-	  TheNamedObjMap::Instance().get(params.named_obj.prop_ids[loop]).getRecordXML(prop_record_xml);
-   
-	  // Try to invert this record XML into a ChromaProp struct
-	  {
-	    Propagator_t  header;
-	    read(prop_record_xml, "/Propagator", header);
-
-	    forward_headers[loop].prop_header   = header.prop_header;
-	    forward_headers[loop].source_header = header.source_header;
-	    forward_headers[loop].gauge_header  = header.gauge_header;
-	  }
-
-	  // Save prop input
-	  write(xml_out, "Propagator_info", prop_record_xml);
-	}
-	catch( std::bad_cast ) 
-	{
-	  QDPIO::cerr << name << ": caught dynamic cast error" 
-		      << std::endl;
-	  QDP_abort(1);
-	}
-	catch (const std::string& e) 
-	{
-	  QDPIO::cerr << name << ": std::map call failed: " << e 
-		      << std::endl;
-	  QDP_abort(1);
-	}
-	pop(xml_out);
-      }
-      pop(xml_out);
+      multi1d<LatticePropagator> forward_props;
+      multi1d<ForwardProp_t> forward_headers;
+      readForwardProps(xml_out, params.named_obj.prop_ids, forward_props, forward_headers);
 
       QDPIO::cout << "Forward propagator successfully read and parsed" << std::endl;
 
@@ -261,6 +347,7 @@ namespace Chroma
       //------------------ Start main body of calculations -----------------------------
 
       LatticePropagator quark_prop_src;
+      multi1d<CoherentSeqSource_t> coherent_headers(params.coherent.size());
 
       try
       {
@@ -279,38 +366,77 @@ namespace Chroma
 									   params.sink_header.sink.path,
 									   u));
 
-	// Do the sink smearing BEFORE the interpolating operator
-	for(int loop=0; loop < params.named_obj.prop_ids.size(); ++loop)
-	{
-	  forward_headers[loop].sink_header = params.sink_header;
-	  (*sinkSmearing)(forward_props[loop]);
-	}
-    
-  
+	quark_prop_src = makeSeqSource(u, params.param, params.sink_header, *sinkSmearing,
+				       forward_headers, forward_props);
+
 	//
-	// Construct the sequential source
+	// Coherent sum over the extra groups. Every group has its own source
+	// position, so the cross terms with the other groups' forward props 
+	// are not gauge invariant and drop out of the 3-pt contractions.
 	//
-	QDPIO::cout << "Sequential source = " << params.param.seqsrc.xml << std::endl;
-
-	std::istringstream  xml_seq(params.param.seqsrc.xml);
-	XMLReader  seqsrctop(xml_seq);
-	QDPIO::cout << "SeqSource = " << params.param.seqsrc.id << std::endl;
-	
-	Handle< HadronSeqSource<LatticePropagator> >
-	  hadSeqSource(TheWilsonHadronSeqSourceFactory::Instance().createObject(params.param.seqsrc.id,
-										seqsrctop,
-										params.param.seqsrc.path));
-
-	swatch.reset();
-	swatch.start();
-	quark_prop_src = (*hadSeqSource)(u, forward_headers, forward_props);
+	if (params.coherent.size() > 0)
+	{
+	  QDPIO::cout << name << ": coherent sequential source with " 
+		      << params.coherent.size()+1 << " groups" << std::endl;
 
-	swatch.stop();
-    
-	QDPIO::cout << "Hadron sequential source computed: time= " 
-		    << swatch.getTimeInSeconds() 
-		    << " secs" << std::endl;
+	  multi1d< multi1d<int> > t_srces(params.coherent.size()+1);
+	  t_srces[0] = forward_headers[0].source_header.getTSrce();
 
+	  push(xml_out, "Coherent_sources");
+	  for(int grp=0; grp < params.coherent.size(); ++grp)
+	  {
+	    const Params::CoherentSource_t& coh = params.coherent[grp];
+
+	    push(xml_out, "elem");
+	    write(xml_out, "group", grp+1);
+
+	    if (coh.prop_ids.size() == 0)
+	    {
+	      QDPIO::cerr << name << ": coherent group " << grp+1 << " has no prop_ids" << std::endl;
+	      QDP_abort(1);
+	    }
+
+	    multi1d<LatticePropagator> coh_props;
+	    readForwardProps(xml_out, coh.prop_ids, coh_props, coherent_headers[grp].forward_props);
+
+	    if (coh.param.j_decay != params.param.j_decay)
+	    {
+	      QDPIO::cerr << name << ": coherent groups must share j_decay" << std::endl;
+	      QDP_abort(1);
+	    }
+
+	    if (coh.param.t_sink < 0 || coh.param.t_sink >= QDP::Layout::lattSize()[j_decay]) 
+	    {
+	      QDPIO::cerr << name << ": coherent group sink time coordinate incorrect: t_sink = " 
+			  << coh.param.t_sink << std::endl;
+	      QDP_abort(1);
+	    }
+
+	    // The mixing can only be undone if the source positions differ
+	    t_srces[grp+1] = coherent_headers[grp].forward_props[0].source_header.getTSrce();
+	    for(int g=0; g <= grp; ++g)
+	    {
+	      bool same = true;
+	      for(int mu=0; mu < t_srces[g].size(); ++mu)
+		if (t_srces[g][mu] != t_srces[grp+1][mu])
+		  same = false;
+
+	      if (same)
+	      {
+		QDPIO::cerr << name << ": coherent groups " << g << " and " << grp+1 
+			    << " have the same source position" << std::endl;
+		QDP_abort(1);
+	      }
+	    }
+
+	    coherent_headers[grp].seqsource_header = coh.param;
+	    quark_prop_src += makeSeqSource(u, coh.param, params.sink_header, *sinkSmearing,
+					    coherent_headers[grp].forward_props, coh_props);
+
+	    pop(xml_out);
+	  }
+	  pop(xml_out);
+	}
 
 	// Do the sink smearing AFTER the interpolating operator
 	(*sinkSmearing)(quark_prop_src);
@@ -354,6 +480,7 @@ namespace Chroma
 	new_header.seqsource_header = params.param;
 	new_header.forward_props    = forward_headers;
 	new_header.gauge_header     = gauge_xml.printCurrentContext();
+	new_header.coherent_sources = coherent_headers;
 
 	XMLBufferWriter record_xml;
 	write(record_xml, "SequentialSource", new_header);
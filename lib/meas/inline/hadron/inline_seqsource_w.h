@@ -34,6 +34,21 @@ namespace Chroma
       SeqSource_t        param;
       PropSinkSmear_t    sink_header;
 
+      //! Extra group summed into a coherent sequential source
+      /*! 
+       * Each group is built from forward props at its own source position
+       * and with its own t_sink. The source positions must differ from each
+       * other and from the primary group so the cross terms vanish under
+       * the gauge average.
+       */
+      struct CoherentSource_t
+      {
+	SeqSource_t            param;
+	multi1d<std::string>   prop_ids;
+      };
+
+      multi1d<CoherentSource_t>  coherent;   /*!< optional, empty for a plain seqsource */
+
       struct NamedObject_t
       {
 	std::string            gauge_id;
@@ -20,6 +20,7 @@
 #include "meas/smear/link_smearing_factory.h"
 #include "util/ferm/key_timeslice_colorvec.h"
 #include "util/ferm/disp_soln_cache.h"
+#include "util/ferm/timeslice_codec_io.h"
 #include "util/ferm/key_val_db.h"
 #include "util/info/proginfo.h"
 #include "util/ft/sftmom.h"
@@ -225,10 +226,10 @@ namespace Chroma
   { 
     //----------------------------------------------------------------------------
     // Convenience type
-    typedef QDP::MapObjectDisk<KeyTimeSliceColorVec_t, TimeSliceIO<LatticeColorVectorF> > MOD_t;
+    typedef QDP::MapObjectDisk<KeyTimeSliceColorVec_t, TimeSliceCodecIO<LatticeColorVectorF> > MOD_t;
 
     // Convenience type
-    typedef QDP::MapObjectDiskMultiple<KeyTimeSliceColorVec_t, TimeSliceIO<LatticeColorVectorF> > MODS_t;
+    typedef QDP::MapObjectDiskMultiple<KeyTimeSliceColorVec_t, TimeSliceCodecIO<LatticeColorVectorF> > MODS_t;
 
     // Convenience type
     typedef QDP::MapObjectMemory<KeyTimeSliceColorVec_t, SubLatticeColorVectorF> SUB_MOD_t;
@@ -608,6 +609,9 @@ namespace Chroma
       //! Eigenvectors
       MODS_t& eigen_source;
 
+      //! Storage codec of the color vector files
+      StorageCodec codec;
+
       //! Put it here
       int num_tries;
 
@@ -631,6 +635,10 @@ namespace Chroma
       swatch.start();
       QDPIO::cout << __func__ << ": initialize the prop cache" << std::endl;
 
+      std::string eigen_meta_data;
+      eigen_source.getUserdata(eigen_meta_data);
+      codec = StorageCodecEnv::codecFromMetaData(eigen_meta_data);
+
       // Typedefs to save typing
       typedef LatticeFermion               T;
       typedef multi1d<LatticeColorMatrix>  P;
@@ -707,7 +715,7 @@ namespace Chroma
 
       LatticeColorVectorF vec_srce = zero;
       KeyTimeSliceColorVec_t src_key(t_slice, colorvec_ind);
-      TimeSliceIO<LatticeColorVectorF> time_slice_io(vec_srce, t_slice);
+      TimeSliceCodecIO<LatticeColorVectorF> time_slice_io(vec_srce, t_slice, codec);
       eigen_source.get(src_key, time_slice_io);
 
       // Loop over each spin source
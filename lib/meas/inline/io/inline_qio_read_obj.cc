@@ -16,6 +16,7 @@
 #include "util/ferm/subset_vectors.h"
 #include "util/ferm/key_prop_colorvec.h"
 #include "handle.h"
+#include "io/storage_codec.h"
 #include "actions/ferm/invert/containers.h"
 
 namespace Chroma 
@@ -53,6 +54,39 @@ namespace Chroma
       // Anonymous namespace
       namespace
       {
+	//------------------------------------------------------------------------
+	//! Read a lattice object, decoding it if it was written through a storage codec
+	/*! The object is read as TD and stored as T */
+	template<typename T, typename TD>
+	void qioReadLatObj(const Params& params, QDP_serialparallel_t serpar)
+	{
+	  TD obj;
+	  XMLReader file_xml, record_xml;
+
+	  QDPFileReader to(file_xml,params.file.file_name,serpar);
+	  const bool encoded = StorageCodecEnv::isCodecFile(file_xml);
+	  if (encoded)
+	    StorageCodecEnv::read(to,record_xml,obj,StorageCodecEnv::codecFromFileXML(file_xml));
+	  else
+	    read(to,record_xml,obj);
+	  close(to);
+
+	  TheNamedObjMap::Instance().create<T>(params.named_obj.object_id);
+	  TheNamedObjMap::Instance().getData<T>(params.named_obj.object_id) = obj;
+	  TheNamedObjMap::Instance().get(params.named_obj.object_id).setRecordXML(record_xml);
+
+	  if (encoded)
+	  {
+	    XMLReader orig_file_xml(file_xml, StorageCodecEnv::file_xml_path);
+	    TheNamedObjMap::Instance().get(params.named_obj.object_id).setFileXML(orig_file_xml);
+	  }
+	  else
+	  {
+	    TheNamedObjMap::Instance().get(params.named_obj.object_id).setFileXML(file_xml);
+	  }
+	}
+
+
 	//------------------------------------------------------------------------
 	class QIOReadLatProp : public QIOReadObject
 	{
@@ -64,17 +98,7 @@ namespace Chroma
 
 	  //! Read a propagator
 	  void operator()(QDP_serialparallel_t serpar) {
-	    LatticePropagator obj;
-	    XMLReader file_xml, record_xml;
-
-	    QDPFileReader to(file_xml,params.file.file_name,serpar);
-	    read(to,record_xml,obj);
-	    close(to);
-
-	    TheNamedObjMap::Instance().create<LatticePropagator>(params.named_obj.object_id);
-	    TheNamedObjMap::Instance().getData<LatticePropagator>(params.named_obj.object_id) = obj;
-	    TheNamedObjMap::Instance().get(params.named_obj.object_id).setFileXML(file_xml);
-	    TheNamedObjMap::Instance().get(params.named_obj.object_id).setRecordXML(record_xml);
+	    qioReadLatObj<LatticePropagator,LatticePropagator>(params, serpar);
 	  }
 	};
 
@@ -97,17 +121,7 @@ namespace Chroma
 
 	  //! Read a propagator
 	  void operator()(QDP_serialparallel_t serpar) {
-	    LatticePropagatorF obj;
-	    XMLReader file_xml, record_xml;
-
-	    QDPFileReader to(file_xml,params.file.file_name,serpar);
-	    read(to,record_xml,obj);
-	    close(to);
-
-	    TheNamedObjMap::Instance().create<LatticePropagator>(params.named_obj.object_id);
-	    TheNamedObjMap::Instance().getData<LatticePropagator>(params.named_obj.object_id) = obj;
-	    TheNamedObjMap::Instance().get(params.named_obj.object_id).setFileXML(file_xml);
-	    TheNamedObjMap::Instance().get(params.named_obj.object_id).setRecordXML(record_xml);
+	    qioReadLatObj<LatticePropagator,LatticePropagatorF>(params, serpar);
 	  }
 	};
 
@@ -130,17 +144,7 @@ namespace Chroma
 
 	  //! Read a propagator
 	  void operator()(QDP_serialparallel_t serpar) {
-	    LatticePropagatorD obj;
-	    XMLReader file_xml, record_xml;
-
-	    QDPFileReader to(file_xml,params.file.file_name,serpar);
-	    read(to,record_xml,obj);
-	    close(to);
-
-	    TheNamedObjMap::Instance().create<LatticePropagator>(params.named_obj.object_id);
-	    TheNamedObjMap::Instance().getData<LatticePropagator>(params.named_obj.object_id) = obj;
-	    TheNamedObjMap::Instance().get(params.named_obj.object_id).setFileXML(file_xml);
-	    TheNamedObjMap::Instance().get(params.named_obj.object_id).setRecordXML(record_xml);
+	    qioReadLatObj<LatticePropagator,LatticePropagatorD>(params, serpar);
 	  }
 	};
 
@@ -402,17 +406,7 @@ namespace Chroma
 
 	  //! Read a propagator
 	  void operator()(QDP_serialparallel_t serpar) {
-	    LatticeFermion obj;
-	    XMLReader file_xml, record_xml;
-
-	    QDPFileReader to(file_xml,params.file.file_name,serpar);
-	    read(to,record_xml,obj);
-	    close(to);
-
-	    TheNamedObjMap::Instance().create<LatticeFermion>(params.named_obj.object_id);
-	    TheNamedObjMap::Instance().getData<LatticeFermion>(params.named_obj.object_id) = obj;
-	    TheNamedObjMap::Instance().get(params.named_obj.object_id).setFileXML(file_xml);
-	    TheNamedObjMap::Instance().get(params.named_obj.object_id).setRecordXML(record_xml);
+	    qioReadLatObj<LatticeFermion,LatticeFermion>(params, serpar);
 	  }
 	};
 
@@ -65,6 +65,8 @@ namespace Chroma
       write(xml, "file_name", input.file_name);
       write(xml, "file_volfmt", input.file_volfmt);
       write(xml, "parallel_io", input.parallel_io);
+      if (input.storage_codec != STORAGE_CODEC_NONE)
+	write(xml, "storage_codec", input.storage_codec);
 
       pop(xml);
     }
@@ -92,6 +94,16 @@ namespace Chroma
     	  input.parallel_io = Layout::isIOGridDefined() && (Layout::numIONodeGrid() > 1);
       }
 
+      input.storage_codec = STORAGE_CODEC_NONE;
+      if (inputtop.count("storage_codec") != 0)
+	read(inputtop, "storage_codec", input.storage_codec);
+
+      // QIO files are encoded site by site, which needs a fixed length per site
+      if (input.storage_codec == STORAGE_CODEC_SHUFFLE_LZ)
+      {
+	QDPIO::cerr << __func__ << ": storage_codec SHUFFLE_LZ is only supported for map objects" << std::endl;
+	QDP_abort(1);
+      }
     }
 
 
@@ -171,10 +183,17 @@ namespace Chroma
 
 	// Write the object
 	swatch.start();
-	QIOWriteObjCallMapEnv::TheQIOWriteObjFuncMap::Instance().callFunction(params.named_obj.object_type,
-									      params.named_obj.object_id,
-									      params.file.file_name, 
-									      params.file.file_volfmt, parallel_io_type);
+	if (params.file.storage_codec == STORAGE_CODEC_NONE)
+	  QIOWriteObjCallMapEnv::TheQIOWriteObjFuncMap::Instance().callFunction(params.named_obj.object_type,
+										params.named_obj.object_id,
+										params.file.file_name, 
+										params.file.file_volfmt, parallel_io_type);
+	else
+	  QIOWriteObjCallMapEnv::TheQIOWriteCodecObjFuncMap::Instance().callFunction(params.named_obj.object_type,
+										     params.named_obj.object_id,
+										     params.file.file_name, 
+										     params.file.file_volfmt, parallel_io_type,
+										     params.file.storage_codec);
 	swatch.stop();
 
 	QDPIO::cout << "Object successfully written: time= " 
@@ -10,6 +10,7 @@
 
 #include "chromabase.h"
 #include "meas/inline/abs_inline_measurement.h"
+#include "io/enum_io/enum_storage_codec_io.h"
 #include "io/qprop_io.h"
 
 namespace Chroma 
@@ -40,6 +41,7 @@ namespace Chroma
 	std::string   file_name;
 	QDP_volfmt_t  file_volfmt;
 	bool          parallel_io;
+	StorageCodec  storage_codec;   /*!< optional, only for lattice propagators and fermions */
       } file;
     };
 
@@ -18,6 +18,7 @@
 #include "util/ferm/subset_ev_pair.h"
 #include "util/ferm/subset_vectors.h"
 #include "util/ferm/key_timeslice_colorvec.h"
+#include "util/ferm/timeslice_codec_io.h"
 
 #include "util/gauge/key_timeslice_gauge.h"
 
@@ -45,6 +46,17 @@ namespace Chroma
       { 
 	static bool registered = false;
 
+	//! Only the color vector readers decode, so only they can have a storage codec
+	void rejectCodec(const Params& params)
+	{
+	  if (params.param.storage_codec != STORAGE_CODEC_NONE)
+	  {
+	    QDPIO::cerr << __func__ << ": storage codecs are only supported for color vectors, not for object_type= "
+			<< params.named_obj.object_type << std::endl;
+	    QDP_abort(1);
+	  }
+	}
+
 	void writeMapObjEVPairLCV(const Params& params)
 	{
 	  // Input object
@@ -63,10 +75,12 @@ namespace Chroma
 	  write(file_xml, "num_vecs", keys.size());
 	  proginfo(file_xml);    // Print out basic program info
 	  write(file_xml, "Weights", getEigenValues(input_obj, keys.size()));
+	  if (params.param.storage_codec != STORAGE_CODEC_NONE)
+	    write(file_xml, "StorageCodec", params.param.storage_codec);
 	  pop(file_xml);
 
 	  // Create the entry
-	  QDP::MapObjectDisk<KeyTimeSliceColorVec_t,TimeSliceIO<LatticeColorVector> > output_obj;
+	  QDP::MapObjectDisk<KeyTimeSliceColorVec_t,TimeSliceCodecIO<LatticeColorVector> > output_obj;
 
 	  output_obj.insertUserdata(file_xml.str());
 	  output_obj.open(params.named_obj.output_file, std::ios_base::in | std::ios_base::out | std::ios_base::trunc);
@@ -94,7 +108,7 @@ namespace Chroma
 		  time_key.t_slice = t;
 		  time_key.colorvec = keys[i];
 
-		  output_obj.insert(time_key, TimeSliceIO<LatticeColorVector>(tmpvec.eigenVector,t));
+		  output_obj.insert(time_key, TimeSliceCodecIO<LatticeColorVector>(tmpvec.eigenVector,t,params.param.storage_codec));
 		}
 	    }
 	  }
@@ -106,6 +120,8 @@ namespace Chroma
 	template<typename V>
 	void writeMapObjArrayLatColMat(const Params& params)
 	{
+	  rejectCodec(params);
+
 	  // Input object
 	  XMLBufferWriter gauge_xml;
 
@@ -155,6 +171,8 @@ namespace Chroma
 	template<typename V>
 	void writeMapObjKeyIntValLat(const Params& params)
 	{
+	  rejectCodec(params);
+
 	  // Input object
 	  XMLBufferWriter gauge_xml;
 
@@ -277,6 +295,10 @@ namespace Chroma
 
       read(inputtop, "start_t", input.start_t);
       read(inputtop, "end_t", input.end_t);
+
+      input.storage_codec = STORAGE_CODEC_NONE;
+      if (inputtop.count("storage_codec") != 0)
+	read(inputtop, "storage_codec", input.storage_codec);
     }
 
 
@@ -313,6 +335,7 @@ namespace Chroma
 	  {
 	    param.start_t = 0;
 	    param.end_t = Layout::lattSize()[Nd-1];
+	    param.storage_codec = STORAGE_CODEC_NONE;
 	  }
       }
       catch(const std::string& e) 
@@ -8,6 +8,7 @@
 
 #include "chromabase.h"
 #include "meas/inline/abs_inline_measurement.h"
+#include "io/enum_io/enum_storage_codec_io.h"
 #include "io/xml_group_reader.h"
 
 namespace Chroma 
@@ -29,6 +30,7 @@ namespace Chroma
       struct Param_t {
 	int start_t;
 	int end_t;
+	StorageCodec storage_codec;        /*!< Storage codec, only for color vectors */
       };
 
       struct NamedObject_t {
@@ -17,6 +17,7 @@
 
 #include "inline_io_aggregate.h"
 #include "default_gauge_field.h"
+#include "named_obj_lifetimes.h"
 
 #include "inline_erase_obj.h"
 #include "inline_list_obj.h"
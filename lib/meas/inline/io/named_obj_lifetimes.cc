@@ -0,0 +1,147 @@
+/*! \file
+ * \brief Lifetimes of the named objects of a chain of inline measurements
+ */
+
+#include "meas/inline/io/named_obj_lifetimes.h"
+#include "meas/inline/io/named_objmap.h"
+
+#include <map>
+
+namespace Chroma
+{
+  // Anonymous namespace
+  namespace
+  {
+    //! Elements that may hold named object ids
+    /*! Every leaf of the NamedObject group, since ids like the propA and
+     *  propB of QPROPADD do not follow a naming pattern, and the ids passed
+     *  elsewhere in the parameters, like the eigen_id of a solver */
+    const std::string id_xpath =
+      "NamedObject//*[not(*)]"
+      " | .//*[substring(name(), string-length(name()) - 2) = '_id']"
+      " | .//*[substring(name(), string-length(name()) - 3) = '_ids']/elem";
+  }
+
+
+  // Scan the measurements
+  NamedObjectLifetimes::NamedObjectLifetimes(XMLReader& xml, const std::string& path)
+  {
+    std::map<std::string,int> index;
+
+    try
+    {
+      XMLReader meas_list(xml, path);
+      num_meas = meas_list.count("elem");
+
+      for(int m=0; m < num_meas; ++m)
+      {
+	std::ostringstream elem_path;
+	elem_path << "elem[" << (m+1) << "]";
+	XMLReader meas(meas_list, elem_path.str());
+
+	int num_ids = meas.count(id_xpath);
+	for(int k=0; k < num_ids; ++k)
+	{
+	  std::ostringstream id_path;
+	  id_path << "(" << id_xpath << ")[" << (k+1) << "]";
+
+	  std::string id;
+	  read(meas, id_path.str(), id);
+
+	  if (id == "")
+	    continue;
+
+	  std::map<std::string,int>::iterator it = index.find(id);
+	  if (it == index.end())
+	  {
+	    // Objects made before the measurements are not ours to release
+	    if (TheNamedObjMap::Instance().check(id))
+	      continue;
+
+	    Lifetime_t life;
+	    life.id    = id;
+	    life.first = m;
+	    life.last  = m;
+
+	    index[id] = lifetimes.size();
+	    lifetimes.push_back(life);
+	  }
+	  else
+	  {
+	    lifetimes[it->second].last = m;
+	  }
+	}
+      }
+    }
+    catch(const std::string& e)
+    {
+      QDPIO::cerr << __func__ << ": caught exception scanning the measurements: " << e << std::endl;
+      QDP_abort(1);
+    }
+
+    last_uses.resize(num_meas);
+    for(int i=0; i < lifetimes.size(); ++i)
+      last_uses[lifetimes[i].last].push_back(lifetimes[i].id);
+  }
+
+
+  // Erase the objects whose last use is measurement m
+  void NamedObjectLifetimes::release(int m) const
+  {
+    const std::vector<std::string>& ids = last_uses[m];
+
+    for(int i=0; i < ids.size(); ++i)
+    {
+      // Ids that never became objects, or were erased by the chain itself
+      if (! TheNamedObjMap::Instance().check(ids[i]))
+	continue;
+
+      QDPIO::cout << "Releasing named object " << ids[i] << " after its last use" << std::endl;
+      TheNamedObjMap::Instance().erase(ids[i]);
+    }
+  }
+
+
+  // Peak number of live objects
+  int NamedObjectLifetimes::peakLive(bool with_release) const
+  {
+    int peak = 0;
+
+    for(int m=0; m < num_meas; ++m)
+    {
+      int live = 0;
+      for(int i=0; i < lifetimes.size(); ++i)
+	if (lifetimes[i].first <= m && (! with_release || m <= lifetimes[i].last))
+	  ++live;
+
+      peak = std::max(peak, live);
+    }
+
+    return peak;
+  }
+
+
+  // Write the lifetimes and the peaks
+  void NamedObjectLifetimes::writeReport(XMLWriter& xml, const std::string& path) const
+  {
+    push(xml, path);
+
+    write(xml, "num_measurements", num_meas);
+    write(xml, "peak_live_objects", peakLive(false));
+    write(xml, "peak_live_objects_released", peakLive(true));
+
+    push(xml, "Objects");
+    for(int i=0; i < lifetimes.size(); ++i)
+    {
+      push(xml, "elem");
+      write(xml, "id", lifetimes[i].id);
+      write(xml, "first_use", lifetimes[i].first);
+      write(xml, "last_use", lifetimes[i].last);
+      pop(xml);
+    }
+    pop(xml);
+
+    pop(xml);
+  }
+
+}
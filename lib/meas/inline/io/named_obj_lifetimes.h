@@ -0,0 +1,78 @@
+// -*- C++ -*-
+/*! \file
+ * \brief Lifetimes of the named objects of a chain of inline measurements
+ */
+
+#ifndef __named_obj_lifetimes_h__
+#define __named_obj_lifetimes_h__
+
+#include "chromabase.h"
+
+#include <string>
+#include <vector>
+
+namespace Chroma
+{
+  //! Lifetimes of the named objects of a chain of inline measurements
+  /*! \ingroup inlineio
+   *
+   * The measurements are scanned before they run. Every leaf value of the
+   * NamedObject group of a measurement, every element whose tag ends in
+   * "_id" and every elem of a tag ending in "_ids" is taken as a named
+   * object id used by that measurement. An object lives from its first to
+   * its last use, after which it can be erased from the named object map.
+   *
+   * A missed id would release an object before its last use, so the scan
+   * takes every value that may be an id. A value that is not an object id,
+   * like an object_type, never matches an object; it only shows up in the
+   * report as an object that is never made. Objects that already exist
+   * when the lifetimes are built, like the default gauge field, belong to
+   * the caller and are never released.
+   *
+   * The sizes of the objects are not known before they are made, so the
+   * dry-run report gives the peak number of live objects with and without
+   * releasing them.
+   */
+  class NamedObjectLifetimes
+  {
+  public:
+    //! Scan the measurements
+    /*!
+     * \param xml     holds the measurements ( Read )
+     * \param path    path to the list of measurements ( Read )
+     */
+    NamedObjectLifetimes(XMLReader& xml, const std::string& path);
+
+    //! Number of measurements
+    int numMeasurements() const {return num_meas;}
+
+    //! Ids of the objects whose last use is measurement m
+    const std::vector<std::string>& lastUses(int m) const {return last_uses[m];}
+
+    //! Erase the objects whose last use is measurement m
+    void release(int m) const;
+
+    //! Peak number of live objects
+    /*! \param with_release  objects are released after their last use ( Read ) */
+    int peakLive(bool with_release) const;
+
+    //! Write the lifetimes and the peaks
+    void writeReport(XMLWriter& xml, const std::string& path) const;
+
+  private:
+    //! Lifetime of one object
+    struct Lifetime_t
+    {
+      std::string  id;
+      int          first;   /*!< first measurement using it */
+      int          last;    /*!< last measurement using it */
+    };
+
+    int                                     num_meas;
+    std::vector<Lifetime_t>                 lifetimes;
+    std::vector< std::vector<std::string> > last_uses;
+  };
+
+}
+
+#endif
@@ -13,6 +13,7 @@
 #include "util/ferm/key_prop_colorvec.h"
 #include "handle.h"
 #include "qdp_map_obj_memory.h"
+#include "io/storage_codec.h"
 
 
 #include "actions/ferm/invert/containers.h"
@@ -497,6 +498,31 @@ namespace Chroma
 	close(to);
       }
 
+      //------------------------------------------------------------------------
+      //! Write a lattice object through a storage codec
+      /*! The object is stored as T, and converted to TD before it is encoded */
+      template<typename T, typename TD>
+      void QIOWriteLatCodec(const std::string& buffer_id,
+			    const std::string& file, 
+			    QDP_volfmt_t volfmt, QDP_serialparallel_t serpar,
+			    StorageCodec codec)
+      {
+	TD obj;
+	XMLBufferWriter file_xml, record_xml, codec_file_xml;
+
+	obj = TheNamedObjMap::Instance().getData<T>(buffer_id);
+	TheNamedObjMap::Instance().get(buffer_id).getFileXML(file_xml);
+	TheNamedObjMap::Instance().get(buffer_id).getRecordXML(record_xml);
+
+	// The codec goes in the file xml, around the original
+	StorageCodecEnv::writeCodecFileXML(codec_file_xml, codec, file_xml);
+    
+	QDPFileWriter to(codec_file_xml,file,volfmt,serpar,QDPIO_OPEN);
+	StorageCodecEnv::write(to,record_xml,obj,codec);
+	close(to);
+      }
+
+
       //! Local registration flag
       bool registered = false;
 
@@ -555,6 +581,15 @@ namespace Chroma
 	success &= TheQIOWriteObjFuncMap::Instance().registerFunction(std::string("MapObjMemoryKeyPropColorVecLatticeFermion"), 
 								      QIOWriteMapObjMemory<KeyPropColorVec_t,LatticeFermion>);
 
+	success &= TheQIOWriteCodecObjFuncMap::Instance().registerFunction(std::string("LatticePropagator"), 
+									   QIOWriteLatCodec<LatticePropagator,LatticePropagator>);
+	success &= TheQIOWriteCodecObjFuncMap::Instance().registerFunction(std::string("LatticePropagatorF"), 
+									   QIOWriteLatCodec<LatticePropagator,LatticePropagatorF>);
+	success &= TheQIOWriteCodecObjFuncMap::Instance().registerFunction(std::string("LatticePropagatorD"), 
+									   QIOWriteLatCodec<LatticePropagator,LatticePropagatorD>);
+	success &= TheQIOWriteCodecObjFuncMap::Instance().registerFunction(std::string("LatticeFermion"), 
+									   QIOWriteLatCodec<LatticeFermion,LatticeFermion>);
+
 	registered = true;
       }
       return success;
@@ -9,6 +9,7 @@
 #include "singleton.h"
 #include "funcmap.h"
 #include "chromabase.h"
+#include "io/enum_io/enum_storage_codec_io.h"
 
 namespace Chroma
 {
@@ -34,6 +35,23 @@ namespace Chroma
 		  StringFunctionMapError> >
     TheQIOWriteObjFuncMap;
 
+    //! Write object through a storage codec function std::map
+    /*! \ingroup inlineio */
+    typedef SingletonHolder< 
+      FunctionMap<DumbDisambiguator,
+		  void,
+		  std::string,
+		  TYPELIST_5(const std::string&,
+			     const std::string&, 
+			     QDP_volfmt_t, QDP_serialparallel_t,
+			     StorageCodec),
+		  void (*)(const std::string& buffer_id,
+			   const std::string& filename, 
+			   QDP_volfmt_t volfmt, QDP_serialparallel_t serpar,
+			   StorageCodec codec),
+		  StringFunctionMapError> >
+    TheQIOWriteCodecObjFuncMap;
+
     bool registerAll();
   }
 
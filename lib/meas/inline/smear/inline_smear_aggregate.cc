@@ -4,6 +4,7 @@
 
 #include "meas/inline/smear/inline_smear_aggregate.h"
 #include "meas/inline/smear/inline_link_smear.h"
+#include "meas/inline/smear/inline_smeared_link_cache.h"
 
 namespace Chroma
 {
@@ -24,6 +25,7 @@ namespace Chroma
       if (! registered)
       {
 	success &= InlineLinkSmearEnv::registerAll();
+	success &= InlineSmearedLinkCacheEnv::registerAll();
 	registered = true;
       }
       return success;
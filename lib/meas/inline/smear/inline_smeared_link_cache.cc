@@ -0,0 +1,130 @@
+/*! \file
+ *  \brief Inline control of the smeared link cache
+ */
+
+#include "meas/inline/smear/inline_smeared_link_cache.h"
+#include "meas/inline/abs_inline_measurement_factory.h"
+#include "util/gauge/smeared_link_cache.h"
+
+
+namespace Chroma 
+{ 
+  namespace InlineSmearedLinkCacheEnv 
+  { 
+    namespace
+    {
+      AbsInlineMeasurement* createMeasurement(XMLReader& xml_in, 
+					      const std::string& path) 
+      {
+	return new InlineMeas(Params(xml_in, path));
+      }
+
+      //! Local registration flag
+      bool registered = false;
+    }
+
+    const std::string name = "SMEARED_LINK_CACHE";
+
+    //! Register all the factories
+    bool registerAll() 
+    {
+      bool success = true; 
+      if (! registered)
+      {
+	success &= TheInlineMeasurementFactory::Instance().registerObject(name, createMeasurement);
+	registered = true;
+      }
+      return success;
+    }
+
+
+    // Param stuff
+    Params::Params()
+    { 
+      frequency  = 0; 
+      max_mbytes = 0;
+      clear      = false;
+    }
+
+    Params::Params(XMLReader& xml_in, const std::string& path) 
+    {
+      try 
+      {
+	XMLReader paramtop(xml_in, path);
+
+	if (paramtop.count("Frequency") == 1)
+	  read(paramtop, "Frequency", frequency);
+	else
+	  frequency = 1;
+      
+	read(paramtop, "Param/max_mbytes", max_mbytes);
+
+	clear = false;
+	if (paramtop.count("Param/clear") != 0)
+	  read(paramtop, "Param/clear", clear);
+      }
+      catch(const std::string& e) 
+      {
+	QDPIO::cerr << "Caught Exception reading XML: " << e << std::endl;
+	QDP_abort(1);
+      }
+    }
+
+
+    // Write params
+    void
+    Params::writeXML(XMLWriter& xml, const std::string& path) 
+    {
+      push(xml, path);
+
+      push(xml, "Param");
+      write(xml, "max_mbytes", max_mbytes);
+      if (clear)
+	write(xml, "clear", clear);
+      pop(xml);
+
+      pop(xml);
+    }
+
+
+    void 
+    InlineMeas::operator()(unsigned long update_no,
+			   XMLWriter& xml_out) 
+    {
+      START_CODE();
+
+      SmearedLinkCache& cache = TheSmearedLinkCache::Instance();
+
+      push(xml_out, "smeared_link_cache");
+      write(xml_out, "update_no", update_no);
+
+      // Report the use since the last call
+      write(xml_out, "entries", cache.size());
+      write(xml_out, "mbytes", double(cache.bytes()) / (1024.0*1024.0));
+      write(xml_out, "hits", int(cache.hits()));
+      write(xml_out, "misses", int(cache.misses()));
+
+      if (params.clear)
+	cache.clear();
+
+      if (params.max_mbytes < 0)
+      {
+	QDPIO::cerr << name << ": max_mbytes must not be negative" << std::endl;
+	QDP_abort(1);
+      }
+
+      cache.setMaxBytes(size_t(params.max_mbytes * 1024.0 * 1024.0));
+
+      QDPIO::cout << name << ": limit = " << params.max_mbytes << " MB"
+		  << "  entries = " << cache.size()
+		  << "  hits = " << cache.hits()
+		  << "  misses = " << cache.misses() << std::endl;
+
+      pop(xml_out);
+
+      END_CODE();
+    } 
+
+  }
+
+}
@@ -0,0 +1,61 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Inline control of the smeared link cache
+ */
+
+#ifndef __inline_smeared_link_cache_h__
+#define __inline_smeared_link_cache_h__
+
+#include "chromabase.h"
+#include "meas/inline/abs_inline_measurement.h"
+
+namespace Chroma 
+{ 
+  /*! \ingroup inlinesmear */
+  namespace InlineSmearedLinkCacheEnv 
+  {
+    extern const std::string name;
+    bool registerAll();
+
+    
+    //! Parameter structure
+    struct Params 
+    {
+      Params();
+      Params(XMLReader& xml_in, const std::string& path);
+      void writeXML(XMLWriter& xml_out, const std::string& path);
+
+      unsigned long frequency;
+
+      double        max_mbytes;     /*!< memory limit, 0 disables the cache */
+      bool          clear;          /*!< drop all entries */
+    };
+
+    //! Inline control of the smeared link cache
+    /*!
+     * Placed at the start of a measurement chain, lets the stout and hex
+     * fermion states and the link smearings share their smeared links
+     * for the configuration.
+     */
+    class InlineMeas : public AbsInlineMeasurement 
+    {
+    public:
+      ~InlineMeas() {}
+      InlineMeas(const Params& p) : params(p) {}
+      InlineMeas(const InlineMeas& p) : params(p.params) {}
+
+      unsigned long getFrequency(void) const {return params.frequency;}
+
+      //! Do the measurement
+      void operator()(const unsigned long update_no,
+		      XMLWriter& xml_out); 
+
+    private:
+      Params params;
+    };
+
+  }
+
+}
+
+#endif
@@ -18,5 +18,6 @@
 #include "inline_smear_aggregate.h"
 
 #include "inline_link_smear.h"
+#include "inline_smeared_link_cache.h"
 
 #endif
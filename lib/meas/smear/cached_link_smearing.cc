@@ -0,0 +1,48 @@
+/*! \file
+ *  \brief Link smearing through the smeared link cache
+ */
+
+#include "chromabase.h"
+
+#include "meas/smear/cached_link_smearing.h"
+#include "util/gauge/smeared_link_cache.h"
+
+namespace Chroma
+{
+
+  // Smear the links, or fetch them from the cache
+  void CachedLinkSmearing::operator()(multi1d<LatticeColorMatrix>& u) const
+  {
+    START_CODE();
+
+    SmearedLinkCache& cache = TheSmearedLinkCache::Instance();
+
+    if (! cache.enabled())
+    {
+      (*smear)(u);
+
+      END_CODE();
+      return;
+    }
+
+    std::string gauge_id = cache.gaugeId(u);
+
+    SmearedLinkCache::Levels_t levels;
+    if (cache.lookup(levels, gauge_id, key))
+    {
+      QDPIO::cout << "Smeared links found in cache" << std::endl;
+      u = levels[0];
+    }
+    else
+    {
+      (*smear)(u);
+
+      levels.resize(1);
+      levels[0] = u;
+      cache.insert(gauge_id, key, levels);
+    }
+
+    END_CODE();
+  }
+
+}
@@ -0,0 +1,49 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Link smearing through the smeared link cache
+ */
+
+#ifndef __cached_link_smearing_h__
+#define __cached_link_smearing_h__
+
+#include "meas/smear/link_smearing.h"
+
+namespace Chroma
+{
+
+  //! Link smearing through the smeared link cache
+  /*! @ingroup smear
+   *
+   * Wraps a link smearing so that the smeared field of a given gauge field
+   * is only computed once per configuration while the smeared link cache
+   * is enabled. The key identifies the smearing and its parameters.
+   */
+  class CachedLinkSmearing : public LinkSmearing
+  {
+  public:
+    //! Full constructor
+    CachedLinkSmearing(Handle<LinkSmearing> smear_, const std::string& key_) :
+      smear(smear_), key(key_) {}
+
+    //! Smear the links, or fetch them from the cache
+    void operator()(multi1d<LatticeColorMatrix>& u) const;
+
+  private:
+    Handle<LinkSmearing>  smear;
+    std::string           key;
+  };
+
+
+  //! Cache key of a link smearing from its parameters
+  /*! @ingroup smear */
+  template<typename P>
+  std::string linkSmearingKey(const std::string& name, const P& params)
+  {
+    XMLBufferWriter xml;
+    params.writeXML(xml, "LinkSmearing");
+    return name + ":" + xml.str();
+  }
+
+}
+
+#endif
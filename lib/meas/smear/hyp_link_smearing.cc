@@ -5,6 +5,7 @@
 #include "chromabase.h"
 
 #include "meas/smear/link_smearing_factory.h"
+#include "meas/smear/cached_link_smearing.h"
 #include "meas/smear/hyp_link_smearing.h"
 #include "meas/smear/hyp_smear.h"
 #include "meas/smear/hyp_smear3d.h"
@@ -31,18 +32,19 @@ namespace Chroma
   {
     namespace
     {
+      //! Name to be used
+      const std::string name = "HYP_SMEAR";
+
       //! Callback function
       LinkSmearing* createSource(XMLReader& xml_in,
 				 const std::string& path)
       {
-	return new LinkSmear(Params(xml_in, path));
+	Params params(xml_in, path);
+	return new CachedLinkSmearing(new LinkSmear(params), linkSmearingKey(name, params));
       }
 
       //! Local registration flag
       bool registered = false;
-
-      //! Name to be used
-      const std::string name = "HYP_SMEAR";
     }
 
     //! Return the name
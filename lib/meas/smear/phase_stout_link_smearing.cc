@@ -5,6 +5,7 @@
 #include "chromabase.h"
 
 #include "meas/smear/link_smearing_factory.h"
+#include "meas/smear/cached_link_smearing.h"
 #include "meas/smear/phase_stout_link_smearing.h"
 
 namespace Chroma
@@ -29,18 +30,19 @@ namespace Chroma
   {
     namespace
     {
+      //! Name to be used
+      const std::string name = "PHASE_STOUT_SMEAR";
+
       //! Callback function
       LinkSmearing* createSource(XMLReader& xml_in,
 				 const std::string& path)
       {
-	return new LinkSmear(Params(xml_in, path));
+	Params params(xml_in, path);
+	return new CachedLinkSmearing(new LinkSmear(params), linkSmearingKey(name, params));
       }
 
       //! Local registration flag
       bool registered = false;
-
-      //! Name to be used
-      const std::string name = "PHASE_STOUT_SMEAR";
     }
 
     //! Return the name
@@ -0,0 +1,172 @@
+/*! \file
+ *  \brief Volume source of Z(N) noise from a counter based generator
+ */
+
+#include "meas/sources/counter_zN_src.h"
+
+#include <vector>
+#include <cmath>
+#include <stdint.h>
+
+namespace Chroma
+{
+  // Default key
+  ZNNoiseKey_t::ZNNoiseKey_t() : seed(0), config(0), noise_id(0), dilution(0)
+  {
+  }
+
+
+  // Reader
+  void read(XMLReader& xml, const std::string& path, ZNNoiseKey_t& param)
+  {
+    XMLReader paramtop(xml, path);
+
+    read(paramtop, "seed", param.seed);
+    read(paramtop, "config", param.config);
+    read(paramtop, "noise_id", param.noise_id);
+
+    param.dilution = 0;
+    if (paramtop.count("dilution") != 0)
+      read(paramtop, "dilution", param.dilution);
+  }
+
+
+  // Writer
+  void write(XMLWriter& xml, const std::string& path, const ZNNoiseKey_t& param)
+  {
+    push(xml, path);
+
+    write(xml, "seed", param.seed);
+    write(xml, "config", param.config);
+    write(xml, "noise_id", param.noise_id);
+    if (param.dilution != 0)
+      write(xml, "dilution", param.dilution);
+
+    pop(xml);
+  }
+
+
+  // Are two keys the same
+  bool operator==(const ZNNoiseKey_t& a, const ZNNoiseKey_t& b)
+  {
+    return (a.seed == b.seed) && (a.config == b.config)
+      && (a.noise_id == b.noise_id) && (a.dilution == b.dilution);
+  }
+
+
+  // Philox4x32-10 block cipher
+  void philox4x32(unsigned int ctr[4], const unsigned int key[2])
+  {
+    const uint32_t M0 = 0xD2511F53;
+    const uint32_t M1 = 0xCD9E8D57;
+    const uint32_t W0 = 0x9E3779B9;
+    const uint32_t W1 = 0xBB67AE85;
+
+    uint32_t c0 = ctr[0], c1 = ctr[1], c2 = ctr[2], c3 = ctr[3];
+    uint32_t k0 = key[0], k1 = key[1];
+
+    for(int r=0; r < 10; ++r)
+    {
+      uint64_t p0 = uint64_t(M0) * c0;
+      uint64_t p1 = uint64_t(M1) * c2;
+
+      uint32_t n0 = uint32_t(p1 >> 32) ^ c1 ^ k0;
+      uint32_t n2 = uint32_t(p0 >> 32) ^ c3 ^ k1;
+
+      c0 = n0;
+      c1 = uint32_t(p1);
+      c2 = n2;
+      c3 = uint32_t(p0);
+
+      k0 += W0;
+      k1 += W1;
+    }
+
+    ctr[0] = c0; ctr[1] = c1; ctr[2] = c2; ctr[3] = c3;
+  }
+
+
+  // Anonymous namespace
+  namespace
+  {
+#ifndef QDP_IS_QDPJIT
+    //! Arguments for the noise site loop
+    struct ZNNoiseArgs
+    {
+      LatticeFermion&        a;
+      const ZNNoiseKey_t&    key;
+      const std::vector<REAL>&  re;     /*!< cos of the N phases */
+      const std::vector<REAL>&  im;     /*!< sin of the N phases */
+    };
+
+    //! Fill a range of sites
+    inline
+    void zNNoiseSiteLoop(int lo, int hi, int myId, ZNNoiseArgs* arg)
+    {
+      const multi1d<int>& latt_size = Layout::lattSize();
+      const uint64_t N = arg->re.size();
+      const unsigned int key[2] = {(unsigned int)arg->key.seed, (unsigned int)arg->key.config};
+
+      for(int site=lo; site < hi; ++site)
+      {
+	// Lexicographic global site, x fastest
+	multi1d<int> coord = Layout::siteCoords(Layout::nodeNumber(), site);
+	unsigned int gsite = 0;
+	for(int mu=Nd-1; mu >= 0; --mu)
+	  gsite = gsite*latt_size[mu] + coord[mu];
+
+	unsigned int rnd[4];
+	for(int k=0; k < Ns*Nc; ++k)
+	{
+	  if (k % 4 == 0)
+	  {
+	    rnd[0] = gsite;
+	    rnd[1] = arg->key.noise_id;
+	    rnd[2] = arg->key.dilution;
+	    rnd[3] = k / 4;
+	    philox4x32(rnd, key);
+	  }
+
+	  // floor(N*r) with r uniform in [0,1)
+	  const int n = int((N * uint64_t(rnd[k % 4])) >> 32);
+
+	  arg->a.elem(site).elem(k / Nc).elem(k % Nc).real() = arg->re[n];
+	  arg->a.elem(site).elem(k / Nc).elem(k % Nc).imag() = arg->im[n];
+	}
+      }
+    }
+#endif
+  }
+
+
+  // Z(N)-source from a counter based generator
+  void zN_src(LatticeFermion& a, int N, const ZNNoiseKey_t& key)
+  {
+    START_CODE();
+
+    if (N <= 0)
+    {
+      QDPIO::cerr << __func__ << ": invalid N= " << N << std::endl;
+      QDP_abort(1);
+    }
+
+#ifndef QDP_IS_QDPJIT
+    std::vector<REAL> re(N), im(N);
+    for(int n=0; n < N; ++n)
+    {
+      double theta = 6.283185307179586476925286 * n / N;
+      re[n] = std::cos(theta);
+      im[n] = std::sin(theta);
+    }
+
+    ZNNoiseArgs args = {a, key, re, im};
+    dispatch_to_threads(Layout::sitesOnNode(), args, zNNoiseSiteLoop);
+#else
+    QDPIO::cerr << __func__ << ": counter based noise needs site access, not available with QDP-JIT" << std::endl;
+    QDP_abort(1);
+#endif
+
+    END_CODE();
+  }
+
+}  // end namespace Chroma
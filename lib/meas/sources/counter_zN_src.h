@@ -0,0 +1,67 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Volume source of Z(N) noise from a counter based generator
+ */
+
+#ifndef __counter_zN_src_h__
+#define __counter_zN_src_h__
+
+#include "chromabase.h"
+
+namespace Chroma
+{
+  //! Key of a counter based noise vector
+  /*! @ingroup sources
+   *
+   * Together with the global site and the spin and color component the key
+   * is the counter of the generator, so the noise does not depend on the
+   * layout, the number of threads or what was drawn before.
+   */
+  struct ZNNoiseKey_t
+  {
+    ZNNoiseKey_t();
+
+    int   seed;           /*!< Seed of the whole calculation */
+    int   config;         /*!< Configuration number */
+    int   noise_id;       /*!< Noise vector number */
+    int   dilution;       /*!< Dilution component, 0 if they share the noise */
+  };
+
+  //! Reader
+  /*! @ingroup sources */
+  void read(XMLReader& xml, const std::string& path, ZNNoiseKey_t& param);
+
+  //! Writer
+  /*! @ingroup sources */
+  void write(XMLWriter& xml, const std::string& path, const ZNNoiseKey_t& param);
+
+  //! Are two keys the same
+  /*! @ingroup sources */
+  bool operator==(const ZNNoiseKey_t& a, const ZNNoiseKey_t& b);
+
+
+  //! Philox4x32-10 block cipher
+  /*! @ingroup sources
+   *
+   * \param ctr   counter, replaced by the 4 random words ( Modify )
+   * \param key   key ( Read )
+   */
+  void philox4x32(unsigned int ctr[4], const unsigned int key[2]);
+
+  //! Z(N)-source from a counter based generator
+  /*! @ingroup sources
+   *
+   * Unlike the zN_src using the global generator, the sites are filled
+   * in a threaded loop and the same key gives the same source on any
+   * layout, so a source can be made again when it is needed instead of
+   * being kept.
+   *
+   * \param a      Source fermion ( Write )
+   * \param N      The N in Z(N) ( Read )
+   * \param key    Key of the noise ( Read )
+   */
+  void zN_src(LatticeFermion& a, int N, const ZNNoiseKey_t& key);
+
+}  // end namespace Chroma
+
+#endif
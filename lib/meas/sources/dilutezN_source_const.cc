@@ -82,6 +82,8 @@ namespace Chroma
     Params::Params()
     {
       smear = false ;
+      counter_rng = false;
+      ran_seed = zero;
       j_decay = -1;
       t_source = -1;
     }
@@ -114,7 +116,18 @@ namespace Chroma
 	smear = true ;
       }
 
-      read(paramtop, "ran_seed", ran_seed);
+      // The counter based generator replaces the global one
+      counter_rng = false;
+      ran_seed = zero;
+      if (paramtop.count("NoiseKey") != 0)
+      {
+	counter_rng = true;
+	read(paramtop, "NoiseKey", noise_key);
+      }
+
+      if (! counter_rng || paramtop.count("ran_seed") != 0)
+	read(paramtop, "ran_seed", ran_seed);
+
       read(paramtop, "N", N);
       read(paramtop, "j_decay", j_decay);
       read(paramtop, "t_source", t_source);
@@ -141,6 +154,8 @@ namespace Chroma
 
       write(xml, "version", version);
       write(xml, "ran_seed", ran_seed);
+      if (counter_rng)
+	write(xml, "NoiseKey", noise_key);
       write(xml, "N", N);
       write(xml, "j_decay", j_decay);
       write(xml, "t_source", t_source);
@@ -218,16 +233,9 @@ namespace Chroma
       // Finally, do something useful
       //
 
-      // Save current seed
-      Seed ran_seed;
-      QDP::RNG::savern(ran_seed);
-
-      // Set the seed to desired value
-      QDP::RNG::setrn(params.ran_seed);
-
       // Create the noisy quark source on the entire lattice
       LatticeFermion quark_noise;
-      zN_src(quark_noise, params.N);
+      makeNoise(quark_noise, params);
 
       // This is the filtered noise source to return
       LatticeFermion quark_source = zero;
@@ -338,11 +346,43 @@ namespace Chroma
 	}
       }// if(smear) ends here
       
-      
+      return quark_source;
+    }
+
+
+    // Create the undiluted noise on the entire lattice
+    void makeNoise(LatticeFermion& quark_noise, const Params& params)
+    {
+      if (params.counter_rng)
+      {
+	zN_src(quark_noise, params.N, params.noise_key);
+	return;
+      }
+
+      // Save current seed
+      Seed ran_seed;
+      QDP::RNG::savern(ran_seed);
+
+      // Set the seed to desired value
+      QDP::RNG::setrn(params.ran_seed);
+
+      zN_src(quark_noise, params.N);
+
       // Reset the seed
       QDP::RNG::setrn(ran_seed);
+    }
 
-      return quark_source;
+
+    // Do two sources dilute the same noise
+    bool sameNoise(const Params& a, const Params& b)
+    {
+      if (a.counter_rng != b.counter_rng)
+	return false;
+
+      if (a.counter_rng)
+	return a.noise_key == b.noise_key;
+      else
+	return toBool(a.ran_seed == b.ran_seed);
     }
 
   } // end namespace
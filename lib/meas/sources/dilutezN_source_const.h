@@ -10,6 +10,7 @@
 
 #include "meas/sources/source_construction.h"
 #include "io/xml_group_reader.h"
+#include "meas/sources/counter_zN_src.h"
 
 namespace Chroma
 {
@@ -38,6 +39,8 @@ namespace Chroma
       bool smear ; // a flag that tells me to smear or not to smear
 
       Seed                     ran_seed;             /*!< Set the seed to this value */
+      bool                     counter_rng;          /*!< Use the counter based generator */
+      ZNNoiseKey_t             noise_key;            /*!< Key of the counter based noise */
       int                      N;                    /*!< Z(N) */
       
       multi1d<int>             spatial_mask_size;    /*!< Spatial size of periodic mask */
@@ -73,6 +76,15 @@ namespace Chroma
       Params  params;   /*!< source params */
     };
 
+
+    //! Create the undiluted noise on the entire lattice
+    /*! @ingroup sources */
+    void makeNoise(LatticeFermion& quark_noise, const Params& params);
+
+    //! Do two sources dilute the same noise
+    /*! @ingroup sources */
+    bool sameNoise(const Params& a, const Params& b);
+
   }  // end namespace DiluteZNQuarkSourceConstEnv
 
 
@@ -19,6 +19,7 @@
 #include "z2_src.h"
 #include "srcfil.h"
 #include "zN_src.h"
+#include "counter_zN_src.h"
 
 #include "source_construction.h"
 #include "source_const_factory.h"
@@ -0,0 +1,308 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Memory based std::map object that spills to disk
+ */
+
+#ifndef __map_obj_tiered_h__
+#define __map_obj_tiered_h__
+
+#include "chromabase.h"
+#include "handle.h"
+#include "qdp_map_obj.h"
+#include "qdp_map_obj_disk.h"
+#include "util/ferm/subset_ev_pair.h"
+
+#include <map>
+#include <list>
+#include <vector>
+#include <string>
+#include <cstdio>
+
+namespace Chroma
+{
+
+  //! Memory held by a lattice value
+  /*! @ingroup ferm */
+  template<typename T>
+  inline size_t mapObjTieredBytes(const OLattice<T>& val)
+  {
+    return sizeof(T) * Layout::sitesOnNode();
+  }
+
+  //! Memory held by an eigenpair
+  /*! @ingroup ferm */
+  template<typename T>
+  inline size_t mapObjTieredBytes(const EVPair<T>& val)
+  {
+    return mapObjTieredBytes(val.eigenVector)
+      + val.eigenValue.weights.size() * sizeof(Real);
+  }
+
+
+  //! Memory based std::map object that spills to disk
+  /*! @ingroup ferm
+   *
+   * Entries are held in memory up to a byte budget. Beyond that the least
+   * recently used entries are moved to a scratch MapObjectDisk, and are
+   * brought back into memory when accessed. Entries that are unchanged
+   * since they were last written keep their disk copy, so dropping them
+   * from memory again costs nothing. Once no entry has a disk copy left,
+   * after erase() or clear(), and on destruction the scratch file is
+   * closed and removed.
+   *
+   * All nodes must make the same sequence of calls, as for MapObjectDisk.
+   */
+  template<typename K, typename V>
+  class MapObjectTiered : public QDP::MapObject<K,V>
+  {
+  public:
+    //! Constructor
+    /*!
+     * \param file_name_   scratch file for the spilled entries ( Read )
+     * \param max_bytes_   memory budget for the entries on this node ( Read )
+     */
+    MapObjectTiered(const std::string& file_name_, size_t max_bytes_) :
+      file_name(file_name_), max_bytes(max_bytes_), cur_bytes(0), disk_entries(0), disk_file(false) {}
+
+    //! Destructor removes the scratch file
+    ~MapObjectTiered()
+    {
+      closeDisk();
+    }
+
+    //! Check if a key exists
+    bool exist(const K& key) const
+    {
+      return index.find(key) != index.end();
+    }
+
+    //! Insert a pair of data and key into the object
+    int insert(const K& key, const V& val)
+    {
+      typename std::map<K,Entry_t>::iterator e = index.find(key);
+
+      if (e == index.end())
+      {
+	Entry_t entry;
+	entry.bytes     = mapObjTieredBytes(val);
+	entry.in_memory = false;
+	entry.on_disk   = false;
+	e = index.insert(std::make_pair(key, entry)).first;
+      }
+
+      // Any disk copy is now stale
+      dropDiskCopy(e);
+      store(e, val);
+
+      return 0;
+    }
+
+    //! Insert user data into the metadata database
+    int insertUserdata(const std::string& user_data_)
+    {
+      user_data = user_data_;
+      return 0;
+    }
+
+    //! Get data for a given key
+    int get(const K& key, V& val) const
+    {
+      typename std::map<K,Entry_t>::iterator e = index.find(key);
+
+      if (e == index.end())
+      {
+	QDPIO::cerr << "MapObjectTiered: key not found" << std::endl;
+	QDP_abort(1);
+      }
+
+      if (e->second.in_memory)
+      {
+	val = mem[key];
+	touch(e);
+      }
+      else
+      {
+	// Fetch the entry back; it still has its disk copy
+	disk->get(key, val);
+	store(e, val);
+      }
+
+      return 0;
+    }
+
+    //! Get the user data from the metadata database
+    int getUserdata(std::string& user_data_) const
+    {
+      user_data_ = user_data;
+      return 0;
+    }
+
+    //! Erase a key-value
+    int erase(const K& key)
+    {
+      typename std::map<K,Entry_t>::iterator e = index.find(key);
+      if (e == index.end())
+	return 0;
+
+      if (e->second.in_memory)
+      {
+	mem.erase(key);
+	lru.erase(e->second.lru_pos);
+	cur_bytes -= e->second.bytes;
+      }
+
+      dropDiskCopy(e);
+      index.erase(e);
+      return 0;
+    }
+
+    //! Clear the object
+    void clear()
+    {
+      mem.clear();
+      lru.clear();
+      index.clear();
+      cur_bytes = 0;
+      closeDisk();
+    }
+
+    //! Commit
+    void flush()
+    {
+      if (disk_entries > 0)
+	disk->flush();
+    }
+
+    //! Size of Map
+    unsigned int size() const
+    {
+      return static_cast<unsigned long>(index.size());
+    }
+
+    //! Dump keys
+    std::vector<K> keys() const
+    {
+      std::vector<K> ks;
+      for(typename std::map<K,Entry_t>::const_iterator e = index.begin(); e != index.end(); ++e)
+	ks.push_back(e->first);
+      return ks;
+    }
+
+    //! Bytes of the entries held in memory
+    size_t memoryBytes() const {return cur_bytes;}
+
+  private:
+    //! Where an entry lives
+    struct Entry_t
+    {
+      size_t   bytes;
+      bool     in_memory;
+      bool     on_disk;        /*!< the disk copy is up to date */
+      typename std::list<K>::iterator  lru_pos;
+    };
+
+    //! Move an entry to the most recently used end
+    void touch(typename std::map<K,Entry_t>::iterator e) const
+    {
+      lru.splice(lru.end(), lru, e->second.lru_pos);
+    }
+
+    //! Hold a value in memory, making room first
+    void store(typename std::map<K,Entry_t>::iterator e, const V& val) const
+    {
+      if (e->second.in_memory)
+      {
+	mem[e->first] = val;
+	touch(e);
+	return;
+      }
+
+      makeRoom(e->second.bytes);
+
+      mem[e->first] = val;
+      e->second.in_memory = true;
+      e->second.lru_pos = lru.insert(lru.end(), e->first);
+      cur_bytes += e->second.bytes;
+    }
+
+    //! Spill least recently used entries until nbytes more fit
+    void makeRoom(size_t nbytes) const
+    {
+      while (! lru.empty() && cur_bytes + nbytes > max_bytes)
+      {
+	const K key = lru.front();
+	typename std::map<K,Entry_t>::iterator e = index.find(key);
+
+	if (! e->second.on_disk)
+	{
+	  openDisk();
+	  disk->insert(key, mem[key]);
+	  e->second.on_disk = true;
+	  ++disk_entries;
+	}
+
+	mem.erase(key);
+	lru.pop_front();
+	e->second.in_memory = false;
+	cur_bytes -= e->second.bytes;
+      }
+    }
+
+    //! Open the scratch file on the first spill
+    void openDisk() const
+    {
+      if (disk_entries > 0)
+	return;
+
+      QDPIO::cout << "MapObjectTiered: spilling to " << file_name << std::endl;
+
+      disk = new QDP::MapObjectDisk<K,V>();
+      disk->insertUserdata(user_data);
+      disk->open(file_name, std::ios_base::in | std::ios_base::out | std::ios_base::trunc);
+      disk_file = true;
+    }
+
+    //! Forget the disk copy of an entry, closing the scratch file with the last one
+    void dropDiskCopy(typename std::map<K,Entry_t>::iterator e) const
+    {
+      if (! e->second.on_disk)
+	return;
+
+      e->second.on_disk = false;
+      if (--disk_entries == 0)
+	closeDisk();
+    }
+
+    //! Close and remove the scratch file, none of its records are reachable
+    void closeDisk() const
+    {
+      disk = Handle< QDP::MapObjectDisk<K,V> >();
+      disk_entries = 0;
+
+      if (disk_file)
+      {
+	// The file is written by the primary node only
+	if (Layout::primaryNode())
+	  std::remove(file_name.c_str());
+
+	disk_file = false;
+      }
+    }
+
+    std::string  file_name;
+    size_t       max_bytes;
+    std::string  user_data;
+
+    // The cache is updated on reads, so these change in const calls
+    mutable std::map<K,V>                      mem;
+    mutable std::map<K,Entry_t>                index;
+    mutable std::list<K>                       lru;      /*!< memory entries, oldest first */
+    mutable size_t                             cur_bytes;
+    mutable Handle< QDP::MapObjectDisk<K,V> >  disk;     /*!< open while disk_entries > 0 */
+    mutable size_t                             disk_entries;
+    mutable bool                               disk_file;    /*!< the scratch file exists */
+  };
+
+} // namespace Chroma
+
+#endif
@@ -0,0 +1,105 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Memory based std::map object that spills to disk, factory registration
+ */
+
+#include "chromabase.h"
+#include "util/ferm/map_obj/map_obj_tiered.h"
+#include "util/ferm/map_obj/map_obj_factory_w.h"
+#include "util/ferm/map_obj/map_obj_tiered_w.h"
+#include "util/ferm/key_prop_colorvec.h"
+#include <string>
+
+namespace Chroma 
+{ 
+  
+  namespace MapObjectTieredEnv 
+  {
+
+    namespace
+    {
+      // Parameter structure
+      struct Params
+      {
+	Params() {}
+	Params(XMLReader& xml_in, const std::string& path);
+
+	std::string   file_name;      /*!< scratch file for spilled entries */
+	double        max_mbytes;     /*!< memory budget per node */
+      };
+
+      // Reader for input parameters
+      Params::Params(XMLReader& xml, const std::string& path)
+      {
+	XMLReader paramtop(xml, path);
+
+	read(paramtop, "FileName", file_name);
+	read(paramtop, "MaxMBytes", max_mbytes);
+
+	if (max_mbytes < 0)
+	{
+	  QDPIO::cerr << __func__ << ": MaxMBytes must not be negative" << std::endl;
+	  QDP_abort(1);
+	}
+      }
+
+      //! Budget in bytes
+      size_t maxBytes(const Params& params)
+      {
+	return size_t(params.max_mbytes * 1024.0 * 1024.0);
+      }
+
+
+      //! Callback function
+      QDP::MapObject<int,EVPair<LatticeColorVector> >* createMapObjIntKeyCV(XMLReader& xml_in,
+									    const std::string& path,
+									    const std::string& user_data) 
+      {
+	// Needs parameters...
+	Params params(xml_in, path);
+	
+	auto obj = new MapObjectTiered<int,EVPair<LatticeColorVector> >(params.file_name, maxBytes(params));
+	obj->insertUserdata(user_data);
+
+	return obj;
+      }
+
+      //! Callback function
+      QDP::MapObject<KeyPropColorVec_t,LatticeFermion>* createMapObjKeyPropColorVecLF(XMLReader& xml_in,
+										      const std::string& path,
+										      const std::string& user_data) 
+      {
+	// Needs parameters...
+	Params params(xml_in, path);
+
+	auto obj = new MapObjectTiered<KeyPropColorVec_t,LatticeFermion>(params.file_name, maxBytes(params));
+	obj->insertUserdata(user_data);
+
+	return obj;
+      }
+
+      //! Local registration flag
+      bool registered = false;
+
+      //! Name to be used
+      const std::string name = "MAP_OBJECT_TIERED";
+    } // namespace anonymous
+
+    std::string getName() {return name;}
+
+    //! Register all the factories
+    bool registerAll() 
+    {
+      bool success = true; 
+      if (! registered)
+      {
+	success &= Chroma::TheMapObjIntKeyColorEigenVecFactory::Instance().registerObject(name, createMapObjIntKeyCV);
+	success &= Chroma::TheMapObjKeyPropColorVecFactory::Instance().registerObject(name, createMapObjKeyPropColorVecLF);
+	registered = true;
+      }
+      return success;
+    }
+  } // Namespace MapObjectTieredEnv
+
+
+} // Chroma
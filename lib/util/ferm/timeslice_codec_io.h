@@ -0,0 +1,90 @@
+// -*- C++ -*-
+/*! \file
+ * \brief Time slice IO of lattice objects through a storage codec
+ */
+
+#ifndef __timeslice_codec_io_h__
+#define __timeslice_codec_io_h__
+
+#include "chromabase.h"
+#include "qdp_disk_map_slice.h"
+#include "io/storage_codec.h"
+
+namespace Chroma
+{
+  //! Time slice IO of a lattice object through a storage codec
+  /*! \ingroup ferm
+   *
+   * Stands in for TimeSliceIO as the value of a map object. With the codec
+   * NONE the records are exactly those of TimeSliceIO, so the files can be
+   * read either way. Otherwise every record is the encoded stream of the
+   * TimeSliceIO record. The codec is not in the records, it is kept in the
+   * user data of the map object.
+   */
+  template<typename T>
+  class TimeSliceCodecIO
+  {
+  public:
+    //! Constructor
+    /*!
+     * \param lat_      lattice object ( Modify )
+     * \param t_slice_  time slice ( Read )
+     * \param codec_    storage codec of the records ( Read )
+     */
+    TimeSliceCodecIO(T& lat_, int t_slice_, StorageCodec codec_ = STORAGE_CODEC_NONE) :
+      io(lat_, t_slice_), codec(codec_) {}
+
+    //! The time slice reader and writer
+    TimeSliceIO<T>& getIO() {return io;}
+    const TimeSliceIO<T>& getIO() const {return io;}
+
+    //! The codec
+    StorageCodec getCodec() const {return codec;}
+
+  private:
+    TimeSliceIO<T>  io;
+    StorageCodec    codec;
+  };
+
+
+  //! Write a time slice
+  /*! \ingroup ferm */
+  template<typename T>
+  void write(BinaryWriter& bin, const TimeSliceCodecIO<T>& s)
+  {
+    if (s.getCodec() == STORAGE_CODEC_NONE)
+    {
+      write(bin, s.getIO());
+      return;
+    }
+
+    BinaryBufferWriter raw;
+    write(raw, s.getIO());
+
+    const int nsites = Layout::vol() / Layout::lattSize()[Nd-1];
+    StorageCodecEnv::writeEncoded(bin, StorageCodecEnv::encode(raw.str(), s.getCodec(),
+							       sizeof(typename WordType<T>::Type_t), nsites));
+  }
+
+
+  //! Read a time slice
+  /*! \ingroup ferm */
+  template<typename T>
+  void read(BinaryReader& bin, TimeSliceCodecIO<T>& s)
+  {
+    if (s.getCodec() == STORAGE_CODEC_NONE)
+    {
+      read(bin, s.getIO());
+      return;
+    }
+
+    std::string enc;
+    StorageCodecEnv::readEncoded(bin, enc);
+
+    BinaryBufferReader raw(StorageCodecEnv::decode(enc, sizeof(typename WordType<T>::Type_t)));
+    read(raw, s.getIO());
+  }
+
+}
+
+#endif
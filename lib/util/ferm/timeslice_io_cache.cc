@@ -6,12 +6,189 @@
 
 #include "util/ferm/timeslice_io_cache.h"
 
-namespace Chroma 
-{  
+namespace Chroma
+{
   //----------------------------------------------------------------------------
   // Constructor
-  TimeSliceIOCache::TimeSliceIOCache(QDP::MapObjectDisk< KeyTimeSliceColorVec_t,TimeSliceIO<LatticeColorVector> >& eigen_source_)
-    : eigen_source(eigen_source_)
+  TimeSliceReadAhead::TimeSliceReadAhead(const Fetch_t& fetch_, int num_buffers_)
+    : fetch(fetch_), num_buffers(num_buffers_), time_slices(Nd-1),
+      next_read(0), in_flight(false), quit(false)
+  {
+    if (! available() || num_buffers <= 0)
+      return;
+
+    // The buffers are allocated here, the I/O thread only fills them
+    buffers.resize(num_buffers);
+    for(int b=0; b < num_buffers; ++b)
+      free_bufs.push_back(b);
+
+    io_thread = std::thread(&TimeSliceReadAhead::ioLoop, this);
+  }
+
+
+  // Stops the I/O thread
+  TimeSliceReadAhead::~TimeSliceReadAhead()
+  {
+    if (io_thread.joinable())
+    {
+      {
+	std::lock_guard<std::mutex> lk(mtx);
+	quit = true;
+      }
+      cv.notify_all();
+      io_thread.join();
+    }
+  }
+
+
+  // Can vectors be read on a background thread
+  bool TimeSliceReadAhead::available()
+  {
+    return Layout::numNodes() == 1;
+  }
+
+
+  // Declare the order of the upcoming reads
+  void TimeSliceReadAhead::start(const std::vector<KeyTimeSliceColorVec_t>& order_)
+  {
+    if (! io_thread.joinable())
+      return;
+
+    {
+      std::lock_guard<std::mutex> lk(mtx);
+
+      order.clear();
+      for(int i=0; i < order_.size(); ++i)
+      {
+	Index_t idx(order_[i].t_slice, order_[i].colorvec);
+
+	// Skip what is already read or being read
+	if (ready.find(idx) != ready.end() || (in_flight && in_flight_idx == idx))
+	  continue;
+
+	order.push_back(idx);
+      }
+      next_read = 0;
+    }
+
+    cv.notify_all();
+  }
+
+
+  // Body of the I/O thread
+  void TimeSliceReadAhead::ioLoop()
+  {
+    std::unique_lock<std::mutex> lk(mtx);
+
+    while (true)
+    {
+      cv.wait(lk, [this]{ return quit || (next_read < order.size() && ! free_bufs.empty()); });
+
+      if (quit)
+	break;
+
+      // Entries read directly in the meantime are marked with -1
+      Index_t idx = order[next_read++];
+      if (idx.first < 0 || ready.find(idx) != ready.end())
+	continue;
+
+      int b = free_bufs.back();
+      free_bufs.pop_back();
+
+      in_flight     = true;
+      in_flight_idx = idx;
+      lk.unlock();
+
+      {
+	std::lock_guard<std::mutex> disk_lk(disk_mtx);
+	fetch(KeyTimeSliceColorVec_t(idx.first, idx.second), buffers[b]);
+      }
+
+      lk.lock();
+      in_flight = false;
+      ready[idx] = b;
+
+      cv.notify_all();
+    }
+  }
+
+
+  // Read the time slice of key into vec
+  void TimeSliceReadAhead::get(const KeyTimeSliceColorVec_t& key, LatticeColorVector& vec)
+  {
+    if (io_thread.joinable())
+    {
+      Index_t idx(key.t_slice, key.colorvec);
+      std::unique_lock<std::mutex> lk(mtx);
+
+      // Wait if it is being read right now
+      cv.wait(lk, [this,&idx]{ return ! (in_flight && in_flight_idx == idx); });
+
+      std::map<Index_t,int>::iterator r = ready.find(idx);
+      if (r != ready.end())
+      {
+	int b = r->second;
+	ready.erase(r);
+	lk.unlock();
+
+	vec[time_slices.getSet()[key.t_slice]] = buffers[b];
+
+	lk.lock();
+	free_bufs.push_back(b);
+	lk.unlock();
+	cv.notify_all();
+	return;
+      }
+
+      // Not read ahead: do not read it again later
+      for(size_t i=next_read; i < order.size(); ++i)
+	if (order[i] == idx)
+	  order[i] = Index_t(-1,-1);
+    }
+
+    // Direct read
+    std::lock_guard<std::mutex> disk_lk(disk_mtx);
+    fetch(key, vec);
+  }
+
+
+  //----------------------------------------------------------------------------
+  // Constructor
+  TimeSliceIOCache::TimeSliceIOCache(QDP::MapObjectDisk< KeyTimeSliceColorVec_t,TimeSliceCodecIO<LatticeColorVector> >& eigen_source_)
+  {
+    std::string eigen_meta_data;
+    eigen_source_.getUserdata(eigen_meta_data);
+    const StorageCodec codec = StorageCodecEnv::codecFromMetaData(eigen_meta_data);
+
+    fetch = [&eigen_source_,codec](const KeyTimeSliceColorVec_t& key, LatticeColorVector& vec) {
+      TimeSliceCodecIO<LatticeColorVector> time_slice_io(vec, key.t_slice, codec);
+      eigen_source_.get(key, time_slice_io);
+    };
+    exist = [&eigen_source_](const KeyTimeSliceColorVec_t& key) {return eigen_source_.exist(key);};
+
+    init();
+  }
+
+
+  // Constructor from a set of files
+  TimeSliceIOCache::TimeSliceIOCache(QDP::MapObjectDiskMultiple< KeyTimeSliceColorVec_t,TimeSliceCodecIO<LatticeColorVector> >& eigen_source_)
+  {
+    std::string eigen_meta_data;
+    eigen_source_.getUserdata(eigen_meta_data);
+    const StorageCodec codec = StorageCodecEnv::codecFromMetaData(eigen_meta_data);
+
+    fetch = [&eigen_source_,codec](const KeyTimeSliceColorVec_t& key, LatticeColorVector& vec) {
+      TimeSliceCodecIO<LatticeColorVector> time_slice_io(vec, key.t_slice, codec);
+      eigen_source_.get(key, time_slice_io);
+    };
+    exist = [&eigen_source_](const KeyTimeSliceColorVec_t& key) {return eigen_source_.exist(key);};
+
+    init();
+  }
+
+
+  // Find the number of vectors and size the cache
+  void TimeSliceIOCache::init()
   {
     const int Lt = Layout::lattSize()[Nd-1];
 
@@ -24,7 +201,7 @@ namespace Chroma
       key.t_slice  = 0;
       key.colorvec = num_vecs;
 
-      if (! eigen_source.exist(key)) {break;}
+      if (! exist(key)) {break;}
 
       ++num_vecs;
     }
@@ -45,13 +222,32 @@ namespace Chroma
     for(int n=0; n < num_vecs; ++n)
     {
       eigen_cache[n] = zero;
-      
+
       for(int t=0; t < Lt; ++t)
 	cache_marker(t,n) = false;
     }
   }
 
 
+  // Read ahead the vectors of these time slices
+  void TimeSliceIOCache::readAhead(const std::vector<int>& t_slices, int num_buffers)
+  {
+    if (! TimeSliceReadAhead::available())
+      return;
+
+    if (read_ahead.operator->() == 0)
+      read_ahead = new TimeSliceReadAhead(fetch, num_buffers);
+
+    std::vector<KeyTimeSliceColorVec_t> order;
+    for(int i=0; i < t_slices.size(); ++i)
+      for(int n=0; n < num_vecs; ++n)
+	if (! cache_marker(t_slices[i],n))
+	  order.push_back(KeyTimeSliceColorVec_t(t_slices[i], n));
+
+    read_ahead->start(order);
+  }
+
+
   // Get a std::vector
   LatticeColorVector& TimeSliceIOCache::getVec(int colorvec)
   {
@@ -68,9 +264,11 @@ namespace Chroma
       key_vec.t_slice  = t_actual;
       key_vec.colorvec = colorvec;
 
-      TimeSliceIO<LatticeColorVector> time_slice_io(eigen_cache[colorvec], t_actual);
+      if (read_ahead.operator->() != 0)
+	read_ahead->get(key_vec, eigen_cache[colorvec]);
+      else
+	fetch(key_vec, eigen_cache[colorvec]);
 
-      eigen_source.get(key_vec, time_slice_io);
       cache_marker(t_actual,colorvec) = true;
     }
 
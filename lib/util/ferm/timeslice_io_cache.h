@@ -10,19 +10,98 @@
 
 #include "chromabase.h"
 #include "qdp_map_obj_disk.h"
+#include "qdp_map_obj_disk_multiple.h"
 #include "util/ferm/key_timeslice_colorvec.h"
+#include "util/ferm/timeslice_codec_io.h"
+#include "util/ft/time_slice_set.h"
 
-namespace Chroma 
-{ 
+#include <vector>
+#include <map>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+namespace Chroma
+{
   /*! \ingroup inlinehadron */
   //----------------------------------------------------------------------------
+  //----------------------------------------------------------------------------
+  //! Background reader of time slice eigenvectors
+  /*!
+   * The caller declares the order in which it will ask for the time slice
+   * vectors. An I/O thread then reads them in that order into a bounded
+   * set of buffers, so the disk reads overlap with the computation.
+   * Vectors asked for out of order are read directly.
+   *
+   * The map object readers communicate between the nodes, which is only
+   * safe from one thread, so reading ahead is only done on a single node.
+   * Otherwise every read is direct.
+   */
+  class TimeSliceReadAhead
+  {
+  public:
+    //! Read the time slice of a key into a vector
+    typedef std::function<void(const KeyTimeSliceColorVec_t&, LatticeColorVector&)> Fetch_t;
+
+    //! Constructor
+    /*!
+     * \param fetch_          direct read ( Read )
+     * \param num_buffers_    number of vectors held ahead ( Read )
+     */
+    TimeSliceReadAhead(const Fetch_t& fetch_, int num_buffers_);
+
+    //! Stops the I/O thread
+    ~TimeSliceReadAhead();
+
+    //! Can vectors be read on a background thread
+    static bool available();
+
+    //! Declare the order of the upcoming reads
+    /*! Replaces the previous order; vectors already read ahead are kept */
+    void start(const std::vector<KeyTimeSliceColorVec_t>& order_);
+
+    //! Read the time slice of key into vec
+    void get(const KeyTimeSliceColorVec_t& key, LatticeColorVector& vec);
+
+  private:
+    //! Body of the I/O thread
+    void ioLoop();
+
+    //! (t_slice, colorvec)
+    typedef std::pair<int,int>  Index_t;
+
+    Fetch_t                      fetch;
+    int                          num_buffers;
+    multi1d<LatticeColorVector>  buffers;
+    TimeSliceSet                 time_slices;
+
+    std::vector<Index_t>         order;        /*!< declared reads */
+    size_t                       next_read;    /*!< next entry of order to read */
+    std::map<Index_t,int>        ready;        /*!< vectors read ahead and their buffers */
+    std::vector<int>             free_bufs;
+    bool                         in_flight;    /*!< the I/O thread is reading */
+    Index_t                      in_flight_idx;
+    bool                         quit;
+
+    std::thread              io_thread;
+    std::mutex               mtx;          /*!< guards the state above */
+    std::condition_variable  cv;
+    std::mutex               disk_mtx;     /*!< one reader of the file at a time */
+  };
+
+
   //----------------------------------------------------------------------------
   //! Cache for holding time slice eigenvectors
+  /*! The storage codec of the vectors is taken from the user data of the source */
   class TimeSliceIOCache
   {
   public:
     //! Constructor
-    TimeSliceIOCache(QDP::MapObjectDisk<KeyTimeSliceColorVec_t,LatticeColorVector>& eigen_source_);
+    TimeSliceIOCache(QDP::MapObjectDisk<KeyTimeSliceColorVec_t,TimeSliceCodecIO<LatticeColorVector> >& eigen_source_);
+
+    //! Constructor from a set of files
+    TimeSliceIOCache(QDP::MapObjectDiskMultiple<KeyTimeSliceColorVec_t,TimeSliceCodecIO<LatticeColorVector> >& eigen_source_);
 
     //! Virtual destructor
     virtual ~TimeSliceIOCache() {}
@@ -36,14 +115,26 @@ namespace Chroma
     //! Get a std::vector
     virtual LatticeColorVector& getVec(int t_actual, int colorvec);
 
+    //! Read ahead the vectors of these time slices, time slice by time slice
+    /*!
+     * \param t_slices      time slices in the order they will be used ( Read )
+     * \param num_buffers   number of vectors held ahead ( Read )
+     */
+    virtual void readAhead(const std::vector<int>& t_slices, int num_buffers);
+
   private:
+    //! Find the number of vectors and size the cache
+    void init();
+
     // Arguments
-    QDP::MapObjectDisk< KeyTimeSliceColorVec_t,TimeSliceIO<LatticeColorVector> >& eigen_source;
+    TimeSliceReadAhead::Fetch_t                               fetch;
+    std::function<bool(const KeyTimeSliceColorVec_t&)>        exist;
 
     // Local
     multi1d<LatticeColorVector>  eigen_cache;
     multi2d<bool>                cache_marker;
     int                          num_vecs;
+    Handle<TimeSliceReadAhead>   read_ahead;
   };
 
 }
@@ -572,6 +572,103 @@ namespace Chroma
     return hsum ;
   }
 
+  // Anonymous namespace
+  namespace
+  {
+#ifndef QDP_IS_QDPJIT
+    //! Arguments for the batched projection site loop
+    struct SftBatchArgs
+    {
+      const multi1d<LatticeComplex>& cf;
+      const multi1d<LatticeComplex>& phases;
+      const multi1d<int>&            coloring;
+      int                            length;
+      multi1d< multi1d<REAL64> >&    partial;   /*!< one accumulator per thread */
+    };
+
+    //! Site loop for the batched projection
+    inline
+    void sftBatchSiteLoop(int lo, int hi, int myId, SftBatchArgs* a)
+    {
+      const int num_cf  = a->cf.size();
+      const int num_mom = a->phases.size();
+      const int length  = a->length;
+      REAL64* acc = a->partial[myId].slice();
+
+      for(int site=lo; site < hi; ++site)
+      {
+	const int t = a->coloring[site];
+
+	for(int mom_num=0; mom_num < num_mom; ++mom_num)
+	{
+	  const RComplex<REAL>& ph = a->phases[mom_num].elem(site).elem().elem();
+	  REAL64 ph_re = ph.real();
+	  REAL64 ph_im = ph.imag();
+
+	  for(int n=0; n < num_cf; ++n)
+	  {
+	    const RComplex<REAL>& c = a->cf[n].elem(site).elem().elem();
+	    int idx = 2*((n*num_mom + mom_num)*length + t);
+
+	    acc[idx]   += ph_re*c.real() - ph_im*c.imag();
+	    acc[idx+1] += ph_re*c.imag() + ph_im*c.real();
+	  }
+	}
+      }
+    }
+#endif
+  }
+
+
+  multi3d<DComplex>
+  SftMom::sft(const multi1d<LatticeComplex>& cf) const
+  {
+    int length = sft_set.numSubsets();
+    multi3d<DComplex> hsum(cf.size(), num_mom, length);
+
+#ifndef QDP_IS_QDPJIT
+    const int nelem = 2*cf.size()*num_mom*length;
+
+    multi1d< multi1d<REAL64> > partial(qdpNumThreads());
+    for(int i=0; i < partial.size(); ++i)
+    {
+      partial[i].resize(nelem);
+      partial[i] = 0;
+    }
+
+    SftBatchArgs args = {cf, phases, sft_set.latticeColoring(), length, partial};
+    dispatch_to_threads(Layout::sitesOnNode(), args, sftBatchSiteLoop);
+
+    // Collapse the threads and then the nodes
+    multi1d<REAL64> tot(nelem);
+    tot = 0;
+    for(int i=0; i < partial.size(); ++i)
+      for(int j=0; j < nelem; ++j)
+	tot[j] += partial[i][j];
+
+    QDPInternal::globalSumArray(tot.slice(), nelem);
+
+    for(int n=0; n < cf.size(); ++n)
+      for(int mom_num=0; mom_num < num_mom; ++mom_num)
+	for(int t=0; t < length; ++t)
+	{
+	  int idx = 2*((n*num_mom + mom_num)*length + t);
+	  hsum[n][mom_num][t] = cmplx(Double(tot[idx]), Double(tot[idx+1]));
+	}
+#else
+    for(int n=0; n < cf.size(); ++n)
+      for (int mom_num=0; mom_num < num_mom; ++mom_num)
+      {
+	multi1d<DComplex> h = sumMulti(phases[mom_num]*cf[n], sft_set);
+	for(int t=0; t < length; ++t)
+	  hsum[n][mom_num][t] = h[t];
+      }
+#endif
+
+    return hsum ;
+  }
+
+
 #if BASE_PRECISION==32
   multi2d<DComplex>
   SftMom::sft(const LatticeComplexD& cf) const
@@ -106,6 +106,15 @@ namespace Chroma
     //! Do a sumMulti(cf*phases,getSet()[my_subset])
     multi2d<DComplex> sft(const LatticeReal& cf, int subset_color) const;
 
+    //! Batched sumMulti(cf[n]*phases,getSet()) for all n
+    /*! 
+     * All correlators and momenta are projected in one sweep over the
+     * lattice with a single global reduction.
+     *
+     * \return  hsum[n][mom_num][t]
+     */
+    multi3d<DComplex> sft(const multi1d<LatticeComplex>& cf) const;
+
 #if BASE_PRECISION==32
     multi2d<DComplex> sft(const LatticeComplexD& cf) const;
     //! Do a sum(cf*phases,getSet()[my_subset])
@@ -6,8 +6,13 @@
 #include "util/gauge/gauge_init_aggregate.h"
 
 #include "util/gauge/nersc_gauge_init.h"
+#include "meas/glue/mesplq.h"
 #include "qdp_iogauge.h"
 
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+
 namespace Chroma
 {
 
@@ -28,6 +33,81 @@ namespace Chroma
   //! Hooks to register the class
   namespace NERSCGaugeInitEnv
   {
+    namespace
+    {
+      //! Header value of a NERSC file, read on the primary node
+      bool headerValue(const std::string& cfg_file, const std::string& key, double& val)
+      {
+	int found = 0;
+	val = 0;
+
+	if (Layout::primaryNode())
+	{
+	  std::ifstream in(cfg_file.c_str());
+	  std::string line;
+
+	  while (std::getline(in, line) && line.find("END_HEADER") == std::string::npos)
+	  {
+	    std::string::size_type eq = line.find('=');
+	    if (eq == std::string::npos)
+	      continue;
+
+	    std::istringstream k(line.substr(0, eq));
+	    std::string name;
+	    k >> name;
+
+	    if (name == key)
+	    {
+	      std::istringstream v(line.substr(eq+1));
+	      if (v >> val)
+		found = 1;
+	      break;
+	    }
+	  }
+	}
+
+	QDPInternal::broadcast(found);
+	QDPInternal::broadcast(val);
+
+	return found != 0;
+      }
+
+
+      //! Compare the plaquette and link trace with the file header
+      void checkHeader(const multi1d<LatticeColorMatrix>& u, const std::string& cfg_file)
+      {
+	Double w_plaq, s_plaq, t_plaq, link;
+	MesPlq(u, w_plaq, s_plaq, t_plaq, link);
+
+	const double tol = 1.0e-5;
+	double val;
+
+	if (headerValue(cfg_file, "PLAQUETTE", val))
+	{
+	  QDPIO::cout << name << ": header plaquette = " << val 
+		      << "  computed = " << w_plaq << std::endl;
+
+	  if (fabs(toDouble(w_plaq) - val) > tol*fabs(val))
+	  {
+	    QDPIO::cerr << name << ": plaquette does not match the header of " << cfg_file << std::endl;
+	    QDP_abort(1);
+	  }
+	}
+
+	if (headerValue(cfg_file, "LINK_TRACE", val))
+	{
+	  QDPIO::cout << name << ": header link trace = " << val 
+		      << "  computed = " << link << std::endl;
+
+	  if (fabs(toDouble(link) - val) > tol*std::max(fabs(val), 1.0e-2))
+	  {
+	    QDPIO::cerr << name << ": link trace does not match the header of " << cfg_file << std::endl;
+	    QDP_abort(1);
+	  }
+	}
+      }
+    }
+
     //! Callback function
     GaugeInit* createSource(XMLReader& xml_in,
 			    const std::string& path)
@@ -84,6 +164,9 @@ namespace Chroma
     {
       u.resize(Nd);
       readArchiv(gauge_xml, u, params.cfg_file);
+
+      // Verify the gauge invariant checks of the header
+      checkHeader(u, params.cfg_file);
     }
   }
 }
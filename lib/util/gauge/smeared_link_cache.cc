@@ -0,0 +1,219 @@
+/*! \file
+ *  \brief Cache of smeared gauge fields shared across measurements
+ */
+
+#include "util/gauge/smeared_link_cache.h"
+
+#include <cstring>
+#include <sstream>
+#include <iomanip>
+
+namespace Chroma
+{
+
+  // Anonymous namespace
+  namespace
+  {
+#ifndef QDP_IS_QDPJIT
+    //! Arguments for the fingerprint site loop
+    struct GaugeHashArgs
+    {
+      const multi1d<LatticeColorMatrix>&  u;
+      multi1d<unsigned long long>&        partial;   /*!< one hash per thread */
+    };
+
+    //! FNV style hash of the links of a range of sites
+    inline
+    void gaugeHashSiteLoop(int lo, int hi, int myId, GaugeHashArgs* a)
+    {
+      const int nreal = 2*Nc*Nc;
+      unsigned long long h = 14695981039346656037ULL;
+
+      for(int mu=0; mu < a->u.size(); ++mu)
+      {
+	for(int site=lo; site < hi; ++site)
+	{
+	  const REAL* p = &(a->u[mu].elem(site).elem().elem(0,0).real());
+
+	  for(int i=0; i < nreal; ++i)
+	  {
+	    unsigned long long w = 0;
+	    std::memcpy(&w, p+i, sizeof(REAL));
+	    h = (h ^ w) * 1099511628211ULL;
+	  }
+	}
+      }
+
+      a->partial[myId] = h;
+    }
+#endif
+  }
+
+
+  // Empty and disabled
+  SmearedLinkCache::SmearedLinkCache() :
+    max_bytes(0), cur_bytes(0), clock(0), num_hits(0), num_misses(0)
+  {
+  }
+
+
+  // Set the memory limit
+  void SmearedLinkCache::setMaxBytes(size_t max_bytes_)
+  {
+    max_bytes = max_bytes_;
+
+    if (max_bytes == 0)
+      clear();
+    else
+      makeRoom(0);
+  }
+
+
+  // Fingerprint of a gauge field
+  std::string SmearedLinkCache::gaugeId(const multi1d<LatticeColorMatrix>& u) const
+  {
+    START_CODE();
+
+    std::ostringstream id;
+
+#ifndef QDP_IS_QDPJIT
+    multi1d<unsigned long long> partial(qdpNumThreads());
+    partial = 0;
+
+    GaugeHashArgs args = {u, partial};
+    dispatch_to_threads(Layout::sitesOnNode(), args, gaugeHashSiteLoop);
+
+    // Combine the threads in order, then the nodes by summing the two halves
+    unsigned long long h = 14695981039346656037ULL;
+    for(int i=0; i < partial.size(); ++i)
+      h = (h ^ partial[i]) * 1099511628211ULL;
+
+    multi1d<REAL64> halves(2);
+    halves[0] = REAL64(h >> 32);
+    halves[1] = REAL64(h & 0xffffffffULL);
+    QDPInternal::globalSumArray(halves.slice(), halves.size());
+
+    id << std::hex << (unsigned long long)(halves[0]) << "-" << (unsigned long long)(halves[1]);
+#else
+    // Position weighted sums of the traces
+    LatticeReal w = zero;
+    for(int mu=0; mu < Nd; ++mu)
+      w = w * Real(Layout::lattSize()[mu]) + LatticeReal(Layout::latticeCoordinate(mu));
+
+    id << std::setprecision(17);
+    for(int mu=0; mu < u.size(); ++mu)
+    {
+      LatticeComplex tr = trace(u[mu]);
+      id << toDouble(sum(real(tr))) << ":" << toDouble(sum(imag(tr)))
+	 << ":" << toDouble(sum(w*real(tr))) << ":" << toDouble(sum(w*imag(tr))) << "/";
+    }
+#endif
+
+    END_CODE();
+
+    return id.str();
+  }
+
+
+  // Is a gauge field an input or output of some entry
+  bool SmearedLinkCache::known(const std::string& gauge_id) const
+  {
+    for(std::map<std::string, Entry_t>::const_iterator p = entries.begin(); p != entries.end(); ++p)
+      if (p->second.gauge_id == gauge_id || p->second.out_id == gauge_id)
+	return true;
+
+    return false;
+  }
+
+
+  // Find the levels stored for a gauge field and smearing
+  bool SmearedLinkCache::lookup(Levels_t& levels, const std::string& gauge_id, const std::string& key)
+  {
+    if (! enabled())
+      return false;
+
+    // A new gauge field means a new configuration
+    if (! known(gauge_id))
+      clear();
+
+    std::map<std::string, Entry_t>::iterator p = entries.find(gauge_id + "|" + key);
+    if (p == entries.end())
+    {
+      ++num_misses;
+      return false;
+    }
+
+    ++num_hits;
+    p->second.last_use = ++clock;
+    levels = p->second.levels;
+
+    return true;
+  }
+
+
+  // Store the levels for a gauge field and smearing
+  void SmearedLinkCache::insert(const std::string& gauge_id, const std::string& key, const Levels_t& levels)
+  {
+    if (! enabled() || levels.size() == 0)
+      return;
+
+    START_CODE();
+
+    const std::string k = gauge_id + "|" + key;
+
+    std::map<std::string, Entry_t>::iterator p = entries.find(k);
+    if (p != entries.end())
+    {
+      cur_bytes -= p->second.bytes;
+      entries.erase(p);
+    }
+
+    size_t nbytes = 0;
+    for(int i=0; i < levels.size(); ++i)
+      nbytes += levels[i].size() * Layout::sitesOnNode() * sizeof(REAL) * 2 * Nc * Nc;
+
+    if (nbytes > max_bytes)
+    {
+      END_CODE();
+      return;
+    }
+
+    makeRoom(nbytes);
+
+    Entry_t& e = entries[k];
+    e.gauge_id = gauge_id;
+    e.out_id   = gaugeId(levels[levels.size()-1]);
+    e.levels   = levels;
+    e.bytes    = nbytes;
+    e.last_use = ++clock;
+
+    cur_bytes += nbytes;
+
+    END_CODE();
+  }
+
+
+  // Drop least recently used entries until nbytes more fit
+  void SmearedLinkCache::makeRoom(size_t nbytes)
+  {
+    while (! entries.empty() && cur_bytes + nbytes > max_bytes)
+    {
+      std::map<std::string, Entry_t>::iterator oldest = entries.begin();
+      for(std::map<std::string, Entry_t>::iterator p = entries.begin(); p != entries.end(); ++p)
+	if (p->second.last_use < oldest->second.last_use)
+	  oldest = p;
+
+      cur_bytes -= oldest->second.bytes;
+      entries.erase(oldest);
+    }
+  }
+
+
+  // Drop all entries
+  void SmearedLinkCache::clear()
+  {
+    entries.clear();
+    cur_bytes = 0;
+  }
+
+}  // end namespace Chroma
@@ -0,0 +1,114 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Cache of smeared gauge fields shared across measurements
+ */
+
+#ifndef __smeared_link_cache_h__
+#define __smeared_link_cache_h__
+
+#include "chromabase.h"
+#include "singleton.h"
+
+#include <map>
+
+namespace Chroma
+{
+
+  //! Cache of smeared gauge fields
+  /*! \ingroup gauge
+   *
+   * Holds the smeared links computed by the fermion states and the link
+   * smearing objects, keyed by a fingerprint of the input gauge field and
+   * a string describing the smearing (usually the XML of its parameters).
+   * An entry holds a sequence of smearing levels, so a chain of iterated
+   * smearings can be extended from the deepest level already computed.
+   *
+   * The cache is disabled until a memory limit is set. When it is full the
+   * least recently used entries are dropped. A lookup with a gauge field
+   * that is neither the input nor the output of any entry is taken as a
+   * change of configuration and empties the cache.
+   */
+  class SmearedLinkCache
+  {
+  public:
+    //! Smearing levels of one entry
+    typedef multi1d< multi1d<LatticeColorMatrix> > Levels_t;
+
+    //! Empty and disabled
+    SmearedLinkCache();
+
+    //! Set the memory limit in bytes. Zero disables the cache.
+    void setMaxBytes(size_t max_bytes_);
+
+    //! Memory limit in bytes
+    size_t maxBytes() const {return max_bytes;}
+
+    //! Is the cache in use
+    bool enabled() const {return max_bytes > 0;}
+
+    //! Bytes held by the entries
+    size_t bytes() const {return cur_bytes;}
+
+    //! Number of entries
+    int size() const {return entries.size();}
+
+    //! Number of hits and misses so far
+    unsigned long hits() const {return num_hits;}
+    unsigned long misses() const {return num_misses;}
+
+    //! Fingerprint of a gauge field
+    /*! Identical on all nodes. Only meaningful within one run. */
+    std::string gaugeId(const multi1d<LatticeColorMatrix>& u) const;
+
+    //! Find the levels stored for a gauge field and smearing
+    /*!
+     * \param levels      the stored levels, first is the first smearing ( Write )
+     * \param gauge_id    fingerprint of the unsmeared gauge field ( Read )
+     * \param key         description of the smearing ( Read )
+     *
+     * \return true if an entry was found
+     */
+    bool lookup(Levels_t& levels, const std::string& gauge_id, const std::string& key);
+
+    //! Store the levels for a gauge field and smearing
+    /*! Replaces an existing entry. Nothing is stored if it exceeds the limit. */
+    void insert(const std::string& gauge_id, const std::string& key, const Levels_t& levels);
+
+    //! Drop all entries
+    void clear();
+
+  private:
+    struct Entry_t
+    {
+      std::string    gauge_id;    /*!< input gauge field */
+      std::string    out_id;      /*!< deepest smeared level */
+      Levels_t       levels;
+      size_t         bytes;
+      unsigned long  last_use;
+    };
+
+    //! Is a gauge field an input or output of some entry
+    bool known(const std::string& gauge_id) const;
+
+    //! Drop least recently used entries until nbytes more fit
+    void makeRoom(size_t nbytes);
+
+    std::map<std::string, Entry_t>  entries;
+    size_t         max_bytes;
+    size_t         cur_bytes;
+    unsigned long  clock;
+    unsigned long  num_hits;
+    unsigned long  num_misses;
+  };
+
+
+  //! Singleton smeared link cache
+  /*! \ingroup gauge */
+  typedef SingletonHolder<SmearedLinkCache,
+			  QDP::CreateUsingNew,
+			  QDP::NoDestroy,
+			  QDP::SingleThreaded> TheSmearedLinkCache;
+
+}  // end namespace Chroma
+
+#endif
@@ -17,6 +17,7 @@
 
 #include "proginfo.h"
 #include "printgeom.h"
+#include "profiler.h"
 
 #endif
 
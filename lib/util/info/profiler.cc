@@ -0,0 +1,279 @@
+/*! \file
+ * \brief Hierarchical named-region profiler
+ */
+
+#include "util/info/profiler.h"
+
+#include <chrono>
+#include <cstdio>
+#include <unistd.h>
+#include <sys/resource.h>
+
+namespace Chroma
+{
+  // Anonymous namespace
+  namespace
+  {
+    //! Seconds on a monotonic clock
+    double wallSecs()
+    {
+      return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    //! Current resident set size in MB, or zero if not known
+    double residentMB()
+    {
+      double mb = 0;
+#ifdef __linux__
+      FILE* f = fopen("/proc/self/statm", "r");
+      if (f)
+      {
+	long size, resident;
+	if (fscanf(f, "%ld %ld", &size, &resident) == 2)
+	  mb = double(resident) * double(sysconf(_SC_PAGESIZE)) / (1024.0*1024.0);
+	fclose(f);
+      }
+#endif
+      return mb;
+    }
+
+    //! High-water mark of the resident set in MB
+    double highWaterMB()
+    {
+      struct rusage ru;
+      if (getrusage(RUSAGE_SELF, &ru) != 0)
+	return 0;
+
+#ifdef __APPLE__
+      return double(ru.ru_maxrss) / (1024.0*1024.0);   // bytes
+#else
+      return double(ru.ru_maxrss) / 1024.0;            // kilobytes
+#endif
+    }
+
+    //! Number of quantities reduced over the nodes per region
+    const int num_across = 3;
+  }
+
+
+  // Constructor
+  Profiler::Profiler() : current(0), on(false)
+  {
+    Region_t root;
+    root.name          = "total";
+    root.parent        = -1;
+    root.memory        = true;
+    root.calls         = 1;
+    root.incl_secs     = 0;
+    root.child_secs    = 0;
+    root.peak_rss_mb   = 0;
+    root.hwm_growth_mb = 0;
+    root.start_secs    = 0;
+    root.start_hwm_mb  = 0;
+
+    regions.push_back(root);
+  }
+
+
+  // Start recording on this thread
+  void Profiler::enable()
+  {
+    if (on)
+      return;
+
+    on      = true;
+    owner   = std::this_thread::get_id();
+    current = 0;
+
+    regions[0].start_secs   = wallSecs();
+    regions[0].start_hwm_mb = highWaterMB();
+    regions[0].peak_rss_mb  = residentMB();
+  }
+
+
+  // Open a region
+  bool Profiler::begin(const std::string& name, Sampling sampling)
+  {
+    if (! on || std::this_thread::get_id() != owner)
+      return false;
+
+    // Find the child of that name, the lists are short
+    std::vector<int>& children = regions[current].children;
+    int r = -1;
+    for(int i=0; i < children.size(); ++i)
+    {
+      if (regions[children[i]].name == name)
+      {
+	r = children[i];
+	break;
+      }
+    }
+
+    if (r < 0)
+    {
+      Region_t reg;
+      reg.name          = name;
+      reg.parent        = current;
+      reg.memory        = (sampling == TIME_AND_MEMORY);
+      reg.calls         = 0;
+      reg.incl_secs     = 0;
+      reg.child_secs    = 0;
+      reg.peak_rss_mb   = 0;
+      reg.hwm_growth_mb = 0;
+
+      r = regions.size();
+      regions.push_back(reg);
+      regions[current].children.push_back(r);
+    }
+
+    Region_t& reg = regions[r];
+    if (reg.memory)
+    {
+      reg.start_hwm_mb = highWaterMB();
+      reg.peak_rss_mb  = std::max(reg.peak_rss_mb, residentMB());
+    }
+    reg.start_secs = wallSecs();
+
+    current = r;
+    return true;
+  }
+
+
+  // Close the innermost open region
+  void Profiler::end()
+  {
+    if (current == 0)
+    {
+      QDPIO::cerr << "Profiler: region closed more often than opened" << std::endl;
+      QDP_abort(1);
+    }
+
+    Region_t& reg = regions[current];
+    const double secs = wallSecs() - reg.start_secs;
+
+    reg.calls     += 1;
+    reg.incl_secs += secs;
+    if (reg.memory)
+    {
+      reg.peak_rss_mb   = std::max(reg.peak_rss_mb, residentMB());
+      reg.hwm_growth_mb = std::max(reg.hwm_growth_mb, highWaterMB() - reg.start_hwm_mb);
+    }
+
+    Region_t& parent = regions[reg.parent];
+    parent.child_secs  += secs;
+    parent.peak_rss_mb  = std::max(parent.peak_rss_mb, reg.peak_rss_mb);
+
+    current = reg.parent;
+  }
+
+
+  // Write a region and its children
+  void Profiler::writeRegion(XMLWriter& xml, int r, const multi2d<double>& across) const
+  {
+    const Region_t& reg = regions[r];
+
+    double incl = reg.incl_secs;
+    if (r == 0)
+      incl = on ? wallSecs() - reg.start_secs : 0;
+
+    push(xml, "Region");
+    write(xml, "name", reg.name);
+    write(xml, "calls", reg.calls);
+    write(xml, "inclusive_secs", incl);
+    write(xml, "exclusive_secs", incl - reg.child_secs);
+
+    if (across.size1() > 0)
+    {
+      write(xml, "inclusive_secs_min", across(r,0));
+      write(xml, "inclusive_secs_max", across(r,1));
+      write(xml, "inclusive_secs_avg", across(r,2));
+      write(xml, "exclusive_secs_min", across(r,3));
+      write(xml, "exclusive_secs_max", across(r,4));
+      write(xml, "exclusive_secs_avg", across(r,5));
+      if (reg.memory)
+	write(xml, "peak_rss_mb_max", across(r,7));
+    }
+
+    if (reg.memory)
+    {
+      write(xml, "peak_rss_mb", reg.peak_rss_mb);
+      write(xml, "hwm_growth_mb", reg.hwm_growth_mb);
+    }
+
+    if (reg.children.size() > 0)
+    {
+      push(xml, "Regions");
+      for(int i=0; i < reg.children.size(); ++i)
+	writeRegion(xml, reg.children[i], across);
+      pop(xml);
+    }
+
+    pop(xml);
+  }
+
+
+  // Write the profile, collective over the nodes
+  void Profiler::writeProfile(XMLWriter& xml, const std::string& path) const
+  {
+    const int num_nodes = Layout::numNodes();
+    const int nreg      = regions.size();
+
+    // The trees can only be compared if every node has the same number of regions
+    double counts[2] = {double(nreg), double(nreg)*double(nreg)};
+    QDPInternal::globalSumArray(counts, 2);
+    const bool same_tree = (num_nodes*counts[1] == counts[0]*counts[0]);
+
+    multi2d<double> across;
+    if (same_tree)
+    {
+      across.resize(nreg, 3*num_across);
+      multi1d<double> sums(nreg*num_across);
+
+      const double now = wallSecs();
+      for(int r=0; r < nreg; ++r)
+      {
+	const Region_t& reg = regions[r];
+	double incl = (r == 0) ? now - reg.start_secs : reg.incl_secs;
+
+	double v[num_across] = {incl, incl - reg.child_secs, reg.peak_rss_mb};
+	for(int k=0; k < num_across; ++k)
+	{
+	  double mn = v[k];
+	  double mx = v[k];
+	  QDPInternal::globalMin(mn);
+	  QDPInternal::globalMax(mx);
+
+	  across(r,3*k)   = mn;
+	  across(r,3*k+1) = mx;
+	  sums[r*num_across + k] = v[k];
+	}
+      }
+
+      QDPInternal::globalSumArray(sums.slice(), sums.size());
+
+      for(int r=0; r < nreg; ++r)
+	for(int k=0; k < num_across; ++k)
+	  across(r,3*k+2) = sums[r*num_across + k] / num_nodes;
+    }
+    else
+    {
+      QDPIO::cerr << "Profiler: the nodes have different regions, only writing node 0" << std::endl;
+    }
+
+    push(xml, path);
+    write(xml, "num_nodes", num_nodes);
+    write(xml, "same_regions_on_all_nodes", same_tree);
+    writeRegion(xml, 0, across);
+    pop(xml);
+  }
+
+
+  // Write the profile to a file, collective over the nodes
+  void Profiler::writeProfile(const std::string& file) const
+  {
+    XMLFileWriter xml(file);
+    writeProfile(xml, "Profile");
+    xml.close();
+  }
+
+}  // end namespace Chroma
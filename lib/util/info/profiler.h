@@ -0,0 +1,148 @@
+// -*- C++ -*-
+/*! \file
+ * \brief Hierarchical named-region profiler
+ */
+
+#ifndef __profiler_h__
+#define __profiler_h__
+
+#include "chromabase.h"
+#include "singleton.h"
+
+#include <string>
+#include <vector>
+#include <thread>
+
+namespace Chroma
+{
+  //! Hierarchical named-region profiler
+  /*! \ingroup info
+   *
+   * Regions are opened and closed in nested order, normally through a
+   * ProfileRegion on the stack. A region opened inside another becomes its
+   * child, so the same name can appear at several places of the tree.
+   * For every node of the tree the number of calls, the inclusive time,
+   * the exclusive time (without the children) and the memory footprint of
+   * the process are recorded.
+   *
+   * The memory footprint is the resident set size sampled at the region
+   * boundaries, together with the growth of the high-water mark of the
+   * process during the region, which also catches the transient peaks
+   * in between. Sampling it costs a file read and a system call, so fine
+   * grained regions (a matvec) are opened with TIME_ONLY and only read the
+   * clock; their memory shows up in the enclosing regions.
+   *
+   * Only the thread that enabled the profiler records, regions opened
+   * from other threads are ignored. Writing the profile is collective:
+   * every node must have seen the same tree, and the times are reduced
+   * to their minimum, maximum and average over the nodes.
+   */
+  class Profiler
+  {
+  public:
+    //! What a region records
+    enum Sampling {TIME_AND_MEMORY, TIME_ONLY};
+
+    //! Constructor
+    Profiler();
+
+    //! Start recording on this thread
+    void enable();
+
+    //! Is the profiler recording
+    bool enabled() const {return on;}
+
+    //! Open a region
+    /*! \return whether the region was opened and must be closed */
+    bool begin(const std::string& name, Sampling sampling = TIME_AND_MEMORY);
+
+    //! Close the innermost open region
+    void end();
+
+    //! Write the profile, collective over the nodes
+    void writeProfile(XMLWriter& xml, const std::string& path) const;
+
+    //! Write the profile to a file, collective over the nodes
+    void writeProfile(const std::string& file) const;
+
+  private:
+    //! A node of the region tree
+    struct Region_t
+    {
+      std::string       name;
+      int               parent;
+      bool              memory;         /*!< memory is sampled */
+      std::vector<int>  children;
+
+      unsigned long     calls;
+      double            incl_secs;
+      double            child_secs;     /*!< inclusive time of the children */
+      double            peak_rss_mb;    /*!< largest resident set at the boundaries */
+      double            hwm_growth_mb;  /*!< largest growth of the high-water mark */
+
+      double            start_secs;     /*!< of the open call */
+      double            start_hwm_mb;
+    };
+
+    //! Write a region and its children
+    void writeRegion(XMLWriter& xml, int r, const multi2d<double>& across) const;
+
+    std::vector<Region_t>  regions;   /*!< region 0 is the whole run */
+    int                    current;
+    bool                   on;
+    std::thread::id        owner;
+  };
+
+
+  //! Singleton profiler
+  /*! \ingroup info */
+  typedef SingletonHolder<Profiler,
+			  QDP::CreateUsingNew,
+			  QDP::NoDestroy,
+			  QDP::SingleThreaded> TheProfiler;
+
+
+  //! A profiled scope
+  /*! \ingroup info
+   *
+   * Opens the region on construction and closes it on destruction.
+   * Costs only a test of a flag when the profiler is not enabled.
+   */
+  class ProfileRegion
+  {
+  public:
+    //! Open the region
+    explicit ProfileRegion(const char* name,
+			   Profiler::Sampling sampling = Profiler::TIME_AND_MEMORY) : opened(false)
+    {
+      Profiler& prof = TheProfiler::Instance();
+      if (prof.enabled())
+	opened = prof.begin(name, sampling);
+    }
+
+    //! Open the region
+    explicit ProfileRegion(const std::string& name,
+			   Profiler::Sampling sampling = Profiler::TIME_AND_MEMORY) : opened(false)
+    {
+      Profiler& prof = TheProfiler::Instance();
+      if (prof.enabled())
+	opened = prof.begin(name, sampling);
+    }
+
+    //! Close the region
+    ~ProfileRegion()
+    {
+      if (opened)
+	TheProfiler::Instance().end();
+    }
+
+  private:
+    ProfileRegion(const ProfileRegion&);
+    ProfileRegion& operator=(const ProfileRegion&);
+
+    bool opened;
+  };
+
+}  // end namespace Chroma
+
+#endif
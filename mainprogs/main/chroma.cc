@@ -16,6 +16,8 @@ struct Params_t
 {
   multi1d<int>    nrow;
   std::string     inline_measurement_xml;
+  std::string     profile_file;      /*!< optional region profile, empty for none */
+  std::string     named_obj_release; /*!< NONE, AUTO or DRY_RUN */
 };
 
 struct Inline_input_t
@@ -37,6 +39,20 @@ void read(XMLReader& xml, const std::string& path, Params_t& p)
   p.inline_measurement_xml = inline_os.str();
   QDPIO::cout << "InlineMeasurements are: " << std::endl;
   QDPIO::cout << p.inline_measurement_xml << std::endl;
+
+  if (paramtop.count("ProfileFile") != 0)
+    read(paramtop, "ProfileFile", p.profile_file);
+
+  p.named_obj_release = "NONE";
+  if (paramtop.count("NamedObjectRelease") != 0)
+    read(paramtop, "NamedObjectRelease", p.named_obj_release);
+
+  if (p.named_obj_release != "NONE" && p.named_obj_release != "AUTO" && p.named_obj_release != "DRY_RUN")
+  {
+    QDPIO::cerr << "CHROMA: unknown NamedObjectRelease = " << p.named_obj_release 
+		<< ", expected NONE, AUTO or DRY_RUN" << std::endl;
+    QDP_abort(1);
+  }
 }
 
 
@@ -118,6 +134,10 @@ int main(int argc, char *argv[])
     QDP_abort(1);
   }
 
+  // Profile the run if asked for
+  if (input.param.profile_file != "")
+    TheProfiler::Instance().enable();
+
   XMLFileWriter& xml_out = Chroma::getXMLOutputInstance();
   push(xml_out, "chroma");
 
@@ -144,6 +164,8 @@ int main(int argc, char *argv[])
   swatch.start();
   try 
   {
+    ProfileRegion region("gauge_init");
+
     std::istringstream  xml_c(input.cfg.xml);
     XMLReader  cfgtop(xml_c);
     QDPIO::cout << "CHROMA: Gauge initialization: cfg_type = " << input.cfg.id << std::endl;
@@ -198,7 +220,10 @@ int main(int argc, char *argv[])
   swatch.start();
   
   // Calculate some gauge invariant observables
-  MesPlq(xml_out, "Observables", u);
+  {
+    ProfileRegion region("observables");
+    MesPlq(xml_out, "Observables", u);
+  }
   swatch.stop();
   QDPIO::cout << "CHROMA: initial plaquette measurement time=" << swatch.getTimeInSeconds() << " secs" << std::endl;
 
@@ -220,6 +245,24 @@ int main(int argc, char *argv[])
     InlineDefaultGaugeField::reset();
     InlineDefaultGaugeField::set(u, config_xml);
 
+    // Lifetimes of the named objects made by the measurements
+    Handle<NamedObjectLifetimes> lifetimes;
+    if (input.param.named_obj_release != "NONE")
+    {
+      lifetimes = new NamedObjectLifetimes(MeasXML, "/InlineMeasurements");
+      lifetimes->writeReport(xml_out, "NamedObjectLifetimes");
+
+      QDPIO::cout << "CHROMA: peak number of live named objects = " << lifetimes->peakLive(false)
+		  << ", with release after last use = " << lifetimes->peakLive(true) << std::endl;
+    }
+
+    // Only report what would be released
+    if (input.param.named_obj_release == "DRY_RUN")
+    {
+      QDPIO::cout << "CHROMA: dry run, the measurements are not done" << std::endl;
+      the_measurements.resize(0);
+    }
+
     // Measure inline observables 
     push(xml_out, "InlineObservables");
     xml_out.flush();
@@ -243,6 +286,10 @@ int main(int argc, char *argv[])
 
 	xml_out.flush();
       }
+
+      // Free the objects no later measurement uses
+      if (input.param.named_obj_release == "AUTO")
+	lifetimes->release(m);
     }
     swatch.stop();
 
@@ -296,6 +343,12 @@ int main(int argc, char *argv[])
 	      << snoop.getTimeInSeconds() 
 	      << " secs" << std::endl;
 
+  if (input.param.profile_file != "")
+  {
+    TheProfiler::Instance().writeProfile(input.param.profile_file);
+    QDPIO::cout << "CHROMA: wrote profile to " << input.param.profile_file << std::endl;
+  }
+
   QDPIO::cout << "CHROMA: ran successfully" << std::endl;
 
   END_CODE();
@@ -0,0 +1,710 @@
+/*! \file
+ * \brief Benchmark suite for the kernels, solvers and contractions
+ *
+ * Times the main kernels on a random gauge field and reports the time per
+ * site, the GFlop/s and an estimate of the memory bandwidth in JSON. A
+ * previous output file can be given as a baseline, and each benchmark that
+ * got slower by more than a tolerance is reported.
+ *
+ * Input:
+ *
+ * <Param>
+ *   <nrow>8 8 8 16</nrow>
+ *   <MinTime>1.0</MinTime>            <!-- seconds per benchmark -->
+ *   <Benchmarks>wilson_dslash cg</Benchmarks>   <!-- optional, default all -->
+ *   <JsonFile>chroma_bench.json</JsonFile>
+ *   <Baseline>chroma_bench.baseline.json</Baseline>  <!-- optional -->
+ *   <Tolerance>0.1</Tolerance>        <!-- optional -->
+ * </Param>
+ */
+
+#include "chroma.h"
+#include "io/xml_group_reader.h"
+#include "actions/ferm/invert/minvcg2.h"
+#include "actions/ferm/fermacts/clover_fermact_params_w.h"
+#include "actions/ferm/linop/clover_term_w.h"
+#include "actions/ferm/linop/lwldslash_w.h"
+#include "util/gauge/hotst.h"
+#include "util/gauge/stout_utils.h"
+#include "meas/smear/gaus_smear.h"
+#include "util/ft/sftmom.h"
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <map>
+#include <functional>
+
+using namespace Chroma;
+
+//! Input parameters
+struct BenchParams_t
+{
+  multi1d<int>              nrow;
+  double                    min_time;      /*!< seconds per benchmark */
+  multi1d<std::string>      benchmarks;    /*!< empty means all */
+  std::string               json_file;
+  std::string               baseline;      /*!< optional previous output */
+  double                    tolerance;     /*!< allowed relative slow down */
+};
+
+
+//! One measurement
+struct BenchResult_t
+{
+  std::string  name;
+  int          calls;
+  double       secs;
+  double       us_per_site;
+  double       gflops;        /*!< negative if the flop count is unknown */
+  double       gbytes;        /*!< negative if the traffic is unknown */
+};
+
+
+void read(XMLReader& xml, const std::string& path, BenchParams_t& p)
+{
+  XMLReader paramtop(xml, path);
+
+  read(paramtop, "nrow", p.nrow);
+
+  p.min_time = 1.0;
+  if (paramtop.count("MinTime") != 0)
+    read(paramtop, "MinTime", p.min_time);
+
+  if (paramtop.count("Benchmarks") != 0)
+    read(paramtop, "Benchmarks", p.benchmarks);
+
+  p.json_file = "chroma_bench.json";
+  if (paramtop.count("JsonFile") != 0)
+    read(paramtop, "JsonFile", p.json_file);
+
+  if (paramtop.count("Baseline") != 0)
+    read(paramtop, "Baseline", p.baseline);
+
+  p.tolerance = 0.1;
+  if (paramtop.count("Tolerance") != 0)
+    read(paramtop, "Tolerance", p.tolerance);
+}
+
+
+//! Time a kernel
+/*!
+ * The number of calls is doubled until they take at least min_time.
+ * The flop and byte counts are per call and per node.
+ */
+BenchResult_t timeKernel(const std::string& name, const std::function<void()>& kernel,
+			 double min_time, double flops, double bytes)
+{
+  QDPIO::cout << "Benchmark " << name << std::endl;
+
+  // Warm up
+  kernel();
+
+  StopWatch swatch;
+  double secs = 0;
+  int calls;
+
+  for(calls=1; ; calls <<= 1)
+  {
+    swatch.reset();
+    swatch.start();
+    for(int i=0; i < calls; ++i)
+      kernel();
+    swatch.stop();
+
+    secs = swatch.getTimeInSeconds();
+    QDPInternal::globalSum(secs);
+    secs /= Layout::numNodes();
+
+    if (secs >= min_time)
+      break;
+  }
+
+  BenchResult_t res;
+  res.name        = name;
+  res.calls       = calls;
+  res.secs        = secs;
+  res.us_per_site = 1.0e6 * secs / (double(calls) * Layout::sitesOnNode());
+  res.gflops      = (flops > 0) ? 1.0e-9 * flops * Layout::numNodes() * calls / secs : -1;
+  res.gbytes      = (bytes > 0) ? 1.0e-9 * bytes * Layout::numNodes() * calls / secs : -1;
+
+  QDPIO::cout << "  " << name << ": calls= " << calls
+	      << "  us/site= " << res.us_per_site;
+  if (res.gflops > 0)
+    QDPIO::cout << "  GFlop/s= " << res.gflops;
+  if (res.gbytes > 0)
+    QDPIO::cout << "  GB/s= " << res.gbytes;
+  QDPIO::cout << std::endl;
+
+  return res;
+}
+
+
+//! Read an object group from an XML string
+GroupXML_t groupFromXML(const std::string& xml_str, const std::string& path, const std::string& type_name)
+{
+  std::istringstream is(xml_str);
+  XMLReader xml(is);
+  return readXMLGroup(xml, path, type_name);
+}
+
+
+//! Solver parameters
+GroupXML_t invertParam(const std::string& inv_type)
+{
+  std::ostringstream os;
+  os << "<InvertParam><invType>" << inv_type << "</invType>"
+     << "<RsdCG>1.0e-7</RsdCG><MaxCG>1000</MaxCG></InvertParam>";
+
+  return groupFromXML(os.str(), "/InvertParam", "invType");
+}
+
+
+namespace
+{
+  const std::string wilson_xml =
+    "<FermionAction><FermAct>WILSON</FermAct><Kappa>0.11</Kappa>"
+    "<FermionBC><FermBC>SIMPLE_FERMBC</FermBC><boundary>1 1 1 -1</boundary></FermionBC>"
+    "</FermionAction>";
+
+  const std::string clover_xml =
+    "<FermionAction><FermAct>CLOVER</FermAct><Kappa>0.11</Kappa><clovCoeff>1.0</clovCoeff>"
+    "<FermionBC><FermBC>SIMPLE_FERMBC</FermBC><boundary>1 1 1 -1</boundary></FermionBC>"
+    "</FermionAction>";
+
+  const std::string dwf_xml =
+    "<FermionAction><FermAct>DWF</FermAct><OverMass>1.8</OverMass><Mass>0.05</Mass><N5>8</N5>"
+    "<FermionBC><FermBC>SIMPLE_FERMBC</FermBC><boundary>1 1 1 -1</boundary></FermionBC>"
+    "</FermionAction>";
+
+  const std::string asqtad_xml =
+    "<FermionAction><FermAct>ASQTAD</FermAct><Mass>0.05</Mass><u0>1.0</u0>"
+    "<FermState><Name>SIMPLE_FERM_STATE</Name>"
+    "<FermionBC><FermBC>SIMPLE_FERMBC</FermBC><boundary>1 1 1 -1</boundary></FermionBC>"
+    "</FermState></FermionAction>";
+
+  const std::string gaugeact_xml =
+    "<GaugeAction><Name>WILSON_GAUGEACT</Name><beta>5.7</beta>"
+    "<GaugeBC><Name>PERIODIC_GAUGEBC</Name></GaugeBC></GaugeAction>";
+
+  typedef LatticeFermion               T;
+  typedef multi1d<LatticeColorMatrix>  P;
+  typedef multi1d<LatticeColorMatrix>  Q;
+}
+
+
+//! All the benchmarks
+class ChromaBench
+{
+public:
+  ChromaBench(const BenchParams_t& p_, const multi1d<LatticeColorMatrix>& u_) : p(p_), u(u_) {}
+
+  //! Run the selected benchmarks
+  std::vector<BenchResult_t> run()
+  {
+    typedef void (ChromaBench::*Bench_t)();
+    std::vector< std::pair<std::string,Bench_t> > all;
+
+    all.push_back(std::make_pair("wilson_dslash", &ChromaBench::wilsonDslash));
+    all.push_back(std::make_pair("wilson_linop", &ChromaBench::wilsonLinOp));
+    all.push_back(std::make_pair("clover_linop", &ChromaBench::cloverLinOp));
+    all.push_back(std::make_pair("clover_term", &ChromaBench::cloverTerm));
+    all.push_back(std::make_pair("dwf_linop", &ChromaBench::dwfLinOp));
+    all.push_back(std::make_pair("asqtad_linop", &ChromaBench::asqtadLinOp));
+    all.push_back(std::make_pair("cg", &ChromaBench::cg));
+    all.push_back(std::make_pair("bicgstab", &ChromaBench::bicgstab));
+    all.push_back(std::make_pair("multishift_cg", &ChromaBench::multiShiftCG));
+    all.push_back(std::make_pair("gaussian_smearing", &ChromaBench::gaussianSmearing));
+    all.push_back(std::make_pair("meson_contraction", &ChromaBench::mesonContraction));
+    all.push_back(std::make_pair("baryon_contraction", &ChromaBench::baryonContraction));
+    all.push_back(std::make_pair("stout_smearing", &ChromaBench::stoutSmearing));
+    all.push_back(std::make_pair("gauge_force", &ChromaBench::gaugeForce));
+
+    for(int i=0; i < all.size(); ++i)
+    {
+      if (! selected(all[i].first))
+	continue;
+
+      (this->*all[i].second)();
+    }
+
+    return results;
+  }
+
+private:
+  //! Is this benchmark to be run
+  bool selected(const std::string& name) const
+  {
+    if (p.benchmarks.size() == 0)
+      return true;
+
+    for(int i=0; i < p.benchmarks.size(); ++i)
+      if (p.benchmarks[i] == name)
+	return true;
+
+    return false;
+  }
+
+  void add(const std::string& name, const std::function<void()>& kernel, double flops, double bytes)
+  {
+    results.push_back(timeKernel(name, kernel, p.min_time, flops, bytes));
+  }
+
+  Handle< WilsonTypeFermAct<T,P,Q> > wilsonTypeAct(const std::string& xml)
+  {
+    GroupXML_t grp = groupFromXML(xml, "/FermionAction", "FermAct");
+    std::istringstream is(grp.xml);
+    XMLReader top(is);
+
+    return Handle< WilsonTypeFermAct<T,P,Q> >(
+      TheWilsonTypeFermActFactory::Instance().createObject(grp.id, top, grp.path));
+  }
+
+  //! Wilson dslash on one checkerboard
+  void wilsonDslash()
+  {
+    Handle< FermState<T,P,Q> > state(new PeriodicFermState<T,P,Q>(u));
+    WilsonDslash D(state);
+
+    LatticeFermion psi, chi;
+    gaussian(psi);
+    chi = zero;
+
+    // Per output site: 8 links and 8 neighbours in, one spinor out
+    const int cbsites = Layout::sitesOnNode()/2;
+    const double bytes = double(cbsites) * (8*18 + 8*24 + 24) * sizeof(REAL);
+
+    add("wilson_dslash", [&]() {D.apply(chi, psi, PLUS, 0);}, double(cbsites) * D.nFlops(), bytes);
+  }
+
+  //! A preconditioned fermion matrix
+  void linOp(const std::string& name, const std::string& xml, double bytes_per_cbsite)
+  {
+    Handle< WilsonTypeFermAct<T,P,Q> > S_f(wilsonTypeAct(xml));
+    Handle< FermState<T,P,Q> > state(S_f->createState(u));
+    Handle< LinearOperator<T> > M(S_f->linOp(state));
+
+    LatticeFermion psi, chi;
+    gaussian(psi);
+    chi = zero;
+
+    add(name, [&]() {(*M)(chi, psi, PLUS);}, M->nFlops(),
+	bytes_per_cbsite * (Layout::sitesOnNode()/2));
+  }
+
+  void wilsonLinOp()
+  {
+    // Two dslashes and the linear combination
+    linOp("wilson_linop", wilson_xml, 2*(8*18 + 8*24 + 24) * sizeof(REAL));
+  }
+
+  void cloverLinOp()
+  {
+    // Two dslashes and two clover terms
+    linOp("clover_linop", clover_xml, 2*(8*18 + 8*24 + 24 + 72 + 2*24) * sizeof(REAL));
+  }
+
+  //! Clover term apply and factorisation
+  void cloverTerm()
+  {
+    std::istringstream is(clover_xml);
+    XMLReader xml(is);
+    CloverFermActParams param(xml, "/FermionAction");
+
+    Handle< FermState<T,P,Q> > state(new PeriodicFermState<T,P,Q>(u));
+    CloverTerm clov;
+    clov.create(state, param);
+
+    LatticeFermion psi, chi;
+    gaussian(psi);
+    chi = zero;
+
+    const int cbsites = Layout::sitesOnNode()/2;
+
+    // 72 reals of packed clover term per site
+    add("clover_apply", [&]() {clov.apply(chi, psi, PLUS, 0);},
+	double(cbsites) * clov.nFlops(), double(cbsites) * (72 + 2*24) * sizeof(REAL));
+
+    add("clover_invert", [&]() {clov.choles(0);}, -1, double(cbsites) * 2*72 * sizeof(REAL));
+  }
+
+  //! Domain wall fermion matrix
+  void dwfLinOp()
+  {
+    GroupXML_t grp = groupFromXML(dwf_xml, "/FermionAction", "FermAct");
+    std::istringstream is(grp.xml);
+    XMLReader top(is);
+
+    Handle< WilsonTypeFermAct5D<T,P,Q> >
+      S_f(TheWilsonTypeFermAct5DFactory::Instance().createObject(grp.id, top, grp.path));
+    Handle< FermState<T,P,Q> > state(S_f->createState(u));
+    Handle< LinearOperatorArray<T> > M(S_f->linOp(state));
+
+    multi1d<LatticeFermion> psi(M->size()), chi(M->size());
+    for(int s=0; s < M->size(); ++s)
+    {
+      gaussian(psi[s]);
+      chi[s] = zero;
+    }
+
+    add("dwf_linop", [&]() {(*M)(chi, psi, PLUS);}, M->nFlops(), -1);
+  }
+
+  //! Staggered fermion matrix
+  void asqtadLinOp()
+  {
+    typedef LatticeStaggeredFermion TS;
+
+    GroupXML_t grp = groupFromXML(asqtad_xml, "/FermionAction", "FermAct");
+    std::istringstream is(grp.xml);
+    XMLReader top(is);
+
+    Handle< StaggeredTypeFermAct<TS,P,Q> >
+      S_f(TheStagTypeFermActFactory::Instance().createObject(grp.id, top, grp.path));
+    Handle< FermState<TS,P,Q> > state(S_f->createState(u));
+    Handle< LinearOperator<TS> > M(S_f->linOp(state));
+
+    LatticeStaggeredFermion psi, chi;
+    gaussian(psi);
+    chi = zero;
+
+    add("asqtad_linop", [&]() {(*M)(chi, psi, PLUS);}, M->nFlops(), -1);
+  }
+
+  //! CG on the preconditioned clover normal equations
+  /*! The flop count includes only the fermion matrix */
+  void cg()
+  {
+    Handle< WilsonTypeFermAct<T,P,Q> > S_f(wilsonTypeAct(clover_xml));
+    Handle< FermState<T,P,Q> > state(S_f->createState(u));
+    Handle< LinearOperator<T> > M(S_f->linOp(state));
+    Handle< MdagMSystemSolver<T> > solver(S_f->invMdagM(state, invertParam("CG_INVERTER")));
+
+    LatticeFermion psi, chi;
+    gaussian(chi);
+
+    psi = zero;
+    int n_count = (*solver)(psi, chi).n_count;
+
+    add("cg", [&]() {psi = zero; (*solver)(psi, chi);}, double(n_count) * 2 * M->nFlops(), -1);
+  }
+
+  //! BiCGStab on the preconditioned clover matrix
+  /*! The flop count includes only the fermion matrix */
+  void bicgstab()
+  {
+    Handle< WilsonTypeFermAct<T,P,Q> > S_f(wilsonTypeAct(clover_xml));
+    Handle< FermState<T,P,Q> > state(S_f->createState(u));
+    Handle< LinearOperator<T> > M(S_f->linOp(state));
+    Handle< LinOpSystemSolver<T> > solver(S_f->invLinOp(state, invertParam("BICGSTAB_INVERTER")));
+
+    LatticeFermion psi, chi;
+    gaussian(chi);
+
+    psi = zero;
+    int n_count = (*solver)(psi, chi).n_count;
+
+    add("bicgstab", [&]() {psi = zero; (*solver)(psi, chi);}, double(n_count) * 2 * M->nFlops(), -1);
+  }
+
+  //! Multi-shift CG on the preconditioned clover normal equations
+  /*! The flop count includes only the fermion matrix */
+  void multiShiftCG()
+  {
+    Handle< WilsonTypeFermAct<T,P,Q> > S_f(wilsonTypeAct(clover_xml));
+    Handle< FermState<T,P,Q> > state(S_f->createState(u));
+    Handle< LinearOperator<T> > M(S_f->linOp(state));
+
+    const int n_shifts = 8;
+    multi1d<Real> shifts(n_shifts);
+    multi1d<Real> RsdCG(n_shifts);
+    for(int i=0; i < n_shifts; ++i)
+    {
+      shifts[i] = 0.0001 * pow(double(10), double(i)/2);
+      RsdCG[i]  = 1.0e-7;
+    }
+
+    LatticeFermion chi;
+    gaussian(chi, M->subset());
+    multi1d<LatticeFermion> psi(n_shifts);
+
+    int n_count;
+    for(int i=0; i < n_shifts; ++i)
+      psi[i] = zero;
+    MInvCG2(*M, chi, psi, shifts, RsdCG, 1000, n_count);
+
+    add("multishift_cg", [&]() {
+	int n;
+	for(int i=0; i < n_shifts; ++i)
+	  psi[i] = zero;
+	MInvCG2(*M, chi, psi, shifts, RsdCG, 1000, n);
+      }, double(n_count) * 2 * M->nFlops(), -1);
+  }
+
+  //! Gaussian smearing of a colour vector
+  void gaussianSmearing()
+  {
+    const int itr = 20;
+    const int j_decay = Nd-1;
+
+    LatticeColorVector chi;
+    gaussian(chi);
+
+    // Per iteration: 2*(Nd-1) matrix-vector products and the sums
+    const int sites = Layout::sitesOnNode();
+    const double flops = double(sites) * itr * (2*(Nd-1)*66 + (2*(Nd-1)+2)*6);
+    const double bytes = double(sites) * itr * (2*(Nd-1)*(18 + 6) + 2*6) * sizeof(REAL);
+
+    add("gaussian_smearing", [&]() {gausSmear(u, chi, Real(2), itr, j_decay);}, flops, bytes);
+  }
+
+  //! Meson two-point functions for all 16 gammas
+  void mesonContraction()
+  {
+    SftMom phases(0, true, Nd-1);
+
+    LatticePropagator q;
+    gaussian(q);
+
+    // Per gamma: a trace of a product of two 12x12 matrices
+    const int sites = Layout::sitesOnNode();
+    const double flops = double(sites) * Ns*Ns * 8*(Ns*Nc)*(Ns*Nc);
+    const double bytes = double(sites) * Ns*Ns * 2*(Ns*Nc)*(Ns*Nc) * sizeof(REAL);
+
+    add("meson_contraction", [&]() {
+	LatticePropagator anti_q = Gamma(15) * q * Gamma(15);
+	for(int n=0; n < Ns*Ns; ++n)
+	{
+	  multi2d<DComplex> hsum = phases.sft(trace(adj(anti_q) * Gamma(n) * q * Gamma(n)));
+	}
+      }, flops, bytes);
+  }
+
+  //! Nucleon two-point function
+  void baryonContraction()
+  {
+    SftMom phases(0, true, Nd-1);
+
+    LatticePropagator q;
+    gaussian(q);
+
+    // C gamma_5
+    SpinMatrix g_one = 1.0;
+    SpinMatrix Cg5 = Gamma(5) * g_one;
+
+    const int sites = Layout::sitesOnNode();
+    const double bytes = double(sites) * 3*2*(Ns*Nc)*(Ns*Nc) * sizeof(REAL);
+
+    add("baryon_contraction", [&]() {
+	LatticePropagator di_quark = quarkContract13(q * Cg5, Cg5 * q);
+	LatticeComplex b_prop = trace(q * traceSpin(di_quark));
+	multi2d<DComplex> hsum = phases.sft(b_prop);
+      }, -1, bytes);
+  }
+
+  //! One level of stout smearing in all directions
+  void stoutSmearing()
+  {
+    multi1d<bool> smear_dirs(Nd);
+    smear_dirs = true;
+
+    multi2d<Real> rho(Nd, Nd);
+    rho = 0.1;
+    for(int mu=0; mu < Nd; ++mu)
+      rho(mu,mu) = 0;
+
+    multi1d<LatticeColorMatrix> u_next(Nd);
+
+    add("stout_smearing", [&]() {Stouting::smear_links(u, u_next, smear_dirs, rho);}, -1, -1);
+  }
+
+  //! Wilson gauge action force
+  void gaugeForce()
+  {
+    GroupXML_t grp = groupFromXML(gaugeact_xml, "/GaugeAction", "Name");
+    std::istringstream is(grp.xml);
+    XMLReader top(is);
+    Handle< GaugeAction<P,Q> > S_g(TheGaugeActFactory::Instance().createObject(grp.id, top, grp.path));
+    Handle< GaugeState<P,Q> > state(S_g->createState(u));
+
+    multi1d<LatticeColorMatrix> ds_u(Nd);
+
+    add("gauge_force", [&]() {S_g->deriv(ds_u, state);}, -1, -1);
+  }
+
+  const BenchParams_t&                p;
+  const multi1d<LatticeColorMatrix>&  u;
+  std::vector<BenchResult_t>          results;
+};
+
+
+//! Write a number or null
+void writeJsonNumber(std::ostream& os, double x)
+{
+  if (x < 0)
+    os << "null";
+  else
+    os << x;
+}
+
+
+//! Write the results as JSON, one benchmark per line
+void writeJson(const std::string& file, const BenchParams_t& p, const std::vector<BenchResult_t>& results)
+{
+  if (! Layout::primaryNode())
+    return;
+
+  std::ofstream os(file.c_str());
+  os << std::setprecision(6);
+
+  os << "{\n";
+  os << "  \"lattice\": [";
+  for(int mu=0; mu < p.nrow.size(); ++mu)
+    os << (mu > 0 ? ", " : "") << p.nrow[mu];
+  os << "],\n";
+  os << "  \"nodes\": " << Layout::numNodes() << ",\n";
+  os << "  \"precision\": " << sizeof(REAL) << ",\n";
+  os << "  \"benchmarks\": [\n";
+
+  for(int i=0; i < results.size(); ++i)
+  {
+    const BenchResult_t& r = results[i];
+    os << "    {\"name\": \"" << r.name << "\", \"calls\": " << r.calls
+       << ", \"seconds\": " << r.secs
+       << ", \"us_per_site\": " << r.us_per_site
+       << ", \"gflops\": ";
+    writeJsonNumber(os, r.gflops);
+    os << ", \"gbytes_per_sec\": ";
+    writeJsonNumber(os, r.gbytes);
+    os << "}" << (i+1 < results.size() ? "," : "") << "\n";
+  }
+
+  os << "  ]\n";
+  os << "}\n";
+}
+
+
+//! Read the time per site of each benchmark from a previous output
+/*! Only the layout written by writeJson is understood */
+std::map<std::string,double> readBaseline(const std::string& file)
+{
+  std::map<std::string,double> base;
+  std::ifstream is(file.c_str());
+
+  if (! is)
+  {
+    QDPIO::cerr << "chroma_bench: cannot open baseline " << file << std::endl;
+    return base;
+  }
+
+  const std::string name_tag = "\"name\": \"";
+  const std::string time_tag = "\"us_per_site\": ";
+
+  std::string line;
+  while (std::getline(is, line))
+  {
+    size_t n = line.find(name_tag);
+    size_t t = line.find(time_tag);
+    if (n == std::string::npos || t == std::string::npos)
+      continue;
+
+    n += name_tag.size();
+    std::string name = line.substr(n, line.find('"', n) - n);
+
+    std::istringstream ts(line.substr(t + time_tag.size()));
+    double us;
+    if (ts >> us)
+      base[name] = us;
+  }
+
+  return base;
+}
+
+
+//! Compare with the baseline, returns the number of regressions
+int compareBaseline(const BenchParams_t& p, const std::vector<BenchResult_t>& results)
+{
+  int nslow = 0;
+
+  if (Layout::primaryNode())
+  {
+    std::map<std::string,double> base = readBaseline(p.baseline);
+
+    for(int i=0; i < results.size(); ++i)
+    {
+      std::map<std::string,double>::const_iterator b = base.find(results[i].name);
+      if (b == base.end() || b->second <= 0)
+	continue;
+
+      double ratio = results[i].us_per_site / b->second;
+      std::cout << "chroma_bench: " << results[i].name << " time/baseline= " << ratio;
+
+      if (ratio > 1 + p.tolerance)
+      {
+	std::cout << "  SLOWER";
+	++nslow;
+      }
+      std::cout << std::endl;
+    }
+  }
+
+  QDPInternal::broadcast(nslow);
+  return nslow;
+}
+
+
+bool linkageHack(void)
+{
+  bool foo = true;
+
+  foo &= WilsonTypeFermActsEnv::registerAll();
+  foo &= StaggeredTypeFermActsEnv::registerAll();
+  foo &= GaugeActsEnv::registerAll();
+
+  return foo;
+}
+
+
+int main(int argc, char **argv)
+{
+  // Put the machine into a known state
+  Chroma::initialize(&argc, &argv);
+  QDPIO::cout << "Linkage = " << linkageHack() << std::endl;
+
+  BenchParams_t params;
+
+  try
+  {
+    XMLReader xml_in(Chroma::getXMLInputFileName());
+    read(xml_in, "/Param", params);
+  }
+  catch(const std::string& e)
+  {
+    QDPIO::cerr << "Caught Exception reading XML: " << e << std::endl;
+    QDP_abort(1);
+  }
+
+  Layout::setLattSize(params.nrow);
+  Layout::create();
+
+  // A random gauge field
+  multi1d<LatticeColorMatrix> u(Nd);
+  HotSt(u);
+
+  ChromaBench bench(params, u);
+  std::vector<BenchResult_t> results = bench.run();
+
+  writeJson(params.json_file, params, results);
+
+  int nslow = 0;
+  if (params.baseline != "")
+    nslow = compareBaseline(params, results);
+
+  // Time to bolt
+  Chroma::finalize();
+
+  exit(nslow > 0 ? 1 : 0);
+}
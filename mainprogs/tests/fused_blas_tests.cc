@@ -0,0 +1,382 @@
+#include "gtest/gtest.h"
+#include "chromabase.h"
+#include "actions/ferm/invert/fused_blas.h"
+
+#include <vector>
+#include <cmath>
+
+using namespace Chroma;
+
+//! Tolerances of the comparisons, by precision
+template<typename T>
+struct FusedBLASTol;
+
+template<>
+struct FusedBLASTol<LatticeFermionF>
+{
+  static double value() { return 1.0e-5; }
+};
+
+template<>
+struct FusedBLASTol<LatticeFermionD>
+{
+  static double value() { return 1.0e-12; }
+};
+
+
+/*
+ * The specializations for LatticeFermionF and LatticeFermionD replace the
+ * templates, so the reference of each test is the body of the template
+ * written out with QDP expressions. Fields are compared on the whole
+ * lattice, which also checks that sites outside the subset are untouched.
+ */
+template<typename T>
+class FusedBLASTests : public ::testing::Test {
+public:
+  typedef typename FusedBLAS::Scalar<T>::Complex_t C;
+  typedef typename FusedBLAS::Scalar<T>::Real_t    R;
+  typedef typename WordType<T>::Type_t             W;
+
+  FusedBLASTests()
+  {
+    subs.push_back(&all);
+    subs.push_back(&rb[1]);
+  }
+
+  static T random()
+  {
+    T x;
+    gaussian(x);
+    return x;
+  }
+
+  static double tol() { return FusedBLASTol<T>::value(); }
+
+  static double diff(const T& x, const T& x_ref)
+  {
+    T d = x - x_ref;
+    return toDouble(sqrt(norm2(d) / norm2(x_ref)));
+  }
+
+  static double diff(const Double& x, const Double& x_ref)
+  {
+    return fabs(toDouble(x - x_ref)) / fabs(toDouble(x_ref));
+  }
+
+  static double diff(const DComplex& x, const DComplex& x_ref)
+  {
+    DComplex d = x - x_ref;
+    return hypot(toDouble(real(d)), toDouble(imag(d))) /
+      hypot(toDouble(real(x_ref)), toDouble(imag(x_ref)));
+  }
+
+  std::vector<const Subset*> subs;
+};
+
+typedef ::testing::Types<LatticeFermionF, LatticeFermionD> FusedBLASTypes;
+TYPED_TEST_CASE(FusedBLASTests, FusedBLASTypes);
+
+
+TYPED_TEST(FusedBLASTests, axpyNorm)
+{
+  typedef TypeParam T;
+  typedef typename TestFixture::C C;
+  const DComplex a = cmplx(Double(0.3), Double(-0.7));
+
+  for(int i=0; i < this->subs.size(); ++i)
+  {
+    const Subset& s = *this->subs[i];
+    T x = this->random();
+    T y = this->random();
+    T y_ref = y;
+
+    C a_c = a;
+    y_ref[s] += a_c*x;
+    Double n_ref = norm2(y_ref, s);
+
+    Double n = FusedBLAS::axpyNorm(y, a, x, s);
+
+    EXPECT_LT(this->diff(y, y_ref), this->tol()) << "subset " << i;
+    EXPECT_LT(this->diff(n, n_ref), this->tol()) << "subset " << i;
+  }
+}
+
+TYPED_TEST(FusedBLASTests, axpyDot)
+{
+  typedef TypeParam T;
+  typedef typename TestFixture::C C;
+  const DComplex a = cmplx(Double(-1.1), Double(0.4));
+
+  for(int i=0; i < this->subs.size(); ++i)
+  {
+    const Subset& s = *this->subs[i];
+    T x = this->random();
+    T z = this->random();
+    T y = this->random();
+    T y_ref = y;
+
+    C a_c = a;
+    y_ref[s] += a_c*x;
+    DComplex d_ref = innerProduct(z, y_ref, s);
+
+    DComplex d = FusedBLAS::axpyDot(y, a, x, z, s);
+
+    EXPECT_LT(this->diff(y, y_ref), this->tol()) << "subset " << i;
+    EXPECT_LT(this->diff(d, d_ref), this->tol()) << "subset " << i;
+  }
+}
+
+TYPED_TEST(FusedBLASTests, xpay)
+{
+  typedef TypeParam T;
+  typedef typename TestFixture::C C;
+  const DComplex a = cmplx(Double(0.8), Double(0.25));
+
+  for(int i=0; i < this->subs.size(); ++i)
+  {
+    const Subset& s = *this->subs[i];
+    T x = this->random();
+    T y = this->random();
+    T y_ref = y;
+
+    C a_c = a;
+    y_ref[s] = x + a_c*y_ref;
+
+    FusedBLAS::xpay(y, x, a, s);
+
+    EXPECT_LT(this->diff(y, y_ref), this->tol()) << "subset " << i;
+  }
+}
+
+TYPED_TEST(FusedBLASTests, axpbyNorm)
+{
+  typedef TypeParam T;
+  typedef typename TestFixture::C C;
+  const DComplex a = cmplx(Double(0.5), Double(-0.2));
+  const DComplex b = cmplx(Double(-0.9), Double(1.3));
+
+  for(int i=0; i < this->subs.size(); ++i)
+  {
+    const Subset& s = *this->subs[i];
+    T x = this->random();
+    T y = this->random();
+    T y_ref = y;
+
+    C a_c = a;
+    C b_c = b;
+    y_ref[s] = a_c*x + b_c*y_ref;
+    Double n_ref = norm2(y_ref, s);
+
+    Double n = FusedBLAS::axpbyNorm(y, a, x, b, s);
+
+    EXPECT_LT(this->diff(y, y_ref), this->tol()) << "subset " << i;
+    EXPECT_LT(this->diff(n, n_ref), this->tol()) << "subset " << i;
+  }
+}
+
+TYPED_TEST(FusedBLASTests, axpyAxpyNorm)
+{
+  typedef TypeParam T;
+  typedef typename TestFixture::C C;
+  const DComplex a = cmplx(Double(0.6), Double(0.1));
+  const DComplex b = cmplx(Double(-0.35), Double(0.75));
+
+  for(int i=0; i < this->subs.size(); ++i)
+  {
+    const Subset& s = *this->subs[i];
+    T x = this->random();
+    T p = this->random();
+    T r = this->random();
+    T q = this->random();
+    T x_ref = x;
+    T r_ref = r;
+
+    C a_c = a;
+    C b_c = b;
+    x_ref[s] += a_c*p;
+    r_ref[s] += b_c*q;
+    Double n_ref = norm2(r_ref, s);
+
+    Double n = FusedBLAS::axpyAxpyNorm(x, a, p, r, b, q, s);
+
+    EXPECT_LT(this->diff(x, x_ref), this->tol()) << "subset " << i;
+    EXPECT_LT(this->diff(r, r_ref), this->tol()) << "subset " << i;
+    EXPECT_LT(this->diff(n, n_ref), this->tol()) << "subset " << i;
+  }
+}
+
+TYPED_TEST(FusedBLASTests, axpyAxpyNormAliased)
+{
+  typedef TypeParam T;
+  typedef typename TestFixture::C C;
+  const DComplex a = cmplx(Double(1.2), Double(-0.45));
+  const DComplex b = cmplx(Double(-0.65), Double(-0.3));
+
+  for(int i=0; i < this->subs.size(); ++i)
+  {
+    const Subset& s = *this->subs[i];
+    T psi = this->random();
+    T r = this->random();
+    T t = this->random();
+    T psi_ref = psi;
+    T r_ref = r;
+
+    // psi is updated with the old r
+    C a_c = a;
+    C b_c = b;
+    psi_ref[s] += a_c*r_ref;
+    r_ref[s] += b_c*t;
+    Double n_ref = norm2(r_ref, s);
+
+    Double n = FusedBLAS::axpyAxpyNorm(psi, a, r, r, b, t, s);
+
+    EXPECT_LT(this->diff(psi, psi_ref), this->tol()) << "subset " << i;
+    EXPECT_LT(this->diff(r, r_ref), this->tol()) << "subset " << i;
+    EXPECT_LT(this->diff(n, n_ref), this->tol()) << "subset " << i;
+  }
+}
+
+TYPED_TEST(FusedBLASTests, blockDot)
+{
+  typedef TypeParam T;
+
+  for(int i=0; i < this->subs.size(); ++i)
+  {
+    const Subset& s = *this->subs[i];
+    T u = this->random();
+    T v = this->random();
+    T w = this->random();
+
+    // Includes a norm and a repeated vector
+    std::vector<const T*> a(3), b(3);
+    a[0] = &u;  b[0] = &v;
+    a[1] = &w;  b[1] = &w;
+    a[2] = &v;  b[2] = &u;
+
+    std::vector<DComplex> out;
+    FusedBLAS::blockDot(out, a, b, s);
+
+    ASSERT_EQ(out.size(), a.size());
+    for(int k=0; k < a.size(); ++k)
+    {
+      DComplex d_ref = innerProduct(*a[k], *b[k], s);
+      EXPECT_LT(this->diff(out[k], d_ref), this->tol()) << "subset " << i << " pair " << k;
+    }
+  }
+}
+
+TYPED_TEST(FusedBLASTests, pipeCGUpdate)
+{
+  typedef TypeParam T;
+  typedef typename TestFixture::R R;
+  typedef typename TestFixture::W W;
+  const Double alpha(0.37);
+  const Double beta(0.81);
+
+  for(int i=0; i < this->subs.size(); ++i)
+  {
+    const Subset& sub = *this->subs[i];
+    T n = this->random();
+    T z = this->random();
+    T s = this->random();
+    T p = this->random();
+    T x = this->random();
+    T r = this->random();
+    T w = this->random();
+    T z_ref = z, s_ref = s, p_ref = p, x_ref = x, r_ref = r, w_ref = w;
+
+    R a_r = W(toDouble(alpha));
+    R b_r = W(toDouble(beta));
+    z_ref[sub] = n + b_r*z_ref;
+    s_ref[sub] = w_ref + b_r*s_ref;
+    p_ref[sub] = r_ref + b_r*p_ref;
+    x_ref[sub] += a_r*p_ref;
+    r_ref[sub] -= a_r*s_ref;
+    w_ref[sub] -= a_r*z_ref;
+    Double rr_ref = norm2(r_ref, sub);
+    Double wr_ref = real(innerProduct(w_ref, r_ref, sub));
+
+    Double rr, wr;
+    FusedBLAS::pipeCGUpdate(rr, wr, alpha, beta, n, z, s, p, x, r, w, sub);
+
+    EXPECT_LT(this->diff(z, z_ref), this->tol()) << "subset " << i;
+    EXPECT_LT(this->diff(s, s_ref), this->tol()) << "subset " << i;
+    EXPECT_LT(this->diff(p, p_ref), this->tol()) << "subset " << i;
+    EXPECT_LT(this->diff(x, x_ref), this->tol()) << "subset " << i;
+    EXPECT_LT(this->diff(r, r_ref), this->tol()) << "subset " << i;
+    EXPECT_LT(this->diff(w, w_ref), this->tol()) << "subset " << i;
+    EXPECT_LT(this->diff(rr, rr_ref), this->tol()) << "subset " << i;
+    EXPECT_LT(this->diff(wr, wr_ref), this->tol()) << "subset " << i;
+  }
+}
+
+TYPED_TEST(FusedBLASTests, multiShiftUpdate)
+{
+  typedef TypeParam T;
+  typedef typename TestFixture::R R;
+  typedef typename TestFixture::W W;
+  const int nshift = 4;
+  const int nact = 2;
+  const Double a(0.42);
+
+  std::vector<double> z(nshift), c(nshift), b(nshift);
+  for(int k=0; k < nshift; ++k)
+  {
+    z[k] = 0.9 - 0.1*k;
+    c[k] = 0.3 + 0.15*k;
+    b[k] = -0.55 + 0.2*k;
+  }
+
+  for(int i=0; i < this->subs.size(); ++i)
+  {
+    const Subset& sub = *this->subs[i];
+    T r = this->random();
+    T p_0 = this->random();
+    T p_0_ref = p_0;
+
+    std::vector<T> p_v(nshift), x_v(nshift), p_ref(nshift), x_ref(nshift);
+    std::vector<T*> p(nshift), x(nshift);
+    for(int k=0; k < nshift; ++k)
+    {
+      p_v[k] = this->random();
+      x_v[k] = this->random();
+      p_ref[k] = p_v[k];
+      x_ref[k] = x_v[k];
+      p[k] = &p_v[k];
+      x[k] = &x_v[k];
+    }
+
+    // Active shifts update x and p, retired shifts only x
+    for(int k=0; k < nshift; ++k)
+    {
+      R b_r = W(b[k]);
+      x_ref[k][sub] -= b_r*p_ref[k];
+
+      if (k < nact)
+      {
+	R z_r = W(z[k]);
+	R c_r = W(c[k]);
+	p_ref[k][sub] = z_r*r + c_r*p_ref[k];
+      }
+    }
+    R a_r = W(toDouble(a));
+    p_0_ref[sub] = r + a_r*p_0_ref;
+
+    std::vector<T> p_old = p_v;
+    FusedBLAS::multiShiftUpdate(r, p_0, a, p, x, nact, z, c, b, sub);
+
+    EXPECT_LT(this->diff(p_0, p_0_ref), this->tol()) << "subset " << i;
+    for(int k=0; k < nshift; ++k)
+    {
+      EXPECT_LT(this->diff(x_v[k], x_ref[k]), this->tol()) << "subset " << i << " shift " << k;
+      EXPECT_LT(this->diff(p_v[k], p_ref[k]), this->tol()) << "subset " << i << " shift " << k;
+    }
+
+    // The search directions of retired shifts are left exactly as they were
+    for(int k=nact; k < nshift; ++k)
+    {
+      T d = p_v[k] - p_old[k];
+      EXPECT_EQ(toDouble(norm2(d)), 0.0) << "subset " << i << " shift " << k;
+    }
+  }
+}
@@ -0,0 +1,19 @@
+#
+#  This is the portion of a script this is included recursively
+#
+
+#
+# Each test has a name, input file name, output file name,
+# and the good output that is tested against.
+#
+@regres_list = 
+    (
+     {
+	 exec_path   => "$top_builddir/mainprogs/main" , 
+	 execute     => "chroma" , 
+	 input       => "$test_dir/chroma/io/named_obj_release/named_obj_release.ini.xml" , 
+	 output      => "named_obj_release.candidate.xml",
+	 metric      => "$test_dir/chroma/io/named_obj_release/named_obj_release.metric.xml" ,
+	 controlfile => "$test_dir/chroma/io/named_obj_release/named_obj_release.out.xml" ,
+     }
+     );